@@ -0,0 +1,11 @@
+@echo off
+rem Builds the stub TouchEngine library from TouchEngineStub.cpp, to Binaries\ThirdParty\Win64\Stub of the plugin.
+rem Run it from a Visual Studio developer command prompt, then start Unreal with
+rem -TouchEngineLibDir=<plugin directory>\Binaries\ThirdParty\Win64\Stub to load the stub instead of the TouchEngine library of TouchDesigner.
+setlocal
+set SOURCE_DIR=%~dp0
+set OUTPUT_DIR=%SOURCE_DIR%..\..\..\Binaries\ThirdParty\Win64\Stub
+if not exist "%OUTPUT_DIR%" mkdir "%OUTPUT_DIR%"
+
+cl /nologo /std:c++17 /O2 /EHsc /MD /LD /DTE_BUILD_DLL /I"%SOURCE_DIR%..\TouchEngineAPI\include" "%SOURCE_DIR%TouchEngineStub.cpp" /Fo"%OUTPUT_DIR%\\" /Fe"%OUTPUT_DIR%\TouchEngine.dll" /link d3d11.lib
+exit /b %ERRORLEVEL%
@@ -0,0 +1,2420 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+/*
+ * Stub build of the TouchEngine library, implementing the C API used by the plugin without launching TouchDesigner.
+ *
+ * The path given to TEInstanceConfigure is read as a text description of the links of the component instead of a .tox file
+ * (see CookPipelineBenchmark.stub.tox next to this file for the syntax). Descriptions have to start with a touchengine_stub line, so a real
+ * .tox file given to the stub fails to load instead of being parsed as an empty component. Each cook sleeps for the configured time, then writes outputs
+ * computed from the frame time and the numeric inputs, so the whole cook pipeline of the plugin can be run and profiled on
+ * machines without a TouchDesigner install, like build agents.
+ *
+ * Texture outputs never receive a value, and the Vulkan entry points are not exported, so the stub is meant to be used with the
+ * NullRHI, D3D11 or D3D12. Build it with Build.bat and start Unreal with -TouchEngineLibDir=<directory of the stub TouchEngine.dll>.
+ *
+ * The stub is only built for Win64, like the rest of the plugin: it does not give a Linux build of the plugin. The sources compile with
+ * gcc and clang, but the TouchEngine module itself is only allowed on Win64 in TouchEngine.uplugin, and the TE_ENUM declarations of
+ * the TouchEngine API headers are rejected by clang, so running the automation tests on Linux build agents needs both to be ported first.
+ */
+
+#include "TouchEngine/TEObject.h"
+#include "TouchEngine/TEResult.h"
+#include "TouchEngine/TEInstance.h"
+#include "TouchEngine/TETexture.h"
+#include "TouchEngine/TESemaphore.h"
+#include "TouchEngine/TEGraphicsContext.h"
+#include "TouchEngine/TEAdapter.h"
+#include "TouchEngine/TEFloatBuffer.h"
+#include "TouchEngine/TETable.h"
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+// The TouchEngine D3D headers expect the Windows and D3D types to be declared
+#include <d3d11_1.h>
+#include <d3d12.h>
+#include "TouchEngine/TED3D.h"
+#include "TouchEngine/TED3D11.h"
+#include "TouchEngine/TED3D12.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace TouchEngineStub
+{
+	/** Precedes the memory of every object handed out by the library, so the public structs (TEString, TELinkInfo...) can be returned as is */
+	struct alignas(16) FObjectHeader
+	{
+		std::atomic<int32_t> RefCount { 1 };
+		TEObjectType Type = TEObjectTypeUnknown;
+		/** The TETextureType or TESemaphoreType of textures and semaphores */
+		int32_t SubType = 0;
+		void (*Destroy)(FObjectHeader* Header) = nullptr;
+	};
+
+	template <typename T>
+	struct TObjectBlock
+	{
+		FObjectHeader Header;
+		T Payload;
+	};
+
+	inline FObjectHeader* GetHeader(const void* Object)
+	{
+		return reinterpret_cast<FObjectHeader*>(const_cast<char*>(static_cast<const char*>(Object)) - sizeof(FObjectHeader));
+	}
+
+	template <typename T>
+	void DestroyObject(FObjectHeader* Header)
+	{
+		delete reinterpret_cast<TObjectBlock<T>*>(Header);
+	}
+
+	template <typename T>
+	T* CreateObject(TEObjectType Type, int32_t SubType = 0, void (*Destroy)(FObjectHeader*) = &DestroyObject<T>)
+	{
+		static_assert(alignof(T) <= alignof(FObjectHeader), "The payload must directly follow the header");
+		TObjectBlock<T>* Block = new TObjectBlock<T>();
+		Block->Header.Type = Type;
+		Block->Header.SubType = SubType;
+		Block->Header.Destroy = Destroy;
+		return &Block->Payload;
+	}
+
+	template <typename T>
+	T* Retain(T* Object)
+	{
+		return static_cast<T*>(TERetain(const_cast<void*>(static_cast<const void*>(Object))));
+	}
+
+	template <typename T>
+	void Release(T*& Object)
+	{
+		void* Pointer = const_cast<void*>(static_cast<const void*>(Object));
+		TERelease_(&Pointer);
+		Object = nullptr;
+	}
+
+	struct FString
+	{
+		TEString Public {};
+		std::string Storage;
+	};
+
+	struct FStringArray
+	{
+		TEStringArray Public {};
+		std::vector<std::string> Storage;
+		std::vector<const char*> Pointers;
+	};
+
+	struct FLinkInfo
+	{
+		TELinkInfo Public {};
+		std::string Label;
+		std::string Name;
+		std::string Identifier;
+	};
+
+	struct FLinkState
+	{
+		TELinkState Public {};
+	};
+
+	struct FErrorArray
+	{
+		TEErrorArray Public {};
+	};
+
+	/** Leads the payload of every texture type */
+	struct FTexture
+	{
+		TETextureOrigin Origin = TETextureOriginTopLeft;
+		TETextureComponentMap Map = kTETextureComponentMapIdentity;
+	};
+
+	TEString* MakeString(std::string Value)
+	{
+		FString* String = CreateObject<FString>(TEObjectTypeString);
+		String->Storage = std::move(Value);
+		String->Public.string = String->Storage.c_str();
+		return &String->Public;
+	}
+
+	TEStringArray* MakeStringArray(std::vector<std::string> Values)
+	{
+		FStringArray* Array = CreateObject<FStringArray>(TEObjectTypeStringArray);
+		Array->Storage = std::move(Values);
+		for (const std::string& Value : Array->Storage)
+		{
+			Array->Pointers.push_back(Value.c_str());
+		}
+		Array->Public.count = static_cast<int32_t>(Array->Pointers.size());
+		Array->Public.strings = Array->Pointers.empty() ? nullptr : Array->Pointers.data();
+		return &Array->Public;
+	}
+
+	template <typename T>
+	TEResult CopySupportedValues(const std::vector<T>& Supported, T* Values, int32_t* Count)
+	{
+		if (!Count)
+		{
+			return TEResultBadUsage;
+		}
+		const int32_t Available = static_cast<int32_t>(Supported.size());
+		if (!Values)
+		{
+			*Count = Available;
+			return TEResultSuccess;
+		}
+		if (*Count < Available)
+		{
+			*Count = Available;
+			return TEResultInsufficientMemory;
+		}
+		std::copy(Supported.begin(), Supported.end(), Values);
+		*Count = Available;
+		return TEResultSuccess;
+	}
+}
+
+struct TETable_
+{
+	std::vector<std::vector<std::string>> Rows;
+	int32_t Columns = 0;
+};
+
+struct TEFloatBuffer_
+{
+	double Rate = 0.;
+	int32_t Channels = 0;
+	uint32_t Capacity = 0;
+	uint32_t ValueCount = 0;
+	bool bTimeDependent = false;
+	int64_t StartTime = 0;
+	TEFloatBufferExtend ExtendBefore = TEFloatBufferExtendHold;
+	TEFloatBufferExtend ExtendAfter = TEFloatBufferExtendHold;
+	float ExtendConstant = 0.f;
+	std::vector<std::string> Names;
+	std::vector<const char*> NamePointers;
+	std::vector<std::vector<float>> Values;
+	std::vector<const float*> ValuePointers;
+};
+
+namespace TouchEngineStub
+{
+	TEFloatBuffer* MakeFloatBuffer(double Rate, int32_t Channels, uint32_t Capacity, const char* const* Names, bool bTimeDependent)
+	{
+		if (Channels <= 0)
+		{
+			return nullptr;
+		}
+		TEFloatBuffer* Buffer = CreateObject<TEFloatBuffer>(TEObjectTypeFloatBuffer);
+		Buffer->Rate = Rate;
+		Buffer->Channels = Channels;
+		Buffer->Capacity = Capacity;
+		Buffer->bTimeDependent = bTimeDependent;
+		Buffer->Values.assign(Channels, std::vector<float>(Capacity, 0.f));
+		for (std::vector<float>& Channel : Buffer->Values)
+		{
+			Buffer->ValuePointers.push_back(Channel.data());
+		}
+		if (Names)
+		{
+			for (int32_t Index = 0; Index < Channels; ++Index)
+			{
+				Buffer->Names.emplace_back(Names[Index] ? Names[Index] : "");
+			}
+			for (const std::string& Name : Buffer->Names)
+			{
+				Buffer->NamePointers.push_back(Name.c_str());
+			}
+		}
+		return Buffer;
+	}
+
+	/** The part of the time of the frame written by the double outputs of a clock link */
+	enum class EClockValue
+	{
+		None,
+		TimeValue,
+		TimeScale,
+		Discontinuity
+	};
+
+	/** A link of the loaded component, described by a line of the file given to TEInstanceConfigure */
+	struct FLink
+	{
+		std::string Identifier;
+		std::string Name;
+		TEScope Scope = TEScopeInput;
+		TELinkType Type = TELinkTypeDouble;
+		TELinkDomain Domain = TELinkDomainParameter;
+		int32_t Count = 1;
+		/** The number of samples per channel of float buffer outputs */
+		uint32_t Samples = 1;
+		TELinkInterest Interest = TELinkInterestAll;
+		/** Set on the outputs declared by a clock link, which report the time given to TEInstanceStartFrameAtTime instead of a computed value */
+		EClockValue Clock = EClockValue::None;
+
+		/** Current values of boolean, double and int links */
+		std::vector<double> Values;
+		bool bHasValue = false;
+		std::string String;
+		TETable* Table = nullptr;
+		TEFloatBuffer* FloatBuffer = nullptr;
+		TETexture* Texture = nullptr;
+
+		bool IsNumeric() const { return Type == TELinkTypeBoolean || Type == TELinkTypeDouble || Type == TELinkTypeInt; }
+
+		void ReleaseValues()
+		{
+			Release(Table);
+			Release(FloatBuffer);
+			Release(Texture);
+		}
+	};
+
+	/** The content of a component description file */
+	struct FComponent
+	{
+		std::vector<FLink> Links;
+		double CookMilliseconds = 0.;
+		int32_t DropEvery = 0;
+	};
+
+	bool ParseLinkType(const std::string& Token, TELinkType& OutType)
+	{
+		static const std::map<std::string, TELinkType> Types = {
+			{ "bool", TELinkTypeBoolean },
+			{ "double", TELinkTypeDouble },
+			{ "int", TELinkTypeInt },
+			{ "string", TELinkTypeString },
+			{ "table", TELinkTypeStringData },
+			{ "floatbuffer", TELinkTypeFloatBuffer },
+			{ "texture", TELinkTypeTexture },
+		};
+		const auto Found = Types.find(Token);
+		if (Found == Types.end())
+		{
+			return false;
+		}
+		OutType = Found->second;
+		return true;
+	}
+
+	TEResult ParseComponent(const std::string& Path, FComponent& OutComponent)
+	{
+		std::ifstream File(Path);
+		if (!File)
+		{
+			return TEResultFileError;
+		}
+
+		std::string Line;
+		bool bHasHeader = false;
+		while (std::getline(File, Line))
+		{
+			std::istringstream Tokens(Line.substr(0, Line.find('#')));
+			std::string Keyword;
+			if (!(Tokens >> Keyword))
+			{
+				continue;
+			}
+
+			if (!bHasHeader)
+			{
+				int Version = 0;
+				if (Keyword != "touchengine_stub" || !(Tokens >> Version) || Version != 1)
+				{
+					return TEResultFileError;
+				}
+				bHasHeader = true;
+				continue;
+			}
+			if (Keyword == "cook_ms")
+			{
+				if (!(Tokens >> OutComponent.CookMilliseconds))
+				{
+					return TEResultFileError;
+				}
+				continue;
+			}
+			if (Keyword == "drop_every")
+			{
+				if (!(Tokens >> OutComponent.DropEvery))
+				{
+					return TEResultFileError;
+				}
+				continue;
+			}
+			if (Keyword != "in" && Keyword != "out")
+			{
+				return TEResultFileError;
+			}
+
+			FLink Link;
+			std::string TypeToken;
+			if (!(Tokens >> TypeToken >> Link.Name))
+			{
+				return TEResultFileError;
+			}
+			if (TypeToken == "clock")
+			{
+				// A clock is declared as three double outputs, so tests can check the exact time and discontinuity each frame was started with
+				if (Keyword != "out")
+				{
+					return TEResultFileError;
+				}
+				const std::pair<const char*, EClockValue> ClockValues[] = {
+					{ "_value", EClockValue::TimeValue },
+					{ "_scale", EClockValue::TimeScale },
+					{ "_discontinuity", EClockValue::Discontinuity },
+				};
+				for (const std::pair<const char*, EClockValue>& ClockValue : ClockValues)
+				{
+					FLink ClockLink;
+					ClockLink.Name = Link.Name + ClockValue.first;
+					ClockLink.Identifier = Keyword + "/" + ClockLink.Name;
+					ClockLink.Scope = TEScopeOutput;
+					ClockLink.Type = TELinkTypeDouble;
+					ClockLink.Domain = TELinkDomainOperator;
+					ClockLink.Clock = ClockValue.second;
+					ClockLink.Values.assign(1, 0.);
+					const bool bIsDuplicate = std::any_of(OutComponent.Links.begin(), OutComponent.Links.end(), [&ClockLink](const FLink& Other) { return Other.Identifier == ClockLink.Identifier; });
+					if (bIsDuplicate)
+					{
+						return TEResultFileError;
+					}
+					OutComponent.Links.push_back(std::move(ClockLink));
+				}
+				continue;
+			}
+			if (!ParseLinkType(TypeToken, Link.Type))
+			{
+				return TEResultFileError;
+			}
+			Link.Scope = Keyword == "in" ? TEScopeInput : TEScopeOutput;
+			if (Tokens >> Link.Count)
+			{
+				Tokens >> Link.Samples;
+			}
+			if (Link.Count <= 0 || Link.Samples == 0)
+			{
+				return TEResultFileError;
+			}
+
+			// Values and strings given to a component are parameters, everything else comes from or goes to an operator
+			const bool bIsParameter = Link.Scope == TEScopeInput && (Link.IsNumeric() || Link.Type == TELinkTypeString);
+			Link.Domain = bIsParameter ? TELinkDomainParameter : TELinkDomainOperator;
+			Link.Identifier = Keyword + "/" + Link.Name;
+			if (Link.Type == TELinkTypeBoolean || Link.Type == TELinkTypeString || Link.Type == TELinkTypeTexture || Link.Type == TELinkTypeStringData)
+			{
+				Link.Count = 1;
+			}
+			if (Link.IsNumeric())
+			{
+				Link.Values.assign(Link.Count, 0.);
+				Link.bHasValue = Link.Scope == TEScopeInput;
+			}
+			if (Link.Type == TELinkTypeString)
+			{
+				Link.bHasValue = Link.Scope == TEScopeInput;
+			}
+
+			const bool bIsDuplicate = std::any_of(OutComponent.Links.begin(), OutComponent.Links.end(), [&Link](const FLink& Other) { return Other.Identifier == Link.Identifier; });
+			if (bIsDuplicate)
+			{
+				return TEResultFileError;
+			}
+			OutComponent.Links.push_back(std::move(Link));
+		}
+		return bHasHeader ? TEResultSuccess : TEResultFileError;
+	}
+
+	const char* GetGroupIdentifier(TEScope Scope)
+	{
+		return Scope == TEScopeInput ? "in" : "out";
+	}
+}
+
+struct TEInstance_
+{
+	TEInstanceEventCallback EventCallback = nullptr;
+	TEInstanceLinkCallback LinkCallback = nullptr;
+	void* CallbackInfo = nullptr;
+
+	/** Guards everything below, and is never held while calling back into the caller */
+	std::mutex Mutex;
+
+	std::string Path;
+	std::string AssetDirectory;
+	TETimeMode TimeMode = TETimeInternal;
+	TETextureOrigin OutputOrigin = TETextureOriginTopLeft;
+	int64_t FrameRateNumerator = 60;
+	int32_t FrameRateDenominator = 1;
+	bool bSuspended = true;
+
+	/** Incremented by every configure, load and unload, so a load which has been superseded does not report its result */
+	uint64_t LoadGeneration = 0;
+	bool bLoadPending = false;
+	bool bLoaded = false;
+	TouchEngineStub::FComponent Component;
+	std::unordered_map<std::string, size_t> LinkIndices;
+
+	bool bFrameInProgress = false;
+	/** Incremented by every frame start, so a cook which has been cancelled does not report its result */
+	uint64_t FrameGeneration = 0;
+	int64_t FrameCount = 0;
+	int64_t FrameStartValue = 0;
+	int64_t FrameEndValue = 0;
+	int32_t FrameTimeScale = 1;
+	/** The discontinuity flag given to TEInstanceStartFrameAtTime for the frame being cooked */
+	bool bFrameIsDiscontinuity = false;
+	bool bFrameDropped = false;
+	int64_t LastFinishedStartValue = 0;
+	std::condition_variable FrameCancelled;
+
+	std::map<const TETexture*, std::pair<TESemaphore*, uint64_t>> TextureTransfers;
+
+	/** Every event is delivered from this thread, except the cancellation of a frame which is delivered by TEInstanceCancelFrame itself */
+	std::thread Worker;
+	std::deque<std::function<void()>> Jobs;
+	std::condition_variable JobAdded;
+	bool bStopping = false;
+	/** Set when the last reference was released from a callback, in which case the worker thread destroys the instance once it exits */
+	bool bDestroyOnWorkerExit = false;
+};
+
+namespace TouchEngineStub
+{
+	TouchEngineStub::FLink* FindLink(TEInstance& Instance, const char* Identifier)
+	{
+		if (!Identifier)
+		{
+			return nullptr;
+		}
+		const auto Found = Instance.LinkIndices.find(Identifier);
+		return Found != Instance.LinkIndices.end() ? &Instance.Component.Links[Found->second] : nullptr;
+	}
+
+	void PushJob(TEInstance& Instance, std::function<void()> Job)
+	{
+		// The mutex is expected to be held by the caller
+		Instance.Jobs.push_back(std::move(Job));
+		Instance.JobAdded.notify_one();
+	}
+
+	void SendEvent(TEInstance& Instance, TEEvent Event, TEResult Result, int64_t StartValue = 0, int64_t EndValue = 0, int32_t TimeScale = 1)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Instance.Mutex);
+			if (Instance.bStopping)
+			{
+				return;
+			}
+		}
+		if (Instance.EventCallback)
+		{
+			Instance.EventCallback(&Instance, Event, Result, StartValue, TimeScale, EndValue, TimeScale, Instance.CallbackInfo);
+		}
+	}
+
+	void SendLinkEvent(TEInstance& Instance, TELinkEvent Event, const std::string& Identifier)
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Instance.Mutex);
+			if (Instance.bStopping)
+			{
+				return;
+			}
+		}
+		if (Instance.LinkCallback)
+		{
+			Instance.LinkCallback(&Instance, Event, Identifier.c_str(), Instance.CallbackInfo);
+		}
+	}
+
+	void ClearTextureTransfers(TEInstance& Instance)
+	{
+		for (auto& Transfer : Instance.TextureTransfers)
+		{
+			Release(Transfer.second.first);
+		}
+		Instance.TextureTransfers.clear();
+	}
+
+	/**
+	 * Drops the loaded component and queues the events telling the caller about it. Any load in progress reports TEResultCancelled,
+	 * as does any frame in progress. Expects the mutex to be held.
+	 */
+	void UnloadLocked(TEInstance& Instance)
+	{
+		++Instance.LoadGeneration;
+		const bool bWasLoadPending = Instance.bLoadPending;
+		const bool bWasFrameInProgress = Instance.bFrameInProgress;
+		const int64_t StartValue = Instance.FrameStartValue;
+		const int64_t EndValue = Instance.FrameEndValue;
+		const int32_t TimeScale = Instance.FrameTimeScale;
+		std::vector<std::string> RemovedLinks;
+		for (FLink& Link : Instance.Component.Links)
+		{
+			RemovedLinks.push_back(Link.Identifier);
+			Link.ReleaseValues();
+		}
+
+		Instance.bLoadPending = false;
+		Instance.bLoaded = false;
+		Instance.bFrameInProgress = false;
+		Instance.Component = FComponent();
+		Instance.LinkIndices.clear();
+		ClearTextureTransfers(Instance);
+		Instance.FrameCancelled.notify_all();
+
+		TEInstance* InstancePtr = &Instance;
+		PushJob(Instance, [InstancePtr, bWasLoadPending, bWasFrameInProgress, StartValue, EndValue, TimeScale, RemovedLinks = std::move(RemovedLinks)]()
+		{
+			if (bWasFrameInProgress)
+			{
+				SendEvent(*InstancePtr, TEEventFrameDidFinish, TEResultCancelled, StartValue, EndValue, TimeScale);
+			}
+			if (bWasLoadPending)
+			{
+				SendEvent(*InstancePtr, TEEventInstanceDidLoad, TEResultCancelled);
+			}
+			for (const std::string& Identifier : RemovedLinks)
+			{
+				SendLinkEvent(*InstancePtr, TELinkEventRemoved, Identifier);
+			}
+			SendEvent(*InstancePtr, TEEventInstanceDidUnload, TEResultSuccess);
+			SendEvent(*InstancePtr, TEEventInstanceReady, TEResultSuccess);
+		});
+	}
+
+	void LoadJob(TEInstance& Instance, uint64_t Generation, const std::string& Path)
+	{
+		FComponent Component;
+		const TEResult Result = ParseComponent(Path, Component);
+
+		std::vector<std::string> AddedLinks;
+		{
+			std::lock_guard<std::mutex> Lock(Instance.Mutex);
+			if (Instance.LoadGeneration != Generation) // Unloaded or configured again in the meantime, which reported the cancellation
+			{
+				return;
+			}
+			Instance.bLoadPending = false;
+			if (Result == TEResultSuccess)
+			{
+				Instance.Component = std::move(Component);
+				for (size_t Index = 0; Index < Instance.Component.Links.size(); ++Index)
+				{
+					Instance.LinkIndices.emplace(Instance.Component.Links[Index].Identifier, Index);
+					AddedLinks.push_back(Instance.Component.Links[Index].Identifier);
+				}
+				Instance.bLoaded = true;
+				Instance.FrameCount = 0;
+			}
+		}
+
+		for (const std::string& Identifier : AddedLinks)
+		{
+			SendLinkEvent(Instance, TELinkEventAdded, Identifier);
+		}
+		SendEvent(Instance, TEEventInstanceDidLoad, Result);
+	}
+
+	/** Sum of the inputs, which every output depends on so changing an input changes the outputs like it would in a real component */
+	double SumInputsLocked(const TEInstance& Instance)
+	{
+		double Sum = 0.;
+		for (const FLink& Link : Instance.Component.Links)
+		{
+			if (Link.Scope != TEScopeInput)
+			{
+				continue;
+			}
+			if (Link.IsNumeric())
+			{
+				Sum += Link.Values.empty() ? 0. : Link.Values[0];
+			}
+			else if (Link.FloatBuffer && Link.FloatBuffer->ValueCount > 0)
+			{
+				Sum += Link.FloatBuffer->Values[0][Link.FloatBuffer->ValueCount - 1];
+			}
+		}
+		return Sum;
+	}
+
+	/** Writes the outputs of the frame being cooked and returns the identifiers of the links the caller should be told about */
+	std::vector<std::string> UpdateOutputsLocked(TEInstance& Instance)
+	{
+		constexpr double TwoPi = 6.283185307179586;
+		const double Time = static_cast<double>(Instance.FrameStartValue) / Instance.FrameTimeScale;
+		const double InputSum = SumInputsLocked(Instance);
+		const double FrameRate = static_cast<double>(Instance.FrameRateNumerator) / Instance.FrameRateDenominator;
+
+		std::vector<std::string> ChangedLinks;
+		for (FLink& Link : Instance.Component.Links)
+		{
+			if (Link.Scope != TEScopeOutput || Link.Type == TELinkTypeTexture)
+			{
+				continue;
+			}
+
+			switch (Link.Type)
+			{
+			case TELinkTypeBoolean:
+				Link.Values[0] = Instance.FrameCount % 2 == 0 ? 1. : 0.;
+				break;
+			case TELinkTypeDouble:
+				if (Link.Clock != EClockValue::None)
+				{
+					Link.Values[0] = Link.Clock == EClockValue::TimeValue ? static_cast<double>(Instance.FrameStartValue)
+						: Link.Clock == EClockValue::TimeScale ? static_cast<double>(Instance.FrameTimeScale)
+						: Instance.bFrameIsDiscontinuity ? 1. : 0.;
+					break;
+				}
+				for (int32_t Index = 0; Index < Link.Count; ++Index)
+				{
+					Link.Values[Index] = std::sin(Time + Index) + InputSum;
+				}
+				break;
+			case TELinkTypeInt:
+				for (int32_t Index = 0; Index < Link.Count; ++Index)
+				{
+					Link.Values[Index] = static_cast<double>(Instance.FrameCount + Index) + std::floor(InputSum);
+				}
+				break;
+			case TELinkTypeString:
+				Link.String = "frame " + std::to_string(Instance.FrameCount);
+				break;
+			case TELinkTypeStringData:
+				{
+					TETable* Table = TETableCreate();
+					TETableResize(Table, 2, 2);
+					TETableSetStringValue(Table, 0, 0, "frame");
+					TETableSetStringValue(Table, 0, 1, std::to_string(Instance.FrameCount).c_str());
+					TETableSetStringValue(Table, 1, 0, "inputs");
+					TETableSetStringValue(Table, 1, 1, std::to_string(InputSum).c_str());
+					Release(Link.Table);
+					Link.Table = Table;
+					break;
+				}
+			case TELinkTypeFloatBuffer:
+				{
+					// A new buffer every frame, as the caller may still hold the previous one
+					TEFloatBuffer* Buffer = MakeFloatBuffer(FrameRate, Link.Count, Link.Samples, nullptr, false);
+					for (int32_t Channel = 0; Channel < Link.Count; ++Channel)
+					{
+						for (uint32_t Sample = 0; Sample < Link.Samples; ++Sample)
+						{
+							Buffer->Values[Channel][Sample] = static_cast<float>(std::sin(TwoPi * Sample / Link.Samples + Time + Channel) + InputSum);
+						}
+					}
+					Buffer->ValueCount = Link.Samples;
+					Release(Link.FloatBuffer);
+					Link.FloatBuffer = Buffer;
+					break;
+				}
+			default:
+				break;
+			}
+			Link.bHasValue = true;
+
+			if (Link.Interest == TELinkInterestSubsequentValues)
+			{
+				Link.Interest = TELinkInterestAll;
+			}
+			if (Link.Interest == TELinkInterestAll)
+			{
+				ChangedLinks.push_back(Link.Identifier);
+			}
+		}
+		return ChangedLinks;
+	}
+
+	void FrameJob(TEInstance& Instance, uint64_t Generation)
+	{
+		std::vector<std::string> ChangedLinks;
+		{
+			std::unique_lock<std::mutex> Lock(Instance.Mutex);
+			const auto IsCancelled = [&Instance, Generation]() { return Instance.bStopping || !Instance.bFrameInProgress || Instance.FrameGeneration != Generation; };
+			const auto CookDuration = std::chrono::duration<double, std::milli>(Instance.Component.CookMilliseconds);
+			if (Instance.FrameCancelled.wait_for(Lock, CookDuration, IsCancelled) || IsCancelled())
+			{
+				return;
+			}
+			if (!Instance.bFrameDropped)
+			{
+				ChangedLinks = UpdateOutputsLocked(Instance);
+			}
+		}
+
+		// Like TouchEngine, output values are signaled before the frame is reported as finished
+		for (const std::string& Identifier : ChangedLinks)
+		{
+			SendLinkEvent(Instance, TELinkEventValueChange, Identifier);
+		}
+
+		int64_t StartValue;
+		int64_t EndValue;
+		int32_t TimeScale;
+		{
+			std::lock_guard<std::mutex> Lock(Instance.Mutex);
+			if (Instance.bStopping || !Instance.bFrameInProgress || Instance.FrameGeneration != Generation) // Cancelled while the outputs were signaled
+			{
+				return;
+			}
+			Instance.bFrameInProgress = false;
+			// A dropped frame is reported with the start time of the previous frame, which is how the caller detects it
+			StartValue = Instance.bFrameDropped ? Instance.LastFinishedStartValue : Instance.FrameStartValue;
+			EndValue = Instance.FrameEndValue;
+			TimeScale = Instance.FrameTimeScale;
+			Instance.LastFinishedStartValue = StartValue;
+		}
+		SendEvent(Instance, TEEventFrameDidFinish, TEResultSuccess, StartValue, EndValue, TimeScale);
+	}
+
+	void RunWorker(TEInstance* Instance)
+	{
+		while (true)
+		{
+			std::function<void()> Job;
+			{
+				std::unique_lock<std::mutex> Lock(Instance->Mutex);
+				Instance->JobAdded.wait(Lock, [Instance]() { return Instance->bStopping || !Instance->Jobs.empty(); });
+				if (Instance->bStopping)
+				{
+					break;
+				}
+				Job = std::move(Instance->Jobs.front());
+				Instance->Jobs.pop_front();
+			}
+			Job();
+		}
+
+		if (Instance->bDestroyOnWorkerExit)
+		{
+			DestroyObject<TEInstance>(GetHeader(Instance));
+		}
+	}
+
+	void DestroyInstance(FObjectHeader* Header)
+	{
+		TEInstance* Instance = &reinterpret_cast<TObjectBlock<TEInstance>*>(Header)->Payload;
+		{
+			std::lock_guard<std::mutex> Lock(Instance->Mutex);
+			Instance->bStopping = true;
+			Instance->bFrameInProgress = false;
+			for (FLink& Link : Instance->Component.Links)
+			{
+				Link.ReleaseValues();
+			}
+			ClearTextureTransfers(*Instance);
+		}
+		Instance->JobAdded.notify_all();
+		Instance->FrameCancelled.notify_all();
+
+		if (Instance->Worker.get_id() == std::this_thread::get_id())
+		{
+			Instance->bDestroyOnWorkerExit = true;
+			Instance->Worker.detach();
+			return;
+		}
+		Instance->Worker.join();
+		DestroyObject<TEInstance>(Header);
+	}
+
+	template <typename T>
+	TEResult GetNumericValue(TEInstance* Instance, const char* Identifier, TELinkValue Which, T* Value, int32_t Count, TELinkType Type)
+	{
+		if (!Instance || !Value || Count <= 0)
+		{
+			return TEResultBadUsage;
+		}
+		std::lock_guard<std::mutex> Lock(Instance->Mutex);
+		const FLink* Link = FindLink(*Instance, Identifier);
+		if (!Link)
+		{
+			return TEResultNoMatchingEntity;
+		}
+		if (Link->Type != Type)
+		{
+			return TEResultBadUsage;
+		}
+		for (int32_t Index = 0; Index < Count; ++Index)
+		{
+			const bool bHasIndex = Index < Link->Count;
+			Value[Index] = Which == TELinkValueCurrent && bHasIndex ? static_cast<T>(Link->Values[Index]) : T();
+		}
+		return TEResultSuccess;
+	}
+
+	template <typename T>
+	TEResult SetNumericValue(TEInstance* Instance, const char* Identifier, const T* Value, int32_t Count, TELinkType Type)
+	{
+		if (!Instance || !Value || Count <= 0)
+		{
+			return TEResultBadUsage;
+		}
+		std::lock_guard<std::mutex> Lock(Instance->Mutex);
+		FLink* Link = FindLink(*Instance, Identifier);
+		if (!Link)
+		{
+			return TEResultNoMatchingEntity;
+		}
+		if (Link->Scope != TEScopeInput || Link->Type != Type || Count > Link->Count)
+		{
+			return TEResultBadUsage;
+		}
+		for (int32_t Index = 0; Index < Count; ++Index)
+		{
+			Link->Values[Index] = static_cast<double>(Value[Index]);
+		}
+		return TEResultSuccess;
+	}
+
+	/** Looks up an input link of the given type to set its value, expecting the mutex to be held */
+	TEResult FindInputLinkLocked(TEInstance& Instance, const char* Identifier, TELinkType Type, FLink*& OutLink)
+	{
+		OutLink = FindLink(Instance, Identifier);
+		if (!OutLink)
+		{
+			return TEResultNoMatchingEntity;
+		}
+		return OutLink->Scope == TEScopeInput && OutLink->Type == Type ? TEResultSuccess : TEResultBadUsage;
+	}
+
+	const char* GetResultDescription(TEResult Result)
+	{
+		switch (Result)
+		{
+		case TEResultSuccess: return "Success.";
+		case TEResultInsufficientMemory: return "Insufficient memory.";
+		case TEResultGPUAllocationFailed: return "A GPU allocation failed.";
+		case TEResultTextureFormatNotSupported: return "The texture format is not supported.";
+		case TEResultTextureComponentMapNotSupported: return "The texture component map was not honored.";
+		case TEResultExecutableError: return "The TouchEngine process stopped.";
+		case TEResultInternalError: return "Internal error.";
+		case TEResultMissingResource: return "A required resource is missing.";
+		case TEResultDroppedSamples: return "Samples were dropped during rendering.";
+		case TEResultMissedSamples: return "Insufficient samples were provided during rendering.";
+		case TEResultBadUsage: return "Invalid arguments, or a function called at an improper time.";
+		case TEResultNoMatchingEntity: return "The requested entity does not exist.";
+		case TEResultCancelled: return "The operation was cancelled.";
+		case TEResultExpiredKey: return "The key is expired.";
+		case TEResultNoKey: return "No key was found.";
+		case TEResultKeyError: return "The installed key could not be read.";
+		case TEResultFileError: return "The file could not be read, or is not a valid component description for the stub library.";
+		case TEResultNewerFileVersion: return "The file was saved by a newer version.";
+		case TEResultTouchEngineNotFound: return "TouchEngine was not found.";
+		case TEResultTouchEngineBadPath: return "TouchEngine could not be used.";
+		case TEResultFailedToLaunchTouchEngine: return "TouchEngine failed to launch.";
+		case TEResultFeatureNotSupportedBySystem: return "A required feature is not supported by the system.";
+		case TEResultOlderEngineVersion: return "The version of TouchEngine is older than the library.";
+		case TEResultIncompatibleEngineVersion: return "The version of TouchEngine is not compatible with the library.";
+		case TEResultPermissionDenied: return "Permission denied.";
+		case TEResultComponentErrors: return "The component reported errors.";
+		case TEResultComponentWarnings: return "The component reported warnings.";
+		default: return nullptr;
+		}
+	}
+}
+
+using namespace TouchEngineStub;
+
+// Objects
+
+TEObject* TERetain(TEObject* object)
+{
+	if (object)
+	{
+		GetHeader(object)->RefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	return object;
+}
+
+void TERelease_(TEObject** object)
+{
+	if (!object || !*object)
+	{
+		return;
+	}
+	FObjectHeader* Header = GetHeader(*object);
+	*object = nullptr;
+	if (Header->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		Header->Destroy(Header);
+	}
+}
+
+TEObjectType TEGetType(const TEObject* object)
+{
+	return object ? GetHeader(object)->Type : TEObjectTypeUnknown;
+}
+
+const char* TEResultGetDescription(TEResult result)
+{
+	return GetResultDescription(result);
+}
+
+TESeverity TEResultGetSeverity(TEResult result)
+{
+	switch (result)
+	{
+	case TEResultSuccess:
+		return TESeverityNone;
+	case TEResultTextureComponentMapNotSupported:
+	case TEResultDroppedSamples:
+	case TEResultMissedSamples:
+	case TEResultOlderEngineVersion:
+	case TEResultComponentWarnings:
+		return TESeverityWarning;
+	default:
+		return TESeverityError;
+	}
+}
+
+// Instances
+
+TEResult TEInstanceGetSupportedFileExtensions(TEStringArray** extensions)
+{
+	if (!extensions)
+	{
+		return TEResultBadUsage;
+	}
+	*extensions = MakeStringArray({ "tox" });
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceCreate(TEInstanceEventCallback event_callback, TEInstanceLinkCallback link_callback, void* callback_info, TEInstance** instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	TEInstance* Instance = CreateObject<TEInstance>(TEObjectTypeInstance, 0, &DestroyInstance);
+	Instance->EventCallback = event_callback;
+	Instance->LinkCallback = link_callback;
+	Instance->CallbackInfo = callback_info;
+	Instance->Worker = std::thread(&RunWorker, Instance);
+	*instance = Instance;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceConfigure(TEInstance* instance, const char* path, TETimeMode mode)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	if (instance->bLoaded || instance->bLoadPending)
+	{
+		UnloadLocked(*instance);
+	}
+	else
+	{
+		++instance->LoadGeneration;
+		TEInstance* Instance = instance;
+		PushJob(*instance, [Instance]() { SendEvent(*Instance, TEEventInstanceReady, TEResultSuccess); });
+	}
+	instance->Path = path ? path : "";
+	instance->TimeMode = mode;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLoad(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	if (instance->Path.empty())
+	{
+		return TEResultBadUsage;
+	}
+	if (instance->bLoaded || instance->bLoadPending)
+	{
+		UnloadLocked(*instance);
+	}
+	const uint64_t Generation = ++instance->LoadGeneration;
+	instance->bLoadPending = true;
+	TEInstance* Instance = instance;
+	PushJob(*instance, [Instance, Generation, Path = instance->Path]() { LoadJob(*Instance, Generation, Path); });
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceUnload(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	UnloadLocked(*instance);
+	return TEResultSuccess;
+}
+
+bool TEInstanceHasFile(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	return !instance->Path.empty();
+}
+
+void TEInstanceGetPath(TEInstance* instance, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	*string = MakeString(instance->Path);
+}
+
+TETimeMode TEInstanceGetTimeMode(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TETimeInternal;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	return instance->TimeMode;
+}
+
+TEResult TEInstanceAssociateGraphicsContext(TEInstance* instance, TEGraphicsContext* context)
+{
+	// Nothing is rendered, so the context is not needed
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceAssociateAdapter(TEInstance* instance, TEAdapter* adapter)
+{
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+TEResult TEInstanceSetOutputTextureOrigin(TEInstance* instance, TETextureOrigin origin)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	instance->OutputOrigin = origin;
+	return TEResultSuccess;
+}
+
+TETextureOrigin TEInstanceGetOutputTextureOrigin(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TETextureOriginTopLeft;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	return instance->OutputOrigin;
+}
+
+TEResult TEInstanceResume(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	instance->bSuspended = false;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceSuspend(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	instance->bSuspended = true;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceSetFrameRate(TEInstance* instance, int64_t numerator, int32_t denominator)
+{
+	if (!instance || numerator <= 0 || denominator <= 0)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	instance->FrameRateNumerator = numerator;
+	instance->FrameRateDenominator = denominator;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceSetFloatFrameRate(TEInstance* instance, float rate)
+{
+	return TEInstanceSetFrameRate(instance, static_cast<int64_t>(std::llround(rate * 1000.)), 1000);
+}
+
+TEResult TEInstanceGetFrameRate(TEInstance* instance, int64_t* numerator, int32_t* denominator)
+{
+	if (!instance || !numerator || !denominator)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	*numerator = instance->FrameRateNumerator;
+	*denominator = instance->FrameRateDenominator;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetFloatFrameRate(TEInstance* instance, float* rate)
+{
+	int64_t Numerator;
+	int32_t Denominator;
+	const TEResult Result = TEInstanceGetFrameRate(instance, &Numerator, &Denominator);
+	if (Result == TEResultSuccess && rate)
+	{
+		*rate = static_cast<float>(static_cast<double>(Numerator) / Denominator);
+	}
+	return rate ? Result : TEResultBadUsage;
+}
+
+TEResult TEInstanceSetStatisticsCallback(TEInstance* instance, TEInstanceStatisticsCallback callback)
+{
+	// No statistics are gathered
+	return instance ? TEResultSuccess : TEResultBadUsage;
+}
+
+void TEInstanceGetAssetDirectory(TEInstance* instance, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	std::string Directory = instance->AssetDirectory;
+	if (Directory.empty())
+	{
+		const size_t Separator = instance->Path.find_last_of("/\\");
+		Directory = Separator == std::string::npos ? std::string() : instance->Path.substr(0, Separator);
+	}
+	*string = MakeString(std::move(Directory));
+}
+
+TEResult TEInstanceSetAssetDirectory(TEInstance* instance, const char* path)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	instance->AssetDirectory = path ? path : "";
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetSupportedTextureTypes(TEInstance* instance, TETextureType types[], int32_t* count)
+{
+	return instance ? CopySupportedValues<TETextureType>({ TETextureTypeD3DShared }, types, count) : TEResultBadUsage;
+}
+
+TEResult TEInstanceGetSupportedTextureFormats(TEInstance* instance, TETextureFormat formats[], int32_t* count)
+{
+	static const std::vector<TETextureFormat> Formats = {
+		TETextureFormatR8Unorm, TETextureFormatR16Unorm, TETextureFormatR16F, TETextureFormatR32F,
+		TETextureFormatRG8Unorm, TETextureFormatRG16Unorm, TETextureFormatRG16F, TETextureFormatRG32F,
+		TETextureFormatRGB10_A2Unorm, TETextureFormatRGBA8Unorm, TETextureFormatBGRA8Unorm, TETextureFormatSRGBA8Unorm,
+		TETextureFormatSBGRA8Unorm, TETextureFormatRGBA16Unorm, TETextureFormatRGBA16F, TETextureFormatRGBA32F,
+	};
+	return instance ? CopySupportedValues(Formats, formats, count) : TEResultBadUsage;
+}
+
+TEResult TEInstanceGetSupportedSemaphoreTypes(TEInstance* instance, TESemaphoreType types[], int32_t* count)
+{
+	return instance ? CopySupportedValues<TESemaphoreType>({ TESemaphoreTypeD3DFence }, types, count) : TEResultBadUsage;
+}
+
+bool TEInstanceDoesTextureOwnershipTransfer(TEInstance* instance)
+{
+	return false;
+}
+
+TEResult TEInstanceAddTextureTransfer(TEInstance* instance, TETexture* texture, TESemaphore* semaphore, uint64_t value)
+{
+	if (!instance || !texture)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	std::pair<TESemaphore*, uint64_t>& Transfer = instance->TextureTransfers[texture];
+	Release(Transfer.first);
+	Transfer = { semaphore ? Retain(semaphore) : nullptr, value };
+	return TEResultSuccess;
+}
+
+bool TEInstanceHasTextureTransfer(TEInstance* instance, const TETexture* texture)
+{
+	if (!instance || !texture)
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	return instance->TextureTransfers.count(texture) > 0;
+}
+
+TEResult TEInstanceGetTextureTransfer(TEInstance* instance, const TETexture* texture, TESemaphore** semaphore, uint64_t* waitValue)
+{
+	if (!instance || !texture || !semaphore || !waitValue)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const auto Found = instance->TextureTransfers.find(texture);
+	if (Found == instance->TextureTransfers.end())
+	{
+		return TEResultBadUsage;
+	}
+	// The reference held by the instance is handed to the caller
+	*semaphore = Found->second.first;
+	*waitValue = Found->second.second;
+	instance->TextureTransfers.erase(Found);
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceStartFrameAtTime(TEInstance* instance, int64_t time_value, int32_t time_scale, bool discontinuity)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	if (!instance->bLoaded || instance->bSuspended || instance->bFrameInProgress)
+	{
+		return TEResultBadUsage;
+	}
+
+	if (instance->TimeMode == TETimeExternal)
+	{
+		if (time_scale <= 0)
+		{
+			return TEResultBadUsage;
+		}
+		instance->FrameTimeScale = time_scale;
+		instance->FrameStartValue = time_value;
+		instance->FrameEndValue = time_value + std::llround(static_cast<double>(time_scale) * instance->FrameRateDenominator / instance->FrameRateNumerator);
+		instance->bFrameIsDiscontinuity = discontinuity;
+	}
+	else
+	{
+		// The internal clock ticks once per frame, in units of the frame rate denominator
+		instance->FrameTimeScale = static_cast<int32_t>(instance->FrameRateNumerator);
+		instance->FrameStartValue = instance->FrameCount * instance->FrameRateDenominator;
+		instance->FrameEndValue = instance->FrameStartValue + instance->FrameRateDenominator;
+		instance->bFrameIsDiscontinuity = false;
+	}
+
+	++instance->FrameCount;
+	const int32_t DropEvery = instance->Component.DropEvery;
+	instance->bFrameDropped = DropEvery > 0 && instance->FrameCount % DropEvery == 0;
+	instance->bFrameInProgress = true;
+	const uint64_t Generation = ++instance->FrameGeneration;
+	TEInstance* Instance = instance;
+	PushJob(*instance, [Instance, Generation]() { FrameJob(*Instance, Generation); });
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceCancelFrame(TEInstance* instance)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+
+	int64_t StartValue;
+	int64_t EndValue;
+	int32_t TimeScale;
+	{
+		std::lock_guard<std::mutex> Lock(instance->Mutex);
+		if (!instance->bFrameInProgress)
+		{
+			return TEResultBadUsage;
+		}
+		instance->bFrameInProgress = false;
+		StartValue = instance->FrameStartValue;
+		EndValue = instance->FrameEndValue;
+		TimeScale = instance->FrameTimeScale;
+		instance->LastFinishedStartValue = StartValue;
+		instance->FrameCancelled.notify_all();
+	}
+	// Delivered before returning, as the plugin expects its frame to be over once this function returns
+	SendEvent(*instance, TEEventFrameDidFinish, TEResultCancelled, StartValue, EndValue, TimeScale);
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetErrors(TEInstance* instance, TEErrorArray** errors)
+{
+	if (!instance || !errors)
+	{
+		return TEResultBadUsage;
+	}
+	*errors = &CreateObject<FErrorArray>(TEObjectTypeErrorArray)->Public;
+	return TEResultSuccess;
+}
+
+// Links
+
+TEResult TEInstanceLinkGetChildren(TEInstance* instance, const char* identifier, TEStringArray** children)
+{
+	if (!instance || !children)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	if (!identifier)
+	{
+		*children = MakeStringArray({ GetGroupIdentifier(TEScopeInput), GetGroupIdentifier(TEScopeOutput) });
+		return TEResultSuccess;
+	}
+
+	for (const TEScope Scope : { TEScopeInput, TEScopeOutput })
+	{
+		if (std::string(identifier) == GetGroupIdentifier(Scope))
+		{
+			std::vector<std::string> Identifiers;
+			for (const FLink& Link : instance->Component.Links)
+			{
+				if (Link.Scope == Scope)
+				{
+					Identifiers.push_back(Link.Identifier);
+				}
+			}
+			*children = MakeStringArray(std::move(Identifiers));
+			return TEResultSuccess;
+		}
+	}
+	if (FindLink(*instance, identifier))
+	{
+		*children = MakeStringArray({});
+		return TEResultSuccess;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkGetParent(TEInstance* instance, const char* identifier, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	*string = MakeString(GetGroupIdentifier(Link->Scope));
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceGetLinkGroups(TEInstance* instance, TEScope scope, TEStringArray** groups)
+{
+	if (!instance || !groups)
+	{
+		return TEResultBadUsage;
+	}
+	*groups = MakeStringArray({ GetGroupIdentifier(scope) });
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetInfo(TEInstance* instance, const char* identifier, TELinkInfo** info)
+{
+	if (!instance || !identifier || !info)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLinkInfo* LinkInfo = nullptr;
+	for (const TEScope Scope : { TEScopeInput, TEScopeOutput })
+	{
+		if (std::string(identifier) == GetGroupIdentifier(Scope))
+		{
+			LinkInfo = CreateObject<FLinkInfo>(TEObjectTypeLinkInfo);
+			LinkInfo->Label = Scope == TEScopeInput ? "Inputs" : "Outputs";
+			LinkInfo->Name = LinkInfo->Identifier = identifier;
+			LinkInfo->Public.scope = Scope;
+			LinkInfo->Public.intent = TELinkIntentNotSpecified;
+			LinkInfo->Public.type = TELinkTypeGroup;
+			LinkInfo->Public.domain = TELinkDomainNone;
+			LinkInfo->Public.count = static_cast<int32_t>(std::count_if(instance->Component.Links.begin(), instance->Component.Links.end(), [Scope](const FLink& Link) { return Link.Scope == Scope; }));
+		}
+	}
+	if (!LinkInfo)
+	{
+		const FLink* Link = FindLink(*instance, identifier);
+		if (!Link)
+		{
+			return TEResultNoMatchingEntity;
+		}
+		LinkInfo = CreateObject<FLinkInfo>(TEObjectTypeLinkInfo);
+		LinkInfo->Label = LinkInfo->Name = Link->Name;
+		LinkInfo->Identifier = Link->Identifier;
+		LinkInfo->Public.scope = Link->Scope;
+		LinkInfo->Public.intent = TELinkIntentNotSpecified;
+		LinkInfo->Public.type = Link->Type;
+		LinkInfo->Public.domain = Link->Domain;
+		LinkInfo->Public.count = Link->Count;
+	}
+	LinkInfo->Public.label = LinkInfo->Label.c_str();
+	LinkInfo->Public.name = LinkInfo->Name.c_str();
+	LinkInfo->Public.identifier = LinkInfo->Identifier.c_str();
+	*info = &LinkInfo->Public;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetState(TEInstance* instance, const char* identifier, TELinkState** state)
+{
+	if (!instance || !state)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	FLinkState* LinkState = CreateObject<FLinkState>(TEObjectTypeLinkState);
+	LinkState->Public.enabled = true;
+	LinkState->Public.editable = Link->Scope == TEScopeInput;
+	*state = &LinkState->Public;
+	return TEResultSuccess;
+}
+
+bool TEInstanceLinkHasChoices(TEInstance* instance, const char* identifier)
+{
+	return false;
+}
+
+TEResult TEInstanceLinkGetChoiceLabels(TEInstance* instance, const char* identifier, TEStringArray** labels)
+{
+	if (labels)
+	{
+		*labels = nullptr;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkGetChoiceValues(TEInstance* instance, const char* identifier, TEStringArray** values)
+{
+	if (values)
+	{
+		*values = nullptr;
+	}
+	return TEResultNoMatchingEntity;
+}
+
+bool TEInstanceLinkHasUserTint(TEInstance* instance, const char* identifier)
+{
+	return false;
+}
+
+TEResult TEInstanceLinkGetUserTint(TEInstance* instance, const char* identifier, TEColor* tint)
+{
+	return TEResultNoMatchingEntity;
+}
+
+TEResult TEInstanceLinkSetInterest(TEInstance* instance, const char* identifier, TELinkInterest interest)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	Link->Interest = interest;
+	return TEResultSuccess;
+}
+
+TELinkInterest TEInstanceLinkGetInterest(TEInstance* instance, const char* identifier)
+{
+	if (!instance)
+	{
+		return TELinkInterestNone;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	return Link ? Link->Interest : TELinkInterestNone;
+}
+
+bool TEInstanceLinkHasValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t index)
+{
+	if (!instance)
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link || index < 0 || index >= Link->Count)
+	{
+		return false;
+	}
+	// Inputs default to zero or an empty string and have no range
+	switch (which)
+	{
+	case TELinkValueDefault:
+		return Link->Scope == TEScopeInput && (Link->IsNumeric() || Link->Type == TELinkTypeString);
+	case TELinkValueCurrent:
+		return Link->bHasValue || Link->Table || Link->FloatBuffer || Link->Texture;
+	default:
+		return false;
+	}
+}
+
+TEResult TEInstanceLinkGetBooleanValue(TEInstance* instance, const char* identifier, TELinkValue which, bool* value)
+{
+	double Value;
+	const TEResult Result = GetNumericValue(instance, identifier, which, &Value, 1, TELinkTypeBoolean);
+	if (Result == TEResultSuccess && value)
+	{
+		*value = Value != 0.;
+	}
+	return value ? Result : TEResultBadUsage;
+}
+
+TEResult TEInstanceLinkGetDoubleValue(TEInstance* instance, const char* identifier, TELinkValue which, double* value, int32_t count)
+{
+	return GetNumericValue(instance, identifier, which, value, count, TELinkTypeDouble);
+}
+
+TEResult TEInstanceLinkGetIntValue(TEInstance* instance, const char* identifier, TELinkValue which, int32_t* value, int32_t count)
+{
+	return GetNumericValue(instance, identifier, which, value, count, TELinkTypeInt);
+}
+
+TEResult TEInstanceLinkGetStringValue(TEInstance* instance, const char* identifier, TELinkValue which, TEString** string)
+{
+	if (!instance || !string)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	if (Link->Type != TELinkTypeString)
+	{
+		return TEResultBadUsage;
+	}
+	*string = MakeString(which == TELinkValueCurrent ? Link->String : std::string());
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetTextureValue(TEInstance* instance, const char* identifier, TELinkValue which, TETexture** value)
+{
+	if (!instance || !value)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	if (Link->Type != TELinkTypeTexture)
+	{
+		return TEResultBadUsage;
+	}
+	*value = which == TELinkValueCurrent && Link->Texture ? Retain(Link->Texture) : nullptr;
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetTableValue(TEInstance* instance, const char* identifier, TELinkValue which, TETable** value)
+{
+	if (!instance || !value)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	if (Link->Type != TELinkTypeStringData)
+	{
+		return TEResultBadUsage;
+	}
+	if (which != TELinkValueCurrent || !Link->Table)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	*value = Retain(Link->Table);
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetFloatBufferValue(TEInstance* instance, const char* identifier, TELinkValue which, TEFloatBuffer** value)
+{
+	if (!instance || !value)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	const FLink* Link = FindLink(*instance, identifier);
+	if (!Link)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	if (Link->Type != TELinkTypeFloatBuffer)
+	{
+		return TEResultBadUsage;
+	}
+	// Float buffers have no default value
+	if (which != TELinkValueCurrent || !Link->FloatBuffer)
+	{
+		return TEResultNoMatchingEntity;
+	}
+	*value = Retain(Link->FloatBuffer);
+	return TEResultSuccess;
+}
+
+TEResult TEInstanceLinkGetObjectValue(TEInstance* instance, const char* identifier, TELinkValue which, TEObject** value)
+{
+	if (!instance || !value)
+	{
+		return TEResultBadUsage;
+	}
+	TELinkType Type;
+	{
+		std::lock_guard<std::mutex> Lock(instance->Mutex);
+		const FLink* Link = FindLink(*instance, identifier);
+		if (!Link)
+		{
+			return TEResultNoMatchingEntity;
+		}
+		Type = Link->Type;
+	}
+	switch (Type)
+	{
+	case TELinkTypeTexture:
+		return TEInstanceLinkGetTextureValue(instance, identifier, which, reinterpret_cast<TETexture**>(value));
+	case TELinkTypeStringData:
+		return TEInstanceLinkGetTableValue(instance, identifier, which, reinterpret_cast<TETable**>(value));
+	case TELinkTypeFloatBuffer:
+		return TEInstanceLinkGetFloatBufferValue(instance, identifier, which, reinterpret_cast<TEFloatBuffer**>(value));
+	default:
+		return TEResultBadUsage;
+	}
+}
+
+TEResult TEInstanceLinkSetBooleanValue(TEInstance* instance, const char* identifier, bool value)
+{
+	return SetNumericValue(instance, identifier, &value, 1, TELinkTypeBoolean);
+}
+
+TEResult TEInstanceLinkSetDoubleValue(TEInstance* instance, const char* identifier, const double* value, int32_t count)
+{
+	return SetNumericValue(instance, identifier, value, count, TELinkTypeDouble);
+}
+
+TEResult TEInstanceLinkSetIntValue(TEInstance* instance, const char* identifier, const int32_t* value, int32_t count)
+{
+	return SetNumericValue(instance, identifier, value, count, TELinkTypeInt);
+}
+
+TEResult TEInstanceLinkSetStringValue(TEInstance* instance, const char* identifier, const char* value)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLink* Link = FindLink(*instance, identifier);
+	if (Link && Link->Scope == TEScopeInput && Link->Type == TELinkTypeStringData)
+	{
+		// A string given to a table input becomes its single cell
+		TETable* Table = TETableCreate();
+		TETableResize(Table, 1, 1);
+		TETableSetStringValue(Table, 0, 0, value ? value : "");
+		Release(Link->Table);
+		Link->Table = Table;
+		return TEResultSuccess;
+	}
+	const TEResult Result = FindInputLinkLocked(*instance, identifier, TELinkTypeString, Link);
+	if (Result == TEResultSuccess)
+	{
+		Link->String = value ? value : "";
+	}
+	return Result;
+}
+
+TEResult TEInstanceLinkSetTextureValue(TEInstance* instance, const char* identifier, TETexture* texture, TEGraphicsContext* context)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLink* Link;
+	const TEResult Result = FindInputLinkLocked(*instance, identifier, TELinkTypeTexture, Link);
+	if (Result == TEResultSuccess)
+	{
+		TETexture* Previous = Link->Texture;
+		Link->Texture = texture ? Retain(texture) : nullptr;
+		Release(Previous);
+	}
+	return Result;
+}
+
+TEResult TEInstanceLinkSetFloatBufferValue(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLink* Link;
+	const TEResult Result = FindInputLinkLocked(*instance, identifier, TELinkTypeFloatBuffer, Link);
+	if (Result == TEResultSuccess)
+	{
+		if (buffer && buffer->Channels > Link->Count)
+		{
+			return TEResultBadUsage;
+		}
+		TEFloatBuffer* Previous = Link->FloatBuffer;
+		Link->FloatBuffer = buffer ? Retain(const_cast<TEFloatBuffer*>(buffer)) : nullptr;
+		Release(Previous);
+	}
+	return Result;
+}
+
+TEResult TEInstanceLinkAddFloatBuffer(TEInstance* instance, const char* identifier, const TEFloatBuffer* buffer)
+{
+	// Only the latest samples are used to compute the outputs, so appending is the same as replacing
+	return TEInstanceLinkSetFloatBufferValue(instance, identifier, buffer);
+}
+
+TEResult TEInstanceLinkSetTableValue(TEInstance* instance, const char* identifier, const TETable* table)
+{
+	if (!instance)
+	{
+		return TEResultBadUsage;
+	}
+	std::lock_guard<std::mutex> Lock(instance->Mutex);
+	FLink* Link;
+	const TEResult Result = FindInputLinkLocked(*instance, identifier, TELinkTypeStringData, Link);
+	if (Result == TEResultSuccess)
+	{
+		Release(Link->Table);
+		Link->Table = table ? TETableCreateCopy(table) : nullptr;
+	}
+	return Result;
+}
+
+TEResult TEInstanceLinkSetObjectValue(TEInstance* instance, const char* identifier, TEObject* object)
+{
+	switch (TEGetType(object))
+	{
+	case TEObjectTypeTexture:
+		return TEInstanceLinkSetTextureValue(instance, identifier, object, nullptr);
+	case TEObjectTypeTable:
+		return TEInstanceLinkSetTableValue(instance, identifier, static_cast<const TETable*>(object));
+	case TEObjectTypeFloatBuffer:
+		return TEInstanceLinkSetFloatBufferValue(instance, identifier, static_cast<const TEFloatBuffer*>(object));
+	default:
+		return TEResultBadUsage;
+	}
+}
+
+// Float buffers
+
+TEFloatBuffer* TEFloatBufferCreate(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+{
+	return MakeFloatBuffer(rate, channels, capacity, names, false);
+}
+
+TEFloatBuffer* TEFloatBufferCreateTimeDependent(double rate, int32_t channels, uint32_t capacity, const char* const* names)
+{
+	return MakeFloatBuffer(rate, channels, capacity, names, true);
+}
+
+TEFloatBuffer* TEFloatBufferCreateCopy(const TEFloatBuffer* buffer)
+{
+	if (!buffer)
+	{
+		return nullptr;
+	}
+	TEFloatBuffer* Copy = MakeFloatBuffer(buffer->Rate, buffer->Channels, buffer->Capacity, buffer->NamePointers.empty() ? nullptr : buffer->NamePointers.data(), buffer->bTimeDependent);
+	Copy->ValueCount = buffer->ValueCount;
+	Copy->StartTime = buffer->StartTime;
+	Copy->ExtendBefore = buffer->ExtendBefore;
+	Copy->ExtendAfter = buffer->ExtendAfter;
+	Copy->ExtendConstant = buffer->ExtendConstant;
+	for (int32_t Channel = 0; Channel < buffer->Channels; ++Channel)
+	{
+		Copy->Values[Channel] = buffer->Values[Channel];
+		Copy->ValuePointers[Channel] = Copy->Values[Channel].data();
+	}
+	return Copy;
+}
+
+TEResult TEFloatBufferSetValues(TEFloatBuffer* buffer, const float** values, uint32_t count)
+{
+	if (!buffer || !values || count > buffer->Capacity)
+	{
+		return TEResultBadUsage;
+	}
+	for (int32_t Channel = 0; Channel < buffer->Channels; ++Channel)
+	{
+		std::copy(values[Channel], values[Channel] + count, buffer->Values[Channel].begin());
+	}
+	buffer->ValueCount = count;
+	return TEResultSuccess;
+}
+
+TEResult TEFloatBufferSetStartTime(TEFloatBuffer* buffer, int64_t start)
+{
+	if (!buffer || !buffer->bTimeDependent)
+	{
+		return TEResultBadUsage;
+	}
+	buffer->StartTime = start;
+	return TEResultSuccess;
+}
+
+const float* const* TEFloatBufferGetValues(const TEFloatBuffer* buffer)
+{
+	return buffer && !buffer->ValuePointers.empty() ? buffer->ValuePointers.data() : nullptr;
+}
+
+bool TEFloatBufferIsTimeDependent(const TEFloatBuffer* buffer)
+{
+	return buffer && buffer->bTimeDependent;
+}
+
+int64_t TEFloatBufferGetStartTime(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->StartTime : 0;
+}
+
+int64_t TEFloatBufferGetEndTime(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->StartTime + buffer->ValueCount : 0;
+}
+
+uint32_t TEFloatBufferGetCapacity(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Capacity : 0;
+}
+
+double TEFloatBufferGetRate(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Rate : 0.;
+}
+
+int32_t TEFloatBufferGetChannelCount(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->Channels : 0;
+}
+
+uint32_t TEFloatBufferGetValueCount(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ValueCount : 0;
+}
+
+const char* const* TEFloatBufferGetChannelNames(const TEFloatBuffer* buffer)
+{
+	return buffer && !buffer->NamePointers.empty() ? buffer->NamePointers.data() : nullptr;
+}
+
+TEFloatBufferExtend TEFloatBufferGetExtendBefore(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendBefore : TEFloatBufferExtendHold;
+}
+
+TEFloatBufferExtend TEFloatBufferGetExtendAfter(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendAfter : TEFloatBufferExtendHold;
+}
+
+float TEFloatBufferGetExtendConstantValue(const TEFloatBuffer* buffer)
+{
+	return buffer ? buffer->ExtendConstant : 0.f;
+}
+
+void TEFloatBufferSetExtend(TEFloatBuffer* buffer, TEFloatBufferExtend before, TEFloatBufferExtend after, float constant)
+{
+	if (buffer)
+	{
+		buffer->ExtendBefore = before;
+		buffer->ExtendAfter = after;
+		buffer->ExtendConstant = constant;
+	}
+}
+
+// Tables
+
+TETable* TETableCreate(void)
+{
+	return CreateObject<TETable>(TEObjectTypeTable);
+}
+
+TETable* TETableCreateCopy(const TETable* table)
+{
+	if (!table)
+	{
+		return nullptr;
+	}
+	TETable* Copy = TETableCreate();
+	Copy->Rows = table->Rows;
+	Copy->Columns = table->Columns;
+	return Copy;
+}
+
+int32_t TETableGetRowCount(const TETable* table)
+{
+	return table ? static_cast<int32_t>(table->Rows.size()) : 0;
+}
+
+int32_t TETableGetColumnCount(const TETable* table)
+{
+	return table ? table->Columns : 0;
+}
+
+const char* TETableGetStringValue(const TETable* table, int32_t row, int32_t column)
+{
+	if (!table || row < 0 || row >= TETableGetRowCount(table) || column < 0 || column >= table->Columns)
+	{
+		return nullptr;
+	}
+	return table->Rows[row][column].c_str();
+}
+
+void TETableResize(TETable* table, int32_t rows, int32_t columns)
+{
+	if (!table || rows < 0 || columns < 0)
+	{
+		return;
+	}
+	table->Rows.resize(rows);
+	for (std::vector<std::string>& Row : table->Rows)
+	{
+		Row.resize(columns);
+	}
+	table->Columns = columns;
+}
+
+TEResult TETableSetStringValue(TETable* table, int32_t row, int32_t column, const char* value)
+{
+	if (!table || row < 0 || row >= TETableGetRowCount(table) || column < 0 || column >= table->Columns)
+	{
+		return TEResultBadUsage;
+	}
+	table->Rows[row][column] = value ? value : "";
+	return TEResultSuccess;
+}
+
+// Textures, semaphores and graphics contexts
+
+TETextureType TETextureGetType(const TETexture* texture)
+{
+	return static_cast<TETextureType>(texture ? GetHeader(texture)->SubType : 0);
+}
+
+TETextureOrigin TETextureGetOrigin(const TETexture* texture)
+{
+	return texture ? static_cast<const FTexture*>(texture)->Origin : TETextureOriginTopLeft;
+}
+
+TETextureComponentMap TETextureGetComponentMap(TETexture* texture)
+{
+	return texture ? static_cast<const FTexture*>(texture)->Map : kTETextureComponentMapIdentity;
+}
+
+TESemaphoreType TESemaphoreGetType(const TESemaphore* semaphore)
+{
+	return static_cast<TESemaphoreType>(semaphore ? GetHeader(semaphore)->SubType : 0);
+}
+
+TEAdapter* TEGraphicsContextGetAdapter(TEGraphicsContext* context)
+{
+	// Adapters are not used, and the caller handles a null adapter
+	return nullptr;
+}
+
+#ifdef _WIN32
+
+struct TED3DSharedTexture_
+{
+	TouchEngineStub::FTexture Base;
+	HANDLE Handle = nullptr;
+	bool bOwnsHandle = false;
+	TED3DHandleType HandleType = TED3DHandleTypeD3D11Global;
+	DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+	uint64_t Width = 0;
+	uint32_t Height = 0;
+	TED3DSharedTextureCallback Callback = nullptr;
+	void* CallbackInfo = nullptr;
+};
+
+struct TED3D11Texture_
+{
+	TouchEngineStub::FTexture Base;
+	ID3D11Texture2D* Texture = nullptr;
+	DXGI_FORMAT TypedFormat = DXGI_FORMAT_UNKNOWN;
+	TED3D11TextureCallback Callback = nullptr;
+	void* CallbackInfo = nullptr;
+};
+
+struct TED3DSharedFence_
+{
+	HANDLE Handle = nullptr;
+	TED3DSharedFenceCallback Callback = nullptr;
+	void* CallbackInfo = nullptr;
+};
+
+struct TED3D11Context_
+{
+	ID3D11Device* Device = nullptr;
+};
+
+struct TED3D12Context_
+{
+	ID3D12Device* Device = nullptr;
+};
+
+namespace TouchEngineStub
+{
+	HANDLE DuplicateNTHandle(HANDLE Handle)
+	{
+		HANDLE Duplicate = nullptr;
+		const HANDLE Process = GetCurrentProcess();
+		return DuplicateHandle(Process, Handle, Process, &Duplicate, 0, FALSE, DUPLICATE_SAME_ACCESS) ? Duplicate : nullptr;
+	}
+
+	void DestroySharedTexture(FObjectHeader* Header)
+	{
+		TED3DSharedTexture* Texture = &reinterpret_cast<TObjectBlock<TED3DSharedTexture>*>(Header)->Payload;
+		if (Texture->Callback)
+		{
+			Texture->Callback(Texture->Handle, TEObjectEventRelease, Texture->CallbackInfo);
+		}
+		if (Texture->bOwnsHandle)
+		{
+			CloseHandle(Texture->Handle);
+		}
+		DestroyObject<TED3DSharedTexture>(Header);
+	}
+
+	void DestroyD3D11Texture(FObjectHeader* Header)
+	{
+		TED3D11Texture* Texture = &reinterpret_cast<TObjectBlock<TED3D11Texture>*>(Header)->Payload;
+		if (Texture->Callback)
+		{
+			Texture->Callback(Texture->Texture, TEObjectEventRelease, Texture->CallbackInfo);
+		}
+		Texture->Texture->Release();
+		DestroyObject<TED3D11Texture>(Header);
+	}
+
+	void DestroySharedFence(FObjectHeader* Header)
+	{
+		TED3DSharedFence* Fence = &reinterpret_cast<TObjectBlock<TED3DSharedFence>*>(Header)->Payload;
+		if (Fence->Callback)
+		{
+			Fence->Callback(Fence->Handle, TEObjectEventRelease, Fence->CallbackInfo);
+		}
+		CloseHandle(Fence->Handle);
+		DestroyObject<TED3DSharedFence>(Header);
+	}
+
+	void DestroyD3D11Context(FObjectHeader* Header)
+	{
+		TED3D11Context* Context = &reinterpret_cast<TObjectBlock<TED3D11Context>*>(Header)->Payload;
+		if (Context->Device)
+		{
+			Context->Device->Release();
+		}
+		DestroyObject<TED3D11Context>(Header);
+	}
+
+	void DestroyD3D12Context(FObjectHeader* Header)
+	{
+		TED3D12Context* Context = &reinterpret_cast<TObjectBlock<TED3D12Context>*>(Header)->Payload;
+		if (Context->Device)
+		{
+			Context->Device->Release();
+		}
+		DestroyObject<TED3D12Context>(Header);
+	}
+
+	TED3D11Texture* MakeD3D11Texture(ID3D11Texture2D* Texture, TETextureOrigin Origin, TETextureComponentMap Map, DXGI_FORMAT TypedFormat, TED3D11TextureCallback Callback, void* Info)
+	{
+		if (!Texture)
+		{
+			return nullptr;
+		}
+		TED3D11Texture* Result = CreateObject<TED3D11Texture>(TEObjectTypeTexture, TETextureTypeD3D11, &DestroyD3D11Texture);
+		Texture->AddRef();
+		Result->Base.Origin = Origin;
+		Result->Base.Map = Map;
+		Result->Texture = Texture;
+		Result->TypedFormat = TypedFormat;
+		Result->Callback = Callback;
+		Result->CallbackInfo = Info;
+		return Result;
+	}
+}
+
+TEResult TEInstanceGetSupportedD3DHandleTypes(TEInstance* instance, TED3DHandleType types[], int32_t* count)
+{
+	static const std::vector<TED3DHandleType> HandleTypes = { TED3DHandleTypeD3D11Global, TED3DHandleTypeD3D11NT, TED3DHandleTypeD3D12ResourceNT };
+	return instance ? CopySupportedValues(HandleTypes, types, count) : TEResultBadUsage;
+}
+
+TEResult TEInstanceGetSupportedD3DFormats(TEInstance* instance, DXGI_FORMAT formats[], int32_t* count)
+{
+	static const std::vector<DXGI_FORMAT> Formats = {
+		DXGI_FORMAT_R8_UNORM, DXGI_FORMAT_R16_UNORM, DXGI_FORMAT_R16_FLOAT, DXGI_FORMAT_R32_FLOAT,
+		DXGI_FORMAT_R8G8_UNORM, DXGI_FORMAT_R16G16_UNORM, DXGI_FORMAT_R16G16_FLOAT, DXGI_FORMAT_R32G32_FLOAT,
+		DXGI_FORMAT_R10G10B10A2_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM, DXGI_FORMAT_B8G8R8A8_UNORM, DXGI_FORMAT_R8G8B8A8_UNORM_SRGB,
+		DXGI_FORMAT_B8G8R8A8_UNORM_SRGB, DXGI_FORMAT_R16G16B16A16_UNORM, DXGI_FORMAT_R16G16B16A16_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT,
+	};
+	return instance ? CopySupportedValues(Formats, formats, count) : TEResultBadUsage;
+}
+
+bool TEInstanceRequiresKeyedMutexReleaseToZero(TEInstance* instance)
+{
+	return false;
+}
+
+TED3DSharedTexture* TED3DSharedTextureCreate(HANDLE handle, TED3DHandleType type, DXGI_FORMAT format, uint64_t width, uint32_t height, TETextureOrigin origin, TETextureComponentMap map, TED3DSharedTextureCallback callback, void* info)
+{
+	const bool bIsNTHandle = type != TED3DHandleTypeD3D11Global;
+	const HANDLE Handle = bIsNTHandle ? DuplicateNTHandle(handle) : handle;
+	if (!Handle)
+	{
+		return nullptr;
+	}
+	TED3DSharedTexture* Texture = CreateObject<TED3DSharedTexture>(TEObjectTypeTexture, TETextureTypeD3DShared, &DestroySharedTexture);
+	Texture->Base.Origin = origin;
+	Texture->Base.Map = map;
+	Texture->Handle = Handle;
+	Texture->bOwnsHandle = bIsNTHandle;
+	Texture->HandleType = type;
+	Texture->Format = format;
+	Texture->Width = width;
+	Texture->Height = height;
+	Texture->Callback = callback;
+	Texture->CallbackInfo = info;
+	return Texture;
+}
+
+HANDLE TED3DSharedTextureGetHandle(const TED3DSharedTexture* texture)
+{
+	return texture ? texture->Handle : nullptr;
+}
+
+TED3DHandleType TED3DSharedTextureGetHandleType(const TED3DSharedTexture* texture)
+{
+	return texture ? texture->HandleType : TED3DHandleTypeD3D11Global;
+}
+
+uint64_t TED3DSharedTextureGetWidth(const TED3DSharedTexture* texture)
+{
+	return texture ? texture->Width : 0;
+}
+
+uint32_t TED3DSharedTextureGetHeight(const TED3DSharedTexture* texture)
+{
+	return texture ? texture->Height : 0;
+}
+
+DXGI_FORMAT TED3DSharedTextureGetFormat(const TED3DSharedTexture* texture)
+{
+	return texture ? texture->Format : DXGI_FORMAT_UNKNOWN;
+}
+
+TEResult TED3DSharedTextureSetCallback(TED3DSharedTexture* texture, TED3DSharedTextureCallback callback, void* info)
+{
+	if (!texture)
+	{
+		return TEResultBadUsage;
+	}
+	texture->Callback = callback;
+	texture->CallbackInfo = info;
+	return TEResultSuccess;
+}
+
+TED3DSharedFence* TED3DSharedFenceCreate(HANDLE handle, TED3DSharedFenceCallback callback, void* info)
+{
+	const HANDLE Handle = DuplicateNTHandle(handle);
+	if (!Handle)
+	{
+		return nullptr;
+	}
+	TED3DSharedFence* Fence = CreateObject<TED3DSharedFence>(TEObjectTypeSemaphore, TESemaphoreTypeD3DFence, &DestroySharedFence);
+	Fence->Handle = Handle;
+	Fence->Callback = callback;
+	Fence->CallbackInfo = info;
+	return Fence;
+}
+
+HANDLE TED3DSharedFenceGetHandle(TED3DSharedFence* fence)
+{
+	return fence ? fence->Handle : nullptr;
+}
+
+TEResult TED3DSharedFenceSetCallback(TED3DSharedFence* fence, TED3DSharedFenceCallback callback, void* info)
+{
+	if (!fence)
+	{
+		return TEResultBadUsage;
+	}
+	fence->Callback = callback;
+	fence->CallbackInfo = info;
+	return TEResultSuccess;
+}
+
+TED3D11Texture* TED3D11TextureCreate(ID3D11Texture2D* texture, TETextureOrigin origin, TETextureComponentMap map, TED3D11TextureCallback callback, void* info)
+{
+	return MakeD3D11Texture(texture, origin, map, DXGI_FORMAT_UNKNOWN, callback, info);
+}
+
+TED3D11Texture* TED3D11TextureCreateTypeless(ID3D11Texture2D* texture, TETextureOrigin origin, TETextureComponentMap map, DXGI_FORMAT typedFormat, TED3D11TextureCallback callback, void* info)
+{
+	return MakeD3D11Texture(texture, origin, map, typedFormat, callback, info);
+}
+
+ID3D11Texture2D* TED3D11TextureGetTexture(const TED3D11Texture* texture)
+{
+	return texture ? texture->Texture : nullptr;
+}
+
+TEResult TED3D11TextureSetCallback(TED3D11Texture* texture, TED3D11TextureCallback callback, void* info)
+{
+	if (!texture)
+	{
+		return TEResultBadUsage;
+	}
+	texture->Callback = callback;
+	texture->CallbackInfo = info;
+	return TEResultSuccess;
+}
+
+TEResult TED3D11ContextCreate(ID3D11Device* device, TED3D11Context** context)
+{
+	if (!context)
+	{
+		return TEResultBadUsage;
+	}
+	TED3D11Context* Context = CreateObject<TED3D11Context>(TEObjectTypeGraphicsContext, 0, &DestroyD3D11Context);
+	if (device)
+	{
+		device->AddRef();
+	}
+	Context->Device = device;
+	*context = Context;
+	return TEResultSuccess;
+}
+
+ID3D11Device* TED3D11ContextGetDevice(TED3D11Context* context)
+{
+	return context ? context->Device : nullptr;
+}
+
+TEResult TED3D11ContextGetTexture(TED3D11Context* context, TED3DSharedTexture* source, TED3D11Texture** texture)
+{
+	if (!context || !source || !texture)
+	{
+		return TEResultBadUsage;
+	}
+	if (!context->Device) // Opening a shared texture needs a device
+	{
+		return TEResultFeatureNotSupportedBySystem;
+	}
+
+	ID3D11Texture2D* Texture = nullptr;
+	HRESULT Result = E_FAIL;
+	if (source->HandleType == TED3DHandleTypeD3D11Global)
+	{
+		Result = context->Device->OpenSharedResource(source->Handle, IID_PPV_ARGS(&Texture));
+	}
+	else
+	{
+		ID3D11Device1* Device1 = nullptr;
+		if (SUCCEEDED(context->Device->QueryInterface(IID_PPV_ARGS(&Device1))))
+		{
+			Result = Device1->OpenSharedResource1(source->Handle, IID_PPV_ARGS(&Texture));
+			Device1->Release();
+		}
+	}
+	if (FAILED(Result))
+	{
+		return TEResultInternalError;
+	}
+
+	*texture = MakeD3D11Texture(Texture, source->Base.Origin, source->Base.Map, DXGI_FORMAT_UNKNOWN, nullptr, nullptr);
+	Texture->Release();
+	return TEResultSuccess;
+}
+
+TEResult TED3D12ContextCreate(ID3D12Device* device, TED3D12Context** context)
+{
+	if (!context)
+	{
+		return TEResultBadUsage;
+	}
+	TED3D12Context* Context = CreateObject<TED3D12Context>(TEObjectTypeGraphicsContext, 0, &DestroyD3D12Context);
+	if (device)
+	{
+		device->AddRef();
+	}
+	Context->Device = device;
+	*context = Context;
+	return TEResultSuccess;
+}
+
+ID3D12Device* TED3D12ContextGetDevice(TED3D12Context* context)
+{
+	return context ? context->Device : nullptr;
+}
+
+#endif // _WIN32
@@ -428,7 +428,16 @@ UFunction* UTouchBlueprintFunctionLibrary::FindInputGetterByType(const FName InT
 
 bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* Target, const FString VarName, const float Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetFloatValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetFloatByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, float Value)
+{
+	return SetFloatValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetFloatValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, float Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Float)
@@ -443,7 +452,7 @@ bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* T
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetFloatByName), TEXT("Input is not a float property."));
 	}
 	return false;
@@ -451,7 +460,16 @@ bool UTouchBlueprintFunctionLibrary::SetFloatByName(UTouchEngineComponentBase* T
 
 bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBase* Target, const FString VarName, const TArray<float> Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetFloatArrayValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetFloatArrayByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const TArray<float>& Value)
+{
+	return SetFloatArrayValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetFloatArrayValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const TArray<float>& Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Float || DynVar->VarType == EVarType::Double)
@@ -469,7 +487,7 @@ bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBa
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetFloatArrayByName), TEXT("Input is not a float array or CHOP property."));
 	}
 	return false;
@@ -477,7 +495,16 @@ bool UTouchBlueprintFunctionLibrary::SetFloatArrayByName(UTouchEngineComponentBa
 
 bool UTouchBlueprintFunctionLibrary::SetIntByName(UTouchEngineComponentBase* Target, const FString VarName, const int32 Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetIntValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetIntByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, int32 Value)
+{
+	return SetIntValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetIntValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, int32 Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Int)
@@ -486,7 +513,7 @@ bool UTouchBlueprintFunctionLibrary::SetIntByName(UTouchEngineComponentBase* Tar
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetIntByName), TEXT("Input is not an integer property."));
 	}
 	return false;
@@ -528,7 +555,16 @@ bool UTouchBlueprintFunctionLibrary::SetIntArrayByName(UTouchEngineComponentBase
 
 bool UTouchBlueprintFunctionLibrary::SetBoolByName(UTouchEngineComponentBase* Target, const FString VarName, const bool Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetBoolValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetBoolByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, bool Value)
+{
+	return SetBoolValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetBoolValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, bool Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Bool)
@@ -537,7 +573,7 @@ bool UTouchBlueprintFunctionLibrary::SetBoolByName(UTouchEngineComponentBase* Ta
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetBoolByName), TEXT("Input is not an boolean property."));
 	}
 	return false;
@@ -579,7 +615,16 @@ bool UTouchBlueprintFunctionLibrary::SetByteByName(UTouchEngineComponentBase* Ta
 
 bool UTouchBlueprintFunctionLibrary::SetStringByName(UTouchEngineComponentBase* Target, const FString VarName, const FString Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetStringValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetStringByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FString& Value)
+{
+	return SetStringValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetStringValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FString& Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String)
@@ -588,7 +633,7 @@ bool UTouchBlueprintFunctionLibrary::SetStringByName(UTouchEngineComponentBase*
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetStringByName), TEXT("Input is not a string property."));
 	}
 	return false;
@@ -639,7 +684,16 @@ bool UTouchBlueprintFunctionLibrary::SetColorByName(UTouchEngineComponentBase* T
 
 bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentBase* Target, FString VarName, FLinearColor Value, FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetLinearColorValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetLinearColorByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FLinearColor& Value)
+{
+	return SetLinearColorValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetLinearColorValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FLinearColor& Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if ((DynVar->VarType == EVarType::Double || DynVar->VarType == EVarType::Float) && DynVar->bIsArray)
@@ -652,7 +706,7 @@ bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentB
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetLinearColorByName), TEXT("Input is not a color property."));
 	}
 	return false;
@@ -660,7 +714,16 @@ bool UTouchBlueprintFunctionLibrary::SetLinearColorByName(UTouchEngineComponentB
 
 bool UTouchBlueprintFunctionLibrary::SetVectorByName(UTouchEngineComponentBase* Target, const FString VarName, const FVector Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetVectorValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetVectorByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FVector& Value)
+{
+	return SetVectorValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetVectorValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FVector& Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray)
@@ -674,7 +737,7 @@ bool UTouchBlueprintFunctionLibrary::SetVectorByName(UTouchEngineComponentBase*
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetVectorByName), TEXT("Input is not a double array property."));
 	}
 	return false;
@@ -723,14 +786,23 @@ bool UTouchBlueprintFunctionLibrary::SetEnumByName(UTouchEngineComponentBase* Ta
 
 bool UTouchBlueprintFunctionLibrary::SetChopByName(UTouchEngineComponentBase* Target, const FString VarName, const FTouchEngineCHOP& Value, const FString Prefix)
 {
-	FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	return SetChopValue(Target, TryGetDynamicVariable(Target, VarName, Prefix), Value, Prefix + VarName);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetChopByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FTouchEngineCHOP& Value)
+{
+	return SetChopValue(Target, TryGetDynamicVariable(Target, Handle), Value, Handle.Identifier);
+}
+
+bool UTouchBlueprintFunctionLibrary::SetChopValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FTouchEngineCHOP& Value, const FString& VarName)
+{
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::CHOP)
 		{
 			if (!Value.IsValid()) // todo: there should not be the need to check if the value is valid as this is checked later on, but we need to find a way to return false.
 			{
-				LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+				LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 					GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetChopByName), TEXT("Value given is not a valid CHOP."));
 				return false;
 			}
@@ -738,7 +810,7 @@ bool UTouchBlueprintFunctionLibrary::SetChopByName(UTouchEngineComponentBase* Ta
 			DynVar->SetFrameLastUpdatedFromNextCookFrame(Target->EngineInfo);
 			return true;
 		}
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Prefix + VarName,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, VarName,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, SetChopByName), TEXT("Input is not a CHOP property."));
 	}
 	return false;
@@ -758,7 +830,7 @@ bool UTouchBlueprintFunctionLibrary::GetTextureByName(UTouchEngineComponentBase*
 	Value = nullptr;
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutputDynamicVariable(Target, VarName, Prefix);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Texture)
@@ -797,7 +869,7 @@ bool UTouchBlueprintFunctionLibrary::GetStringArrayByName(UTouchEngineComponentB
 	Value = nullptr;
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutputDynamicVariable(Target, VarName, Prefix);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String && DynVar->bIsArray)
@@ -823,7 +895,7 @@ bool UTouchBlueprintFunctionLibrary::GetFloatArrayByName(UTouchEngineComponentBa
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutputDynamicVariable(Target, VarName, Prefix);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::Double && DynVar->bIsArray) //todo: should this accept float and CHOP?
@@ -853,7 +925,7 @@ bool UTouchBlueprintFunctionLibrary::GetStringByName(UTouchEngineComponentBase*
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutputDynamicVariable(Target, VarName, Prefix);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::String && !DynVar->bIsArray)
@@ -895,7 +967,7 @@ bool UTouchBlueprintFunctionLibrary::GetCHOPByName(UTouchEngineComponentBase* Ta
 	Value = {};
 	FrameLastUpdated = -1;
 
-	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, Prefix);
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetOutputDynamicVariable(Target, VarName, Prefix);
 	if (DynVar)
 	{
 		if (DynVar->VarType == EVarType::CHOP && DynVar->bIsArray)
@@ -1450,6 +1522,17 @@ bool UTouchBlueprintFunctionLibrary::GetChannelByName(FTouchEngineCHOP& InChop,
 }
 
 
+bool UTouchBlueprintFunctionLibrary::ResolveVariableHandle(UTouchEngineComponentBase* Target, const FString& VarName, FTouchEngineDynamicVariableHandle& Handle)
+{
+	const FTouchEngineDynamicVariableStruct* DynVar = TryGetDynamicVariable(Target, VarName, FString());
+	if (!DynVar)
+	{
+		Handle = FTouchEngineDynamicVariableHandle();
+		return false;
+	}
+	return Target->DynamicVariables.ResolveHandle(DynVar->VarIdentifier, Handle);
+}
+
 FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix)
 {
 	if (!Target)
@@ -1473,21 +1556,48 @@ FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamic
 		VarNameWithPrefix = Prefix + VarName;
 	}
 
-	// try to find by name
-	FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.GetDynamicVariableByIdentifier(VarNameWithPrefix);
-
+	// try to find by name, and then by visible name
+	FTouchEngineDynamicVariableHandle Handle;
+	Target->DynamicVariables.ResolveHandle(VarNameWithPrefix, Handle);
+	FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.GetDynamicVariableByHandle(Handle);
 	if (!DynVar)
 	{
-		// failed to find by name, try to find by visible name
-		DynVar = Target->DynamicVariables.GetDynamicVariableByName(VarNameWithPrefix);
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, VarNameWithPrefix,
+			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, TryGetDynamicVariable));
 	}
-	
+
+	return DynVar;
+}
+
+FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetOutputDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix)
+{
+	if (Target)
+	{
+		// In Synchronized mode with bLateLatchSynchronizedOutputs, this is where we wait for the cook of this frame
+		Target->LatchSynchronizedCookOutputs();
+	}
+	return TryGetDynamicVariable(Target, VarName, Prefix);
+}
+
+FTouchEngineDynamicVariableStruct* UTouchBlueprintFunctionLibrary::TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle)
+{
+	if (!Target)
+	{
+		return nullptr;
+	}
+
+	if (!Target->IsLoaded())
+	{
+		UE_LOG(LogTouchEngine, Warning, TEXT("Attempted to get or set the variable '%s' while TouchEngine was not ready. Skipping."), *Handle.Identifier);
+		return nullptr;
+	}
+
+	FTouchEngineDynamicVariableStruct* DynVar = Target->DynamicVariables.GetDynamicVariableByHandle(Handle);
 	if (!DynVar)
 	{
-		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, VarNameWithPrefix,
+		LogTouchEngineError(Target, UE::TouchEngine::FTouchErrorLog::EErrorType::VariableNameNotFound, Handle.Identifier,
 			GET_FUNCTION_NAME_CHECKED(UTouchBlueprintFunctionLibrary, TryGetDynamicVariable));
 	}
-
 	return DynVar;
 }
 
@@ -21,14 +21,17 @@
 #include "ToxAsset.h"
 #include "Engine/TouchEngineInfo.h"
 #include "Engine/TouchEngineSubsystem.h"
+#include "Engine/Util/TouchEngineInstancePool.h"
+#include "Engine/Util/TouchToxMetadataCache.h"
 #include "Engine/Util/CookFrameData.h"
 
 #include "Engine/Engine.h"
+#include "Engine/World.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/FeedbackContext.h"
 #include "Misc/Paths.h"
-#include "Tasks/Task.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 #include "RenderingThread.h"
 #include "Engine/TEDebug.h"
@@ -133,6 +136,44 @@ void UTouchEngineComponentBase::BroadcastOnToxUnloaded(bool bInSkipBlueprintEven
 	}
 }
 
+void UTouchEngineComponentBase::BroadcastOnTouchEngineLost(ETouchEngineRestartReason Reason)
+{
+	OnTouchEngineLost_Native.Broadcast(Reason);
+	
+#if WITH_EDITOR
+	const bool bCanBroadcastEvents = HasBegunPlay() || bAllowRunningInEditor;
+#else
+	const bool bCanBroadcastEvents = HasBegunPlay();
+#endif
+
+	if (bCanBroadcastEvents)
+	{
+#if WITH_EDITOR
+		FEditorScriptExecutionGuard ScriptGuard;
+#endif
+		OnTouchEngineLost.Broadcast(Reason);
+	}
+}
+
+void UTouchEngineComponentBase::BroadcastOnTouchEngineRecovered(ETouchEngineRestartReason Reason, double GapInSeconds)
+{
+	OnTouchEngineRecovered_Native.Broadcast(Reason, GapInSeconds);
+	
+#if WITH_EDITOR
+	const bool bCanBroadcastEvents = HasBegunPlay() || bAllowRunningInEditor;
+#else
+	const bool bCanBroadcastEvents = HasBegunPlay();
+#endif
+
+	if (bCanBroadcastEvents)
+	{
+#if WITH_EDITOR
+		FEditorScriptExecutionGuard ScriptGuard;
+#endif
+		OnTouchEngineRecovered.Broadcast(Reason, GapInSeconds);
+	}
+}
+
 void UTouchEngineComponentBase::BroadcastOnStartFrame(const FTouchEngineInputFrameData& FrameData) const
 {
 #if WITH_EDITOR
@@ -307,6 +348,8 @@ void UTouchEngineComponentBase::StartTouchEngine()
 
 void UTouchEngineComponentBase::StopTouchEngine()
 {
+	PendingRestart.Reset();
+	NumConsecutiveRestarts = 0;
 	ReleaseResources(EReleaseTouchResources::KillProcess);
 }
 
@@ -324,6 +367,12 @@ bool UTouchEngineComponentBase::IsRunning() const
 	return EngineInfo && EngineInfo->Engine && EngineInfo->Engine->IsReadyToCookFrame();
 }
 
+void UTouchEngineComponentBase::SetLockstepRenderFrame(FFrameNumber Frame, int32 TemporalSampleIndex)
+{
+	LockstepClock.Configure(LockstepFrameRate, LockstepTemporalSampleCount);
+	LockstepClock.SetNextSample(Frame, TemporalSampleIndex);
+}
+
 bool UTouchEngineComponentBase::KeepFrameTexture(UTexture2D* FrameTexture, UTexture2D*& Texture)
 {
 	Texture = nullptr;
@@ -360,6 +409,7 @@ void UTouchEngineComponentBase::PreEditChange(FProperty* PropertyThatWillChange)
 void UTouchEngineComponentBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
+	DynamicVariables.InvalidateIndex(); // the variables might have been edited in place
 
 	const FName PropertyName = (PropertyChangedEvent.Property != nullptr) ? PropertyChangedEvent.Property->GetFName() : NAME_None;
 	if (PropertyName == GET_MEMBER_NAME_CHECKED(UTouchEngineComponentBase, ToxAsset))
@@ -396,6 +446,7 @@ void UTouchEngineComponentBase::PostEditUndo()
 	Super::PostEditUndo();
 	
 	EngineInfo = PreUndoValues.EngineInfo; //not supposed to be directly affected by Undo/Redo
+	DynamicVariables.InvalidateIndex();
 	
 	if (IsValid(EngineInfo))
 	{
@@ -523,6 +574,11 @@ void UTouchEngineComponentBase::PostLoad()
 {
 	Super::PostLoad();
 
+	if (ImportedTexturePoolSize_DEPRECATED != INDEX_NONE)
+	{
+		GetImportedTexturePoolBudgetInBytes(); // converts the pool size saved by older versions to a budget
+	}
+
 #if WITH_EDITOR
 	if (IsValid(ToxAsset))
 	{
@@ -615,11 +671,94 @@ void UTouchEngineComponentBase::TickComponent(float DeltaTime, ELevelTick TickTy
 	const double Now = FPlatformTime::Seconds();
 	UE_LOG(LogTouchEngineComponent, Log, TEXT("  ====== ====== ====== ====== ------ ------ ====== ====== TickComponent ====== ====== ------ ------ ====== ====== ====== ======  %f"), Now - StartTime)
 	StartTime = Now;
+
+	if (IsUsingAdaptiveCookQueue())
+	{
+		if (!AdaptiveCookController.IsInitialized())
+		{
+			AdaptiveCookController.Reset(InputBufferLimit, CookPipelineDepth);
+		}
+		if (!AdaptiveCookController.ShouldSubmitCook_GameThread(DeltaTime))
+		{
+			// TouchEngine would not be able to process this cook before the next one, so we skip it and give its time to the next one
+			AdaptiveSkippedDeltaTime += DeltaTime;
+			return;
+		}
+		DeltaTime += AdaptiveSkippedDeltaTime;
+		AdaptiveSkippedDeltaTime = 0.f;
+	}
+
+	if (IsUsingCookScheduler()) // Synchronized mode, and so the lockstep offline render, cook in the tick so the outputs are read in the same frame
+	{
+		UTouchEngineSubsystem* TESubsystem = GEngine->GetEngineSubsystem<UTouchEngineSubsystem>();
+		if (FTouchCookScheduler* CookScheduler = TESubsystem ? TESubsystem->GetCookScheduler() : nullptr)
+		{
+			// The scheduler will call StartScheduledCook at the end of the frame, or later if the frame is over budget
+			CookScheduler->RequestCook(this, DeltaTime);
+			return;
+		}
+	}
 	StartNewCook(DeltaTime);
 }
 
+void UTouchEngineComponentBase::StartScheduledCook(float DeltaTime)
+{
+	// The engine could have been released between the request and now
+	if (EngineInfo && EngineInfo->Engine && EngineInfo->Engine->IsReadyToCookFrame())
+	{
+		StartNewCook(DeltaTime);
+	}
+}
+
+TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing> UTouchEngineComponentBase::GetOrCreateCHOPOutputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate)
+{
+	using namespace UE::TouchEngine;
+	check(IsInGameThread());
+	if (const TSharedRef<FTouchCHOPSampleRing>* Stream = CHOPOutputStreams.Find(Identifier))
+	{
+		return *Stream;
+	}
+	const TSharedRef<FTouchCHOPSampleRing>& Stream = CHOPOutputStreams.Add(Identifier, MakeShared<FTouchCHOPSampleRing>(NumChannels, CapacityInSamples, SampleRate));
+	BindCHOPStreams_GameThread();
+	return Stream;
+}
+
+TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing> UTouchEngineComponentBase::GetOrCreateCHOPInputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate)
+{
+	using namespace UE::TouchEngine;
+	check(IsInGameThread());
+	if (const TSharedRef<FTouchCHOPSampleRing>* Stream = CHOPInputStreams.Find(Identifier))
+	{
+		return *Stream;
+	}
+	const TSharedRef<FTouchCHOPSampleRing>& Stream = CHOPInputStreams.Add(Identifier, MakeShared<FTouchCHOPSampleRing>(NumChannels, CapacityInSamples, SampleRate));
+	BindCHOPStreams_GameThread();
+	return Stream;
+}
+
+void UTouchEngineComponentBase::BindCHOPStreams_GameThread()
+{
+	using namespace UE::TouchEngine;
+	const TSharedPtr<FTouchVariableManager> VariableManager = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetVariableManager() : nullptr;
+	if (!VariableManager)
+	{
+		return; // they will be bound once the tox file is loaded
+	}
+	// Binding a ring already bound does nothing, so we do not need to track which ones were
+	for (const TPair<FString, TSharedRef<FTouchCHOPSampleRing>>& Pair : CHOPOutputStreams)
+	{
+		VariableManager->BindCHOPOutputStream_GameThread(Pair.Key, Pair.Value);
+	}
+	for (const TPair<FString, TSharedRef<FTouchCHOPSampleRing>>& Pair : CHOPInputStreams)
+	{
+		VariableManager->BindCHOPInputStream_GameThread(Pair.Key, Pair.Value);
+	}
+}
+
 void UTouchEngineComponentBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	PendingRestart.Reset();
+	NumConsecutiveRestarts = 0;
 	ReleaseResources(EReleaseTouchResources::KillProcess);
 	BroadcastCustomEndPlay();
 	if (HasBegunPlay()) // We need to be sure, it might not always be the case as we are sometimes indirectly calling this function.
@@ -805,6 +944,30 @@ void UTouchEngineComponentBase::PostEditImport()
 	PostLoad(); // Call PostLoad after this object has been imported via paste/duplicate
 }
 
+void UTouchEngineComponentBase::SetImportedTexturePoolSize(int32 InImportedTexturePoolSize)
+{
+	ImportedTexturePoolSize_DEPRECATED = InImportedTexturePoolSize;
+	const int64 ImportedTexturePoolBudgetInBytes = GetImportedTexturePoolBudgetInBytes();
+	if (EngineInfo && EngineInfo->Engine && EngineInfo->Engine->IsReadyToCookFrame()) // Otherwise, the budget is given to the engine once the tox file is loaded
+	{
+		EngineInfo->Engine->SetImportedTexturePoolBudget(ImportedTexturePoolBudgetInBytes);
+	}
+}
+
+int64 UTouchEngineComponentBase::GetImportedTexturePoolBudgetInBytes()
+{
+	if (ImportedTexturePoolSize_DEPRECATED != INDEX_NONE)
+	{
+		// The old pool size was a number of textures. We do not know their size anymore, so we assume 1920x1080 RGBA8 textures, which is about 8MB each
+		constexpr int32 EstimatedTextureSizeMB = 8;
+		ImportedTexturePoolBudgetMB = FMath::Max(0, ImportedTexturePoolSize_DEPRECATED) * EstimatedTextureSizeMB;
+		UE_LOG(LogTouchEngineComponent, Log, TEXT("%s: ImportedTexturePoolSize (%d textures) is deprecated and was converted to an ImportedTexturePoolBudgetMB of %d MB"),
+			*GetReadableName(), ImportedTexturePoolSize_DEPRECATED, ImportedTexturePoolBudgetMB);
+		ImportedTexturePoolSize_DEPRECATED = INDEX_NONE;
+	}
+	return static_cast<int64>(ImportedTexturePoolBudgetMB) * 1024 * 1024;
+}
+
 void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 {
 	using namespace UE::TouchEngine;
@@ -813,11 +976,14 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 
 	// 1. First, we get a new frame ID and we set the inputs
 	FTouchEngineInputFrameData InputFrameData{EngineInfo->Engine->GetNextFrameID()};
+	InputFrameData.ComponentId = GetUniqueID();
 
 	UE_LOG(LogTouchEngineComponent, Log, TEXT("[StartNewCook[%s]] ------ Starting new Cook [Frame No %lld] ------"), *GetCurrentThreadStr(), InputFrameData.FrameID)
 	UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[StartNewCook[%s]] Calling `VarsOnStartFrame` for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.A [GT] Set Inputs"), STAT_TE_I_A, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, SetInputs);
+		TRACE_TOUCHENGINE_COOK_STAGE(GatherInputs, InputFrameData);
 		// Here we are only gathering the input values but we are only sending them to TouchEngine when the cook is processed
 		BroadcastOnStartFrame(InputFrameData);
 	}
@@ -825,10 +991,21 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 	// 2. We prepare the request
 	InputFrameData.StartTime = FPlatformTime::Seconds() - GStartTime;
 	const int64 TimeScale = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetFrameRate() * 1000 : 1000; // The TimeScale should be a multiplier of the frame rate for best results. Decided on TDUE-189
+	const TSharedPtr<FTouchVariableManager> VariableManager = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetVariableManager() : nullptr;
 	FCookFrameRequest CookFrameRequest{
 		DeltaTime, TimeScale, InputFrameData,
-		DynamicVariables.CopyInputsForCook(InputFrameData.FrameID)
+		VariableManager ? DynamicVariables.CopyInputsForCook(InputFrameData.FrameID, *VariableManager) : FTouchEngineCookInputs(),
+		GetEffectiveCookTimeout()
 	};
+	if (IsUsingLockstepOfflineRender())
+	{
+		// The time of the cook is the exact time of the rendered sample, whatever the delta time of the tick was
+		LockstepClock.Configure(LockstepFrameRate, LockstepTemporalSampleCount);
+		CookFrameRequest.ExactTime = LockstepClock.ConsumeNextTime(CookFrameRequest.bIsTimeDiscontinuity);
+		CookFrameRequest.FrameTimeInSeconds = LockstepClock.GetSampleDurationInSeconds();
+		UE_LOG(LogTouchEngineComponent, Log, TEXT("[StartNewCook[%s]] Lockstep cook of frame %lld at %lld/%d (%.6fs)%s"), *GetCurrentThreadStr(), InputFrameData.FrameID,
+			CookFrameRequest.ExactTime->Value, CookFrameRequest.ExactTime->Scale, CookFrameRequest.ExactTime->ToSeconds(), CookFrameRequest.bIsTimeDiscontinuity ? TEXT(" [Discontinuity]") : TEXT(""))
+	}
 
 	// 2b. If the user put a breakpoint in OnStartFrame and decided to turn off AllowRunningInEditor, we could arrive here with an invalid engine.
 	if (!EngineInfo || !EngineInfo->Engine || !EngineInfo->Engine->IsReadyToCookFrame())
@@ -840,39 +1017,113 @@ void UTouchEngineComponentBase::StartNewCook(float DeltaTime)
 	}
 
 	// 3. We actually send the cook to the frame cooker. It will be enqueued until it can be processed
-	const TFuture<void> PendingCookFrame = EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit)
-         .Next([WeakTEComponent = MakeWeakObjectPtr(this)](FCookFrameResult CookFrameResult)
-         {
-             // When done, we will need to be on GameThread to call BroadcastOnEndFrame, so better going there right away
-             ExecuteOnGameThread<void>([WeakTEComponent, CookFrameResult = MoveTemp(CookFrameResult)]()
-             {
-                 DECLARE_SCOPE_CYCLE_COUNTER(TEXT("IV. [GT] Post Cook"), STAT_TE_IV, STATGROUP_TouchEngine);
-
-                 if (UTouchEngineComponentBase* ThisPinned = WeakTEComponent.Get())
-                 {
-                     ThisPinned->OnCookFinished(CookFrameResult);
-                 }
-                 else if (CookFrameResult.OnReadyToStartNextCook)  // If the component is not valid anymore, we set all the promises and we leave
-                 {
-                     CookFrameResult.OnReadyToStartNextCook->SetValue();
-                 }
-             }); // ExecuteOnGameThread<void>
-         }); // PendingCookFrame->Next
+	TRACE_TOUCHENGINE_COOK_STAGE_BEGIN(Enqueue, InputFrameData);
+	const bool bIsAdaptive = IsUsingAdaptiveCookQueue() && AdaptiveCookController.IsInitialized();
+	const int32 CookInputBufferLimit = bIsAdaptive ? AdaptiveCookController.GetInputBufferLimit() : InputBufferLimit;
+	const int32 CookFramePipelineDepth = bIsAdaptive ? AdaptiveCookController.GetPipelineDepth() : CookPipelineDepth;
+	TFuture<FCookFrameResult> CookFuture = EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), CookInputBufferLimit, CookFramePipelineDepth);
+	TRACE_TOUCHENGINE_COOK_STAGE_END(Enqueue, InputFrameData);
 
 	// 4. In Synchronised mode, we do stall the GameThread. This is the only difference between Synchronised and Independent/Delayed Synchronised modes (apart from the TETimeMode)
+	if (CookMode == ETouchEngineCookMode::Synchronized && bLateLatchSynchronizedOutputs)
+	{
+		// The wait is deferred to the first read of the outputs, or to the end of the world tick. We only need the RHI Thread to start the copies of the inputs in the meantime, the GameThread does not need to wait for it
+		if (DeferredSynchronizedCook) // Should not happen as it is waited for every frame, but we cannot have two cooks in flight in Synchronized mode
+		{
+			FinishDeferredSynchronizedCook();
+		}
+		DeferredSynchronizedCook = FDeferredSynchronizedCook{ MoveTemp(CookFuture), InputFrameData.FrameID, FPlatformTime::Cycles64() };
+		if (!OnWorldPostActorTickHandle.IsValid())
+		{
+			OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UTouchEngineComponentBase::OnWorldPostActorTick);
+		}
+		ENQUEUE_RENDER_COMMAND(TouchEngineDispatchSynchronizedCook)([](FRHICommandListImmediate& RHICmdList)
+		{
+			RHICmdList.ImmediateFlush(EImmediateFlushType::DispatchToRHIThread);
+		});
+		return;
+	}
+	
+	const TFuture<void> PendingCookFrame = HandleCookResultWhenDone(MoveTemp(CookFuture));
 	if (CookMode == ETouchEngineCookMode::Synchronized)
 	{
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("II. [GT] Synchronized Wait"), STAT_TE_II, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, SynchronizedWait);
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] About to wait for PendingCookFrame for frame %lld"), *GetCurrentThreadStr(), InputFrameData.FrameID)
 		FlushRenderingCommands(); //We need to ensure the RHI Thread starts the copies before we wait or we would end in a deadlock
-		const bool bDidCookTimeout = !PendingCookFrame.WaitFor(FTimespan::FromSeconds(CookTimeout));
+		const bool bDidCookTimeout = !PendingCookFrame.WaitFor(FTimespan::FromSeconds(GetEffectiveCookTimeout()));
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::StartNewCook[%s]] Done waiting for PendingCookFrame for frame %lld. Cook timeout? %s"), *GetCurrentThreadStr(), InputFrameData.FrameID, bDidCookTimeout ? TEXT("TRUE") : TEXT("false"))
 	}
-	
-	// 6. We check if the cook timed out
-	if (EngineInfo)
+	// The cook timeout is handled by the cook watchdog thread, which cancels the cook even while the GameThread is blocked above
+}
+
+TFuture<void> UTouchEngineComponentBase::HandleCookResultWhenDone(TFuture<UE::TouchEngine::FCookFrameResult>&& CookFuture)
+{
+	using namespace UE::TouchEngine;
+	return MoveTemp(CookFuture).Next([WeakTEComponent = MakeWeakObjectPtr(this)](FCookFrameResult CookFrameResult)
+	{
+		// When done, we will need to be on GameThread to call BroadcastOnEndFrame, so better going there right away
+		ExecuteOnGameThread<void>([WeakTEComponent, CookFrameResult = MoveTemp(CookFrameResult)]()
+		{
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("IV. [GT] Post Cook"), STAT_TE_IV, STATGROUP_TouchEngine);
+			CSV_SCOPED_TIMING_STAT(TouchEngine, PostCook);
+
+			if (UTouchEngineComponentBase* ThisPinned = WeakTEComponent.Get())
+			{
+				ThisPinned->OnCookFinished(CookFrameResult);
+			}
+			else if (CookFrameResult.OnReadyToStartNextCook)  // If the component is not valid anymore, we set all the promises and we leave
+			{
+				CookFrameResult.OnReadyToStartNextCook->SetValue();
+			}
+		}); // ExecuteOnGameThread<void>
+	}); // CookFuture.Next
+}
+
+void UTouchEngineComponentBase::LatchSynchronizedCookOutputs()
+{
+	check(IsInGameThread());
+	if (DeferredSynchronizedCook)
+	{
+		FinishDeferredSynchronizedCook();
+	}
+}
+
+void UTouchEngineComponentBase::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (DeferredSynchronizedCook && World == GetWorld())
+	{
+		FinishDeferredSynchronizedCook();
+	}
+}
+
+void UTouchEngineComponentBase::FinishDeferredSynchronizedCook()
+{
+	using namespace UE::TouchEngine;
+	FDeferredSynchronizedCook Cook = MoveTemp(DeferredSynchronizedCook.GetValue());
+	DeferredSynchronizedCook.Reset();
+
+	bool bIsReady = Cook.CookFuture.IsReady();
+	if (!bIsReady)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("II. [GT] Synchronized Wait"), STAT_TE_II, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, SynchronizedWait);
+		// The cook watchdog cancels the cook once CookTimeout is reached, so we only wait for the time left
+		const double TimeLeft = GetEffectiveCookTimeout() - FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Cook.StartCycles);
+		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::FinishDeferredSynchronizedCook[%s]] About to wait %.2fms for frame %lld"), *GetCurrentThreadStr(), TimeLeft * 1000.0, Cook.FrameID)
+		bIsReady = TimeLeft > 0.0 && Cook.CookFuture.WaitFor(FTimespan::FromSeconds(TimeLeft));
+	}
+
+	if (bIsReady)
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("IV. [GT] Post Cook"), STAT_TE_IV, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, PostCook);
+		OnCookFinished(Cook.CookFuture.Get());
+	}
+	else
 	{
-		EngineInfo->CheckIfCookTimedOut_GameThread(CookTimeout);
+		UE_LOG(LogTouchEngineComponent, Log, TEXT("   [UTouchEngineComponentBase::FinishDeferredSynchronizedCook[%s]] Frame %lld is not done within its CookTimeout, its result will be handled when it is done"), *GetCurrentThreadStr(), Cook.FrameID)
+		HandleCookResultWhenDone(MoveTemp(Cook.CookFuture));
 	}
 }
 
@@ -909,17 +1160,25 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		OutputFrameData.FrameLastUpdated = CookFrameResult.FrameLastUpdated;
 		OutputFrameData.CookStartTime = CookFrameResult.TECookStartTime;
 		OutputFrameData.CookEndTime = CookFrameResult.TECookEndTime;
+		CookStats.RecordCookFinished(CookFrameResult.Result, OutputFrameData);
+		if (IsUsingAdaptiveCookQueue() && AdaptiveCookController.IsInitialized())
+		{
+			AdaptiveCookController.OnCookFinished_GameThread(CookFrameResult);
+		}
 
 		UE_LOG(LogTouchEngineComponent, Log, TEXT("[PendingCookFrame.Next[%s]] Calling `BroadcastOnEndFrame` for frame %lld"), *GetCurrentThreadStr(), CookFrameResult.FrameData.FrameID)
 
 		if (CookFrameResult.Result == ECookFrameResult::Success && !OutputFrameData.bWasFrameDropped) // if the cook was skipped by TE or not successful, we know that the outputs have not changed, so no need to update them 
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.1 [GT] Post Cook - DynVar Get Outputs"), STAT_TE_IV_B_1, STATGROUP_TouchEngine);
+			CSV_SCOPED_TIMING_STAT(TouchEngine, GetOutputs);
+			TRACE_TOUCHENGINE_COOK_STAGE(GetOutputs, CookFrameResult.FrameData);
 			DynamicVariables.GetOutputs(EngineInfo);
 		}
 
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.2 [GT] Post Cook - BroadcastOnEndFrame"), STAT_TE_IV_B_2, STATGROUP_TouchEngine);
+			TRACE_TOUCHENGINE_COOK_STAGE(BroadcastOnEndFrame, CookFrameResult.FrameData);
 			BroadcastOnEndFrame(CookFrameResult.Result, OutputFrameData);
 		}
 	}
@@ -932,12 +1191,14 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 		OutputFrameData.FrameLastUpdated = CookFrameResult.FrameLastUpdated;
 		OutputFrameData.CookStartTime = CookFrameResult.TECookStartTime;
 		OutputFrameData.CookEndTime = CookFrameResult.TECookEndTime;
+		CookStats.RecordCookFinished(CookFrameResult.Result, OutputFrameData);
 
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    IV.B.2 [GT] Post Cook - BroadcastOnEndFrame"), STAT_TE_IV_B_2, STATGROUP_TouchEngine);
+		TRACE_TOUCHENGINE_COOK_STAGE(BroadcastOnEndFrame, CookFrameResult.FrameData);
 		BroadcastOnEndFrame(CookFrameResult.Result == ECookFrameResult::Success ? ECookFrameResult::Cancelled : CookFrameResult.Result, OutputFrameData);
 	}
 
-	// 3. We let the FrameCooker know that we can accept a next cook job. Does not actually start a new cook.
+	// 3. We let the FrameCooker know that we are done with the outputs. It will start the next pending cook straight away if there is one.
 	if (CookFrameResult.OnReadyToStartNextCook)
 	{
 		CookFrameResult.OnReadyToStartNextCook->SetValue();
@@ -952,25 +1213,83 @@ void UTouchEngineComponentBase::OnCookFinished(const UE::TouchEngine::FCookFrame
 	}
 #endif
 
-	// 5. We start a task on a background thread that will execute the next pending cook frame
-	if (EngineInfo && EngineInfo->Engine)
+	// 5. If the TouchEngine process crashed or did not even answer the cancellation of the cook, the instance will not recover by itself
+	if (CookFrameResult.Result == ECookFrameResult::Success)
 	{
-		UE::Tasks::Launch(*(FString("ExecuteNextPendingCookFrame_") + UE_SOURCE_LOCATION), [WeakTEComponent = MakeWeakObjectPtr(this), FrameID = CookFrameResult.FrameData.FrameID]() mutable
+		NumConsecutiveRestarts = 0;
+		if (PendingRestart)
 		{
-			FPlatformProcess::SleepNoStats(1.f / 1000); // to let the engine run
-			AsyncTask(ENamedThreads::GameThread, [WeakTEComponent, FrameID]()
-			{
-				if (WeakTEComponent.IsValid() && WeakTEComponent->EngineInfo)
-				{
-					UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Calling ExecuteNextPendingCookFrame_GameThread after frame %lld"),
-					       *GetCurrentThreadStr(), FrameID)
-					const bool Started = WeakTEComponent->EngineInfo->ExecuteNextPendingCookFrame_GameThread();
-					UE_LOG(LogTouchEngineComponent, Verbose, TEXT("[UTouchEngineComponentBase::StartNewCook[%s]] Called ExecuteNextPendingCookFrame_GameThread after frame %lld which returned `%s`"),
-					       *GetCurrentThreadStr(), FrameID, Started ? TEXT("TRUE") : TEXT("FALSE"))
-				}
-			});
-		}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+			OnTouchEngineRecovered();
+		}
+	}
+	else if (EngineInfo && EngineInfo->Engine && EngineInfo->Engine->NeedsRestart())
+	{
+		RestartTouchEngine(EngineInfo->Engine->HasCrashed() ? ETouchEngineRestartReason::Crashed : ETouchEngineRestartReason::Unresponsive);
+	}
+}
+
+void UTouchEngineComponentBase::RestartTouchEngine(ETouchEngineRestartReason Reason)
+{
+	const TCHAR* ReasonString = Reason == ETouchEngineRestartReason::Crashed ? TEXT("The TouchEngine process crashed") : TEXT("TouchEngine stopped answering the cooks");
+	if (!bRestartOnFailure || NumConsecutiveRestarts >= MaxConsecutiveRestarts)
+	{
+		UE_LOG(LogTouchEngineComponent, Error, TEXT("%s: %s, and the instance is not restarted as %s."), *GetReadableName(), ReasonString,
+			bRestartOnFailure ? *FString::Printf(TEXT("it was already restarted %d times in a row"), NumConsecutiveRestarts) : TEXT("bRestartOnFailure is not set"));
+		PendingRestart.Reset();
+		NumConsecutiveRestarts = 0;
+		ReleaseResources(EReleaseTouchResources::KillProcess);
+		ErrorMessage = FString::Printf(TEXT("%s."), ReasonString);
+		BroadcastOnToxFailedLoad(ErrorMessage);
+		return;
+	}
+
+	UE_LOG(LogTouchEngineComponent, Warning, TEXT("%s: %s, restarting the instance and reloading the tox file (attempt %d of %d)."), *GetReadableName(), ReasonString, NumConsecutiveRestarts + 1, MaxConsecutiveRestarts);
+	++NumConsecutiveRestarts;
+	if (!PendingRestart) // If the restart itself failed, the gap is still measured from the first failure
+	{
+		PendingRestart = FPendingRestart{ Reason, FPlatformTime::Cycles64() };
+		BroadcastOnTouchEngineLost(Reason);
+	}
+	CookStats.RecordRestart();
+	
+	// DynamicVariables are kept as they are: they hold the last value of every input, which HandleToxLoaded carries over and sends with the first cook of the new instance.
+	// The new instance is taken from the pool if there is a warm one available.
+	ReleaseResources(EReleaseTouchResources::KillProcess);
+	LoadToxInternal(true);
+}
+
+void UTouchEngineComponentBase::OnTouchEngineRecovered()
+{
+	const FPendingRestart Restart = PendingRestart.GetValue();
+	PendingRestart.Reset();
+	
+	const double GapInSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Restart.FailureCycles);
+	UE_LOG(LogTouchEngineComponent, Log, TEXT("%s: TouchEngine recovered after %.1fms, replaying %d inputs."), *GetReadableName(), GapInSeconds * 1000.0, DynamicVariables.DynVars_Input.Num());
+	CookStats.RecordRecovery(GapInSeconds * 1000.0);
+	BroadcastOnTouchEngineRecovered(Restart.Reason, GapInSeconds);
+}
+
+UE::TouchEngine::FTouchEngineInstanceStatsSnapshot UTouchEngineComponentBase::GetInstanceStatsSnapshot() const
+{
+	using namespace UE::TouchEngine;
+	FTouchEngineInstanceStatsSnapshot Snapshot;
+	Snapshot.bIsAdaptive = IsUsingAdaptiveCookQueue() && AdaptiveCookController.IsInitialized();
+	Snapshot.InputBufferLimit = Snapshot.bIsAdaptive ? AdaptiveCookController.GetInputBufferLimit() : InputBufferLimit;
+	Snapshot.PipelineDepth = Snapshot.bIsAdaptive ? AdaptiveCookController.GetPipelineDepth() : CookPipelineDepth;
+	Snapshot.SubmissionInterval = Snapshot.bIsAdaptive ? AdaptiveCookController.GetSubmissionInterval() : 1;
+	if (const UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr)
+	{
+		if (const FTouchCookScheduler* CookScheduler = TESubsystem->GetCookScheduler())
+		{
+			Snapshot.SchedulerStats = CookScheduler->GetComponentStats(this);
+		}
+	}
+	if (EngineInfo && EngineInfo->Engine)
+	{
+		Snapshot.NumPendingCooks = EngineInfo->Engine->GetNumPendingCooks();
+		EngineInfo->Engine->GetImportedTexturePoolUsage(Snapshot.NumPooledImportTextures, Snapshot.PooledImportTexturesSizeInBytes);
 	}
+	return Snapshot;
 }
 
 void UTouchEngineComponentBase::LoadToxInternal(bool bForceReloadTox, bool bInSkipBlueprintEvents, bool bForceReloadFromCache)
@@ -992,13 +1311,18 @@ void UTouchEngineComponentBase::LoadToxInternal(bool bForceReloadTox, bool bInSk
 	if (bLoadLocalTouchEngine)
 	{
 		TFuture<UE::TouchEngine::FTouchLoadResult> Future = LoadToxThroughComponentInstance();
+		const bool bAppliedBakedMetadata = ApplyBakedToxMetadata();
 		BroadcastOnToxStartedLoading(bInSkipBlueprintEvents);
-		Future.Next([WeakThis = TWeakObjectPtr<UTouchEngineComponentBase>(this), bLoadLocalTouchEngine, bInSkipBlueprintEvents](const UE::TouchEngine::FTouchLoadResult& LoadResult)
+		Future.Next([WeakThis = TWeakObjectPtr<UTouchEngineComponentBase>(this), bLoadLocalTouchEngine, bInSkipBlueprintEvents, bAppliedBakedMetadata](const UE::TouchEngine::FTouchLoadResult& LoadResult)
 		{
 			check(IsInGameThread());
 
 			if (WeakThis.IsValid())
 			{
+				if (bAppliedBakedMetadata)
+				{
+					WeakThis->ValidateBakedToxMetadata(LoadResult);
+				}
 				WeakThis->HandleToxLoaded(LoadResult, bLoadLocalTouchEngine, bInSkipBlueprintEvents);
 			}
 		});
@@ -1038,6 +1362,10 @@ void UTouchEngineComponentBase::HandleToxLoaded(const UE::TouchEngine::FTouchLoa
 		
 		DynamicVariables.ToxParametersLoaded(LoadResult.SuccessResult->Inputs, LoadResult.SuccessResult->Outputs);
 		DynamicVariables.SetupForFirstCook();
+		AdaptiveCookController.Reset(InputBufferLimit, CookPipelineDepth);
+		LockstepClock.MarkDiscontinuity(); // The new instance has not cooked any frame yet
+		AdaptiveSkippedDeltaTime = 0.f;
+		BindCHOPStreams_GameThread(); // the variable manager was recreated and does not know about our streams anymore
 			
 		if (bLoadedLocalTouchEngine) // we only cache data if it was not loaded from the subsystem
 		{
@@ -1046,7 +1374,7 @@ void UTouchEngineComponentBase::HandleToxLoaded(const UE::TouchEngine::FTouchLoa
 			TESubsystem->LoadPixelFormats(EngineInfo);
 				
 			EngineInfo->Engine->SetExportedTexturePoolSize(ExportedTexturePoolSize);
-			EngineInfo->Engine->SetImportedTexturePoolSize(ImportedTexturePoolSize);
+			EngineInfo->Engine->SetImportedTexturePoolBudget(GetImportedTexturePoolBudgetInBytes());
 		}
 			
 		BroadcastOnToxLoaded(bInSkipBlueprintEvents); 
@@ -1056,6 +1384,12 @@ void UTouchEngineComponentBase::HandleToxLoaded(const UE::TouchEngine::FTouchLoa
 		const FString& LoadErrorMessage = LoadResult.FailureResult->ErrorMessage;
 		ErrorMessage = LoadErrorMessage;
 
+		if (PendingRestart) // The new instance could not load the tox file, so we try again until we reach MaxConsecutiveRestarts
+		{
+			UE_LOG(LogTouchEngineComponent, Warning, TEXT("%s: The restarted TouchEngine instance failed to load the tox file: %s"), *GetReadableName(), *ErrorMessage);
+			RestartTouchEngine(PendingRestart->Reason);
+			return;
+		}
 		BroadcastOnToxFailedLoad(ErrorMessage, bInSkipBlueprintEvents);
 	}
 }
@@ -1073,10 +1407,43 @@ void UTouchEngineComponentBase::EnsureToxMetadataIsSet(const UE::TouchEngine::FT
 	}
 }
 
+bool UTouchEngineComponentBase::ApplyBakedToxMetadata()
+{
+	if (!IsValid(ToxAsset)) // The component can load a tox file without an asset, or with an asset which was deleted
+	{
+		return false;
+	}
+	
+	const TOptional<UE::TouchEngine::FTouchLoadResult> BakedLoadResult = ToxAsset->GetBakedLoadResult();
+	if (!BakedLoadResult)
+	{
+		return false;
+	}
+	
+	// Values already set on the component are kept, and HandleToxLoaded will carry the values set while loading over to the live variables
+	DynamicVariables.ToxParametersLoaded(BakedLoadResult->SuccessResult->Inputs, BakedLoadResult->SuccessResult->Outputs);
+	return true;
+}
+
+void UTouchEngineComponentBase::ValidateBakedToxMetadata(const UE::TouchEngine::FTouchLoadResult& LoadResult) const
+{
+	if (!LoadResult.IsSuccess() || !IsValid(ToxAsset))
+	{
+		return;
+	}
+	
+	const TOptional<UE::TouchEngine::FTouchLoadResult> BakedLoadResult = ToxAsset->GetBakedLoadResult();
+	if (BakedLoadResult && !UE::TouchEngine::FTouchToxMetadataCache::AreEqual_GameThread(*BakedLoadResult, LoadResult))
+	{
+		UE_LOG(LogTouchEngineComponent, Warning, TEXT("%s: The variables baked in '%s' do not match the ones of the tox file '%s'. The variables of the tox file will be used, and the asset should be saved again to update the baked variables."),
+			*GetReadableName(), *ToxAsset->GetPathName(), *ToxAsset->GetAbsoluteFilePath());
+	}
+}
+
 TFuture<UE::TouchEngine::FTouchLoadResult> UTouchEngineComponentBase::LoadToxThroughComponentInstance()
 {
 	ReleaseResources(EReleaseTouchResources::Unload);
-	CreateEngineInfo();
+	CreateEngineInfo(true);
 	return EngineInfo->LoadTox(GetAbsoluteToxPath(), this);
 }
 
@@ -1087,12 +1454,23 @@ TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineComponentBase::LoadToxT
 	return TESubsystem->GetOrLoadParamsFromTox(ToxAsset, ToxLoadTimeout, bForceReloadTox);
 }
 
-void UTouchEngineComponentBase::CreateEngineInfo()
+void UTouchEngineComponentBase::CreateEngineInfo(bool bTakeInstanceFromPool)
 {
 	if (!EngineInfo || !EngineInfo->Engine)
 	{
 		// Create TouchEngine instance if we don't have one already
 		EngineInfo = NewObject<UTouchEngineInfo>(this);
+		TRACE_TOUCHENGINE_COMPONENT(GetUniqueID(), GetOwner() ? FString::Printf(TEXT("%s.%s"), *GetOwner()->GetActorNameOrLabel(), *GetName()) : GetName());
+	}
+
+	if (bTakeInstanceFromPool && !EngineInfo->Engine->HasCreatedTouchInstance())
+	{
+		const UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+		UE::TouchEngine::FTouchEngineInstancePool* InstancePool = TESubsystem ? TESubsystem->GetInstancePool() : nullptr;
+		if (const TSharedPtr<UE::TouchEngine::FTouchEngine> PooledEngine = InstancePool ? InstancePool->Acquire_GameThread(CookMode == ETouchEngineCookMode::Independent, TEFrameRate, this) : nullptr)
+		{
+			EngineInfo->Engine = PooledEngine;
+		}
 	}
 
 	const TSharedPtr<UE::TouchEngine::FTouchEngine> Engine = EngineInfo->Engine;
@@ -1134,13 +1512,44 @@ bool UTouchEngineComponentBase::ShouldUseLocalTouchEngine() const
 void UTouchEngineComponentBase::ReleaseResources(EReleaseTouchResources ReleaseMode)
 {
 	UE_LOG(LogTouchEngineComponent, Log, TEXT("[UTouchEngineComponentBase::ReleaseResources] Requesting the %s of TouchEngine..."), ReleaseMode == EReleaseTouchResources::KillProcess ? TEXT("CLOSING") : TEXT("UNLOADING"))
+	UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (UE::TouchEngine::FTouchCookScheduler* CookScheduler = TESubsystem ? TESubsystem->GetCookScheduler() : nullptr)
+	{
+		CookScheduler->UnregisterComponent(this);
+	}
+	if (OnWorldPostActorTickHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+		OnWorldPostActorTickHandle.Reset();
+	}
+	if (DeferredSynchronizedCook)
+	{
+		// The outputs will not be read as we are releasing the engine, we only need to let the frame cooker know we are done with them
+		MoveTemp(DeferredSynchronizedCook->CookFuture).Next([](const UE::TouchEngine::FCookFrameResult& CookFrameResult)
+		{
+			if (CookFrameResult.OnReadyToStartNextCook)
+			{
+				CookFrameResult.OnReadyToStartNextCook->SetValue();
+			}
+		});
+		DeferredSynchronizedCook.Reset();
+	}
 	if (EngineInfo)
 	{
 		const bool bHadValidEngine = EngineInfo->Engine && (EngineInfo->Engine->IsLoading() || EngineInfo->Engine->IsReadyToCookFrame());
+		UE::TouchEngine::FTouchEngineInstancePool* InstancePool = TESubsystem ? TESubsystem->GetInstancePool() : nullptr;
 		switch (ReleaseMode)
 		{
 		case EReleaseTouchResources::KillProcess:
-			EngineInfo->Destroy();
+			// The pool unloads the tox file and keeps the process alive for the next component loading a tox file
+			if (InstancePool && InstancePool->Release_GameThread(EngineInfo->Engine))
+			{
+				EngineInfo->Engine = nullptr;
+			}
+			else
+			{
+				EngineInfo->Destroy();
+			}
 			EngineInfo = nullptr;
 			break;
 		case EReleaseTouchResources::Unload:
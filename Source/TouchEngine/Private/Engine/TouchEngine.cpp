@@ -150,12 +150,80 @@ namespace UE::TouchEngine
 		}
 	}
 	
+	TFuture<bool> FTouchEngine::Prewarm_GameThread()
+	{
+		check(IsInGameThread());
+		if (!ensureMsgf(!TouchResources.TouchEngineInstance && !PrewarmPromise, TEXT("Only an engine without a TouchEngine instance can be prewarmed.")))
+		{
+			return MakeFulfilledPromise<bool>(false).GetFuture();
+		}
+
+		// There is no component yet, the errors will only be printed to the output log
+		TouchResources.ErrorLog = MakeShared<FTouchErrorLog>(TWeakObjectPtr<UTouchEngineComponentBase>());
+		if (!CreateTouchEngineInstance())
+		{
+			LoadState_GameThread = ELoadState::FailedToLoad;
+			return MakeFulfilledPromise<bool>(false).GetFuture();
+		}
+
+		// The promise must be set before configuring, as TEEventInstanceReady might be received before TEInstanceConfigure returns
+		PrewarmPromise = TPromise<bool>();
+		TFuture<bool> Future = PrewarmPromise->GetFuture();
+		// A null path readies the instance, which spawns the TE process, without loading anything. TEInstance.h states such an instance "cannot be loaded",
+		// which only applies to this configuration: LoadTouchEngine calls TEInstanceConfigure again with the .tox path before TEInstanceLoad, on the running process.
+		if (!OutputResultAndCheckForError_GameThread(TEInstanceConfigure(TouchResources.TouchEngineInstance, nullptr, TimeMode), TEXT("Unable to configure an idle TouchEngine instance")))
+		{
+			LoadState_GameThread = ELoadState::FailedToLoad;
+			TPromise<bool> Promise = MoveTemp(*PrewarmPromise);
+			PrewarmPromise.Reset();
+			Promise.EmplaceValue(false);
+		}
+		return Future;
+	}
+
+	bool FTouchEngine::AdoptPooledInstance_GameThread(bool bIsIndependent, int64 FrameRate, UTouchEngineComponentBase* Component)
+	{
+		check(IsInGameThread());
+		if (!ensureMsgf(TouchResources.TouchEngineInstance && IsReadyToLoad(), TEXT("Only an idle TouchEngine instance can be adopted.")))
+		{
+			return false;
+		}
+
+		TouchResources.ErrorLog = MakeShared<FTouchErrorLog>(TWeakObjectPtr<UTouchEngineComponentBase>(Component));
+		// The time mode is only given to TE when configuring the instance with the tox file, so it is safe to change it now
+		TimeMode = bIsIndependent
+			? TETimeInternal
+			: TETimeExternal;
+		if (!FMath::IsNearlyEqual(TargetFrameRate, static_cast<float>(FrameRate)))
+		{
+			if (!OutputResultAndCheckForError_GameThread(TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, FrameRate, 1), TEXT("Unable to set frame rate")))
+			{
+				return false;
+			}
+			TargetFrameRate = FrameRate;
+		}
+		return true;
+	}
+
+	void FTouchEngine::ReleaseToPool_GameThread()
+	{
+		check(IsInGameThread());
+		Unload_GameThread();
+		
+		if (TouchResources.VariableManager)
+		{
+			// The inputs and outputs might hold references to the textures of the previous component
+			TouchResources.VariableManager->ClearSavedData();
+		}
+		TouchResources.ErrorLog = MakeShared<FTouchErrorLog>(TWeakObjectPtr<UTouchEngineComponentBase>());
+	}
+	
 	int64 FTouchEngine::GetNextFrameID() const
 	{
 		return LoadState_GameThread == ELoadState::Ready && TouchResources.FrameCooker ? TouchResources.FrameCooker->GetNextFrameID() : -1;
 	}
 
-	TFuture<FCookFrameResult> FTouchEngine::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+	TFuture<FCookFrameResult> FTouchEngine::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 PipelineDepth)
 	{
 		check(IsInGameThread());
 
@@ -167,7 +235,7 @@ namespace UE::TouchEngine
 		}
 		
 		TouchResources.ErrorLog->OutputMessages_GameThread();
-		TFuture<FCookFrameResult> CookFrame = TouchResources.FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit)
+		TFuture<FCookFrameResult> CookFrame = TouchResources.FrameCooker->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, PipelineDepth)
            .Next([this](FCookFrameResult Value)
            {
                UE_LOG(LogTouchEngine, Verbose, TEXT("[CookFrame_GameThread->Next[%s]] Finished cooking frame (code: %d)"), *GetCurrentThreadStr(), static_cast<int32>(Value.Result));
@@ -211,6 +279,21 @@ namespace UE::TouchEngine
 		return TouchResources.FrameCooker->ExecuteNextPendingCookFrame_GameThread();
 	}
 
+	int32 FTouchEngine::GetNumPendingCooks() const
+	{
+		return TouchResources.FrameCooker ? TouchResources.FrameCooker->GetNumPendingCooks() : 0;
+	}
+
+	void FTouchEngine::GetImportedTexturePoolUsage(int32& OutNumPooledTextures, int64& OutPooledTexturesSizeInBytes) const
+	{
+		OutNumPooledTextures = 0;
+		OutPooledTexturesSizeInBytes = 0;
+		if (TouchResources.ResourceProvider)
+		{
+			TouchResources.ResourceProvider->GetImporter().GetTexturePoolUsage(OutNumPooledTextures, OutPooledTexturesSizeInBytes);
+		}
+	}
+
 
 	void FTouchEngine::CancelCurrentAndNextCooks_GameThread(ECookFrameResult CookFrameResult)
 	{
@@ -229,13 +312,14 @@ namespace UE::TouchEngine
 		return false;
 	}
 
-	bool FTouchEngine::CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds)
+	bool FTouchEngine::IsUnresponsive() const
 	{
-		if (LoadState_GameThread == ELoadState::Ready && TouchResources.FrameCooker)
-		{
-			return TouchResources.FrameCooker->CheckIfCookTimedOut_GameThread(CookTimeoutInSeconds);
-		}
-		return false;
+		return TouchResources.FrameCooker && TouchResources.FrameCooker->IsUnresponsive();
+	}
+
+	bool FTouchEngine::HasCrashed() const
+	{
+		return TouchResources.FrameCooker && TouchResources.FrameCooker->HasCrashed();
 	}
 
 	void FTouchEngine::HandleTouchEngineInternalError(const TEResult CookResult)
@@ -294,11 +378,11 @@ namespace UE::TouchEngine
 		}
 		return false;
 	}
-	bool FTouchEngine::SetImportedTexturePoolSize(int ImportedTexturePoolSize)
+	bool FTouchEngine::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes)
 	{
-		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ImportedTexturePoolSize can only be set after the engine is started.")))
+		if (ensureMsgf(TouchResources.ResourceProvider, TEXT("ImportedTexturePoolBudget can only be set after the engine is started.")))
 		{
-			TouchResources.ResourceProvider->SetExportedTexturePoolSize(ImportedTexturePoolSize);
+			TouchResources.ResourceProvider->SetImportedTexturePoolBudget(ImportedTexturePoolBudgetInBytes);
 			return true;
 		}
 		return false;
@@ -388,38 +472,9 @@ namespace UE::TouchEngine
 			return false;
 		}
 		
-		if (!TouchResources.TouchEngineInstance)
+		if (!TouchResources.TouchEngineInstance && !CreateTouchEngineInstance())
 		{
-			checkf(!TouchResources.ResourceProvider, TEXT("ResourceProvider was expected to be null if there is no running instance!"));
-			TouchResources.ResourceProvider = ITouchEngineModule::Get().CreateResourceProvider();
-			if (!OutputResultAndCheckForError_GameThread(TouchResources.ResourceProvider ? TEResultSuccess : TEResultFeatureNotSupportedBySystem,
-				FString::Printf(TEXT("Impossible to create a ressource provider for the current RHI `%s` which is not supported."), GDynamicRHI->GetName())))
-			{
-				return false;
-			}
-			
-			// The TE instance may get destroyed latently after the owning FTouchEngine is!
-			// HazardPointer's job is to avoid TE from keep on to garbage memory; the HazardPointer is destroyed after the TE instance is destroyed.
-			TouchResources.HazardPointer = MakeShared<FTouchEngineHazardPointer>(SharedThis(this));
-			const TEResult TouchEngineInstance = TEInstanceCreate(FTouchEngineHazardPointer::TouchEventCallback_AnyThread, FTouchEngineHazardPointer::LinkValueCallback_AnyThread, TouchResources.HazardPointer.Get(), TouchResources.TouchEngineInstance.take());
-			if (!OutputResultAndCheckForError_GameThread(TouchEngineInstance, TEXT("Unable to create TouchEngine Instance")))
-			{
-				return false;
-			}
-
-			const TEResult SetFrameResult = TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate, 1);
-			if (!OutputResultAndCheckForError_GameThread(SetFrameResult, TEXT("Unable to set frame rate")))
-			{
-				return false;
-			}
-			
-			const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, TouchResources.ResourceProvider->GetContext());
-			if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
-			{
-				return false;
-			}
-
-			TouchResources.ResourceProvider->ConfigureInstance(TouchResources.TouchEngineInstance);
+			return false;
 		}
 
 		const bool bLoadTox = !InToxPath.IsEmpty();
@@ -439,6 +494,41 @@ namespace UE::TouchEngine
 		return true;
 	}
 
+	bool FTouchEngine::CreateTouchEngineInstance()
+	{
+		checkf(!TouchResources.ResourceProvider, TEXT("ResourceProvider was expected to be null if there is no running instance!"));
+		TouchResources.ResourceProvider = ITouchEngineModule::Get().CreateResourceProvider();
+		if (!OutputResultAndCheckForError_GameThread(TouchResources.ResourceProvider ? TEResultSuccess : TEResultFeatureNotSupportedBySystem,
+			FString::Printf(TEXT("Impossible to create a ressource provider for the current RHI `%s` which is not supported."), GDynamicRHI->GetName())))
+		{
+			return false;
+		}
+		
+		// The TE instance may get destroyed latently after the owning FTouchEngine is!
+		// HazardPointer's job is to avoid TE from keep on to garbage memory; the HazardPointer is destroyed after the TE instance is destroyed.
+		TouchResources.HazardPointer = MakeShared<FTouchEngineHazardPointer>(SharedThis(this));
+		const TEResult TouchEngineInstance = TEInstanceCreate(FTouchEngineHazardPointer::TouchEventCallback_AnyThread, FTouchEngineHazardPointer::LinkValueCallback_AnyThread, TouchResources.HazardPointer.Get(), TouchResources.TouchEngineInstance.take());
+		if (!OutputResultAndCheckForError_GameThread(TouchEngineInstance, TEXT("Unable to create TouchEngine Instance")))
+		{
+			return false;
+		}
+
+		const TEResult SetFrameResult = TEInstanceSetFrameRate(TouchResources.TouchEngineInstance, TargetFrameRate, 1);
+		if (!OutputResultAndCheckForError_GameThread(SetFrameResult, TEXT("Unable to set frame rate")))
+		{
+			return false;
+		}
+		
+		const TEResult GraphicsContextResult = TEInstanceAssociateGraphicsContext(TouchResources.TouchEngineInstance, TouchResources.ResourceProvider->GetContext());
+		if (!OutputResultAndCheckForError_GameThread(GraphicsContextResult, TEXT("Unable to associate graphics Context")))
+		{
+			return false;
+		}
+
+		TouchResources.ResourceProvider->ConfigureInstance(TouchResources.TouchEngineInstance);
+		return true;
+	}
+
 	void FTouchEngine::TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale)
 	{
 		const bool bIsDestroyingTouchEngine = !TouchResources.ResourceProvider.IsValid();
@@ -489,7 +579,22 @@ namespace UE::TouchEngine
 			OnInstancedUnloaded_AnyThread();
 			LastFrameStartTimeValue.Reset();
 			break;
+		case TEEventInstanceReady:
+			OnInstanceReady_AnyThread(Result);
+			break;
 		case TEEventGeneral:
+			// TEEventGeneral is documented in TEInstance.h as "An error not associated with any other action has occurred", and TEResultExecutableError in TEResult.h as
+			// "The TouchEngine process crashed or stopped responding. An instance will not be usable until TEInstanceConfigure() is called again."
+			// The API gives no access to the process itself, so this event is the only way we learn that the instance needs to be configured again, which the restart does
+			if (Result == TEResultExecutableError && TouchResources.FrameCooker.IsValid())
+			{
+				if (TouchResources.ErrorLog)
+				{
+					TouchResources.ErrorLog->AddResult(TEXT("The TouchEngine process stopped."), Result, FString(), GET_FUNCTION_NAME_CHECKED(FTouchEngine, TouchEventCallback_AnyThread));
+				}
+				TouchResources.FrameCooker->OnTouchEngineCrashed_AnyThread(Result);
+			}
+			break;
 		default:
 			break;
 		}
@@ -580,6 +685,8 @@ namespace UE::TouchEngine
 					return;
 				}
 				SharedThis->TouchResources.VariableManager = MakeShared<FTouchVariableManager>(SharedThis->TouchResources.TouchEngineInstance, SharedThis->TouchResources.ResourceProvider, SharedThis->TouchResources.ErrorLog);
+				SharedThis->TouchResources.VariableManager->RegisterLinks_GameThread(VariablesIn.Value);
+				SharedThis->TouchResources.VariableManager->RegisterLinks_GameThread(VariablesOut.Value);
 
 				check(SharedThis->TouchResources.ResourceProvider); //TouchResources.ResourceProvider is supposed to be valid at this point as it has been created in InstantiateEngineWithToxFile
 				SharedThis->TouchResources.FrameCooker = MakeShared<FTouchFrameCooker>(SharedThis->TouchResources.TouchEngineInstance, *SharedThis->TouchResources.VariableManager, *SharedThis->TouchResources.ResourceProvider);
@@ -651,6 +758,30 @@ namespace UE::TouchEngine
 		});
 	}
 
+	void FTouchEngine::OnInstanceReady_AnyThread(TEResult Result)
+	{
+		// We want to call Async and not ExecuteOnGameThread to be sure any TE callback has had the chance to finish before we raise BP events that might end up firing other TE Callbacks
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = SharedThis(this)->AsWeak(), Result]()
+		{
+			const TSharedPtr<FTouchEngine> ThisPin = WeakThis.Pin();
+			if (!ThisPin || !ThisPin->PrewarmPromise) // TEEventInstanceReady is also received after an unload, in which case there is nothing to do
+			{
+				return;
+			}
+
+			const bool bSuccess = TEResultGetSeverity(Result) != TESeverityError;
+			if (!bSuccess && ThisPin->TouchResources.ErrorLog)
+			{
+				ThisPin->TouchResources.ErrorLog->AddResult(TEXT("Unable to start an idle TouchEngine instance."), Result, FString(), GET_FUNCTION_NAME_CHECKED(FTouchEngine, OnInstanceReady_AnyThread));
+			}
+			ThisPin->LoadState_GameThread = bSuccess ? ELoadState::Unloaded : ELoadState::FailedToLoad;
+			
+			TPromise<bool> Promise = MoveTemp(*ThisPin->PrewarmPromise);
+			ThisPin->PrewarmPromise.Reset();
+			Promise.EmplaceValue(bSuccess);
+		});
+	}
+
 	void FTouchEngine::ResumeLoadAfterUnload_GameThread()
 	{
 		check(IsInGameThread());
@@ -677,8 +808,19 @@ namespace UE::TouchEngine
 			return;
 		}
 
+		const TSharedPtr<FTouchVariableManager> VariableManager = TouchResources.VariableManager;
+		// Looked up once from the identifier without allocating, as this is called for every link which changes value during every cook
+		const FTouchLinkHandle LinkHandle = VariableManager ? VariableManager->FindOrAddLinkHandle_AnyThread(Identifier) : FTouchLinkHandle{};
+		const bool bHasLinkChanged = Event == TELinkEventAdded || Event == TELinkEventRemoved || Event == TELinkEventModified;
+		if (VariableManager && bHasLinkChanged)
+		{
+			VariableManager->InvalidateLinkInfo_AnyThread(LinkHandle);
+		}
+
 		TouchObject<TELinkInfo> Info;
-		const TEResult Result = TEInstanceLinkGetInfo(Instance, Identifier, Info.take());
+		const TEResult Result = VariableManager
+			? VariableManager->GetCachedLinkInfo_AnyThread(LinkHandle, Info)
+			: TEInstanceLinkGetInfo(Instance, Identifier, Info.take());
 
 		// UE_LOG(LogTemp, Log, TEXT("  LinkValue_AnyThread for `%hs` with event `%s` for CookingFrame `%lld`"), Identifier, *TELinkEventToString(Event), TouchResources.FrameCooker ? TouchResources.FrameCooker->GetCookingFrameID() : -1)
 		const bool bIsOutputValue = Result == TEResultSuccess && Info && Info->scope == TEScopeOutput;
@@ -690,9 +832,9 @@ namespace UE::TouchEngine
 			{
 				TouchResources.FrameCooker->ProcessLinkTextureValueChanged_AnyThread(Identifier);
 			}
-			if (TouchResources.VariableManager && TouchResources.FrameCooker->GetCookingFrameID() >= 0)
+			if (VariableManager)
 			{
-				TouchResources.VariableManager->SetFrameLastUpdatedForParameter(Identifier, TouchResources.FrameCooker->GetCookingFrameID());
+				VariableManager->RecordOutputValueChanged_AnyThread(LinkHandle, TouchResources.FrameCooker->GetCookingFrameID());
 			}
 		}
 	}
@@ -711,6 +853,12 @@ namespace UE::TouchEngine
 		}
 		
 		EmplaceLoadPromiseIfSet_GameThread(FTouchLoadResult::MakeFailure(TEXT("TouchEngine being reset.")));
+		if (PrewarmPromise)
+		{
+			TPromise<bool> Promise = MoveTemp(*PrewarmPromise);
+			PrewarmPromise.Reset();
+			Promise.EmplaceValue(false);
+		}
 		LastToxPathAttemptedToLoad.Empty();
 		if (TouchResources.FrameCooker)
 		{
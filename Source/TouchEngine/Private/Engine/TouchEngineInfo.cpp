@@ -58,15 +58,6 @@ bool UTouchEngineInfo::CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameRe
 	return false;
 }
 
-bool UTouchEngineInfo::CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds)
-{
-	if (Engine)
-	{
-		return Engine->CheckIfCookTimedOut_GameThread(CookTimeoutInSeconds);
-	}
-	return false;
-}
-
 TFuture<UE::TouchEngine::FTouchLoadResult> UTouchEngineInfo::LoadTox(const FString& AbsolutePath, UTouchEngineComponentBase* Component, double TimeoutInSeconds)
 {
 	using namespace UE::TouchEngine;
@@ -103,6 +94,15 @@ FTouchEngineCHOP UTouchEngineInfo::GetCHOPOutput(const FString& Identifier) cons
 		: FTouchEngineCHOP();
 }
 
+UE::TouchEngine::FTouchCHOPView UTouchEngineInfo::GetCHOPOutputView(const FString& Identifier) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_StatsVarGet);
+	
+	return Engine
+		? Engine->GetCHOPOutputView(Identifier)
+		: UE::TouchEngine::FTouchCHOPView();
+}
+
 void UTouchEngineInfo::SetCHOPChannelInput(const FString& Identifier, const FTouchEngineCHOPChannel& Chop)
 {
 	SCOPE_CYCLE_COUNTER(STAT_StatsVarSet);
@@ -205,14 +205,14 @@ void UTouchEngineInfo::SetTableInput(const FString& Identifier, FTouchDATFull& O
 	Engine->SetTableInput(Identifier, Op);
 }
 
-TFuture<UE::TouchEngine::FCookFrameResult> UTouchEngineInfo::CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+TFuture<UE::TouchEngine::FCookFrameResult> UTouchEngineInfo::CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 PipelineDepth)
 {
 	using namespace UE::TouchEngine;
 	check(IsInGameThread());
 
 	if (Engine)
 	{
-		return Engine->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit);
+		return Engine->CookFrame_GameThread(MoveTemp(CookFrameRequest), InputBufferLimit, PipelineDepth);
 	}
 
 	return MakeFulfilledPromise<FCookFrameResult>(FCookFrameResult::FromCookFrameRequest(CookFrameRequest, ECookFrameResult::BadRequest, -1)).GetFuture();
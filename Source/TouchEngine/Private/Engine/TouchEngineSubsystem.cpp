@@ -14,17 +14,44 @@
 
 #include "Engine/TouchEngineSubsystem.h"
 
+#include "Logging.h"
 #include "ToxAsset.h"
 // #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/TouchEngineInfo.h"
 #include "Engine/TouchEngine.h"
+#include "Engine/Util/TouchCookScheduler.h"
+#include "Engine/Util/TouchEngineInstancePool.h"
+#include "Engine/Util/TouchToxMetadataCache.h"
 
+#include "Algo/Count.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/Paths.h"
+#include "Util/TouchEngineStatsGroup.h"
 
 // class FAssetRegistryModule;
 
 namespace UE::TouchEngine::Private
 {
+	static TAutoConsoleVariable<int32> CVarMaxConcurrentLoads(
+		TEXT("TouchEngine.Subsystem.MaxConcurrentLoads"),
+		2,
+		TEXT("The maximum number of tox files the TouchEngine subsystem loads at the same time to get their parameters. Each concurrent load uses its own TouchEngine instance."));
+
+	static FAutoConsoleCommand CmdToxLoadStats(
+		TEXT("TouchEngine.Subsystem.LoadStats"),
+		TEXT("Outputs the number of tox files loaded by the TouchEngine subsystem and the percentiles of their queue wait and load time."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (const UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr)
+			{
+				for (const FString& Line : TESubsystem->GetToxLoadStats())
+				{
+					UE_LOG(LogTouchEngine, Display, TEXT("%s"), *Line);
+				}
+			}
+		}));
+	
 	static TOptional<FString> GetAbsoluteToxPathIfExists(const UToxAsset* ToxAsset)
 	{
 		if (IsValid(ToxAsset))
@@ -41,7 +68,10 @@ namespace UE::TouchEngine::Private
 
 void UTouchEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
-	EngineForLoading = NewObject<UTouchEngineInfo>();
+	Loaders.AddDefaulted();
+	LoaderEngines.Add(NewObject<UTouchEngineInfo>());
+	CookScheduler = MakeShared<UE::TouchEngine::FTouchCookScheduler>();
+	InstancePool = MakeShared<UE::TouchEngine::FTouchEngineInstancePool>();
 	//
 	// FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
 	// TArray<FAssetData> AssetData;
@@ -60,18 +90,33 @@ void UTouchEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 void UTouchEngineSubsystem::Deinitialize()
 {
 	static const FString FailureReason = TEXT("TouchEngine Subsystem shutting down.");
+	CookScheduler.Reset();
+	InstancePool.Reset();
 
-	if (ActiveTask.IsSet())
+	for (FLoader& Loader : Loaders)
 	{
-		ActiveTask->Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
-		ActiveTask.Reset();
+		if (Loader.ActiveTask.IsSet())
+		{
+			TaskQueue.Add(MoveTemp(Loader.ActiveTask.GetValue()));
+			Loader.ActiveTask.Reset();
+		}
 	}
+	Loaders.Empty(); // The results of the running loads are ignored from now on
 
 	for (FLoadTask& Task : TaskQueue)
 	{
-		Task.Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
+		for (TPromise<UE::TouchEngine::FCachedToxFileInfo>& Promise : Task.Promises)
+		{
+			Promise.SetValue(UE::TouchEngine::FCachedToxFileInfo::MakeFailure(FailureReason));
+		}
 	}
 	TaskQueue.Empty();
+	
+	for (UTouchEngineInfo* LoaderEngine : LoaderEngines)
+	{
+		LoaderEngine->Destroy();
+	}
+	LoaderEngines.Empty();
 }
 
 TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::GetOrLoadParamsFromTox(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bForceReload)
@@ -116,10 +161,13 @@ TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::GetOrLoadPar
 	if (bForceReload)
 	{
 		CachedFileData.Remove(AbsolutePath);
+		RestartActiveLoad(AbsolutePath);
 	}
 
 	ToxAssetToStartLoading.Reset();
-	return EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds);
+	return bForceReload || !FTouchToxMetadataCache::IsEnabled()
+		? EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds)
+		: LoadFromToxMetadataCache(ToxAsset, LoadTimeoutInSeconds);
 	
 }
 
@@ -136,25 +184,30 @@ bool UTouchEngineSubsystem::IsSupportedPixelFormat(TEnumAsByte<ETextureRenderTar
 }
 
 bool UTouchEngineSubsystem::IsLoaded(const UToxAsset* ToxAsset) const
+{
+	return FindLoadedResult(ToxAsset) != nullptr;
+}
+
+const UE::TouchEngine::FTouchLoadResult* UTouchEngineSubsystem::FindLoadedResult(const UToxAsset* ToxAsset) const
 {
 	using namespace UE::TouchEngine;
 	if (!IsValid(ToxAsset))
 	{
-		return false;
+		return nullptr;
 	}
 	if (ToxAssetToStartLoading == ToxAsset)
 	{
-		return false;
+		return nullptr;
 	}
 	
 	const TOptional<FString> AbsolutePath = Private::GetAbsoluteToxPathIfExists(ToxAsset);
 	if (AbsolutePath.IsSet())
 	{
 		const FTouchLoadResult* LoadResult = CachedFileData.Find(AbsolutePath.GetValue());
-		return LoadResult && LoadResult->IsSuccess();
+		return LoadResult && LoadResult->IsSuccess() ? LoadResult : nullptr;
 	}
 
-	return false;
+	return nullptr;
 }
 
 bool UTouchEngineSubsystem::IsLoading(const UToxAsset* ToxAsset) const
@@ -163,7 +216,7 @@ bool UTouchEngineSubsystem::IsLoading(const UToxAsset* ToxAsset) const
 	{
 		return false;
 	}
-	if (ToxAssetToStartLoading == ToxAsset)
+	if (ToxAssetToStartLoading == ToxAsset || ToxAssetsReadingFromCache.Contains(ToxAsset))
 	{
 		return true;
 	}
@@ -177,9 +230,12 @@ bool UTouchEngineSubsystem::IsLoading(const UToxAsset* ToxAsset) const
 	const TOptional<FString> AbsolutePath = Private::GetAbsoluteToxPathIfExists(ToxAsset);
 	if (AbsolutePath.IsSet())
 	{
-		if (ActiveTask && ActiveTask->ToxAsset == ToxAsset)
+		for (const FLoader& Loader : Loaders)
 		{
-			return true;
+			if (Loader.ActiveTask && Loader.ActiveTask->ToxAsset == ToxAsset)
+			{
+				return true;
+			}
 		}
 		for (const FLoadTask& Task :TaskQueue)
 		{
@@ -219,6 +275,7 @@ void UTouchEngineSubsystem::CacheLoadedDataFromComponent(UToxAsset* ToxAsset, co
 	if (IsValid(ToxAsset))
 	{
 		CachedFileData.Add(ToxAsset->GetAbsoluteFilePath(), LoadResult);
+		UE::TouchEngine::FTouchToxMetadataCache::Store_GameThread(ToxAsset->GetAbsoluteFilePath(), LoadResult);
 	}
 }
 
@@ -236,60 +293,276 @@ void UTouchEngineSubsystem::LoadPixelFormats(const UTouchEngineInfo* ComponentEn
 	}
 }
 
-TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds)
+TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::LoadFromToxMetadataCache(UToxAsset* ToxAsset, double LoadTimeoutInSeconds)
+{
+	using namespace UE::TouchEngine;
+
+	TPromise<FCachedToxFileInfo> Promise;
+	TFuture<FCachedToxFileInfo> Future = Promise.GetFuture();
+	const FString AbsolutePath = ToxAsset->GetAbsoluteFilePath();
+	ToxAssetsReadingFromCache.Add(ToxAsset);
+	FTouchToxMetadataCache::Find_GameThread(AbsolutePath)
+		.Next([WeakThis = TWeakObjectPtr<UTouchEngineSubsystem>(this), WeakToxAsset = TWeakObjectPtr<UToxAsset>(ToxAsset), AbsolutePath, LoadTimeoutInSeconds, Promise = MoveTemp(Promise)](TOptional<FTouchLoadResult> CachedResult) mutable
+		{
+			check(IsInGameThread());
+			UTouchEngineSubsystem* This = WeakThis.Get();
+			if (This)
+			{
+				This->ToxAssetsReadingFromCache.RemoveSingle(WeakToxAsset);
+			}
+			UToxAsset* ToxAsset = WeakToxAsset.Get();
+			if (!This || !IsValid(ToxAsset))
+			{
+				Promise.EmplaceValue(FCachedToxFileInfo::MakeFailure(TEXT("The TouchEngine Subsystem or the Tox asset was destroyed while reading the tox metadata cache.")));
+				return;
+			}
+
+			// The file might have been loaded while we were reading the cache, for example by a component
+			if (const FTouchLoadResult* LoadResult = This->CachedFileData.Find(AbsolutePath))
+			{
+				Promise.EmplaceValue(FCachedToxFileInfo{*LoadResult, true});
+				return;
+			}
+			
+			if (!CachedResult)
+			{
+				This->EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds)
+					.Next([Promise = MoveTemp(Promise)](const FCachedToxFileInfo& LoadedInfo) mutable
+					{
+						Promise.EmplaceValue(LoadedInfo);
+					});
+				return;
+			}
+
+			This->CachedFileData.Add(AbsolutePath, CachedResult.GetValue());
+			const FCachedToxFileInfo FinalResult { MoveTemp(CachedResult.GetValue()), true };
+			Promise.EmplaceValue(FinalResult);
+#if WITH_EDITOR
+			ToxAsset->GetOnToxLoadedThroughSubsystem().Broadcast(ToxAsset, FinalResult);
+#endif
+			
+			if (FTouchToxMetadataCache::ShouldRevalidate())
+			{
+				This->EnqueueOrExecuteLoadTask(ToxAsset, LoadTimeoutInSeconds, true);
+			}
+		});
+	
+	return Future;
+}
+
+TFuture<UE::TouchEngine::FCachedToxFileInfo> UTouchEngineSubsystem::EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bIsRevalidation)
 {
 	using namespace UE::TouchEngine;
 	
 	TPromise<FCachedToxFileInfo> Promise;
 	TFuture<FCachedToxFileInfo> Future = Promise.GetFuture();
-	if (ActiveTask)
-	{
-		TaskQueue.Emplace(FLoadTask{ToxAsset, MoveTemp(Promise), LoadTimeoutInSeconds});
-	}
-	else
+	const FString AbsolutePath = ToxAsset->GetAbsoluteFilePath();
+	
+	// Identical requests are given the result of the load already queued or running for the same file
+	if (FLoadTask* ExistingTask = FindLoadTask(AbsolutePath))
 	{
-		ExecuteLoadTask(FLoadTask{ToxAsset, MoveTemp(Promise), LoadTimeoutInSeconds});
+		ExistingTask->Promises.Add(MoveTemp(Promise));
+		++NumLoadRequestsMerged;
+		if (ExistingTask->bIsRevalidation && !bIsRevalidation)
+		{
+			// Someone is now waiting for this task, so it should not wait behind the other revalidations
+			ExistingTask->bIsRevalidation = false;
+			const int32 QueueIndex = TaskQueue.IndexOfByPredicate([&AbsolutePath](const FLoadTask& Task) { return Task.AbsolutePath == AbsolutePath; });
+			if (QueueIndex != INDEX_NONE)
+			{
+				FLoadTask Task = MoveTemp(TaskQueue[QueueIndex]);
+				TaskQueue.RemoveAt(QueueIndex);
+				InsertInQueue(MoveTemp(Task));
+			}
+		}
+		// The task might have been queued again by RestartActiveLoad, which freed its loader
+		DispatchLoadTasks();
+		return Future;
 	}
 
+	FLoadTask LoadTask { ToxAsset, AbsolutePath, {}, LoadTimeoutInSeconds, bIsRevalidation, FPlatformTime::Seconds() };
+	LoadTask.Promises.Add(MoveTemp(Promise));
+	InsertInQueue(MoveTemp(LoadTask));
+	DispatchLoadTasks();
 	return Future;
 }
 
-void UTouchEngineSubsystem::ExecuteLoadTask(FLoadTask&& LoadTask)
+void UTouchEngineSubsystem::DispatchLoadTasks()
 {
 	using namespace UE::TouchEngine;
-	ActiveTask = MoveTemp(LoadTask);
-	EngineForLoading->LoadTox(*ActiveTask->ToxAsset->GetAbsoluteFilePath(), nullptr, ActiveTask->LoadTimeoutInSeconds)
-		.Next([this](const FTouchLoadResult& LoadResult)
+	
+	const int32 MaxConcurrentLoads = FMath::Max(1, Private::CVarMaxConcurrentLoads.GetValueOnGameThread());
+	// The loaders are created before starting any load, as a load failing immediately would call this function again
+	while (Loaders.Num() < MaxConcurrentLoads)
+	{
+		Loaders.AddDefaulted();
+		LoaderEngines.Add(NewObject<UTouchEngineInfo>());
+	}
+	
+	for (int32 LoaderIndex = 0; LoaderIndex < MaxConcurrentLoads && !TaskQueue.IsEmpty(); ++LoaderIndex)
+	{
+		if (Loaders[LoaderIndex].ActiveTask)
 		{
-			check(IsInGameThread());
-
-			// We do not expect this to fire because the only Reset points should be in this if and in Deinitialize()
-			if (ensure(ActiveTask.IsSet()))
-			{
-				const FCachedToxFileInfo FinalResult { LoadResult, false };
-				CachedFileData.Add(ActiveTask->ToxAsset->GetAbsoluteFilePath(), LoadResult);
-				
-				// This is only safe to call after TE has sent the load success event - which has if it has told us the file is loaded.
-				EngineForLoading->GetSupportedPixelFormats(CachedSupportedPixelFormats);
-				
-				ActiveTask->Promise.EmplaceValue(FinalResult);
-#if WITH_EDITOR
-				ActiveTask->ToxAsset->GetOnToxLoadedThroughSubsystem().Broadcast(ActiveTask->ToxAsset, FinalResult);
-#endif
-				ActiveTask.Reset();
-			}
-			
-			if (TaskQueue.Num() > 0)
+			continue;
+		}
+		
+		// The tasks of destroyed assets are stale, nobody can use their result
+		while (!TaskQueue.IsEmpty() && !TaskQueue[0].ToxAsset.IsValid())
+		{
+			for (TPromise<FCachedToxFileInfo>& Promise : TaskQueue[0].Promises)
 			{
-				FLoadTask Task = MoveTemp(TaskQueue[0]);
-				TaskQueue.RemoveAt(0);
-				ExecuteLoadTask(MoveTemp(Task));
+				Promise.EmplaceValue(FCachedToxFileInfo::MakeFailure(TEXT("The Tox asset was destroyed before its file could be loaded.")));
 			}
-			else
+			TaskQueue.RemoveAt(0);
+			++NumLoadsCancelled;
+		}
+		
+		if (!TaskQueue.IsEmpty())
+		{
+			FLoadTask LoadTask = MoveTemp(TaskQueue[0]);
+			TaskQueue.RemoveAt(0);
+			ExecuteLoadTask(LoaderIndex, MoveTemp(LoadTask));
+		}
+	}
+	UpdateLoadStats();
+}
+
+void UTouchEngineSubsystem::ExecuteLoadTask(int32 LoaderIndex, FLoadTask&& LoadTask)
+{
+	using namespace UE::TouchEngine;
+	
+	LoadTask.StartTime = FPlatformTime::Seconds();
+	LoadQueueWaitTimesMs.AddSample((LoadTask.StartTime - LoadTask.EnqueueTime) * 1000.0);
+	SET_FLOAT_STAT(STAT_TE_ToxLoad_QueueWaitMs, (LoadTask.StartTime - LoadTask.EnqueueTime) * 1000.0);
+	
+	const FString AbsolutePath = LoadTask.AbsolutePath;
+	const double LoadTimeoutInSeconds = LoadTask.LoadTimeoutInSeconds;
+	const uint64 LoadId = ++Loaders[LoaderIndex].LoadId;
+	Loaders[LoaderIndex].ActiveTask = MoveTemp(LoadTask);
+	// The future might be executed immediately, which can start other loads, so Loaders must not be accessed after this call
+	LoaderEngines[LoaderIndex]->LoadTox(AbsolutePath, nullptr, LoadTimeoutInSeconds)
+		.Next([WeakThis = TWeakObjectPtr<UTouchEngineSubsystem>(this), LoaderIndex, LoadId](const FTouchLoadResult& LoadResult)
+		{
+			check(IsInGameThread());
+			if (UTouchEngineSubsystem* This = WeakThis.Get())
 			{
-				// If there are no more tasks, prevent the engine locking up rendering resources.
-				// Some .tox files when loaded lock shared hardware resources which we'd block.
-				EngineForLoading->Destroy();
+				This->OnLoadTaskFinished(LoaderIndex, LoadId, LoadResult);
 			}
 		});
 }
+
+void UTouchEngineSubsystem::OnLoadTaskFinished(int32 LoaderIndex, uint64 LoadId, const UE::TouchEngine::FTouchLoadResult& LoadResult)
+{
+	using namespace UE::TouchEngine;
+	
+	// The load was cancelled, and its task was either queued again or failed
+	if (!Loaders.IsValidIndex(LoaderIndex) || Loaders[LoaderIndex].LoadId != LoadId || !Loaders[LoaderIndex].ActiveTask)
+	{
+		return;
+	}
+	
+	FLoadTask LoadTask = MoveTemp(Loaders[LoaderIndex].ActiveTask.GetValue());
+	Loaders[LoaderIndex].ActiveTask.Reset();
+	++NumLoadsCompleted;
+	LoadTimesMs.AddSample((FPlatformTime::Seconds() - LoadTask.StartTime) * 1000.0);
+	SET_FLOAT_STAT(STAT_TE_ToxLoad_LoadTimeMs, (FPlatformTime::Seconds() - LoadTask.StartTime) * 1000.0);
+	
+	const FString& AbsolutePath = LoadTask.AbsolutePath;
+	const FTouchLoadResult* PreviousResult = CachedFileData.Find(AbsolutePath);
+	// A failed revalidation is most likely a time-out, so we keep the cached data rather than replacing valid parameters with an error
+	const bool bKeepPreviousResult = LoadTask.bIsRevalidation && PreviousResult
+		&& (LoadResult.IsFailure() || FTouchToxMetadataCache::AreEqual_GameThread(*PreviousResult, LoadResult));
+	UE_CLOG(LoadTask.bIsRevalidation && LoadResult.IsFailure(), LogTouchEngine, Warning, TEXT("Unable to reload the tox file '%s' to refresh its cached metadata: %s"), *AbsolutePath, *LoadResult.FailureResult->ErrorMessage);
+	
+	const FCachedToxFileInfo FinalResult { bKeepPreviousResult ? *PreviousResult : LoadResult, bKeepPreviousResult };
+	CachedFileData.Add(AbsolutePath, FinalResult.LoadResult);
+	FTouchToxMetadataCache::Store_GameThread(AbsolutePath, LoadResult);
+	
+	// This is only safe to call after TE has sent the load success event - which has if it has told us the file is loaded.
+	LoaderEngines[LoaderIndex]->GetSupportedPixelFormats(CachedSupportedPixelFormats);
+	
+	for (TPromise<FCachedToxFileInfo>& Promise : LoadTask.Promises)
+	{
+		Promise.EmplaceValue(FinalResult);
+	}
+#if WITH_EDITOR
+	// Nothing changed for the listeners if the revalidation gave the same result
+	UToxAsset* ToxAsset = LoadTask.ToxAsset.Get();
+	if (!bKeepPreviousResult && IsValid(ToxAsset))
+	{
+		ToxAsset->GetOnToxLoadedThroughSubsystem().Broadcast(ToxAsset, FinalResult);
+	}
+#endif
+
+	DispatchLoadTasks();
+	if (Loaders.IsValidIndex(LoaderIndex) && !Loaders[LoaderIndex].ActiveTask)
+	{
+		// If there are no more tasks for this loader, prevent the engine locking up rendering resources.
+		// Some .tox files when loaded lock shared hardware resources which we'd block.
+		LoaderEngines[LoaderIndex]->Destroy();
+	}
+}
+
+void UTouchEngineSubsystem::RestartActiveLoad(const FString& AbsolutePath)
+{
+	for (int32 LoaderIndex = 0; LoaderIndex < Loaders.Num(); ++LoaderIndex)
+	{
+		FLoader& Loader = Loaders[LoaderIndex];
+		if (!Loader.ActiveTask || Loader.ActiveTask->AbsolutePath != AbsolutePath)
+		{
+			continue;
+		}
+
+		UE_LOG(LogTouchEngine, Log, TEXT("Cancelling the load of the tox file '%s' as it is being reloaded"), *AbsolutePath);
+		FLoadTask LoadTask = MoveTemp(Loader.ActiveTask.GetValue());
+		Loader.ActiveTask.Reset();
+		++Loader.LoadId; // The unload below fails the current load, which must be ignored
+		++NumLoadsCancelled;
+		LoaderEngines[LoaderIndex]->Unload();
+		
+		LoadTask.bIsRevalidation = false;
+		TaskQueue.Insert(MoveTemp(LoadTask), 0);
+	}
+}
+
+UTouchEngineSubsystem::FLoadTask* UTouchEngineSubsystem::FindLoadTask(const FString& AbsolutePath)
+{
+	for (FLoader& Loader : Loaders)
+	{
+		if (Loader.ActiveTask && Loader.ActiveTask->AbsolutePath == AbsolutePath)
+		{
+			return &Loader.ActiveTask.GetValue();
+		}
+	}
+	return TaskQueue.FindByPredicate([&AbsolutePath](const FLoadTask& Task) { return Task.AbsolutePath == AbsolutePath; });
+}
+
+void UTouchEngineSubsystem::InsertInQueue(FLoadTask&& LoadTask)
+{
+	// Revalidations only refresh data we already have, so they are executed after the loads someone is waiting for
+	const int32 FirstRevalidationIndex = LoadTask.bIsRevalidation ? INDEX_NONE : TaskQueue.IndexOfByPredicate([](const FLoadTask& Task) { return Task.bIsRevalidation; });
+	TaskQueue.Insert(MoveTemp(LoadTask), FirstRevalidationIndex != INDEX_NONE ? FirstRevalidationIndex : TaskQueue.Num());
+}
+
+void UTouchEngineSubsystem::UpdateLoadStats() const
+{
+	SET_DWORD_STAT(STAT_TE_ToxLoad_NbQueued, TaskQueue.Num());
+	SET_DWORD_STAT(STAT_TE_ToxLoad_NbActive, Algo::CountIf(Loaders, [](const FLoader& Loader) { return Loader.ActiveTask.IsSet(); }));
+	SET_DWORD_STAT(STAT_TE_ToxLoad_NbMerged, NumLoadRequestsMerged);
+	SET_DWORD_STAT(STAT_TE_ToxLoad_NbCancelled, NumLoadsCancelled);
+}
+
+TArray<FString> UTouchEngineSubsystem::GetToxLoadStats() const
+{
+	using namespace UE::TouchEngine;
+	
+	const FTouchRollingSampleSummary QueueWait = LoadQueueWaitTimesMs.GetSummary();
+	const FTouchRollingSampleSummary LoadTime = LoadTimesMs.GetSummary();
+	return {
+		FString::Printf(TEXT("Tox loads: %d running, %d queued (max %d concurrent)"),
+			static_cast<int32>(Algo::CountIf(Loaders, [](const FLoader& Loader) { return Loader.ActiveTask.IsSet(); })), TaskQueue.Num(), FMath::Max(1, Private::CVarMaxConcurrentLoads.GetValueOnGameThread())),
+		FString::Printf(TEXT("Completed: %llu  Merged requests: %llu  Cancelled: %llu"), NumLoadsCompleted, NumLoadRequestsMerged, NumLoadsCancelled),
+		FString::Printf(TEXT("Queue wait (ms): p50 %.1f  p95 %.1f  max %.1f"), QueueWait.P50, QueueWait.P95, QueueWait.Max),
+		FString::Printf(TEXT("Load time (ms): p50 %.1f  p95 %.1f  max %.1f"), LoadTime.P50, LoadTime.P95, LoadTime.Max)
+	};
+}
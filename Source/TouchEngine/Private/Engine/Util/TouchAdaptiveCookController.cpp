@@ -0,0 +1,156 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchAdaptiveCookController.h"
+
+#include "Util/TouchEngineStatsGroup.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		/** The weight of a new measurement in the moving averages */
+		constexpr double SmoothingFactor = 0.1;
+		/** The number of finished cooks between two evaluations */
+		constexpr int32 CooksPerEvaluation = 15;
+		/** The number of consecutive evaluations needed before reducing a value */
+		constexpr int32 EvaluationsBeforeDecrease = 3;
+		/** The ratio of cook duration over frame time above which we pipeline the cooks, and the one under which we stop. The gap avoids toggling around 1 */
+		constexpr double EnablePipeliningRatio = 1.1;
+		constexpr double DisablePipeliningRatio = 0.8;
+		
+		static double Smooth(double Average, double Value)
+		{
+			return Average <= 0.0 ? Value : FMath::Lerp(Average, Value, SmoothingFactor);
+		}
+	}
+	
+	void FTouchAdaptiveCookController::Reset(int32 InInputBufferLimit, int32 InPipelineDepth)
+	{
+		*this = FTouchAdaptiveCookController();
+		InputBufferLimit = FMath::Clamp(InInputBufferLimit, 1, MaxInputBufferLimit);
+		PipelineDepth = FMath::Clamp(InPipelineDepth, 1, 2);
+		bIsInitialized = true;
+		UpdateStats();
+	}
+
+	bool FTouchAdaptiveCookController::ShouldSubmitCook_GameThread(float DeltaTime)
+	{
+		SmoothedFrameTime = Private::Smooth(SmoothedFrameTime, DeltaTime);
+		
+		++TicksSinceLastSubmission;
+		if (TicksSinceLastSubmission < SubmissionInterval)
+		{
+			return false;
+		}
+		TicksSinceLastSubmission = 0;
+		return true;
+	}
+
+	void FTouchAdaptiveCookController::OnCookFinished_GameThread(const FCookFrameResult& CookFrameResult)
+	{
+		++NumCooksSinceEvaluation;
+		if (CookFrameResult.Result == ECookFrameResult::InputsDiscarded)
+		{
+			++NumDiscardsSinceEvaluation;
+		}
+		else if (CookFrameResult.Result == ECookFrameResult::Success && CookFrameResult.CookDurationInSeconds > 0.0)
+		{
+			SmoothedCookDuration = Private::Smooth(SmoothedCookDuration, CookFrameResult.CookDurationInSeconds);
+		}
+
+		if (NumCooksSinceEvaluation >= Private::CooksPerEvaluation)
+		{
+			Evaluate();
+			NumCooksSinceEvaluation = 0;
+			NumDiscardsSinceEvaluation = 0;
+		}
+	}
+
+	void FTouchAdaptiveCookController::Evaluate()
+	{
+		if (SmoothedFrameTime <= 0.0 || SmoothedCookDuration <= 0.0)
+		{
+			return;
+		}
+
+		// The number of ticks TouchEngine needs to cook a frame
+		const double CookToFrameRatio = SmoothedCookDuration / SmoothedFrameTime;
+
+		// 1. Submission cadence: there is no point in submitting cooks faster than TouchEngine can process them, they would just be merged in the queue
+		const int32 TargetInterval = FMath::Clamp(FMath::FloorToInt32(CookToFrameRatio), 1, MaxSubmissionInterval);
+		if (TargetInterval > SubmissionInterval)
+		{
+			SubmissionInterval = TargetInterval;
+			NumEvaluationsAllowingShorterInterval = 0;
+		}
+		else if (TargetInterval < SubmissionInterval && NumDiscardsSinceEvaluation == 0)
+		{
+			if (++NumEvaluationsAllowingShorterInterval >= Private::EvaluationsBeforeDecrease)
+			{
+				--SubmissionInterval;
+				NumEvaluationsAllowingShorterInterval = 0;
+			}
+		}
+		else
+		{
+			NumEvaluationsAllowingShorterInterval = 0;
+		}
+
+		// 2. Pipelining: when TouchEngine is the bottleneck, sending the inputs of the next cook while the current one is processing removes the gap between cooks
+		if (PipelineDepth == 1 && CookToFrameRatio > Private::EnablePipeliningRatio)
+		{
+			PipelineDepth = 2;
+		}
+		else if (PipelineDepth == 2 && CookToFrameRatio < Private::DisablePipeliningRatio)
+		{
+			PipelineDepth = 1;
+		}
+
+		// 3. Queue depth: enough room for the cooks submitted while one is processing, plus one. Grow right away when inputs were discarded, shrink slowly
+		const int32 TargetInputBufferLimit = FMath::Clamp(FMath::CeilToInt32(CookToFrameRatio / SubmissionInterval) + 1, 1, MaxInputBufferLimit);
+		if (NumDiscardsSinceEvaluation > 0)
+		{
+			InputBufferLimit = FMath::Min(FMath::Max(InputBufferLimit + 1, TargetInputBufferLimit), MaxInputBufferLimit);
+			NumEvaluationsAllowingShallowerQueue = 0;
+		}
+		else if (TargetInputBufferLimit > InputBufferLimit)
+		{
+			InputBufferLimit = TargetInputBufferLimit;
+			NumEvaluationsAllowingShallowerQueue = 0;
+		}
+		else if (TargetInputBufferLimit < InputBufferLimit)
+		{
+			if (++NumEvaluationsAllowingShallowerQueue >= Private::EvaluationsBeforeDecrease)
+			{
+				--InputBufferLimit;
+				NumEvaluationsAllowingShallowerQueue = 0;
+			}
+		}
+		else
+		{
+			NumEvaluationsAllowingShallowerQueue = 0;
+		}
+
+		UpdateStats();
+	}
+
+	void FTouchAdaptiveCookController::UpdateStats() const
+	{
+		SET_DWORD_STAT(STAT_TE_Adaptive_InputBufferLimit, InputBufferLimit);
+		SET_DWORD_STAT(STAT_TE_Adaptive_PipelineDepth, PipelineDepth);
+		SET_DWORD_STAT(STAT_TE_Adaptive_SubmissionInterval, SubmissionInterval);
+		SET_FLOAT_STAT(STAT_TE_Adaptive_CookToFrameRatio, SmoothedFrameTime > 0.0 ? SmoothedCookDuration / SmoothedFrameTime : 0.0);
+	}
+}
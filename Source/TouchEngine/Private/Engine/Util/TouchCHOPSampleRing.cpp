@@ -0,0 +1,158 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCHOPSampleRing.h"
+
+#include "Logging.h"
+#include "Engine/Util/TouchCHOPView.h"
+
+namespace UE::TouchEngine
+{
+	FTouchCHOPSampleRing::FTouchCHOPSampleRing(int32 InNumChannels, int32 InCapacity, double InSampleRate)
+		: NumChannels(FMath::Max(1, InNumChannels))
+		, Capacity(FMath::Max(1, InCapacity))
+		, SampleRate(InSampleRate)
+	{
+		Samples.SetNumZeroed(NumChannels * Capacity);
+		LastValues.SetNumZeroed(NumChannels);
+	}
+
+	template<typename FGetValue>
+	int32 FTouchCHOPSampleRing::WriteSamples(int32 NumSamples, FGetValue&& GetValue)
+	{
+		const uint64 Pushed = NumPushed.load(std::memory_order_relaxed);
+		const uint64 Popped = NumPopped.load(std::memory_order_acquire);
+		const int32 FreeSpace = Capacity - static_cast<int32>(Pushed - Popped);
+		const int32 NbToWrite = FMath::Min(NumSamples, FreeSpace);
+		if (NumSamples > NbToWrite)
+		{
+			NumOverflowedSamples.fetch_add(NumSamples - NbToWrite, std::memory_order_relaxed);
+		}
+
+		for (int32 SampleIndex = 0; SampleIndex < NbToWrite; ++SampleIndex)
+		{
+			float* Frame = &Samples[((Pushed + SampleIndex) % Capacity) * NumChannels];
+			for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+			{
+				Frame[ChannelIndex] = GetValue(ChannelIndex, SampleIndex);
+			}
+		}
+		if (NbToWrite > 0)
+		{
+			FMemory::Memcpy(LastValues.GetData(), &Samples[((Pushed + NbToWrite - 1) % Capacity) * NumChannels], NumChannels * sizeof(float));
+		}
+
+		NumPushed.store(Pushed + NbToWrite, std::memory_order_release);
+		return NbToWrite;
+	}
+
+	int32 FTouchCHOPSampleRing::Push(TArrayView<const float* const> Channels, int32 NumSamples, int64 StartTime)
+	{
+		if (NumSamples <= 0)
+		{
+			return 0;
+		}
+
+		int32 FirstSample = 0;
+		int32 NbWritten = 0;
+		if (NextPushTime.IsSet() && StartTime + NumSamples < NextPushTime.GetValue() - Capacity)
+		{
+			// The buffer is more than a full ring behind, which means the timeline was restarted (e.g. the tox was reloaded). We follow the new timeline
+			NextPushTime.Reset();
+		}
+		
+		if (NextPushTime.IsSet())
+		{
+			const int64 ExpectedTime = NextPushTime.GetValue();
+			if (StartTime < ExpectedTime)
+			{
+				// Some or all of these samples were already pushed with a previous buffer
+				FirstSample = static_cast<int32>(FMath::Min<int64>(ExpectedTime - StartTime, NumSamples));
+			}
+			else if (StartTime > ExpectedTime)
+			{
+				// Some samples never reached us. We hold the last values so the samples which follow stay at the right time
+				const int32 NbMissingSamples = static_cast<int32>(FMath::Min<int64>(StartTime - ExpectedTime, Capacity));
+				NumHeldSamples.fetch_add(StartTime - ExpectedTime, std::memory_order_relaxed);
+				NbWritten += WriteSamples(NbMissingSamples, [this](int32 ChannelIndex, int32 SampleIndex) { return LastValues[ChannelIndex]; });
+			}
+		}
+		NextPushTime = FMath::Max(NextPushTime.Get(StartTime), StartTime + NumSamples);
+
+		NbWritten += WriteSamples(NumSamples - FirstSample, [&Channels, FirstSample](int32 ChannelIndex, int32 SampleIndex)
+		{
+			return Channels.IsValidIndex(ChannelIndex) && Channels[ChannelIndex] ? Channels[ChannelIndex][FirstSample + SampleIndex] : 0.f;
+		});
+		return NbWritten;
+	}
+
+	int32 FTouchCHOPSampleRing::Push(const FTouchCHOPView& CHOP)
+	{
+		const bool bChannelsMismatch = CHOP.GetNumChannels() != NumChannels;
+		// The rate of a CHOP which is not time-dependent has no meaning, its samples are not placed on the timeline
+		const bool bRateMismatch = CHOP.IsTimeDependent() && !FMath::IsNearlyEqual(CHOP.GetRate(), SampleRate, SampleRate * UE_KINDA_SMALL_NUMBER);
+		if (bChannelsMismatch || bRateMismatch)
+		{
+			// Resampling or remapping the channels would hide the error, so we let the user fix the ring or the CHOP instead
+			NumRejectedBuffers.fetch_add(1, std::memory_order_relaxed);
+			if (!bHasLoggedMismatch)
+			{
+				bHasLoggedMismatch = true;
+				UE_LOG(LogTouchEngine, Warning, TEXT("[FTouchCHOPSampleRing::Push] Rejecting a CHOP with %d channels at %g Hz, the ring expects %d channels at %g Hz. Further mismatches are only counted"),
+					CHOP.GetNumChannels(), CHOP.GetRate(), NumChannels, SampleRate);
+			}
+			return 0;
+		}
+
+		TArray<const float*, TInlineAllocator<16>> Channels;
+		Channels.Reserve(CHOP.GetNumChannels());
+		for (int32 ChannelIndex = 0; ChannelIndex < CHOP.GetNumChannels(); ++ChannelIndex)
+		{
+			Channels.Add(CHOP.GetChannel(ChannelIndex).GetData());
+		}
+
+		const int64 StartTime = CHOP.IsTimeDependent() ? CHOP.GetStartTime() : GetNextPushTime();
+		return Push(Channels, CHOP.GetNumSamples(), StartTime);
+	}
+
+	int32 FTouchCHOPSampleRing::Pop(TArrayView<float> OutSamples)
+	{
+		const uint64 Popped = NumPopped.load(std::memory_order_relaxed);
+		const uint64 Pushed = NumPushed.load(std::memory_order_acquire);
+		const int32 NbToPop = static_cast<int32>(FMath::Min<uint64>(Pushed - Popped, OutSamples.Num() / NumChannels));
+		if (NbToPop <= 0)
+		{
+			return 0;
+		}
+
+		// The samples might wrap around the end of the ring, in which case we copy them in two parts
+		const int32 FirstIndex = static_cast<int32>(Popped % Capacity);
+		const int32 NbBeforeWrap = FMath::Min(NbToPop, Capacity - FirstIndex);
+		FMemory::Memcpy(OutSamples.GetData(), &Samples[FirstIndex * NumChannels], NbBeforeWrap * NumChannels * sizeof(float));
+		if (NbBeforeWrap < NbToPop)
+		{
+			FMemory::Memcpy(OutSamples.GetData() + NbBeforeWrap * NumChannels, Samples.GetData(), (NbToPop - NbBeforeWrap) * NumChannels * sizeof(float));
+		}
+
+		NumPopped.store(Popped + NbToPop, std::memory_order_release);
+		return NbToPop;
+	}
+
+	int32 FTouchCHOPSampleRing::NumAvailable() const
+	{
+		const uint64 Popped = NumPopped.load(std::memory_order_acquire);
+		const uint64 Pushed = NumPushed.load(std::memory_order_acquire);
+		return static_cast<int32>(Pushed - Popped);
+	}
+}
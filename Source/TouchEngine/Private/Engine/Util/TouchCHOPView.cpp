@@ -0,0 +1,75 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCHOPView.h"
+
+namespace UE::TouchEngine
+{
+	FTouchCHOPView::FTouchCHOPView(TouchObject<TEFloatBuffer> InBuffer)
+		: Buffer(MoveTemp(InBuffer))
+	{
+		if (Buffer.get())
+		{
+			// TouchEngine does not modify a buffer once it has been given to us, so we can keep pointers to its content as long as we hold a reference to it
+			Channels = TEFloatBufferGetValues(Buffer);
+			ChannelNames = TEFloatBufferGetChannelNames(Buffer);
+			NumChannels = Channels ? TEFloatBufferGetChannelCount(Buffer) : 0;
+			NumSamples = Channels ? static_cast<int32>(TEFloatBufferGetValueCount(Buffer)) : 0;
+			bIsTimeDependent = TEFloatBufferIsTimeDependent(Buffer);
+			StartTime = bIsTimeDependent ? TEFloatBufferGetStartTime(Buffer) : 0;
+			Rate = TEFloatBufferGetRate(Buffer);
+		}
+	}
+
+	TArrayView<const float> FTouchCHOPView::GetChannel(int32 ChannelIndex) const
+	{
+		return ensure(ChannelIndex >= 0 && ChannelIndex < NumChannels) ? TArrayView<const float>(Channels[ChannelIndex], NumSamples) : TArrayView<const float>();
+	}
+
+	const char* FTouchCHOPView::GetChannelNameANSI(int32 ChannelIndex) const
+	{
+		return ChannelNames && ChannelIndex >= 0 && ChannelIndex < NumChannels ? ChannelNames[ChannelIndex] : nullptr;
+	}
+
+	FString FTouchCHOPView::GetChannelName(int32 ChannelIndex) const
+	{
+		const char* ChannelName = GetChannelNameANSI(ChannelIndex);
+		return ChannelName ? FString(ChannelName) : FString();
+	}
+
+	TArray<FString> FTouchCHOPView::GetChannelNames() const
+	{
+		TArray<FString> Names;
+		Names.Reserve(NumChannels);
+		for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+		{
+			Names.Emplace(GetChannelName(ChannelIndex));
+		}
+		return Names;
+	}
+
+	FTouchEngineCHOP FTouchCHOPView::ToCHOP() const
+	{
+		FTouchEngineCHOP Chop;
+		Chop.Channels.SetNum(NumChannels);
+		for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+		{
+			FTouchEngineCHOPChannel& Channel = Chop.Channels[ChannelIndex];
+			const TArrayView<const float> Values = GetChannel(ChannelIndex);
+			Channel.Values.Append(Values.GetData(), Values.Num());
+			Channel.Name = GetChannelName(ChannelIndex);
+		}
+		return Chop;
+	}
+}
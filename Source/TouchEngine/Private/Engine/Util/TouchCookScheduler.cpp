@@ -0,0 +1,207 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCookScheduler.h"
+
+#include "Blueprint/TouchEngineComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static TAutoConsoleVariable<float> CVarSchedulerFrameBudgetMs(
+			TEXT("TouchEngine.Scheduler.FrameBudgetMs"),
+			0.f,
+			TEXT("The GameThread time, in milliseconds, the cook scheduler can spend starting cooks every frame. Once over budget, the remaining requests are postponed to the next frame. 0 means no budget."));
+		
+		static TAutoConsoleVariable<int32> CVarSchedulerMaxCooksPerFrame(
+			TEXT("TouchEngine.Scheduler.MaxCooksPerFrame"),
+			0,
+			TEXT("The maximum number of cooks the cook scheduler can start every frame, to limit the number of TouchEngine instances competing for the GPU at the same time. 0 means no limit."));
+		
+		static TAutoConsoleVariable<int32> CVarSchedulerMaxDeferredFrames(
+			TEXT("TouchEngine.Scheduler.MaxDeferredFrames"),
+			10,
+			TEXT("The maximum number of frames a cook request can be postponed because of the budget before it is started anyway."));
+		
+		/** The weight of a new frame in the moving averages of the scheduler stats */
+		constexpr double StatsSmoothingFactor = 0.05;
+	}
+	
+	FTouchCookScheduler::FTouchCookScheduler()
+	{
+		OnWorldPostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FTouchCookScheduler::OnWorldPostActorTick);
+	}
+
+	FTouchCookScheduler::~FTouchCookScheduler()
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(OnWorldPostActorTickHandle);
+	}
+
+	void FTouchCookScheduler::RequestCook(UTouchEngineComponentBase* Component, float DeltaTime)
+	{
+		check(IsInGameThread());
+		
+		FScheduledComponent* Scheduled = ScheduledComponents.Find(Component);
+		if (!Scheduled)
+		{
+			Scheduled = &ScheduledComponents.Add(Component);
+			Scheduled->Component = Component;
+			// Components cooking every N frames are given a different phase so they do not all cook on the same frame
+			const int32 CookEveryNFrames = FMath::Max(1, Component->CookEveryNFrames);
+			const uint64 Phase = NumComponentsRegistered++ % CookEveryNFrames;
+			Scheduled->LastCookFrame = GFrameCounter >= static_cast<uint64>(CookEveryNFrames) ? GFrameCounter - CookEveryNFrames + Phase : 0;
+		}
+		
+		Scheduled->bHasPendingRequest = true;
+		Scheduled->PendingDeltaTime += DeltaTime;
+	}
+
+	void FTouchCookScheduler::UnregisterComponent(const UTouchEngineComponentBase* Component)
+	{
+		ScheduledComponents.Remove(Component);
+	}
+
+	TOptional<FTouchCookSchedulerComponentStats> FTouchCookScheduler::GetComponentStats(const UTouchEngineComponentBase* Component) const
+	{
+		const FScheduledComponent* Scheduled = ScheduledComponents.Find(Component);
+		return Scheduled ? Scheduled->Stats : TOptional<FTouchCookSchedulerComponentStats>();
+	}
+
+	void FTouchCookScheduler::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+	{
+		if (ScheduledComponents.IsEmpty())
+		{
+			return;
+		}
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("I. [GT] Cook Scheduler"), STAT_TE_Scheduler, STATGROUP_TouchEngine);
+
+		const double FrameBudgetSeconds = Private::CVarSchedulerFrameBudgetMs.GetValueOnGameThread() / 1000.0;
+		const int32 MaxCooksPerFrame = Private::CVarSchedulerMaxCooksPerFrame.GetValueOnGameThread();
+		const int32 MaxDeferredFrames = FMath::Max(0, Private::CVarSchedulerMaxDeferredFrames.GetValueOnGameThread());
+
+		// 1. Gather the requests of this world, highest priority first, then the ones waiting for the longest.
+		// We keep the keys rather than pointers as starting a cook can end up registering or unregistering components
+		struct FRequest
+		{
+			TObjectKey<UTouchEngineComponentBase> Key;
+			int32 Priority;
+			int32 NumFramesDeferred;
+		};
+		TArray<FRequest> Requests;
+		for (auto It = ScheduledComponents.CreateIterator(); It; ++It)
+		{
+			FScheduledComponent& Scheduled = It.Value();
+			UTouchEngineComponentBase* Component = Scheduled.Component.Get();
+			if (!Component)
+			{
+				It.RemoveCurrent();
+				continue;
+			}
+			if (Component->GetWorld() != World)
+			{
+				continue;
+			}
+			
+			Scheduled.GameThreadTimeThisFrame = 0.0;
+			Scheduled.Stats.Priority = Component->CookPriority;
+			Scheduled.Stats.CookEveryNFrames = FMath::Max(1, Component->CookEveryNFrames);
+			if (Scheduled.bHasPendingRequest && IsEligibleThisFrame(Scheduled))
+			{
+				Requests.Add({ It.Key(), Scheduled.Stats.Priority, Scheduled.NumFramesDeferred });
+			}
+		}
+		Requests.Sort([](const FRequest& A, const FRequest& B)
+		{
+			return A.Priority != B.Priority ? A.Priority > B.Priority : A.NumFramesDeferred > B.NumFramesDeferred;
+		});
+
+		// 2. Start the cooks while we are within the budget. Requests waiting for too long are started regardless of the budget
+		const double FrameStartTime = FPlatformTime::Seconds();
+		int32 NumCooksStarted = 0;
+		int32 NumCooksDeferred = 0;
+		for (const FRequest& Request : Requests)
+		{
+			FScheduledComponent* Scheduled = ScheduledComponents.Find(Request.Key);
+			if (!Scheduled || !Scheduled->Component.IsValid())
+			{
+				continue;
+			}
+			
+			const bool bIsOverBudget = (FrameBudgetSeconds > 0.0 && FPlatformTime::Seconds() - FrameStartTime >= FrameBudgetSeconds)
+				|| (MaxCooksPerFrame > 0 && NumCooksStarted >= MaxCooksPerFrame);
+			const bool bIsStarving = Scheduled->NumFramesDeferred >= MaxDeferredFrames;
+			if (NumCooksStarted > 0 && bIsOverBudget && !bIsStarving)
+			{
+				++Scheduled->NumFramesDeferred;
+				++Scheduled->Stats.NumDeferrals;
+				++NumCooksDeferred;
+				continue;
+			}
+
+			UTouchEngineComponentBase* Component = Scheduled->Component.Get();
+			const float DeltaTime = Scheduled->PendingDeltaTime;
+			Scheduled->bHasPendingRequest = false;
+			Scheduled->PendingDeltaTime = 0.f;
+			Scheduled->NumFramesDeferred = 0;
+			Scheduled->LastCookFrame = GFrameCounter;
+			++Scheduled->Stats.NumScheduledCooks;
+			++NumCooksStarted;
+
+			const double CookStartTime = FPlatformTime::Seconds();
+			Component->StartScheduledCook(DeltaTime);
+			const double CookGameThreadTime = FPlatformTime::Seconds() - CookStartTime;
+
+			Scheduled = ScheduledComponents.Find(Request.Key); // The component could have been unregistered while cooking
+			if (Scheduled)
+			{
+				FTouchCookSchedulerComponentStats& Stats = Scheduled->Stats;
+				Scheduled->GameThreadTimeThisFrame = CookGameThreadTime;
+				Stats.AverageGameThreadMs = Stats.NumScheduledCooks == 1 ? CookGameThreadTime * 1000.0 : FMath::Lerp(Stats.AverageGameThreadMs, CookGameThreadTime * 1000.0, Private::StatsSmoothingFactor);
+			}
+		}
+
+		// 3. Update the utilization of every component of this world, including the ones which did not cook this frame
+		if (DeltaSeconds > 0.f)
+		{
+			for (TPair<TObjectKey<UTouchEngineComponentBase>, FScheduledComponent>& Pair : ScheduledComponents)
+			{
+				FScheduledComponent& Scheduled = Pair.Value;
+				const UTouchEngineComponentBase* Component = Scheduled.Component.Get();
+				if (Component && Component->GetWorld() == World)
+				{
+					const double FrameShare = 100.0 * Scheduled.GameThreadTimeThisFrame / DeltaSeconds;
+					Scheduled.Stats.UtilizationPercent = FMath::Lerp(Scheduled.Stats.UtilizationPercent, FrameShare, Private::StatsSmoothingFactor);
+				}
+			}
+		}
+
+		SET_DWORD_STAT(STAT_TE_Scheduler_NbCooksStarted, NumCooksStarted);
+		SET_DWORD_STAT(STAT_TE_Scheduler_NbCooksDeferred, NumCooksDeferred);
+		SET_FLOAT_STAT(STAT_TE_Scheduler_GameThreadMs, (FPlatformTime::Seconds() - FrameStartTime) * 1000.0);
+	}
+
+	bool FTouchCookScheduler::IsEligibleThisFrame(const FScheduledComponent& Scheduled)
+	{
+		// A request already postponed because of the budget is always eligible, the "every N frames" policy was already checked when it was first postponed
+		if (Scheduled.NumFramesDeferred > 0)
+		{
+			return true;
+		}
+		return GFrameCounter - Scheduled.LastCookFrame >= static_cast<uint64>(Scheduled.Stats.CookEveryNFrames);
+	}
+}
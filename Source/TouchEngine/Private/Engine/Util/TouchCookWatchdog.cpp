@@ -0,0 +1,275 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCookWatchdog.h"
+
+#include "Logging.h"
+#include "Engine/Util/TouchFrameCooker.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchHelpers.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static TAutoConsoleVariable<float> CVarCookWatchdogUnresponsiveTimeout(
+			TEXT("TouchEngine.CookWatchdog.UnresponsiveTimeout"),
+			5.f,
+			TEXT("The number of seconds TouchEngine has to answer the cancellation of a timed-out cook before the instance is considered unresponsive and restarted. 0 disables the restart."));
+
+		static FAutoConsoleCommand CmdCookWatchdogStats(
+			TEXT("TouchEngine.CookWatchdog.Stats"),
+			TEXT("Outputs the number of cooks watched, timed out and escalated to a restart by the cook watchdog."),
+			FConsoleCommandDelegate::CreateLambda([]()
+			{
+				for (const FString& Line : FTouchCookWatchdog::Get().GetStats().ToStrings())
+				{
+					UE_LOG(LogTouchEngine, Display, TEXT("%s"), *Line);
+				}
+			}));
+		
+		static std::atomic<bool> bWasCookWatchdogCreated { false };
+
+		static uint64 SecondsToCycles(double Seconds)
+		{
+			return static_cast<uint64>(FMath::Max(0.0, Seconds) / FPlatformTime::GetSecondsPerCycle64());
+		}
+	}
+
+	TArray<FString> FTouchCookWatchdogStats::ToStrings() const
+	{
+		return {
+			FString::Printf(TEXT("Cook Watchdog - Watched: %d  Timeouts: %llu  Unresponsive Instances: %llu  Max Detection Delay: %.2fms"),
+				NumWatchedCooks, NumTimeouts, NumEscalations, MaxDetectionDelayMs)
+		};
+	}
+	
+	FTouchCookWatchdog& FTouchCookWatchdog::Get()
+	{
+		static FTouchCookWatchdog Watchdog;
+		return Watchdog;
+	}
+
+	void FTouchCookWatchdog::Shutdown()
+	{
+		if (Private::bWasCookWatchdogCreated)
+		{
+			FTouchCookWatchdog& Watchdog = Get();
+			if (Watchdog.Thread)
+			{
+				Watchdog.Thread->Kill(true);
+				delete Watchdog.Thread;
+				Watchdog.Thread = nullptr;
+			}
+		}
+	}
+
+	FTouchCookWatchdog::FTouchCookWatchdog()
+	{
+		Private::bWasCookWatchdogCreated = true;
+		WakeUpEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("TouchEngineCookWatchdog"), 0, TPri_AboveNormal);
+		UE_CLOG(!Thread, LogTouchEngine, Error, TEXT("Unable to start the TouchEngine cook watchdog thread, cook timeouts will not be detected."));
+	}
+
+	FTouchCookWatchdog::~FTouchCookWatchdog()
+	{
+		if (Thread)
+		{
+			Thread->Kill(true);
+			delete Thread;
+			Thread = nullptr;
+		}
+		FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+		WakeUpEvent = nullptr;
+	}
+
+	void FTouchCookWatchdog::Watch_AnyThread(const TSharedRef<FTouchFrameCooker>& FrameCooker, int64 FrameID, uint64 StartCycles, double CookTimeoutInSeconds)
+	{
+		if (bIsStopping)
+		{
+			return;
+		}
+		
+		FWatchedCook WatchedCook { FrameCooker, &FrameCooker.Get(), FrameID, StartCycles + Private::SecondsToCycles(CookTimeoutInSeconds) };
+		bool bShouldWakeUp;
+		{
+			FScopeLock Lock(&WatchedCooksMutex);
+			bShouldWakeUp = WatchedCook.DeadlineCycles < NextWakeUpCycles;
+			if (bShouldWakeUp)
+			{
+				NextWakeUpCycles = WatchedCook.DeadlineCycles;
+			}
+			WatchedCooks.Add(MoveTemp(WatchedCook));
+		}
+		
+		// The watchdog thread only needs to be woken up if it would otherwise sleep past the new deadline
+		if (bShouldWakeUp)
+		{
+			WakeUpEvent->Trigger();
+		}
+	}
+
+	void FTouchCookWatchdog::Unwatch_AnyThread(const FTouchFrameCooker* FrameCooker, int64 FrameID)
+	{
+		FScopeLock Lock(&WatchedCooksMutex);
+		WatchedCooks.RemoveAllSwap([FrameCooker, FrameID](const FWatchedCook& WatchedCook)
+		{
+			return WatchedCook.FrameCookerKey == FrameCooker && WatchedCook.FrameID == FrameID;
+		});
+	}
+
+	void FTouchCookWatchdog::UnwatchAll_AnyThread(const FTouchFrameCooker* FrameCooker)
+	{
+		FScopeLock Lock(&WatchedCooksMutex);
+		WatchedCooks.RemoveAllSwap([FrameCooker](const FWatchedCook& WatchedCook)
+		{
+			return WatchedCook.FrameCookerKey == FrameCooker;
+		});
+	}
+
+	FTouchCookWatchdogStats FTouchCookWatchdog::GetStats() const
+	{
+		FTouchCookWatchdogStats Stats;
+		{
+			FScopeLock Lock(&WatchedCooksMutex);
+			Stats.NumWatchedCooks = WatchedCooks.Num();
+		}
+		Stats.NumTimeouts = NumTimeouts.load(std::memory_order_relaxed);
+		Stats.NumEscalations = NumEscalations.load(std::memory_order_relaxed);
+		Stats.MaxDetectionDelayMs = MaxDetectionDelayMs.load(std::memory_order_relaxed);
+		return Stats;
+	}
+
+	uint32 FTouchCookWatchdog::Run()
+	{
+		while (!bIsStopping)
+		{
+			uint32 WaitTimeMs;
+			{
+				FScopeLock Lock(&WatchedCooksMutex);
+				NextWakeUpCycles = GetNextDeadlineCycles();
+				const uint64 NowCycles = FPlatformTime::Cycles64();
+				WaitTimeMs = NextWakeUpCycles == MAX_uint64
+					? MAX_uint32 // Wait until a cook is watched
+					: NextWakeUpCycles <= NowCycles ? 0 : static_cast<uint32>(FMath::Min<double>(FMath::CeilToDouble(FPlatformTime::ToMilliseconds64(NextWakeUpCycles - NowCycles)), MAX_int32));
+			}
+			if (WaitTimeMs > 0)
+			{
+				WakeUpEvent->Wait(WaitTimeMs);
+			}
+			if (bIsStopping)
+			{
+				break;
+			}
+
+			TArray<FWatchedCook> TimedOutCooks;
+			TArray<FWatchedCook> UnresponsiveCooks;
+			{
+				FScopeLock Lock(&WatchedCooksMutex);
+				CollectExpiredCooks(FPlatformTime::Cycles64(), TimedOutCooks, UnresponsiveCooks);
+			}
+
+			// The frame cookers are called without holding our lock, as they call Unwatch_AnyThread when TouchEngine answers the cancellation
+			for (const FWatchedCook& WatchedCook : TimedOutCooks)
+			{
+				if (const TSharedPtr<FTouchFrameCooker> FrameCooker = WatchedCook.FrameCooker.Pin())
+				{
+					UE_LOG(LogTouchEngine, Log, TEXT("[FTouchCookWatchdog::Run[%s]] The cook of frame %lld timed out, cancelling it"), *GetCurrentThreadStr(), WatchedCook.FrameID);
+					FrameCooker->OnCookDeadlineExpired_AnyThread(WatchedCook.FrameID);
+				}
+			}
+			for (const FWatchedCook& WatchedCook : UnresponsiveCooks)
+			{
+				if (const TSharedPtr<FTouchFrameCooker> FrameCooker = WatchedCook.FrameCooker.Pin())
+				{
+					UE_LOG(LogTouchEngine, Warning, TEXT("[FTouchCookWatchdog::Run[%s]] TouchEngine did not answer the cancellation of the cook of frame %lld, the instance is unresponsive"), *GetCurrentThreadStr(), WatchedCook.FrameID);
+					FrameCooker->OnTouchEngineUnresponsive_AnyThread(WatchedCook.FrameID);
+				}
+			}
+			UpdateStats();
+		}
+		return 0;
+	}
+
+	void FTouchCookWatchdog::Stop()
+	{
+		bIsStopping = true;
+		WakeUpEvent->Trigger();
+	}
+
+	void FTouchCookWatchdog::CollectExpiredCooks(uint64 NowCycles, TArray<FWatchedCook>& OutTimedOutCooks, TArray<FWatchedCook>& OutUnresponsiveCooks)
+	{
+		const float UnresponsiveTimeout = Private::CVarCookWatchdogUnresponsiveTimeout.GetValueOnAnyThread();
+		for (int32 Index = WatchedCooks.Num() - 1; Index >= 0; --Index)
+		{
+			FWatchedCook& WatchedCook = WatchedCooks[Index];
+			if (!WatchedCook.FrameCooker.IsValid())
+			{
+				WatchedCooks.RemoveAtSwap(Index);
+			}
+			else if (!WatchedCook.UnresponsiveDeadlineCycles)
+			{
+				if (NowCycles >= WatchedCook.DeadlineCycles)
+				{
+					const double DetectionDelayMs = FPlatformTime::ToMilliseconds64(NowCycles - WatchedCook.DeadlineCycles);
+					if (DetectionDelayMs > MaxDetectionDelayMs.load(std::memory_order_relaxed))
+					{
+						MaxDetectionDelayMs.store(DetectionDelayMs, std::memory_order_relaxed);
+					}
+					NumTimeouts.fetch_add(1, std::memory_order_relaxed);
+					OutTimedOutCooks.Add(WatchedCook);
+					
+					if (UnresponsiveTimeout > 0.f)
+					{
+						WatchedCook.UnresponsiveDeadlineCycles = NowCycles + Private::SecondsToCycles(UnresponsiveTimeout);
+					}
+					else
+					{
+						WatchedCooks.RemoveAtSwap(Index);
+					}
+				}
+			}
+			else if (NowCycles >= WatchedCook.UnresponsiveDeadlineCycles.GetValue())
+			{
+				NumEscalations.fetch_add(1, std::memory_order_relaxed);
+				OutUnresponsiveCooks.Add(WatchedCook);
+				WatchedCooks.RemoveAtSwap(Index);
+			}
+		}
+	}
+
+	uint64 FTouchCookWatchdog::GetNextDeadlineCycles() const
+	{
+		uint64 NextDeadlineCycles = MAX_uint64;
+		for (const FWatchedCook& WatchedCook : WatchedCooks)
+		{
+			NextDeadlineCycles = FMath::Min(NextDeadlineCycles, WatchedCook.UnresponsiveDeadlineCycles.Get(WatchedCook.DeadlineCycles));
+		}
+		return NextDeadlineCycles;
+	}
+
+	void FTouchCookWatchdog::UpdateStats() const
+	{
+		const FTouchCookWatchdogStats Stats = GetStats();
+		SET_DWORD_STAT(STAT_TE_CookWatchdog_NbWatched, Stats.NumWatchedCooks);
+		SET_DWORD_STAT(STAT_TE_CookWatchdog_NbTimeouts, Stats.NumTimeouts);
+		SET_DWORD_STAT(STAT_TE_CookWatchdog_NbUnresponsive, Stats.NumEscalations);
+		SET_FLOAT_STAT(STAT_TE_CookWatchdog_MaxDetectionDelayMs, Stats.MaxDetectionDelayMs);
+	}
+}
@@ -0,0 +1,106 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FRunnableThread;
+
+namespace UE::TouchEngine
+{
+	class FTouchFrameCooker;
+
+	struct FTouchCookWatchdogStats
+	{
+		/** The number of cooks currently watched */
+		int32 NumWatchedCooks = 0;
+		/** The number of cooks cancelled because they reached their deadline */
+		uint64 NumTimeouts = 0;
+		/** The number of instances which did not answer the cancellation of a timed-out cook and were reported as unresponsive */
+		uint64 NumEscalations = 0;
+		/** The highest delay between a deadline and the watchdog cancelling the cook, in milliseconds */
+		double MaxDetectionDelayMs = 0.0;
+		
+		TArray<FString> ToStrings() const;
+	};
+	
+	/**
+	 * Watches the cooks in flight from a dedicated thread, so a timed-out cook is cancelled on time even if the GameThread hitches or is blocked waiting for the cook.
+	 * Deadlines use FPlatformTime::Cycles64, which is monotonic and cheap to read.
+	 * When a cook reaches its deadline, the frame cooker answers it with a timeout and cancels it from a background task. If TouchEngine still has not answered after TouchEngine.CookWatchdog.UnresponsiveTimeout,
+	 * the frame cooker is told that the instance is unresponsive, which fails its pending cooks so the component can restart the instance.
+	 */
+	class FTouchCookWatchdog : public FRunnable
+	{
+	public:
+		/** Returns the watchdog, starting its thread on the first call */
+		static FTouchCookWatchdog& Get();
+		/** Stops the watchdog thread. Called when the module shuts down */
+		static void Shutdown();
+
+		virtual ~FTouchCookWatchdog() override;
+		
+		/** Starts watching the given cook. Its deadline is StartCycles + CookTimeoutInSeconds */
+		void Watch_AnyThread(const TSharedRef<FTouchFrameCooker>& FrameCooker, int64 FrameID, uint64 StartCycles, double CookTimeoutInSeconds);
+		/** Stops watching the given cook, as TouchEngine has answered it */
+		void Unwatch_AnyThread(const FTouchFrameCooker* FrameCooker, int64 FrameID);
+		/** Stops watching all the cooks of the given frame cooker */
+		void UnwatchAll_AnyThread(const FTouchFrameCooker* FrameCooker);
+
+		FTouchCookWatchdogStats GetStats() const;
+
+		//~ Begin FRunnable Interface
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+		//~ End FRunnable Interface
+
+	private:
+		FTouchCookWatchdog();
+		
+		struct FWatchedCook
+		{
+			TWeakPtr<FTouchFrameCooker> FrameCooker;
+			/** Used to find the cook when unwatching, as the weak pointer cannot be compared once the frame cooker is being destroyed */
+			const FTouchFrameCooker* FrameCookerKey = nullptr;
+			int64 FrameID = -1;
+			/** The cycle at which the cook is cancelled */
+			uint64 DeadlineCycles = 0;
+			/** Set once the cook has been cancelled, the cycle at which the instance is reported as unresponsive if TouchEngine has not answered */
+			TOptional<uint64> UnresponsiveDeadlineCycles;
+		};
+
+		/** Must be obtained to read or write WatchedCooks and NextWakeUpCycles. Never held while calling the frame cookers, which have their own lock */
+		mutable FCriticalSection WatchedCooksMutex;
+		TArray<FWatchedCook> WatchedCooks;
+		/** The cycle at which the watchdog thread will wake up by itself, or MAX_uint64 if it is waiting for a cook to be watched */
+		uint64 NextWakeUpCycles = MAX_uint64;
+		
+		FEvent* WakeUpEvent = nullptr;
+		FRunnableThread* Thread = nullptr;
+		std::atomic<bool> bIsStopping { false };
+
+		std::atomic<uint64> NumTimeouts { 0 };
+		std::atomic<uint64> NumEscalations { 0 };
+		std::atomic<double> MaxDetectionDelayMs { 0.0 };
+
+		/** Returns the cooks whose deadline have passed and updates their state. Called with WatchedCooksMutex locked */
+		void CollectExpiredCooks(uint64 NowCycles, TArray<FWatchedCook>& OutTimedOutCooks, TArray<FWatchedCook>& OutUnresponsiveCooks);
+		/** Returns the earliest deadline of the watched cooks, or MAX_uint64 if there are none. Called with WatchedCooksMutex locked */
+		uint64 GetNextDeadlineCycles() const;
+		void UpdateStats() const;
+	};
+}
@@ -0,0 +1,218 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchEngineComponentStats.h"
+
+#include "Blueprint/TouchEngineComponent.h"
+#include "CanvasTypes.h"
+#include "Engine/Engine.h"
+#include "Engine/Font.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static const FName StatTouchEngineComponentsName(TEXT("STAT_TouchEngineComponents"));
+		
+		static FString GetComponentDisplayName(const UTouchEngineComponentBase* Component)
+		{
+			const AActor* Owner = Component->GetOwner();
+			return Owner ? FString::Printf(TEXT("%s.%s"), *Owner->GetActorNameOrLabel(), *Component->GetName()) : Component->GetName();
+		}
+
+		/** Returns the running components of the given world (or of all worlds if null) whose name contains the given filter */
+		static TArray<UTouchEngineComponentBase*> GetComponentsMatchingFilter(const UWorld* World, const FString& NameFilter)
+		{
+			TArray<UTouchEngineComponentBase*> Components;
+			for (TObjectIterator<UTouchEngineComponentBase> It; It; ++It)
+			{
+				UTouchEngineComponentBase* Component = *It;
+				if (!IsValid(Component) || Component->IsTemplate() || (World && Component->GetWorld() != World))
+				{
+					continue;
+				}
+				if (NameFilter.IsEmpty() || GetComponentDisplayName(Component).Contains(NameFilter))
+				{
+					Components.Add(Component);
+				}
+			}
+			return Components;
+		}
+
+		static void OutputComponentStats(const TArray<FString>& Args, bool bReset)
+		{
+			const FString NameFilter = FString::Join(Args, TEXT(" "));
+			const TArray<UTouchEngineComponentBase*> Components = GetComponentsMatchingFilter(nullptr, NameFilter);
+			UE_CLOG(Components.IsEmpty(), LogTouchEngineComponent, Display, TEXT("No TouchEngine component matching '%s'"), *NameFilter);
+			for (UTouchEngineComponentBase* Component : Components)
+			{
+				if (bReset)
+				{
+					Component->ResetCookStats();
+					UE_LOG(LogTouchEngineComponent, Display, TEXT("Reset the stats of '%s'"), *GetComponentDisplayName(Component));
+					continue;
+				}
+				
+				UE_LOG(LogTouchEngineComponent, Display, TEXT("%s"), *GetComponentDisplayName(Component));
+				for (const FString& Line : Component->GetCookStats().ToStrings(Component->GetInstanceStatsSnapshot()))
+				{
+					UE_LOG(LogTouchEngineComponent, Display, TEXT("    %s"), *Line);
+				}
+			}
+		}
+
+		static FAutoConsoleCommand CmdStats(
+			TEXT("TouchEngine.Stats"),
+			TEXT("Outputs the latency percentiles, drop rate and counters of the TouchEngine components. Usage: TouchEngine.Stats [ComponentName]"),
+			FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { OutputComponentStats(Args, false); }));
+		
+		static FAutoConsoleCommand CmdResetStats(
+			TEXT("TouchEngine.Stats.Reset"),
+			TEXT("Resets the stats of the TouchEngine components. Usage: TouchEngine.Stats.Reset [ComponentName]"),
+			FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args) { OutputComponentStats(Args, true); }));
+
+		static int32 RenderStatTouchEngineComponents(UWorld* World, FViewport* Viewport, FCanvas* Canvas, int32 X, int32 Y, const FVector* ViewLocation, const FRotator* ViewRotation)
+		{
+			UFont* Font = GEngine->GetSmallFont();
+			const int32 RowHeight = FMath::TruncToInt(Font->GetMaxCharHeight() * 1.1f);
+			
+			Canvas->DrawShadowedString(X, Y, TEXT("TouchEngine Components"), Font, FLinearColor::Yellow);
+			Y += RowHeight;
+			for (const UTouchEngineComponentBase* Component : GetComponentsMatchingFilter(World, FString()))
+			{
+				Canvas->DrawShadowedString(X, Y, *GetComponentDisplayName(Component), Font, FLinearColor::White);
+				Y += RowHeight;
+				for (const FString& Line : Component->GetCookStats().ToStrings(Component->GetInstanceStatsSnapshot()))
+				{
+					Canvas->DrawShadowedString(X + 8, Y, *Line, Font, FLinearColor::Green);
+					Y += RowHeight;
+				}
+			}
+			return Y;
+		}
+	}
+	
+	void FTouchEngineComponentStats::RecordCookFinished(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData)
+	{
+		NumCooks.fetch_add(1, std::memory_order_relaxed);
+		switch (Result)
+		{
+		case ECookFrameResult::Success:
+			NumSuccessfulCooks.fetch_add(1, std::memory_order_relaxed);
+			LatencyMs.AddSample(FrameData.Latency * 1000.0);
+			if (FrameData.TickLatency >= 0)
+			{
+				TickLatency.AddSample(FrameData.TickLatency);
+			}
+			if (FrameData.bWasFrameDropped)
+			{
+				NumFramesDropped.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				TouchEngineCookDurationMs.AddSample((FrameData.CookEndTime - FrameData.CookStartTime) * 1000.0);
+			}
+			break;
+		case ECookFrameResult::InputsDiscarded: NumInputsDiscarded.fetch_add(1, std::memory_order_relaxed); break;
+		case ECookFrameResult::TouchEngineCookTimeout: NumTimeouts.fetch_add(1, std::memory_order_relaxed); break;
+		case ECookFrameResult::Cancelled: NumCancelled.fetch_add(1, std::memory_order_relaxed); break;
+		default: NumErrors.fetch_add(1, std::memory_order_relaxed); break;
+		}
+	}
+
+	void FTouchEngineComponentStats::RecordRecovery(double GapMs)
+	{
+		NumRecoveries.fetch_add(1, std::memory_order_relaxed);
+		LastRecoveryGapMs.store(GapMs, std::memory_order_relaxed);
+		if (GapMs > MaxRecoveryGapMs.load(std::memory_order_relaxed))
+		{
+			MaxRecoveryGapMs.store(GapMs, std::memory_order_relaxed);
+		}
+	}
+
+	void FTouchEngineComponentStats::Reset()
+	{
+		LatencyMs.Reset();
+		TickLatency.Reset();
+		TouchEngineCookDurationMs.Reset();
+		NumCooks.store(0, std::memory_order_relaxed);
+		NumSuccessfulCooks.store(0, std::memory_order_relaxed);
+		NumFramesDropped.store(0, std::memory_order_relaxed);
+		NumInputsDiscarded.store(0, std::memory_order_relaxed);
+		NumTimeouts.store(0, std::memory_order_relaxed);
+		NumCancelled.store(0, std::memory_order_relaxed);
+		NumErrors.store(0, std::memory_order_relaxed);
+		NumRestarts.store(0, std::memory_order_relaxed);
+		NumRecoveries.store(0, std::memory_order_relaxed);
+		LastRecoveryGapMs.store(0.0, std::memory_order_relaxed);
+		MaxRecoveryGapMs.store(0.0, std::memory_order_relaxed);
+	}
+
+	double FTouchEngineComponentStats::GetDropRatePercent() const
+	{
+		const uint64 NumSuccessful = NumSuccessfulCooks.load(std::memory_order_relaxed);
+		return NumSuccessful > 0 ? 100.0 * GetNumFramesDropped() / NumSuccessful : 0.0;
+	}
+
+	TArray<FString> FTouchEngineComponentStats::ToStrings(const FTouchEngineInstanceStatsSnapshot& InstanceSnapshot) const
+	{
+		const auto SummaryToString = [](const TCHAR* Name, const FTouchRollingSampleSummary& Summary, const TCHAR* Unit)
+		{
+			return FString::Printf(TEXT("%s: p50 %.2f%s  p95 %.2f%s  p99 %.2f%s  max %.2f%s  mean %.2f%s  (%d samples)"), Name,
+				Summary.P50, Unit, Summary.P95, Unit, Summary.P99, Unit, Summary.Max, Unit, Summary.Mean, Unit, Summary.Num);
+		};
+		
+		TArray<FString> Lines;
+		Lines.Add(SummaryToString(TEXT("Latency"), GetLatencyMsSummary(), TEXT("ms")));
+		Lines.Add(SummaryToString(TEXT("Tick Latency"), GetTickLatencySummary(), TEXT("")));
+		Lines.Add(SummaryToString(TEXT("TE Cook Duration"), GetTouchEngineCookDurationMsSummary(), TEXT("ms")));
+		Lines.Add(FString::Printf(TEXT("Cooks: %llu  Dropped: %llu (%.1f%%)  Inputs Discarded: %llu  Timeouts: %llu  Cancelled: %llu  Errors: %llu  Restarts: %llu"),
+			GetNumCooks(), GetNumFramesDropped(), GetDropRatePercent(), GetNumInputsDiscarded(), GetNumTimeouts(), GetNumCancelled(), GetNumErrors(), GetNumRestarts()));
+		if (GetNumRestarts() > 0)
+		{
+			Lines.Add(FString::Printf(TEXT("Recoveries: %llu  Last Gap: %.1fms  Max Gap: %.1fms"), GetNumRecoveries(), GetLastRecoveryGapMs(), GetMaxRecoveryGapMs()));
+		}
+		Lines.Add(FString::Printf(TEXT("Queue Depth: %d  Import Texture Pool: %d textures (%.1f MB)"),
+			InstanceSnapshot.NumPendingCooks, InstanceSnapshot.NumPooledImportTextures, InstanceSnapshot.PooledImportTexturesSizeInBytes / (1024.0 * 1024.0)));
+		Lines.Add(FString::Printf(TEXT("%s Input Buffer Limit: %d  Pipeline Depth: %d  Submission Interval: %d ticks"),
+			InstanceSnapshot.bIsAdaptive ? TEXT("[Adaptive]") : TEXT("[Fixed]"), InstanceSnapshot.InputBufferLimit, InstanceSnapshot.PipelineDepth, InstanceSnapshot.SubmissionInterval));
+		if (InstanceSnapshot.SchedulerStats)
+		{
+			const FTouchCookSchedulerComponentStats& SchedulerStats = InstanceSnapshot.SchedulerStats.GetValue();
+			Lines.Add(FString::Printf(TEXT("[Scheduled] Priority: %d  Every %d frames  Cooks: %llu  Deferrals: %llu  GameThread: %.2fms  Utilization: %.1f%%"),
+				SchedulerStats.Priority, SchedulerStats.CookEveryNFrames, SchedulerStats.NumScheduledCooks, SchedulerStats.NumDeferrals, SchedulerStats.AverageGameThreadMs, SchedulerStats.UtilizationPercent));
+		}
+		return Lines;
+	}
+
+	void RegisterComponentStatsOverlay()
+	{
+		if (GEngine)
+		{
+			GEngine->AddEngineStat(Private::StatTouchEngineComponentsName, TEXT("STATCAT_Engine"),
+				NSLOCTEXT("TouchEngine", "StatTouchEngineComponents", "Displays the latency and drop rate of the TouchEngine components"),
+				UEngine::FEngineStatRender::CreateStatic(&Private::RenderStatTouchEngineComponents));
+		}
+	}
+
+	void UnregisterComponentStatsOverlay()
+	{
+		if (GEngine)
+		{
+			GEngine->RemoveEngineStat(Private::StatTouchEngineComponentsName);
+		}
+	}
+}
@@ -0,0 +1,285 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchEngineInstancePool.h"
+
+#include "Logging.h"
+#include "Algo/Count.h"
+#include "Engine/Engine.h"
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "Util/TouchEngineStatsGroup.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		static FTouchEngineInstancePool* GetSubsystemInstancePool()
+		{
+			const UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+			return TESubsystem ? TESubsystem->GetInstancePool() : nullptr;
+		}
+		
+		static TAutoConsoleVariable<int32> CVarInstancePoolSize(
+			TEXT("TouchEngine.InstancePool.Size"),
+			0,
+			TEXT("The number of idle TouchEngine instances kept started so components can load their .tox file without waiting for a TouchEngine process to start. 0 disables the pool."),
+			FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+			{
+				if (FTouchEngineInstancePool* InstancePool = GetSubsystemInstancePool())
+				{
+					InstancePool->Refill_GameThread(true);
+				}
+			}));
+		
+		static TAutoConsoleVariable<float> CVarInstancePoolTimeout(
+			TEXT("TouchEngine.InstancePool.Timeout"),
+			30.f,
+			TEXT("The number of seconds an instance of the pool can take to start or to unload before it is destroyed."));
+
+		static FAutoConsoleCommand CmdInstancePoolStats(
+			TEXT("TouchEngine.InstancePool.Stats"),
+			TEXT("Outputs the number of idle instances, the hits and misses and the spawn times of the TouchEngine instance pool."),
+			FConsoleCommandDelegate::CreateLambda([]()
+			{
+				if (const FTouchEngineInstancePool* InstancePool = GetSubsystemInstancePool())
+				{
+					for (const FString& Line : InstancePool->ToStrings())
+					{
+						UE_LOG(LogTouchEngine, Display, TEXT("%s"), *Line);
+					}
+				}
+			}));
+	}
+	
+	FTouchEngineInstancePool::FTouchEngineInstancePool()
+	{
+		// Instances cannot be started before the RHI and the TouchEngine resource providers are available
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FTouchEngineInstancePool::Refill_GameThread, false);
+	}
+
+	FTouchEngineInstancePool::~FTouchEngineInstancePool()
+	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		Empty_GameThread();
+	}
+
+	TSharedPtr<FTouchEngine> FTouchEngineInstancePool::Acquire_GameThread(bool bIsIndependent, int64 FrameRate, UTouchEngineComponentBase* Component)
+	{
+		check(IsInGameThread());
+		if (GetTargetSize() <= 0 && Instances.IsEmpty())
+		{
+			return nullptr;
+		}
+
+		RemoveTimedOutInstances_GameThread();
+		TSharedPtr<FTouchEngine> AcquiredEngine;
+		const int32 Index = Instances.IndexOfByPredicate([this](const FPooledInstance& Instance) { return IsIdle(Instance); });
+		if (Index != INDEX_NONE)
+		{
+			TSharedPtr<FTouchEngine> Engine = MoveTemp(Instances[Index].Engine);
+			Instances.RemoveAt(Index);
+			if (Engine->AdoptPooledInstance_GameThread(bIsIndependent, FrameRate, Component))
+			{
+				AcquiredEngine = MoveTemp(Engine);
+			}
+			else
+			{
+				Engine->DestroyTouchEngine_GameThread();
+			}
+		}
+
+		if (AcquiredEngine)
+		{
+			++Stats.NumHits;
+			INC_DWORD_STAT(STAT_TE_InstancePool_NbHits);
+		}
+		else
+		{
+			++Stats.NumMisses;
+			INC_DWORD_STAT(STAT_TE_InstancePool_NbMisses);
+		}
+		
+		Refill_GameThread();
+		return AcquiredEngine;
+	}
+
+	bool FTouchEngineInstancePool::Release_GameThread(const TSharedPtr<FTouchEngine>& Engine)
+	{
+		check(IsInGameThread());
+		// An instance which failed to load or stopped answering might be in a bad state, we prefer starting a new one
+		if (!Engine || !Engine->HasCreatedTouchInstance() || Engine->HasFailedToLoad() || Engine->NeedsRestart())
+		{
+			return false;
+		}
+
+		// Acquire_GameThread starts a replacement right away, so the pool is usually full when the component gives its instance back.
+		// The returned instance is already running, so it takes the place of a replacement which is still starting.
+		if (Instances.Num() >= GetTargetSize())
+		{
+			const int32 StartingIndex = Instances.FindLastByPredicate([](const FPooledInstance& Instance) { return Instance.bIsStarting; });
+			if (StartingIndex == INDEX_NONE)
+			{
+				return false;
+			}
+			
+			const TSharedPtr<FTouchEngine> StartingEngine = MoveTemp(Instances[StartingIndex].Engine);
+			Instances.RemoveAt(StartingIndex);
+			StartingEngine->DestroyTouchEngine_GameThread();
+		}
+
+		Engine->ReleaseToPool_GameThread();
+		Instances.Add({ Engine, false, FPlatformTime::Seconds() });
+		++Stats.NumReturned;
+		UpdateStats();
+		return true;
+	}
+
+	void FTouchEngineInstancePool::Refill_GameThread(bool bRetryAfterFailure)
+	{
+		check(IsInGameThread());
+		bHasSpawnFailed = bHasSpawnFailed && !bRetryAfterFailure;
+		RemoveTimedOutInstances_GameThread();
+		
+		const int32 TargetSize = GetTargetSize();
+		while (Instances.Num() > TargetSize)
+		{
+			// The entry is removed before destroying the engine so a pending spawn is not reported as a failure
+			const int32 IdleIndex = Instances.FindLastByPredicate([this](const FPooledInstance& Instance) { return IsIdle(Instance); });
+			const TSharedPtr<FTouchEngine> Engine = MoveTemp(Instances[IdleIndex != INDEX_NONE ? IdleIndex : Instances.Num() - 1].Engine);
+			Instances.RemoveAt(IdleIndex != INDEX_NONE ? IdleIndex : Instances.Num() - 1);
+			Engine->DestroyTouchEngine_GameThread();
+		}
+		
+		while (!bHasSpawnFailed && Instances.Num() < TargetSize)
+		{
+			SpawnInstance_GameThread();
+		}
+		UpdateStats();
+	}
+
+	void FTouchEngineInstancePool::Empty_GameThread()
+	{
+		check(IsInGameThread());
+		TArray<FPooledInstance> OldInstances = MoveTemp(Instances);
+		Instances.Reset();
+		for (const FPooledInstance& Instance : OldInstances)
+		{
+			Instance.Engine->DestroyTouchEngine_GameThread();
+		}
+		UpdateStats();
+	}
+
+	TArray<FString> FTouchEngineInstancePool::ToStrings() const
+	{
+		const uint64 NumRequests = Stats.NumHits + Stats.NumMisses;
+		return {
+			FString::Printf(TEXT("Instance pool: %d idle, %d pending (target size %d)"), Stats.NumIdleInstances, Stats.NumPendingInstances, GetTargetSize()),
+			FString::Printf(TEXT("Hits: %llu  Misses: %llu  Hit rate: %.1f%%  Returned: %llu"),
+				Stats.NumHits, Stats.NumMisses, NumRequests > 0 ? 100.0 * Stats.NumHits / NumRequests : 0.0, Stats.NumReturned),
+			FString::Printf(TEXT("Spawned: %llu  Failed: %llu  Spawn time (ms): last %.1f  avg %.1f"),
+				Stats.NumSpawned, Stats.NumSpawnFailures, Stats.LastSpawnTimeMs, Stats.AverageSpawnTimeMs)
+		};
+	}
+
+	void FTouchEngineInstancePool::SpawnInstance_GameThread()
+	{
+		const TSharedPtr<FTouchEngine> Engine = MakeShared<FTouchEngine>();
+		const double SpawnStartTime = FPlatformTime::Seconds();
+		Instances.Add({ Engine, true, SpawnStartTime });
+		++Stats.NumSpawned;
+
+		// The future might be executed immediately if the instance could not be created
+		Engine->Prewarm_GameThread().Next([WeakThis = AsWeak(), WeakEngine = Engine.ToWeakPtr(), SpawnStartTime](bool bSuccess)
+		{
+			const TSharedPtr<FTouchEngineInstancePool> ThisPin = WeakThis.Pin();
+			const TSharedPtr<FTouchEngine> EnginePin = WeakEngine.Pin();
+			if (ThisPin && EnginePin)
+			{
+				ThisPin->OnInstanceSpawned_GameThread(EnginePin, bSuccess, FPlatformTime::Seconds() - SpawnStartTime);
+			}
+		});
+	}
+
+	void FTouchEngineInstancePool::OnInstanceSpawned_GameThread(const TSharedPtr<FTouchEngine>& Engine, bool bSuccess, double SpawnTimeInSeconds)
+	{
+		check(IsInGameThread());
+		const int32 Index = Instances.IndexOfByPredicate([&Engine](const FPooledInstance& Instance) { return Instance.Engine == Engine; });
+		if (Index == INDEX_NONE) // The instance was removed from the pool while it was starting
+		{
+			return;
+		}
+
+		if (bSuccess)
+		{
+			Instances[Index].bIsStarting = false;
+			Stats.LastSpawnTimeMs = SpawnTimeInSeconds * 1000.0;
+			Stats.AverageSpawnTimeMs += (Stats.LastSpawnTimeMs - Stats.AverageSpawnTimeMs) / ++NumSpawnTimesAveraged;
+			SET_FLOAT_STAT(STAT_TE_InstancePool_SpawnTimeMs, Stats.LastSpawnTimeMs);
+			UE_LOG(LogTouchEngine, Display, TEXT("Started an idle TouchEngine instance for the instance pool in %.1f ms"), Stats.LastSpawnTimeMs);
+		}
+		else
+		{
+			++Stats.NumSpawnFailures;
+			bHasSpawnFailed = true;
+			Instances.RemoveAt(Index);
+			Engine->DestroyTouchEngine_GameThread();
+			UE_LOG(LogTouchEngine, Warning, TEXT("Failed to start an idle TouchEngine instance for the instance pool. The pool will not be refilled until TouchEngine.InstancePool.Size is set again."));
+		}
+		UpdateStats();
+	}
+
+	void FTouchEngineInstancePool::RemoveTimedOutInstances_GameThread()
+	{
+		const double TimeoutTime = FPlatformTime::Seconds() - Private::CVarInstancePoolTimeout.GetValueOnGameThread();
+		for (int32 Index = Instances.Num() - 1; Index >= 0; --Index)
+		{
+			if (IsIdle(Instances[Index]) || Instances[Index].PendingStartTime > TimeoutTime)
+			{
+				continue;
+			}
+			
+			UE_LOG(LogTouchEngine, Warning, TEXT("A TouchEngine instance of the instance pool did not become idle after %.1f s and was destroyed"), Private::CVarInstancePoolTimeout.GetValueOnGameThread());
+			const TSharedPtr<FTouchEngine> Engine = MoveTemp(Instances[Index].Engine);
+			Instances.RemoveAt(Index);
+			Engine->DestroyTouchEngine_GameThread();
+		}
+	}
+
+	bool FTouchEngineInstancePool::IsIdle(const FPooledInstance& Instance) const
+	{
+		return !Instance.bIsStarting && Instance.Engine->HasCreatedTouchInstance() && Instance.Engine->IsReadyToLoad();
+	}
+
+	void FTouchEngineInstancePool::UpdateStats()
+	{
+		Stats.NumIdleInstances = Algo::CountIf(Instances, [this](const FPooledInstance& Instance) { return IsIdle(Instance); });
+		Stats.NumPendingInstances = Instances.Num() - Stats.NumIdleInstances;
+		SET_DWORD_STAT(STAT_TE_InstancePool_NbIdle, Stats.NumIdleInstances);
+		SET_DWORD_STAT(STAT_TE_InstancePool_NbPending, Stats.NumPendingInstances);
+	}
+
+	int32 FTouchEngineInstancePool::GetTargetSize()
+	{
+		// Commandlets and servers do not render, so there is no graphics context to give to TouchEngine
+		if (IsRunningCommandlet() || !FApp::CanEverRender())
+		{
+			return 0;
+		}
+		return FMath::Max(0, Private::CVarInstancePoolSize.GetValueOnGameThread());
+	}
+}
@@ -17,12 +17,15 @@
 #include "Logging.h"
 #include "Engine/TEDebug.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchCookWatchdog.h"
 #include "Engine/Util/TouchVariableManager.h"
 #include "Rendering/TouchResourceProvider.h"
 #include "Rendering/Importing/TouchTextureImporter.h"
+#include "Tasks/Task.h"
 #include "TouchEngine/TEInstance.h"
 #include "TouchEngine/TEResult.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -42,10 +45,11 @@ namespace UE::TouchEngine
 		// Set TouchEngineInstance to nullptr in case any of the callbacks triggers below cause a CookFrame_GameThread call
 		TouchEngineInstance.set(nullptr);
 
+		FTouchCookWatchdog::Get().UnwatchAll_AnyThread(this);
 		CancelCurrentAndNextCooks();
 	}
 
-	TFuture<FCookFrameResult> FTouchFrameCooker::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit)
+	TFuture<FCookFrameResult> FTouchFrameCooker::CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 InPipelineDepth)
 	{
 		check(IsInGameThread());
 
@@ -54,12 +58,17 @@ namespace UE::TouchEngine
 		{
 			return MakeFulfilledPromise<FCookFrameResult>(FCookFrameResult::FromCookFrameRequest(CookFrameRequest, ECookFrameResult::BadRequest, TEResultBadUsage)).GetFuture();
 		}
+		if (NeedsRestart()) // The instance is waiting to be restarted
+		{
+			return MakeFulfilledPromise<FCookFrameResult>(FCookFrameResult::FromCookFrameRequest(CookFrameRequest, ECookFrameResult::Cancelled, FrameLastUpdated)).GetFuture();
+		}
 		
 		FPendingFrameCook PendingCook { MoveTemp(CookFrameRequest) };
 		TFuture<FCookFrameResult> Future = PendingCook.PendingCookPromise.GetFuture();
 
 		{
 			FScopeLock Lock(&PendingFrameMutex);
+			PipelineDepth = FMath::Clamp(InPipelineDepth, 1, MAX_PIPELINE_DEPTH);
 			EnqueueCookFrame(MoveTemp(PendingCook), InputBufferLimit);
 			++NextFrameID; // We increase the next cook number as soon as we have enqueued the previous set of inputs.
 			ExecuteNextPendingCookFrame_GameThread(Lock);
@@ -82,8 +91,50 @@ namespace UE::TouchEngine
 		}
 		
 		FScopeLock Lock(&PendingFrameMutex);
+		if (NeedsRestart())
+		{
+			// The cook was already failed by OnTouchEngineUnresponsive_AnyThread or OnTouchEngineCrashed_AnyThread
+			UE_LOG(LogTouchEngine, Log, TEXT("[OnFrameFinishedCooking_AnyThread[%s]] Ignoring the late answer of a TouchEngine instance which needs to be restarted (%s)"), *GetCurrentThreadStr(), *TEResultToString(Result));
+			return;
+		}
+		LastCookFinishedCycles = FPlatformTime::Cycles64();
+		if (TimedOutFrameID >= 0)
+		{
+			// The cook was already answered with a timeout by OnCookDeadlineExpired_AnyThread, TouchEngine is now done with it so the next cook can be started
+			UE_LOG(LogTouchEngine, Log, TEXT("[OnFrameFinishedCooking_AnyThread[%s]] TouchEngine answered the timed-out cook of frame %lld (%s)"), *GetCurrentThreadStr(), TimedOutFrameID, *TEResultToString(Result));
+			FTouchCookWatchdog::Get().Unwatch_AnyThread(this, TimedOutFrameID);
+			TimedOutFrameID = -1;
+			if (!InProgressFrameCook && TouchEngineInstance) // The outputs of the timed-out cook were already consumed, which did not start the next cook
+			{
+				AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
+				{
+					if (const TSharedPtr<FTouchFrameCooker> ThisPin = WeakThis.Pin())
+					{
+						ThisPin->ExecuteNextPendingCookFrame_GameThread();
+					}
+				});
+			}
+			return;
+		}
+		if (InProgressFrameCook)
+		{
+			FTouchCookWatchdog::Get().Unwatch_AnyThread(this, InProgressFrameCook->FrameData.FrameID);
+			const double CookDurationInSeconds = FPlatformTime::ToSeconds64(LastCookFinishedCycles - InProgressFrameCook->JobStartCycles);
+			CSV_CUSTOM_STAT(TouchEngine, CookLatencyMs, CookDurationInSeconds * 1000.0, ECsvCustomStatOp::Max);
+			if (InProgressCookResult)
+			{
+				InProgressCookResult->CookDurationInSeconds = CookDurationInSeconds;
+			}
+		}
+		CSV_CUSTOM_STAT(TouchEngine, NbCooksFinished, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(TouchEngine, NbFramesDropped, bInWasFrameDropped ? 1 : 0, ECsvCustomStatOp::Accumulate);
+		if (InProgressFrameCook)
+		{
+			TraceCookStageEnd(*InProgressFrameCook);
+		}
 		if (ensure(InProgressCookResult))
 		{
+			TRACE_TOUCHENGINE_COOK_TIMES(InProgressCookResult->FrameData, CookStartTime, CookEndTime, bInWasFrameDropped);
 			InProgressCookResult->bWasFrameDropped = bInWasFrameDropped && FrameLastUpdated > -1; // if it is the first frame, we cannot consider it dropped
 			if (CookResult == ECookFrameResult::Success && !InProgressCookResult->bWasFrameDropped) // if the cook was successful and the frame not dropped, we update the FrameLastUpdated
 			{
@@ -104,6 +155,15 @@ namespace UE::TouchEngine
 		}
 		else
 		{
+			if (Result == TEResultExecutableError)
+			{
+				bHasCrashed.store(true, std::memory_order_release);
+			}
+			// TouchEngine is done with this cook, so it is answered with the error before the next cooks are cancelled, otherwise its promise would never be set
+			if (InProgressCookResult)
+			{
+				FinishCurrentCookFrame_AnyThread();
+			}
 			CancelCurrentAndNextCooks(CookResult);
 		}
 	}
@@ -111,12 +171,9 @@ namespace UE::TouchEngine
 	void FTouchFrameCooker::CancelCurrentAndNextCooks(ECookFrameResult CookFrameResult)
 	{
 		FScopeLock Lock(&PendingFrameMutex);
-		if (InProgressFrameCook)
+		if (InProgressFrameCook && InProgressCookResult && !HasCrashed()) // There is nothing to cancel if TouchEngine already answered the cook or if its process is gone
 		{
-			if (InProgressCookResult)
-			{
-				InProgressCookResult->Result = CookFrameResult; // We set the result we want which will not be overriden
-			}
+			InProgressCookResult->Result = CookFrameResult; // We set the result we want which will not be overriden
 			const int64 FrameID = InProgressFrameCook->FrameData.FrameID;
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("Calling TEInstanceCancelFrame for frame %lld..."), FrameID);
 			const TEResult CancelResult = TEInstanceCancelFrame(TouchEngineInstance); // OnFrameFinishedCooking_AnyThread ends up being called before the following statements
@@ -132,10 +189,21 @@ namespace UE::TouchEngine
 			// }
 			// InProgressFrameCook.Reset();
 		}
+		if (InProgressFrameCook)
+		{
+			// The cook is over from our side even if TouchEngine did not answer the cancellation (yet), so the Cook stage is closed in the trace
+			TraceCookStageEnd(*InProgressFrameCook);
+		}
+
+		if (StagedFrameCook)
+		{
+			StagedFrameCook->PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(StagedFrameCook.GetValue(), ECookFrameResult::Cancelled, FrameLastUpdated));
+			StagedFrameCook.Reset();
+		}
 		
 		while (!PendingCookQueue.IsEmpty())
 		{
-			FPendingFrameCook NextFrameCook = PendingCookQueue.Pop();
+			FPendingFrameCook NextFrameCook = PendingCookQueue.PopFront();
 			NextFrameCook.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(NextFrameCook, ECookFrameResult::Cancelled, FrameLastUpdated));
 		}
 	}
@@ -170,15 +238,84 @@ namespace UE::TouchEngine
 		return false;
 	}
 
-	bool FTouchFrameCooker::CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds)
+	void FTouchFrameCooker::OnCookDeadlineExpired_AnyThread(int64 FrameID)
+	{
+		TouchObject<TEInstance> Instance;
+		{
+			FScopeLock Lock(&PendingFrameMutex);
+			if (!InProgressFrameCook || InProgressFrameCook->FrameData.FrameID != FrameID || !InProgressCookResult || !TouchEngineInstance || NeedsRestart())
+			{
+				return; // TouchEngine answered in the meantime
+			}
+			
+			// The cook is answered right away rather than once TouchEngine acknowledges the cancellation, so nobody keeps waiting on an instance which might be hung.
+			// InProgressFrameCook stays set and no other cook is started until TouchEngine answers, or until the watchdog reports the instance as unresponsive so it is restarted.
+			InProgressCookResult->Result = ECookFrameResult::TouchEngineCookTimeout;
+			InProgressCookResult->TouchEngineInternalResult = TEResultCancelled;
+			TimedOutFrameID = FrameID;
+			TraceCookStageEnd(*InProgressFrameCook);
+			FinishCurrentCookFrame_AnyThread();
+			Instance = TouchEngineInstance;
+		}
+
+		// TEInstanceCancelFrame blocks if TouchEngine is hung, so it is neither called with PendingFrameMutex locked, which the GameThread needs to enqueue cooks,
+		// nor from the watchdog thread, which watches the cooks of every instance and has to report this one as unresponsive
+		UE::Tasks::Launch(UE_SOURCE_LOCATION, [Instance = MoveTemp(Instance), FrameID]()
+		{
+			UE_LOG(LogTouchEngineTECalls, Log, TEXT("Calling TEInstanceCancelFrame for the timed-out frame %lld..."), FrameID);
+			const TEResult CancelResult = TEInstanceCancelFrame(Instance);
+			UE_LOG(LogTouchEngineTECalls, Log, TEXT("...Called TEInstanceCancelFrame for the timed-out frame %lld returned '%s'"), FrameID, *TEResultToString(CancelResult));
+		}, UE::Tasks::ETaskPriority::BackgroundNormal);
+	}
+
+	void FTouchFrameCooker::OnTouchEngineUnresponsive_AnyThread(int64 FrameID)
 	{
 		FScopeLock Lock(&PendingFrameMutex);
-		if (InProgressFrameCook && (FDateTime::Now() - InProgressFrameCook->JobStartTime).GetTotalSeconds() >= CookTimeoutInSeconds) // we check if the frame Timed-out
+		if (TimedOutFrameID != FrameID)
 		{
-			CancelCurrentFrame_GameThread(InProgressFrameCook->FrameData.FrameID, ECookFrameResult::TouchEngineCookTimeout);
-			return true;
+			return; // TouchEngine answered in the meantime
+		}
+		
+		bIsUnresponsive.store(true, std::memory_order_release);
+		TimedOutFrameID = -1;
+		// The timed-out cook was already answered, so this only fails the staged and pending cooks
+		CancelCurrentAndNextCooks();
+	}
+
+	void FTouchFrameCooker::OnTouchEngineCrashed_AnyThread(TEResult Result)
+	{
+		FScopeLock Lock(&PendingFrameMutex);
+		bHasCrashed.store(true, std::memory_order_release);
+		FTouchCookWatchdog::Get().UnwatchAll_AnyThread(this);
+		if (InProgressFrameCook && InProgressCookResult)
+		{
+			FailCookInProgress(ECookFrameResult::InternalTouchEngineError, Result);
+		}
+		CancelCurrentAndNextCooks();
+	}
+
+	void FTouchFrameCooker::FailCookInProgress(ECookFrameResult CookFrameResult, TEResult TouchEngineResult)
+	{
+		// TouchEngine will not call OnFrameFinishedCooking_AnyThread, so the cook is failed here. The promise is moved out before being set, as its continuations run right away
+		FPendingFrameCook FailedCook = MoveTemp(InProgressFrameCook.GetValue());
+		FCookFrameResult CookResult = MoveTemp(InProgressCookResult.GetValue());
+		InProgressFrameCook.Reset();
+		InProgressCookResult.Reset();
+		CookResult.Result = CookFrameResult;
+		CookResult.TouchEngineInternalResult = TouchEngineResult;
+		CookResult.FrameLastUpdated = FrameLastUpdated;
+		CookResult.CookDurationInSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - FailedCook.JobStartCycles);
+		TraceCookStageEnd(FailedCook);
+		FailedCook.PendingCookPromise.SetValue(MoveTemp(CookResult));
+	}
+
+	void FTouchFrameCooker::TraceCookStageEnd(FPendingFrameCook& PendingCook)
+	{
+		if (PendingCook.bIsCookStageTraced)
+		{
+			PendingCook.bIsCookStageTraced = false;
+			TRACE_TOUCHENGINE_COOK_STAGE_END(Cook, PendingCook.FrameData);
 		}
-		return false;
 	}
 
 	void FTouchFrameCooker::ProcessLinkTextureValueChanged_AnyThread(const char* Identifier)
@@ -186,6 +323,7 @@ namespace UE::TouchEngine
 		using namespace UE::TouchEngine;
 		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  III.A [AT] ProcessLink"), STAT_TE_III_A, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, ProcessLink);
 		// Stash the state, we don't do any actual renderer work from this thread
 		TouchObject<TETexture> Texture = nullptr;
 		const TEResult Result = TEInstanceLinkGetTextureValue(TouchEngineInstance, Identifier, TELinkValueCurrent, Texture.take());
@@ -231,28 +369,26 @@ namespace UE::TouchEngine
 	void FTouchFrameCooker::EnqueueCookFrame(FPendingFrameCook&& CookRequest, int32 InputBufferLimit)
 	{
 		InputBufferLimit = FMath::Max(1, InputBufferLimit);
+		PendingCookQueue.Reserve(InputBufferLimit);
 		UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]] Enqueing Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
 			*GetCurrentThreadStr(), CookRequest.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
 		
 		// here we remove one more item than the buffer limit as we are going to add the given CookRequest
 		while (!PendingCookQueue.IsEmpty() && PendingCookQueue.Num() >= InputBufferLimit)
 		{
-			FPendingFrameCook CookToCancel = PendingCookQueue.Pop();
+			FPendingFrameCook CookToCancel = PendingCookQueue.PopFront();
 			UE_LOG(LogTouchEngine, Log, TEXT("[EnqueueCookFrame[%s]]   Cancelling Cook for frame %lld (%d cooks currently in the queue, InputBufferLimit is %d )"),
 				*GetCurrentThreadStr(), CookToCancel.FrameData.FrameID, PendingCookQueue.Num(), InputBufferLimit)
 
 			// Before dropping the inputs, we are trying to merge them with the next set of inputs,
 			// which will end up sending them to TE unless they are being set by the next set of inputs
-			FPendingFrameCook& NextFutureCook = PendingCookQueue.IsEmpty() ? CookRequest : PendingCookQueue.Last();
-			for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : CookToCancel.VariablesToSend)
-			{
-				NextFutureCook.VariablesToSend.FindOrAdd(Variable.Key, MoveTemp(Variable.Value));
-			}
+			FPendingFrameCook& NextFutureCook = PendingCookQueue.IsEmpty() ? CookRequest : PendingCookQueue.Front();
+			NextFutureCook.VariablesToSend.MergeOlderInputs(MoveTemp(CookToCancel.VariablesToSend));
 			
 			CookToCancel.PendingCookPromise.SetValue(FCookFrameResult::FromCookFrameRequest(CookToCancel, ECookFrameResult::InputsDiscarded, FrameLastUpdated));
 		}
 		
-		PendingCookQueue.Insert(MoveTemp(CookRequest), 0); // We enqueue at the start so we can easily use Pop to get the last element
+		PendingCookQueue.PushBack(MoveTemp(CookRequest));
 	}
 
 	bool FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread()
@@ -263,75 +399,182 @@ namespace UE::TouchEngine
 
 	bool FTouchFrameCooker::ExecuteNextPendingCookFrame_GameThread(FScopeLock& PendingFrameMutexLock)
 	{
-		if (InProgressFrameCook || PendingCookQueue.IsEmpty())
+		if (InProgressFrameCook)
+		{
+			// The previous cook is not over, but if TouchEngine is done with it we can already send the inputs of the next cook so it is ready to start as soon as possible
+			StageNextPendingCookFrame_GameThread();
+			return false;
+		}
+		if (TimedOutFrameID >= 0)
+		{
+			return false; // TouchEngine is still busy with a timed-out cook, OnFrameFinishedCooking_AnyThread starts the next cook once it is done
+		}
+		
+		if (StagedFrameCook)
+		{
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.B [GT] Cook Frame"), STAT_TE_I_B, STATGROUP_TouchEngine);
+			CSV_SCOPED_TIMING_STAT(TouchEngine, CookFrame);
+			FPendingFrameCook CookRequest = MoveTemp(StagedFrameCook.GetValue());
+			StagedFrameCook.Reset();
+			StartCook_AnyThread(MoveTemp(CookRequest), PendingFrameMutexLock);
+			return true;
+		}
+
+		if (PendingCookQueue.IsEmpty())
 		{
 			return false;
 		}
 		
-		TEResult Result = static_cast<TEResult>(0);
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.B [GT] Cook Frame"), STAT_TE_I_B, STATGROUP_TouchEngine);
-			FPendingFrameCook CookRequest = PendingCookQueue.Pop();
+			CSV_SCOPED_TIMING_STAT(TouchEngine, CookFrame);
+			FPendingFrameCook CookRequest = PendingCookQueue.PopFront();
 
 			UE_LOG(LogTouchEngine, Log, TEXT("  --------- [FTouchFrameCooker::ExecuteCurrentCookFrame[%s]] Executing the cook for the frame %lld [Requested during frame %lld, Queue: %d cooks waiting] ---------"),
 			       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, GetNextFrameID() - 1, PendingCookQueue.Num())
 
 			// 1. First, we prepare the inputs to send
-			{
-				ResourceProvider.PrepareForNewCook(CookRequest.FrameData);
-				UE_LOG(LogTouchEngine, Verbose, TEXT("[ExecuteCurrentCookFrame[%s]] Calling `VariablesToSend.SendInputs` for frame %lld"),
-				       *GetCurrentThreadStr(), CookRequest.FrameData.FrameID)
-				for (TPair<FString, FTouchEngineDynamicVariableStruct>& Variable : CookRequest.VariablesToSend)
-				{
-					Variable.Value.SendInput(VariableManager, CookRequest.FrameData);
-				}
-				CookRequest.VariablesToSend.Reset();
-				ResourceProvider.FinalizeExportsToTouchEngine_GameThread(CookRequest.FrameData);
-			}
+			SendCookInputs_GameThread(CookRequest);
+			// 2. Then we start the cook
+			StartCook_AnyThread(MoveTemp(CookRequest), PendingFrameMutexLock);
+		}
+		return true;
+	}
 
-			InProgressCookResult.Reset();
-			InProgressCookResult = FCookFrameResult();
-			InProgressCookResult->FrameData = CookRequest.FrameData;
+	bool FTouchFrameCooker::StageNextPendingCookFrame_GameThread()
+	{
+		if (PipelineDepth < 2 || StagedFrameCook || PendingCookQueue.IsEmpty() || !InProgressFrameCook)
+		{
+			return false;
+		}
+		// The inputs (and the exported textures) of the next cook are only sent once TouchEngine answered the cook in progress, while its outputs are being consumed.
+		// TouchEngine reads the inputs for the whole duration of a cook, so sending them earlier could change the values and textures of the cook in progress
+		if (InProgressCookResult || TimedOutFrameID >= 0 || NeedsRestart())
+		{
+			return false;
+		}
+
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.Bc [GT] Cook Frame - Stage Next Cook"), STAT_TE_I_Bc, STATGROUP_TouchEngine);
+		FPendingFrameCook CookRequest = PendingCookQueue.PopFront();
+		UE_LOG(LogTouchEngine, Log, TEXT("  --------- [FTouchFrameCooker::StageNextPendingCookFrame[%s]] Staging the cook for the frame %lld while the outputs of frame %lld are consumed [Queue: %d cooks waiting] ---------"),
+			   *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, InProgressFrameCook->FrameData.FrameID, PendingCookQueue.Num())
+		
+		// Once the inputs are sent, this cook cannot be merged or discarded anymore as TouchEngine already received its values
+		SendCookInputs_GameThread(CookRequest);
+		StagedFrameCook.Emplace(MoveTemp(CookRequest));
+		return true;
+	}
 
-			// We may have waited for a short time so the start time should be the requested plus when we started
-			// CookRequest.FrameTimeInSeconds += (FDateTime::Now() - CookRequest.JobCreationTime).GetTotalSeconds(); //todo: check with TE team if this should be added back
-			InProgressFrameCook.Emplace(MoveTemp(CookRequest));
-			InProgressFrameCook->JobStartTime = FDateTime::Now();
+	void FTouchFrameCooker::SendCookInputs_GameThread(FPendingFrameCook& CookRequest)
+	{
+		check(IsInGameThread());
+		TRACE_TOUCHENGINE_COOK_STAGE(SendInputs, CookRequest.FrameData);
+		
+		ResourceProvider.PrepareForNewCook(CookRequest.FrameData);
+		UE_LOG(LogTouchEngine, Verbose, TEXT("[SendCookInputs_GameThread[%s]] Calling `VariablesToSend.SendInputs` for frame %lld"),
+			   *GetCurrentThreadStr(), CookRequest.FrameData.FrameID)
+		CookRequest.VariablesToSend.SendInputs(VariableManager, CookRequest.FrameData);
+		CookRequest.VariablesToSend.Recycle();
+		VariableManager.SendCHOPInputStreams_GameThread();
+		ResourceProvider.FinalizeExportsToTouchEngine_GameThread(CookRequest.FrameData);
+	}
 
-			// This is unlocked before calling TEInstanceStartFrameAtTime in case for whatever reason it finishes cooking the frame instantly. That would cause a deadlock.
-			
-			PendingFrameMutexLock.Unlock();
-			
-			switch (TimeMode)
+	void FTouchFrameCooker::StartCook_AnyThread(FPendingFrameCook&& CookRequest, FScopeLock& PendingFrameMutexLock)
+	{
+		TEResult Result = static_cast<TEResult>(0);
+		
+		InProgressCookResult.Reset();
+		InProgressCookResult = FCookFrameResult();
+		InProgressCookResult->FrameData = CookRequest.FrameData;
+
+		// We may have waited for a short time so the start time should be the requested plus when we started
+		// CookRequest.FrameTimeInSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - CookRequest.JobCreationCycles); //todo: check with TE team if this should be added back
+		InProgressFrameCook.Emplace(MoveTemp(CookRequest));
+		InProgressFrameCook->JobStartCycles = FPlatformTime::Cycles64();
+		if (InProgressFrameCook->CookTimeoutInSeconds > 0.0)
+		{
+			FTouchCookWatchdog::Get().Watch_AnyThread(SharedThis(this), InProgressFrameCook->FrameData.FrameID, InProgressFrameCook->JobStartCycles, InProgressFrameCook->CookTimeoutInSeconds);
+		}
+
+		if (LastCookFinishedCycles != 0)
+		{
+			const double IdleGapMs = FPlatformTime::ToMilliseconds64(InProgressFrameCook->JobStartCycles - LastCookFinishedCycles);
+			SET_FLOAT_STAT(STAT_TE_Cook_IdleGapMs, IdleGapMs);
+			CSV_CUSTOM_STAT(TouchEngine, IdleGapMs, IdleGapMs, ECsvCustomStatOp::Max);
+		}
+		CSV_CUSTOM_STAT(TouchEngine, NbCooksStarted, 1, ECsvCustomStatOp::Accumulate);
+
+		// The Cook stage begins under the lock, so its end (which can come from another thread as soon as we unlock) is always output after it
+		TRACE_TOUCHENGINE_COOK_STAGE_BEGIN(Cook, InProgressFrameCook->FrameData);
+		InProgressFrameCook->bIsCookStageTraced = true;
+		// InProgressFrameCook can be reset by another thread once unlocked, so everything needed to start the cook is copied while we hold the lock
+		const FTouchEngineInputFrameData FrameData = InProgressFrameCook->FrameData;
+		int64 TimeValue = 0;
+		int64 TimeScale = 0;
+		bool bIsTimeDiscontinuity = false;
+		if (TimeMode == TETimeExternal)
+		{
+			if (InProgressFrameCook->ExactTime)
 			{
-			case TETimeInternal:
-				{
-					Result = TEInstanceStartFrameAtTime(TouchEngineInstance, 0, 0, false);
-					UE_LOG(LogTouchEngineTECalls, Log, TEXT("====TEInstanceStartFrameAtTime (TETimeInternal) with time_value '%d', time_scale '%d', and discontinuity 'false' for CookingFrame '%lld' returned '%s'"),
-										0, 0, InProgressFrameCook->FrameData.FrameID, *TEResultToString(Result))
-					UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeInternal) for frame `%lld`:  Time: %d  TimeScale: %d => %s (`%hs`)"), *GetCurrentThreadStr(), InProgressFrameCook->FrameData.FrameID, 0, 0, *TEResultToString(Result), TEResultGetDescription(Result));
-					break;
-				}
-			case TETimeExternal:
-				{
-					AccumulatedTime += InProgressFrameCook->FrameTimeInSeconds * InProgressFrameCook->TimeScale ;
-					Result = TEInstanceStartFrameAtTime(TouchEngineInstance, AccumulatedTime, InProgressFrameCook->TimeScale, false);
-					UE_LOG(LogTouchEngineTECalls, Log, TEXT("====TEInstanceStartFrameAtTime with time_value '%lld', time_scale '%lld', and discontinuity 'false' for CookingFrame '%lld' returned '%s'"),
-										AccumulatedTime, InProgressFrameCook->TimeScale, InProgressFrameCook->FrameData.FrameID, *TEResultToString(Result))
-					UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeExternal) for frame `%lld`:  Time: %lld  TimeScale: %lld => %s (`%hs`)"), *GetCurrentThreadStr(), InProgressFrameCook->FrameData.FrameID, AccumulatedTime, InProgressFrameCook->TimeScale, *TEResultToString(Result), TEResultGetDescription(Result));
-					break;
-				}
+				const FTouchRationalTime& ExactTime = InProgressFrameCook->ExactTime.GetValue();
+				TimeValue = ExactTime.Value;
+				TimeScale = ExactTime.Scale;
+				bIsTimeDiscontinuity = InProgressFrameCook->bIsTimeDiscontinuity;
+				// AccumulatedTime follows along, so a cook without an exact time carries on from this one
+				AccumulatedTime = FMath::RoundToInt64(ExactTime.ToSeconds() * InProgressFrameCook->TimeScale);
+			}
+			else
+			{
+				AccumulatedTime += InProgressFrameCook->FrameTimeInSeconds * InProgressFrameCook->TimeScale;
+				TimeValue = AccumulatedTime;
+				TimeScale = InProgressFrameCook->TimeScale;
+			}
+		}
+
+		// This is unlocked before calling TEInstanceStartFrameAtTime in case for whatever reason it finishes cooking the frame instantly. That would cause a deadlock.
+		
+		PendingFrameMutexLock.Unlock();
+		
+		TRACE_TOUCHENGINE_COOK_STAGE_BEGIN(StartFrame, FrameData);
+		switch (TimeMode)
+		{
+		case TETimeInternal:
+			{
+				Result = TEInstanceStartFrameAtTime(TouchEngineInstance, 0, 0, false);
+				UE_LOG(LogTouchEngineTECalls, Log, TEXT("====TEInstanceStartFrameAtTime (TETimeInternal) with time_value '%d', time_scale '%d', and discontinuity 'false' for CookingFrame '%lld' returned '%s'"),
+									0, 0, FrameData.FrameID, *TEResultToString(Result))
+				UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeInternal) for frame `%lld`:  Time: %d  TimeScale: %d => %s (`%hs`)"), *GetCurrentThreadStr(), FrameData.FrameID, 0, 0, *TEResultToString(Result), TEResultGetDescription(Result));
+				break;
+			}
+		case TETimeExternal:
+			{
+				Result = TEInstanceStartFrameAtTime(TouchEngineInstance, TimeValue, TimeScale, bIsTimeDiscontinuity);
+				UE_LOG(LogTouchEngineTECalls, Log, TEXT("====TEInstanceStartFrameAtTime with time_value '%lld', time_scale '%lld', and discontinuity '%s' for CookingFrame '%lld' returned '%s'"),
+									TimeValue, TimeScale, bIsTimeDiscontinuity ? TEXT("true") : TEXT("false"), FrameData.FrameID, *TEResultToString(Result))
+				UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Error, TEXT("TEInstanceStartFrameAtTime[%s] (TETimeExternal) for frame `%lld`:  Time: %lld  TimeScale: %lld => %s (`%hs`)"), *GetCurrentThreadStr(), FrameData.FrameID, TimeValue, TimeScale, *TEResultToString(Result), TEResultGetDescription(Result));
+				break;
 			}
 		}
+		TRACE_TOUCHENGINE_COOK_STAGE_END(StartFrame, FrameData);
 		
 		const bool bSuccess = Result == TEResultSuccess;
 		if (!bSuccess) //if we are successful, FTouchEngine::TouchEventCallback_AnyThread will be called with the event TEEventFrameDidFinish, and OnFrameFinishedCooking_AnyThread will be called
 		{
+			FTouchCookWatchdog::Get().Unwatch_AnyThread(this, FrameData.FrameID);
+			{
+				FScopeLock Lock(&PendingFrameMutex);
+				if (InProgressFrameCook)
+				{
+					TraceCookStageEnd(*InProgressFrameCook);
+				}
+				if (InProgressCookResult)
+				{
+					InProgressCookResult->Result = ECookFrameResult::FailedToStartCook;
+				}
+			}
 			// This will reacquire a lock - a bit meh but should not happen often
-			InProgressCookResult->Result = ECookFrameResult::FailedToStartCook;
 			FinishCurrentCookFrame_AnyThread();
 		}
-		return true;
 	}
 
 	void FTouchFrameCooker::FinishCurrentCookFrame_AnyThread()
@@ -349,8 +592,51 @@ namespace UE::TouchEngine
 					SharedThis->InProgressFrameCook.Reset();
 					SharedThis->InProgressCookResult.Reset();
 					SharedThis->ResourceProvider.GetImporter().TexturePoolMaintenance(FrameData);
+
+					// The outputs of the previous cook have been consumed, so we start the next cook right away on the earliest thread we can
+					if (!SharedThis->TouchEngineInstance || SharedThis->TimedOutFrameID >= 0) // After a timeout, OnFrameFinishedCooking_AnyThread starts the next cook once TouchEngine is done
+					{
+						return;
+					}
+					if (IsInGameThread()) // Usually the case, as OnReadyToStartNextCook is set by the component after reading the outputs
+					{
+						UE_LOG(LogTouchEngine, Verbose, TEXT("[FTouchFrameCooker::OnReadyToStartNextCook[%s]] Calling ExecuteNextPendingCookFrame_GameThread after frame %lld"),
+							   *GetCurrentThreadStr(), FrameData.FrameID)
+						SharedThis->ExecuteNextPendingCookFrame_GameThread(Lock);
+					}
+					else if (SharedThis->StagedFrameCook) // The inputs of the next cook were already sent, there is nothing left to do on the GameThread
+					{
+						FPendingFrameCook CookRequest = MoveTemp(SharedThis->StagedFrameCook.GetValue());
+						SharedThis->StagedFrameCook.Reset();
+						UE_LOG(LogTouchEngine, Log, TEXT("  --------- [FTouchFrameCooker::OnReadyToStartNextCook[%s]] Starting the staged cook for the frame %lld right after frame %lld ---------"),
+							   *GetCurrentThreadStr(), CookRequest.FrameData.FrameID, FrameData.FrameID)
+						SharedThis->StartCook_AnyThread(MoveTemp(CookRequest), Lock);
+					}
+					else if (!SharedThis->PendingCookQueue.IsEmpty()) // The inputs need to be sent from the GameThread
+					{
+						Lock.Unlock();
+						AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+						{
+							if (const TSharedPtr<FTouchFrameCooker> ThisPin = WeakThis.Pin())
+							{
+								ThisPin->ExecuteNextPendingCookFrame_GameThread();
+							}
+						});
+					}
 				}
 			});
+			if (PipelineDepth > 1 && !StagedFrameCook && !PendingCookQueue.IsEmpty())
+			{
+				// TouchEngine is done with this cook, so the inputs of the next one can be sent while its outputs are being consumed
+				AsyncTask(ENamedThreads::GameThread, [WeakThis = AsWeak()]()
+				{
+					if (const TSharedPtr<FTouchFrameCooker> ThisPin = WeakThis.Pin())
+					{
+						FScopeLock Lock(&ThisPin->PendingFrameMutex);
+						ThisPin->StageNextPendingCookFrame_GameThread();
+					}
+				});
+			}
 			InProgressFrameCook->PendingCookPromise.SetValue(*InProgressCookResult);
 			InProgressCookResult.Reset(); // to be sure not to try to set it again if we cancel
 		}
@@ -20,6 +20,8 @@
 #include "Engine/Util/TouchVariableManager.h"
 #include "TouchEngine/TEInstance.h"
 #include "TouchEngine/TouchObject.h"
+#include "Util/TouchRingBuffer.h"
+#include <atomic>
 
 class FScopeLock;
 
@@ -34,13 +36,26 @@ namespace UE::TouchEngine
 	{
 	public:
 		static constexpr int64 FIRST_FRAME_ID = 1;
+		/** The maximum number of cooks that can be handed to TouchEngine at the same time: the one cooking and the one staged behind it */
+		static constexpr int32 MAX_PIPELINE_DEPTH = 2;
 		
 		FTouchFrameCooker(TouchObject<TEInstance> InTouchEngineInstance, FTouchVariableManager& InVariableManager, FTouchResourceProvider& InResourceProvider);
 		~FTouchFrameCooker();
 
 		void SetTimeMode(TETimeMode InTimeMode) { TimeMode = InTimeMode; }
 
-		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+		/**
+		 * Enqueue the given Cook Request and start it right away if no cook is ongoing.
+		 * @param CookFrameRequest The Request to enqueue
+		 * @param InputBufferLimit The maximum number of cooks to hold in the queue. The older ones will be merged into the next ones and discarded if the queue reach this limit
+		 * @param PipelineDepth The number of cooks in flight. With a depth of 2, the inputs of the next cook are sent as soon as TouchEngine answered the current cook,
+		 * while its outputs are being consumed, so the next cook can be started as soon as they are. Clamped between 1 and MAX_PIPELINE_DEPTH.
+		 */
+		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 PipelineDepth = 1);
+		/**
+		 * Starts the next cook if none is ongoing, otherwise stages the next pending cook if the pipeline depth allows it. Returns true if a cook was started.
+		 * There is usually no need to call this, as the next cook is automatically started once the previous cook's OnReadyToStartNextCook promise is set.
+		 */
 		bool ExecuteNextPendingCookFrame_GameThread();
 		/**
 		 * @brief 
@@ -56,7 +71,23 @@ namespace UE::TouchEngine
 		 * @return Returns true if the frame with the GivenID was cancelled
 		 */
 		bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
-		bool CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds);
+		/**
+		 * Called by the cook watchdog thread when the given cook reached its timeout. Answers it with a TouchEngineCookTimeout result, then cancels it from a background task,
+		 * as TEInstanceCancelFrame does not return if TouchEngine is hung. No other cook is started until TouchEngine answers the cancellation.
+		 */
+		void OnCookDeadlineExpired_AnyThread(int64 FrameID);
+		/**
+		 * Called by the cook watchdog thread when TouchEngine did not answer the cancellation of the given cook.
+		 * Fails the cook and the pending ones, and refuses any further cook as the instance needs to be restarted.
+		 */
+		void OnTouchEngineUnresponsive_AnyThread(int64 FrameID);
+		/** Called when TouchEngine reported that its process crashed. Fails the cook in progress and the pending ones, and refuses any further cook as the instance needs to be restarted. */
+		void OnTouchEngineCrashed_AnyThread(TEResult Result);
+		/** Returns true if TouchEngine stopped answering our cooks. The instance needs to be restarted */
+		bool IsUnresponsive() const { return bIsUnresponsive.load(std::memory_order_acquire); }
+		/** Returns true if the TouchEngine process crashed. The instance needs to be restarted */
+		bool HasCrashed() const { return bHasCrashed.load(std::memory_order_acquire); }
+		bool NeedsRestart() const { return IsUnresponsive() || HasCrashed(); }
 
 		/** Returns the FrameID to be used for the next cook. */
 		int64 GetNextFrameID() const { return NextFrameID; }
@@ -65,6 +96,14 @@ namespace UE::TouchEngine
 		int64 GetFrameLastUpdated() const { return FrameLastUpdated; }
 
 		bool IsCookingFrame() const { return InProgressFrameCook.IsSet(); }
+		/** Returns true if the inputs of the next cook have already been sent to TouchEngine and the cook is waiting for the current one to finish */
+		bool HasStagedCook() const { return StagedFrameCook.IsSet(); }
+		/** Returns the number of cooks waiting for the current cook to be done, including the staged one */
+		int32 GetNumPendingCooks()
+		{
+			FScopeLock Lock(&PendingFrameMutex);
+			return PendingCookQueue.Num() + (StagedFrameCook.IsSet() ? 1 : 0);
+		}
 		/** returns the FrameID of the current cooking frame, or -1 if no frame is cooking */
 		int64 GetCookingFrameID() const { return InProgressFrameCook.IsSet() ? InProgressFrameCook->FrameData.FrameID : -1; }
 
@@ -77,11 +116,13 @@ namespace UE::TouchEngine
 		
 		struct FPendingFrameCook : FCookFrameRequest
 		{
-			/* The time at which the job was created */
-			FDateTime JobCreationTime = FDateTime::Now();
-			/* The time at which the job was started by calling TEInstanceStartFrameAtTime. Used to check the Timeout */
-			FDateTime JobStartTime;
+			/* The FPlatformTime::Cycles64 at which the job was created */
+			uint64 JobCreationCycles = FPlatformTime::Cycles64();
+			/** The FPlatformTime::Cycles64 at which the job was started by calling TEInstanceStartFrameAtTime. Used to measure the cook latency and by the cook watchdog to check the timeout */
+			uint64 JobStartCycles = 0;
 			TPromise<FCookFrameResult> PendingCookPromise;
+			/** True between the begin and end trace events of the Cook stage, so the end event is output exactly once whichever way the cook ends */
+			bool bIsCookStageTraced = false;
 		};
 		
 		TouchObject<TEInstance>	TouchEngineInstance;
@@ -94,26 +135,50 @@ namespace UE::TouchEngine
 
 		/** The last frame we receive a successful cook that was not skipped */
 		int64 FrameLastUpdated = -1;
-
-		/** Must be obtained to read or write InProgressFrameCook. */
+		/** The FPlatformTime::Cycles64 at which TouchEngine last finished a cook. Used to measure how long TouchEngine stays idle between two cooks */
+		uint64 LastCookFinishedCycles = 0;
+		/** Set by the cook watchdog when TouchEngine did not answer the cancellation of a cook. Once set, no new cook is started */
+		std::atomic<bool> bIsUnresponsive { false };
+		/** Set when TouchEngine reported that its process crashed. Once set, no new cook is started */
+		std::atomic<bool> bHasCrashed { false };
+		/** The FrameID of the cook answered by OnCookDeadlineExpired_AnyThread for which TouchEngine has not answered the cancellation yet, or -1. Guarded by PendingFrameMutex */
+		int64 TimedOutFrameID = -1;
+
+		/** Must be obtained to read or write InProgressFrameCook, StagedFrameCook and PendingCookQueue. */
 		FCriticalSection PendingFrameMutex;
 		/** The cook frame request that is currently in progress if any. */
 		TOptional<FPendingFrameCook> InProgressFrameCook;
 		/** The cook frame result for the frame in progress, if any. */
 		TOptional<FCookFrameResult> InProgressCookResult;
+		/** The cook frame request for which the inputs have already been sent to TouchEngine, waiting for InProgressFrameCook to be done. Only used when PipelineDepth > 1 */
+		TOptional<FPendingFrameCook> StagedFrameCook;
+		/** The number of cooks TouchEngine can be working on, as given by the last call to CookFrame_GameThread */
+		int32 PipelineDepth = 1;
 		
-		/** The next frame cooks to execute after InProgressFrameCook is done. Implemented as Array to have access to size and keep FPendingFrameCook.Promise not shared*/
-		TArray<FPendingFrameCook> PendingCookQueue;
-		FCriticalSection PendingCookQueueMutex;
+		/** The next frame cooks to execute after InProgressFrameCook (and StagedFrameCook) are done, oldest first. Holds the FPendingFrameCook by value to keep FPendingFrameCook.Promise not shared */
+		TTouchRingBuffer<FPendingFrameCook> PendingCookQueue;
 
 		/**
-		 * Enqueue the given Cook Request to be processed. There should be a lock to PendingCookQueueMutex before calling this function.
+		 * Enqueue the given Cook Request to be processed. There should be a lock to PendingFrameMutex before calling this function.
 		 * @param CookRequest The Request to enqueue
 		 * @param InputBufferLimit The maximum number of cooks to hold in the queue. The older ones will be cancelled if the queue reach this limit
 		 */
 		void EnqueueCookFrame(FPendingFrameCook&& CookRequest, int32 InputBufferLimit);
 		bool ExecuteNextPendingCookFrame_GameThread(FScopeLock& PendingFrameMutexLock);
+		/**
+		 * Takes the oldest cook from the queue and sends its inputs to TouchEngine so it can be started as soon as the outputs of the current cook are consumed.
+		 * Only does so once TouchEngine answered the current cook. There should be a lock to PendingFrameMutex before calling this function.
+		 */
+		bool StageNextPendingCookFrame_GameThread();
+		/** Prepares the resource provider and sends all the inputs of the given cook to TouchEngine */
+		void SendCookInputs_GameThread(FPendingFrameCook& CookRequest);
+		/** Makes the given cook the InProgressFrameCook and calls TEInstanceStartFrameAtTime. The inputs must have been sent already. Unlocks PendingFrameMutexLock. */
+		void StartCook_AnyThread(FPendingFrameCook&& CookRequest, FScopeLock& PendingFrameMutexLock);
 		void FinishCurrentCookFrame_AnyThread();
+		/** Sets the promise of the cook in progress with the given result when TouchEngine will not answer it anymore. There should be a lock to PendingFrameMutex before calling this function. */
+		void FailCookInProgress(ECookFrameResult CookFrameResult, TEResult TouchEngineResult);
+		/** Outputs the end trace event of the Cook stage of the given cook if it was not output yet. There should be a lock to PendingFrameMutex before calling this function. */
+		static void TraceCookStageEnd(FPendingFrameCook& PendingCook);
 	};
 }
 
@@ -0,0 +1,61 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchLockstepClock.h"
+
+#include "Logging.h"
+
+namespace UE::TouchEngine
+{
+	void FTouchLockstepClock::Configure(const FFrameRate& InFrameRate, int32 InTemporalSampleCount)
+	{
+		FFrameRate NewFrameRate = InFrameRate.IsValid() ? InFrameRate : FFrameRate(24, 1);
+		// TouchEngine takes the time scale as an int32, so the number of samples per second must fit in it
+		const int32 MaxTemporalSampleCount = FMath::Max(1, MAX_int32 / FMath::Max(1, NewFrameRate.Numerator));
+		const int32 NewTemporalSampleCount = FMath::Clamp(InTemporalSampleCount, 1, MaxTemporalSampleCount);
+		UE_CLOG(NewTemporalSampleCount != InTemporalSampleCount, LogTouchEngine, Warning, TEXT("[FTouchLockstepClock] %d temporal samples at %s cannot be represented exactly, using %d samples."),
+			InTemporalSampleCount, *NewFrameRate.ToPrettyText().ToString(), NewTemporalSampleCount);
+		
+		if (NewFrameRate != FrameRate || NewTemporalSampleCount != TemporalSampleCount)
+		{
+			FrameRate = NewFrameRate;
+			TemporalSampleCount = NewTemporalSampleCount;
+			NextSampleIndex = 0;
+			bNextIsDiscontinuity = true;
+		}
+	}
+
+	void FTouchLockstepClock::SetNextSample(FFrameNumber Frame, int32 TemporalSampleIndex)
+	{
+		const int64 SampleIndex = static_cast<int64>(Frame.Value) * TemporalSampleCount + FMath::Clamp(TemporalSampleIndex, 0, TemporalSampleCount - 1);
+		if (SampleIndex != NextSampleIndex)
+		{
+			NextSampleIndex = SampleIndex;
+			bNextIsDiscontinuity = true;
+		}
+	}
+
+	FTouchRationalTime FTouchLockstepClock::ConsumeNextTime(bool& bOutIsDiscontinuity)
+	{
+		bOutIsDiscontinuity = bNextIsDiscontinuity;
+		bNextIsDiscontinuity = false;
+		return GetTimeOfSample(NextSampleIndex++);
+	}
+
+	FTouchRationalTime FTouchLockstepClock::GetTimeOfSample(int64 SampleIndex) const
+	{
+		// SampleIndex / (FrameRate * TemporalSampleCount) seconds, which is SampleIndex * Denominator ticks of a (Numerator * TemporalSampleCount) time scale
+		return FTouchRationalTime{ SampleIndex * FrameRate.Denominator, FrameRate.Numerator * TemporalSampleCount };
+	}
+}
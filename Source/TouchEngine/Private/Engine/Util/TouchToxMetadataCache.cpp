@@ -0,0 +1,248 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchToxMetadataCache.h"
+
+#include "ITouchEngineModule.h"
+#include "Logging.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Async/Async.h"
+#include "Engine/TouchLoadResults.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace UE::TouchEngine
+{
+	namespace Private
+	{
+		/** Increment when the format of the entries changes, to invalidate the existing entries */
+		constexpr int32 ToxMetadataCacheFormatVersion = 1;
+		/** Upper bound of the number of variables of an entry, to detect corrupted entries before allocating */
+		constexpr int32 MaxCachedVariables = 100000;
+		
+		static TAutoConsoleVariable<bool> CVarToxMetadataCacheEnabled(
+			TEXT("TouchEngine.ToxMetadataCache.Enabled"),
+			true,
+			TEXT("Whether the variables parsed from .tox files are saved in Saved/TouchEngine/ToxMetadataCache and reused across sessions, so the details panel can be populated without starting TouchEngine."));
+		
+		static TAutoConsoleVariable<bool> CVarToxMetadataCacheRevalidate(
+			TEXT("TouchEngine.ToxMetadataCache.Revalidate"),
+			true,
+			TEXT("Whether the .tox files found in the metadata cache are reloaded in the background to refresh the cached variables, in case the installed TouchDesigner version parses them differently."));
+
+		static FAutoConsoleCommand CmdClearToxMetadataCache(
+			TEXT("TouchEngine.ToxMetadataCache.Clear"),
+			TEXT("Deletes the variables parsed from .tox files saved in Saved/TouchEngine/ToxMetadataCache."),
+			FConsoleCommandDelegate::CreateStatic(&FTouchToxMetadataCache::Clear));
+		
+		static FString GetCacheDirectory()
+		{
+			return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("TouchEngine"), TEXT("ToxMetadataCache"));
+		}
+
+		/** Identifies the TouchEngine version parsing the .tox files. The API does not give the version of TouchEngine, so the plugin version and the library file are used instead */
+		static FString GetTouchEngineVersionKey()
+		{
+			const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TouchEngine"));
+			const ITouchEngineModule* Module = ITouchEngineModule::GetSafe();
+			const FString LibPath = Module ? Module->GetTouchEngineLibPath() : FString();
+			return FString::Printf(TEXT("%d|%s|%s|%lld"),
+				ToxMetadataCacheFormatVersion,
+				Plugin ? *Plugin->GetDescriptor().VersionName : TEXT(""),
+				*IFileManager::Get().GetTimeStamp(*LibPath).ToString(),
+				IFileManager::Get().FileSize(*LibPath));
+		}
+
+		/** Hashes the content of the .tox file, so this is meant to be called on a worker thread. Returns an empty string if the file cannot be read */
+		static FString GetEntryPath_AnyThread(const FString& AbsoluteToxPath, const FString& CacheDirectory, const FString& VersionKey)
+		{
+			const FMD5Hash FileHash = FMD5Hash::HashFile(*AbsoluteToxPath);
+			if (!FileHash.IsValid())
+			{
+				return FString();
+			}
+
+			FMD5 Md5;
+			Md5.Update(FileHash.GetBytes(), FileHash.GetSize());
+			const FTCHARToUTF8 VersionKeyUtf8(*VersionKey);
+			Md5.Update(reinterpret_cast<const uint8*>(VersionKeyUtf8.Get()), VersionKeyUtf8.Length());
+			FMD5Hash EntryHash;
+			EntryHash.Set(Md5);
+			return FPaths::Combine(CacheDirectory, FString::Printf(TEXT("%s_%s.bin"), *FPaths::GetBaseFilename(AbsoluteToxPath), *LexToString(EntryHash)));
+		}
+
+		/** Reads the entry of the given .tox file. Hashes the file, so this is meant to be called on a worker thread unless the result is needed right away */
+		static bool ReadEntry_AnyThread(const FString& AbsoluteToxPath, const FString& CacheDirectory, const FString& VersionKey, TArray<uint8>& OutData)
+		{
+			const FString EntryPath = GetEntryPath_AnyThread(AbsoluteToxPath, CacheDirectory, VersionKey);
+			return !EntryPath.IsEmpty() && FFileHelper::LoadFileToArray(OutData, *EntryPath, FILEREAD_Silent);
+		}
+
+		/** Serializes the variables of a successful load. Needs to run on the game thread as the variables may reference UObjects */
+		static TArray<uint8> SerializeLoadResult(const FTouchLoadResult& LoadResult)
+		{
+			check(LoadResult.IsSuccess());
+			TArray<FTouchEngineDynamicVariableStruct> Inputs = LoadResult.SuccessResult->Inputs;
+			TArray<FTouchEngineDynamicVariableStruct> Outputs = LoadResult.SuccessResult->Outputs;
+			
+			TArray<uint8> Data;
+			FMemoryWriter Writer(Data, true);
+			FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+			int32 FormatVersion = ToxMetadataCacheFormatVersion;
+			Ar << FormatVersion;
+			FTouchToxMetadataCache::SerializeVariables(Ar, Inputs);
+			FTouchToxMetadataCache::SerializeVariables(Ar, Outputs);
+			return Data;
+		}
+
+		static TOptional<FTouchLoadResult> DeserializeLoadResult(const TArray<uint8>& Data)
+		{
+			FMemoryReader Reader(Data, true);
+			FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+			int32 FormatVersion = INDEX_NONE;
+			Ar << FormatVersion;
+			if (FormatVersion != ToxMetadataCacheFormatVersion)
+			{
+				return {};
+			}
+			
+			TArray<FTouchEngineDynamicVariableStruct> Inputs;
+			TArray<FTouchEngineDynamicVariableStruct> Outputs;
+			FTouchToxMetadataCache::SerializeVariables(Ar, Inputs);
+			FTouchToxMetadataCache::SerializeVariables(Ar, Outputs);
+			if (Ar.IsError() || Reader.IsError())
+			{
+				return {};
+			}
+			return FTouchLoadResult::MakeSuccess(MoveTemp(Inputs), MoveTemp(Outputs));
+		}
+	}
+
+	TFuture<TOptional<FTouchLoadResult>> FTouchToxMetadataCache::Find_GameThread(const FString& AbsoluteToxPath)
+	{
+		check(IsInGameThread());
+		if (!IsEnabled())
+		{
+			return MakeFulfilledPromise<TOptional<FTouchLoadResult>>().GetFuture();
+		}
+
+		TPromise<TOptional<FTouchLoadResult>> Promise;
+		TFuture<TOptional<FTouchLoadResult>> Future = Promise.GetFuture();
+		Async(EAsyncExecution::ThreadPool, [AbsoluteToxPath, CacheDirectory = Private::GetCacheDirectory(), VersionKey = Private::GetTouchEngineVersionKey(), Promise = MoveTemp(Promise)]() mutable
+		{
+			TArray<uint8> Data;
+			const bool bFoundEntry = Private::ReadEntry_AnyThread(AbsoluteToxPath, CacheDirectory, VersionKey, Data);
+			
+			AsyncTask(ENamedThreads::GameThread, [AbsoluteToxPath, Promise = MoveTemp(Promise), Data = MoveTemp(Data), bFoundEntry]() mutable
+			{
+				TOptional<FTouchLoadResult> LoadResult = bFoundEntry ? Private::DeserializeLoadResult(Data) : TOptional<FTouchLoadResult>();
+				UE_CLOG(bFoundEntry && !LoadResult, LogTouchEngine, Warning, TEXT("The cached metadata of the tox file '%s' could not be read and will be reloaded"), *AbsoluteToxPath);
+				UE_CLOG(LoadResult.IsSet(), LogTouchEngine, Log, TEXT("Found the metadata of the tox file '%s' in the metadata cache"), *AbsoluteToxPath);
+				Promise.EmplaceValue(MoveTemp(LoadResult));
+			});
+		});
+		return Future;
+	}
+
+	TOptional<FTouchLoadResult> FTouchToxMetadataCache::FindSynchronous_GameThread(const FString& AbsoluteToxPath)
+	{
+		check(IsInGameThread());
+		TArray<uint8> Data;
+		if (!IsEnabled() || !Private::ReadEntry_AnyThread(AbsoluteToxPath, Private::GetCacheDirectory(), Private::GetTouchEngineVersionKey(), Data))
+		{
+			return {};
+		}
+		
+		TOptional<FTouchLoadResult> LoadResult = Private::DeserializeLoadResult(Data);
+		UE_CLOG(!LoadResult, LogTouchEngine, Warning, TEXT("The cached metadata of the tox file '%s' could not be read"), *AbsoluteToxPath);
+		return LoadResult;
+	}
+
+	void FTouchToxMetadataCache::Store_GameThread(const FString& AbsoluteToxPath, const FTouchLoadResult& LoadResult)
+	{
+		check(IsInGameThread());
+		if (!IsEnabled() || !LoadResult.IsSuccess())
+		{
+			return;
+		}
+		
+		Async(EAsyncExecution::ThreadPool, [AbsoluteToxPath, CacheDirectory = Private::GetCacheDirectory(), VersionKey = Private::GetTouchEngineVersionKey(), Data = Private::SerializeLoadResult(LoadResult)]()
+		{
+			const FString EntryPath = Private::GetEntryPath_AnyThread(AbsoluteToxPath, CacheDirectory, VersionKey);
+			if (!EntryPath.IsEmpty() && !FFileHelper::SaveArrayToFile(Data, *EntryPath))
+			{
+				UE_LOG(LogTouchEngine, Warning, TEXT("Unable to save the metadata of the tox file '%s' to '%s'"), *AbsoluteToxPath, *EntryPath);
+			}
+		});
+	}
+
+	bool FTouchToxMetadataCache::AreEqual_GameThread(const FTouchLoadResult& Lhs, const FTouchLoadResult& Rhs)
+	{
+		check(IsInGameThread());
+		if (!Lhs.IsSuccess() || !Rhs.IsSuccess())
+		{
+			return Lhs.IsSuccess() == Rhs.IsSuccess();
+		}
+		return Private::SerializeLoadResult(Lhs) == Private::SerializeLoadResult(Rhs);
+	}
+
+	void FTouchToxMetadataCache::SerializeVariables(FArchive& Ar, TArray<FTouchEngineDynamicVariableStruct>& Variables)
+	{
+		int32 NumVariables = Variables.Num();
+		Ar << NumVariables;
+		if (Ar.IsLoading())
+		{
+			if (NumVariables < 0 || NumVariables > Private::MaxCachedVariables)
+			{
+				Ar.SetError();
+				return;
+			}
+			Variables.SetNum(NumVariables);
+		}
+		
+		for (FTouchEngineDynamicVariableStruct& Variable : Variables)
+		{
+			Variable.Serialize(Ar);
+			Variable.SerializeMetadata(Ar);
+			if (Ar.IsError())
+			{
+				return;
+			}
+		}
+	}
+
+	void FTouchToxMetadataCache::Clear()
+	{
+		const FString CacheDirectory = Private::GetCacheDirectory();
+		UE_LOG(LogTouchEngine, Display, TEXT("Clearing the tox metadata cache in '%s'"), *CacheDirectory);
+		IFileManager::Get().DeleteDirectory(*CacheDirectory, false, true);
+	}
+
+	bool FTouchToxMetadataCache::IsEnabled()
+	{
+		return Private::CVarToxMetadataCacheEnabled.GetValueOnAnyThread();
+	}
+
+	bool FTouchToxMetadataCache::ShouldRevalidate()
+	{
+		return Private::CVarToxMetadataCacheRevalidate.GetValueOnAnyThread();
+	}
+}
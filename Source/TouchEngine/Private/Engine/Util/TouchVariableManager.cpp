@@ -14,6 +14,7 @@
 
 #include "Engine/Util/TouchVariableManager.h"
 
+#include <atomic>
 #include <string>
 
 #include "Logging.h"
@@ -22,17 +23,25 @@
 #include "Rendering/Exporting/TouchExportParams.h"
 
 #include "Engine/TEDebug.h"
+#include "Util/TouchEngineStatsGroup.h"
 #include "Util/TouchHelpers.h"
 #include "Engine/Texture.h"
 
 namespace UE::TouchEngine
 {
+	namespace Private
+	{
+		/** Starts at 1 so a default constructed FTouchLinkHandle never matches a registry */
+		static std::atomic<uint32> NextRegistryId{1};
+	}
+	
 	FTouchVariableManager::FTouchVariableManager(
 		TouchObject<TEInstance> TouchEngineInstance,
 		TSharedPtr<FTouchResourceProvider> ResourceProvider,
 		const TSharedPtr<FTouchErrorLog>& ErrorLog
 	)
-		: TouchEngineInstance(MoveTemp(TouchEngineInstance))
+		: RegistryId(Private::NextRegistryId++)
+		  , TouchEngineInstance(MoveTemp(TouchEngineInstance))
 		  , ResourceProvider(MoveTemp(ResourceProvider))
 		  , ErrorLog(ErrorLog)
 	{
@@ -62,58 +71,34 @@ namespace UE::TouchEngine
 		return ExistingTextureToBePooled;
 	}
 	
-	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutputSingleSample(const FString& Identifier)
+	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutputSingleSample(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		FTouchEngineCHOP Chop;
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputSingleSample)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputSingleSample)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			TouchObject<TEFloatBuffer> Buf;
 			const TEResult Result = TEInstanceLinkGetFloatBufferValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, Buf.take());
 			if (Result == TEResultSuccess && Buf != nullptr)
 			{
-				FTouchEngineCHOPChannel& Output = CHOPChannelOutputs.FindOrAdd(Identifier); //todo: to be reviewed, why a FTouchEngineCHOPChannel?
-
-				const int32 ChannelCount = TEFloatBufferGetChannelCount(Buf);
-				const int64 NumSamples = TEFloatBufferGetValueCount(Buf);
-				Chop.Channels.Reserve(ChannelCount);
-
-				double rate = TEFloatBufferGetRate(Buf);
-				if (!TEFloatBufferIsTimeDependent(Buf))
+				const FTouchCHOPView View(MoveTemp(Buf));
+				Chop.Channels.Reserve(View.GetNumChannels());
+				if (!View.IsTimeDependent())
 				{
-					const float* const* Channels = TEFloatBufferGetValues(Buf);
-					const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-					
-					// Use the channel data here
-					if (NumSamples > 0 && ChannelCount > 0)
-					{
-						for (int i = 0; i < ChannelCount; i++)
-						{
-							Chop.Channels.Add(FTouchEngineCHOPChannel {{Channels[i], static_cast<int>(NumSamples)}, ChannelNames[i]});
-						}
-					}
+					Chop = View.ToCHOP();
 				}
-				else //todo: to be reviewed
+				else if (View.GetNumSamples() > 0)
 				{
-					//length /= rate / MyFrameRate;
-					const float* const* Channels = TEFloatBufferGetValues(Buf);
-					const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-
-					// Use the channel data here
-					if (NumSamples > 0 && ChannelCount > 0)
+					// A time-dependent buffer holds all the samples since the last frame. The ones we do not return here can be retrieved by streaming the output
+					if (const TSharedRef<FTouchCHOPSampleRing>* Stream = CHOPOutputStreams.Find(Identifier))
 					{
-						Output.Values.Reserve(ChannelCount);
-
-						for (int32 i = 0; i < ChannelCount; i++)
-						{
-							Output.Values.Add(Channels[i][NumSamples - 1]);
-						}
-						Output.Name = ChannelNames[0];
+						(*Stream)->Push(View);
+					}
+					for (int32 i = 0; i < View.GetNumChannels(); i++)
+					{
+						Chop.Channels.Add(FTouchEngineCHOPChannel{{View.GetChannel(i).Last()}, View.GetChannelName(i)});
 					}
-					Chop.Channels.Add(Output);
 				}
 			}
 			else if (Result != TEResultSuccess)
@@ -122,52 +107,46 @@ namespace UE::TouchEngine
 			}
 		}
 
-		return FTouchEngineCHOP{};
+		return Chop;
+	}
+
+	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
+	{
+		return GetCHOPOutputView(Identifier, LinkHandle).ToCHOP();
 	}
 
-	FTouchEngineCHOP FTouchVariableManager::GetCHOPOutput(const FString& Identifier)
+	FTouchCHOPView FTouchVariableManager::GetCHOPOutputView(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputView)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			TouchObject<TEFloatBuffer> Buf = nullptr;
 			const TEResult Result = TEInstanceLinkGetFloatBufferValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, Buf.take());
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetFloatBufferValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result == TEResultSuccess)
 			{
-				FTouchEngineCHOP& Output = CHOPOutputs.FindOrAdd(Identifier);
-
-				const int32_t ChannelCount = TEFloatBufferGetChannelCount(Buf);
-				const uint32_t NumSamples = TEFloatBufferGetValueCount(Buf);
-				const float* const* Channels = TEFloatBufferGetValues(Buf);
-				const char* const* ChannelNames = TEFloatBufferGetChannelNames(Buf);
-				Output.Channels.Empty(ChannelCount);
-				
-				if (TEFloatBufferIsTimeDependent(Buf))
-				{
-				}
-
-				for (int i = 0; i < ChannelCount; i++)
+				FTouchCHOPView& Output = CHOPOutputs.FindOrAdd(Identifier);
+				Output = FTouchCHOPView(MoveTemp(Buf));
+				if (const TSharedRef<FTouchCHOPSampleRing>* Stream = CHOPOutputStreams.Find(Identifier))
 				{
-					Output.Channels.Add(FTouchEngineCHOPChannel{{Channels[i], static_cast<int>(NumSamples)},  ChannelNames[i]});
+					(*Stream)->Push(Output);
 				}
 				return Output;
 			}
 			else
 			{
-				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutput));
+				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkGetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetCHOPOutputView));
 			}
 		}
-		return FTouchEngineCHOP{};
+		return FTouchCHOPView{};
 	}
 
-	UTexture2D* FTouchVariableManager::GetTOPOutput(const FString& Identifier)
+	UTexture2D* FTouchVariableManager::GetTOPOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTOPOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTOPOutput)))
 		{
 			FScopeLock Lock(&TOPOutputsLock);
 
@@ -182,15 +161,13 @@ namespace UE::TouchEngine
 		return nullptr;
 	}
 
-	FTouchDATFull FTouchVariableManager::GetTableOutput(const FString& Identifier) const
+	FTouchDATFull FTouchVariableManager::GetTableOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle) const
 	{
 		FTouchDATFull DATFull;
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeStringData, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTableOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeStringData, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetTableOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			const TEResult Result = TEInstanceLinkGetTableValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, DATFull.TableData.take());
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetTableValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -204,29 +181,21 @@ namespace UE::TouchEngine
 
 	TArray<FString> FTouchVariableManager::GetCHOPChannelNames(const FString& Identifier) const
 	{
-		if (const FTouchEngineCHOP* FullChop = CHOPOutputs.Find(Identifier))
+		if (const FTouchCHOPView* FullChop = CHOPOutputs.Find(Identifier))
 		{
-			TArray<FString> RetVal;
-			RetVal.Reserve(FullChop->Channels.Num());
-			for (int32 i = 0; i < FullChop->Channels.Num(); i++)
-			{
-				RetVal.Add(FullChop->Channels[i].Name);
-			}
-			return RetVal;
+			return FullChop->GetChannelNames();
 		}
 
 		return TArray<FString>();
 	}
 
-	bool FTouchVariableManager::GetBooleanOutput(const FString& Identifier)
+	bool FTouchVariableManager::GetBooleanOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		bool c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetBooleanOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetBooleanOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			const TEResult Result = TEInstanceLinkGetBooleanValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetBooleanValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -238,15 +207,13 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	double FTouchVariableManager::GetDoubleOutput(const FString& Identifier)
+	double FTouchVariableManager::GetDoubleOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		double c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetDoubleOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetDoubleOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			const TEResult Result = TEInstanceLinkGetDoubleValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c, 1);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetDoubleValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -258,15 +225,13 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	int32_t FTouchVariableManager::GetIntegerOutput(const FString& Identifier)
+	int32_t FTouchVariableManager::GetIntegerOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		int32_t c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetIntegerOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetIntegerOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			const TEResult Result = TEInstanceLinkGetIntValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, &c, 1);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetIntValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -278,15 +243,13 @@ namespace UE::TouchEngine
 		return c;
 	}
 
-	TouchObject<TEString> FTouchVariableManager::GetStringOutput(const FString& Identifier)
+	TouchObject<TEString> FTouchVariableManager::GetStringOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TEString> c = {};
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeOutput, TELinkTypeString, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetStringOutput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeOutput, TELinkTypeString, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, GetStringOutput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
 			const TEResult Result = TEInstanceLinkGetStringValue(TouchEngineInstance, IdentifierAsCStr, TELinkValueCurrent, c.take());
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkGetStringValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -299,25 +262,22 @@ namespace UE::TouchEngine
 	}
 	
 
-	void FTouchVariableManager::SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel)
+	void FTouchVariableManager::SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInputSingleSample)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
-			TArray<const float*> DataPointers {CHOPChannel.Values.GetData()};
-			// DataPointers.Reserve(CHOPChannel.Values.Num());
-			// for (int i = 0; i < CHOPChannel.Values.Num(); i++)
-			// {
-			// 	DataPointers.Add(&CHOPChannel.Values[i]);
-			// }
-
-			TouchObject<TEFloatBuffer> Buf;
-			Buf.take(TEFloatBufferCreate(-1.f, CHOPChannel.Values.Num(), 1, nullptr));
+			// Each value is sent as a channel with a single sample, so each channel points directly into the contiguous array of values
+			FCHOPInputBufferPool& Pool = FindOrResetCHOPInputBufferPool(Identifier, {}, CHOPChannel.Values.Num(), 1);
+			Pool.DataPointers.Reset(CHOPChannel.Values.Num());
+			for (int32 i = 0; i < CHOPChannel.Values.Num(); i++)
+			{
+				Pool.DataPointers.Add(&CHOPChannel.Values[i]);
+			}
 
-			TEResult Result = TEFloatBufferSetValues(Buf, DataPointers.GetData(), 1);
+			const TouchObject<TEFloatBuffer> Buf = AcquireCHOPInputBuffer(Pool);
+			TEResult Result = TEFloatBufferSetValues(Buf, Pool.DataPointers.GetData(), 1);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferSetValues[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
 			{
@@ -336,52 +296,32 @@ namespace UE::TouchEngine
 
 	}
 
-	void FTouchVariableManager::SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP)
+	void FTouchVariableManager::SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-			
-			int32 Capacity = CHOP.Channels.IsEmpty() ? 0 : CHOP.Channels[0].Values.Num();
-
-			bool bAreAllChannelNamesEmpty = true;
-			TArray<std::string> ChannelNamesANSI; // Store as temporary string to keep a reference until the buffer is created
-			TArray<const char*> ChannelNames;
-			TArray<const float*> DataPointers;
-			ChannelNamesANSI.Reserve(CHOP.Channels.Num());
-			ChannelNames.Reserve(CHOP.Channels.Num());
-			DataPointers.Reserve(CHOP.Channels.Num());
-			
+			const int32 Capacity = CHOP.Channels.IsEmpty() ? 0 : CHOP.Channels[0].Values.Num();
 			for (int i = 0; i < CHOP.Channels.Num(); i++)
 			{
 				if (CHOP.Channels[i].Values.Num() != Capacity) //CHOP is not valid
 				{
-					Capacity = -1;
-					break;
+					ErrorLog->AddError(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput),
+						TEXT("The given CHOP is not valid."));
+					return;
 				}
-				const FString& ChannelName = CHOP.Channels[i].Name;
-				bAreAllChannelNamesEmpty &= ChannelName.IsEmpty();
-			
-				auto ChannelNameANSI = StringCast<ANSICHAR>(*ChannelName);
-				std::string ChannelNameString(ChannelNameANSI.Get());
-
-				const int32 Index = ChannelNamesANSI.Emplace(ChannelNameString);
-				ChannelNames.Emplace(ChannelName.IsEmpty() ? nullptr : ChannelNamesANSI[Index].c_str());
-
-				DataPointers.Add(CHOP.Channels[i].Values.GetData());
 			}
 
-			if (Capacity == -1)
+			FCHOPInputBufferPool& Pool = FindOrResetCHOPInputBufferPool(Identifier, CHOP.Channels, CHOP.Channels.Num(), Capacity);
+			Pool.DataPointers.Reset(CHOP.Channels.Num());
+			for (const FTouchEngineCHOPChannel& Channel : CHOP.Channels)
 			{
-				ErrorLog->AddError(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetCHOPInput),
-						TEXT("The given CHOP is not valid."));
-				return;
+				Pool.DataPointers.Add(Channel.Values.GetData());
 			}
 
-			const TouchObject<TEFloatBuffer> Buffer = TouchObject<TEFloatBuffer>::make_take(TEFloatBufferCreate(-1.f, CHOP.Channels.Num(), Capacity, bAreAllChannelNamesEmpty ? nullptr : ChannelNames.GetData()));
-			TEResult Result = TEFloatBufferSetValues(Buffer, DataPointers.GetData(), Capacity);
+			const TouchObject<TEFloatBuffer> Buffer = AcquireCHOPInputBuffer(Pool);
+			TEResult Result = TEFloatBufferSetValues(Buffer, Pool.DataPointers.GetData(), Capacity);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEFloatBufferSetValues[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
 			{
@@ -399,14 +339,103 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetTOPInput(const FString& Identifier, UTexture* Texture, const FTouchEngineInputFrameData& FrameData)
+	TSharedRef<FTouchCHOPSampleRing> FTouchVariableManager::GetOrCreateCHOPOutputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate)
+	{
+		check(IsInGameThread());
+		if (const TSharedRef<FTouchCHOPSampleRing>* Stream = CHOPOutputStreams.Find(Identifier))
+		{
+			return *Stream;
+		}
+		return CHOPOutputStreams.Add(Identifier, MakeShared<FTouchCHOPSampleRing>(NumChannels, CapacityInSamples, SampleRate));
+	}
+
+	TSharedRef<FTouchCHOPSampleRing> FTouchVariableManager::GetOrCreateCHOPInputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate)
+	{
+		check(IsInGameThread());
+		if (const FCHOPInputStream* Stream = CHOPInputStreams.Find(Identifier))
+		{
+			return Stream->Ring;
+		}
+		return CHOPInputStreams.Add(Identifier, FCHOPInputStream{MakeShared<FTouchCHOPSampleRing>(NumChannels, CapacityInSamples, SampleRate)}).Ring;
+	}
+
+	void FTouchVariableManager::BindCHOPOutputStream_GameThread(const FString& Identifier, const TSharedRef<FTouchCHOPSampleRing>& Ring)
+	{
+		check(IsInGameThread());
+		CHOPOutputStreams.Add(Identifier, Ring);
+	}
+
+	void FTouchVariableManager::BindCHOPInputStream_GameThread(const FString& Identifier, const TSharedRef<FTouchCHOPSampleRing>& Ring)
+	{
+		check(IsInGameThread());
+		const FCHOPInputStream* Stream = CHOPInputStreams.Find(Identifier);
+		if (!Stream || Stream->Ring != Ring) // we keep the time of the next sample if the ring is already bound
+		{
+			CHOPInputStreams.Add(Identifier, FCHOPInputStream{Ring});
+		}
+	}
+
+	void FTouchVariableManager::SendCHOPInputStreams_GameThread()
+	{
+		check(IsInGameThread());
+		for (TPair<FString, FCHOPInputStream>& Pair : CHOPInputStreams)
+		{
+			const FString& Identifier = Pair.Key;
+			FCHOPInputStream& Stream = Pair.Value;
+			const int32 NumChannels = Stream.Ring->GetNumChannels();
+			const int32 NumSamples = Stream.Ring->NumAvailable();
+			if (NumSamples == 0)
+			{
+				continue;
+			}
+			
+			TouchObject<TELinkInfo> LinkInfo;
+			const char* IdentifierAsCStr = nullptr;
+			if (!GetLinkInfo(Identifier, &Stream.LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeFloatBuffer, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SendCHOPInputStreams_GameThread)))
+			{
+				continue;
+			}
+
+			// The ring is interleaved but TouchEngine expects one array per channel
+			Stream.InterleavedSamples.SetNumUninitialized(NumSamples * NumChannels, false);
+			const int32 NumPopped = Stream.Ring->Pop(Stream.InterleavedSamples);
+			Stream.ChannelSamples.SetNumUninitialized(NumPopped * NumChannels, false);
+			Stream.DataPointers.Reset(NumChannels);
+			for (int32 ChannelIndex = 0; ChannelIndex < NumChannels; ++ChannelIndex)
+			{
+				float* Channel = &Stream.ChannelSamples[ChannelIndex * NumPopped];
+				for (int32 SampleIndex = 0; SampleIndex < NumPopped; ++SampleIndex)
+				{
+					Channel[SampleIndex] = Stream.InterleavedSamples[SampleIndex * NumChannels + ChannelIndex];
+				}
+				Stream.DataPointers.Add(Channel);
+			}
+
+			INC_DWORD_STAT(STAT_TE_CHOPInput_NbFloatBuffersCreated);
+			const TouchObject<TEFloatBuffer> Buffer = TouchObject<TEFloatBuffer>::make_take(TEFloatBufferCreateTimeDependent(Stream.Ring->GetSampleRate(), NumChannels, NumPopped, nullptr));
+			TEFloatBufferSetStartTime(Buffer, Stream.NextSampleTime);
+			TEResult Result = TEFloatBufferSetValues(Buffer, Stream.DataPointers.GetData(), NumPopped);
+			if (Result == TEResultSuccess)
+			{
+				Stream.NextSampleTime += NumPopped;
+				Result = TEInstanceLinkAddFloatBuffer(TouchEngineInstance, IdentifierAsCStr, Buffer);
+				UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkAddFloatBuffer[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
+			}
+			if (Result != TEResultSuccess)
+			{
+				ErrorLog->AddResult(FTouchErrorLog::EErrorType::TEInstanceLinkSetValueError, Result, Identifier, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SendCHOPInputStreams_GameThread),
+					TEXT("Unable to append streamed samples"));
+			}
+		}
+	}
+
+	void FTouchVariableManager::SetTOPInput(const FString& Identifier, UTexture* Texture, const FTouchEngineInputFrameData& FrameData, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTOPInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeTexture, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTOPInput)))
 		{
 			// Fast path
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
 			if (!Texture)
 			{
 				const TEResult Result = TEInstanceLinkSetTextureValue(TouchEngineInstance, IdentifierAsCStr, Texture, ResourceProvider->GetContext());
@@ -446,14 +475,12 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetBooleanInput(const FString& Identifier, const bool& Op)
+	void FTouchVariableManager::SetBooleanInput(const FString& Identifier, const bool& Op, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetBooleanInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeBoolean, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetBooleanInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-
 			const TEResult Result = TEInstanceLinkSetBooleanValue(TouchEngineInstance, IdentifierAsCStr, Op);
 			UE_LOG(LogTouchEngineTECalls, Log, TEXT("  TEInstanceLinkSetBooleanValue[%s]  for '%s' => %s"), *GetCurrentThreadStr(), *Identifier, *TEResultToString(Result));
 			if (Result != TEResultSuccess)
@@ -463,13 +490,12 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetDoubleInput(const FString& Identifier, const TArray<double>& Op)
+	void FTouchVariableManager::SetDoubleInput(const FString& Identifier, TArrayView<const double> Op, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetDoubleInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeDouble, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetDoubleInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
 			TEResult Result;
 			if (Op.Num() == LinkInfo->count)
 			{
@@ -499,14 +525,12 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetIntegerInput(const FString& Identifier, const TArray<int32_t>& Op)
+	void FTouchVariableManager::SetIntegerInput(const FString& Identifier, TArrayView<const int32_t> Op, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetIntegerInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, TELinkTypeInt, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetIntegerInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
-
 			TEResult Result;
 			if (Op.Num() == LinkInfo->count)
 			{
@@ -536,13 +560,12 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetStringInput(const FString& Identifier, const char*& Op)
+	void FTouchVariableManager::SetStringInput(const FString& Identifier, const char*& Op, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetStringInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetStringInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
 			if (LinkInfo->type == TELinkTypeString)
 			{
 				const TEResult Result = TEInstanceLinkSetStringValue(TouchEngineInstance, IdentifierAsCStr, Op);
@@ -580,13 +603,12 @@ namespace UE::TouchEngine
 		}
 	}
 
-	void FTouchVariableManager::SetTableInput(const FString& Identifier, const FTouchDATFull& Op)
+	void FTouchVariableManager::SetTableInput(const FString& Identifier, const FTouchDATFull& Op, FTouchLinkHandle* LinkHandle)
 	{
 		TouchObject<TELinkInfo> LinkInfo;
-		if (GetLinkInfo(Identifier, LinkInfo, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTableInput)))
+		const char* IdentifierAsCStr = nullptr;
+		if (GetLinkInfo(Identifier, LinkHandle, LinkInfo, IdentifierAsCStr, TEScopeInput, GET_FUNCTION_NAME_CHECKED(FTouchVariableManager, SetTableInput)))
 		{
-			const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-			const char* IdentifierAsCStr = AnsiString.Get();
 			if (LinkInfo->type == TELinkTypeString)
 			{
 				const char* String = TETableGetStringValue(Op.TableData, 0, 0);
@@ -616,18 +638,45 @@ namespace UE::TouchEngine
 	}
 	
 
-	void FTouchVariableManager::SetFrameLastUpdatedForParameter(const FString& Identifier, int64 FrameID)
+	void FTouchVariableManager::RecordOutputValueChanged_AnyThread(const FTouchLinkHandle& LinkHandle, int64 FrameID)
 	{
-		LastFrameParameterUpdated.Add(Identifier, FrameID);
+		check(LinkHandle.RegistryId == RegistryId);
+		FScopeLock Lock(&LinkRegistryLock);
+		if (FrameID >= 0)
+		{
+			LinkRegistry[LinkHandle.Index]->FrameLastUpdated = FrameID;
+		}
+		// The value changed even if it happened outside of a cook, so it still needs to be fetched
+		if (ChangedOutputs.Num() <= LinkHandle.Index)
+		{
+			ChangedOutputs.Add(false, LinkHandle.Index + 1 - ChangedOutputs.Num());
+		}
+		ChangedOutputs[LinkHandle.Index] = true;
 	}
 
-	int64 FTouchVariableManager::GetFrameLastUpdatedForParameter(const FString& Identifier)
+	int64 FTouchVariableManager::GetFrameLastUpdatedForParameter(const FString& Identifier, FTouchLinkHandle* LinkHandle) const
 	{
-		return LastFrameParameterUpdated.FindOrAdd(Identifier, -1);
+		const FTouchLinkHandle Handle = LinkHandle ? ResolveLinkHandle(Identifier, *LinkHandle) : FindOrAddLinkHandle(Identifier);
+		FScopeLock Lock(&LinkRegistryLock);
+		return LinkRegistry[Handle.Index]->FrameLastUpdated;
+	}
+
+	void FTouchVariableManager::TakeChangedOutputs_GameThread(TBitArray<>& OutChangedLinks)
+	{
+		check(IsInGameThread());
+		FScopeLock Lock(&LinkRegistryLock);
+		// Swapping keeps the allocations of both bit arrays, so nothing is allocated once they have grown to the number of links
+		Swap(OutChangedLinks, ChangedOutputs);
+		ChangedOutputs.Init(false, OutChangedLinks.Num());
 	}
 
 	void FTouchVariableManager::ClearSavedData()
 	{
+		CHOPOutputs.Empty(); // release the TEFloatBuffers we were holding onto
+		CHOPInputBufferPools.Empty();
+		CHOPOutputStreams.Empty();
+		CHOPInputStreams.Empty();
+		
 		TArray<FName> InputKeys;
 		{
 			FScopeLock ILock(&TOPInputsLock);
@@ -643,12 +692,169 @@ namespace UE::TouchEngine
 		}
 	}
 
-	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const
+	FTouchVariableManager::FCHOPInputBufferPool& FTouchVariableManager::FindOrResetCHOPInputBufferPool(const FString& Identifier, TArrayView<const FTouchEngineCHOPChannel> Channels, int32 NumChannels, int32 Capacity)
+	{
+		uint32 ChannelNamesHash = 0;
+		bool bAreAllChannelNamesEmpty = true;
+		for (const FTouchEngineCHOPChannel& Channel : Channels)
+		{
+			ChannelNamesHash = HashCombine(ChannelNamesHash, GetTypeHash(Channel.Name));
+			bAreAllChannelNamesEmpty &= Channel.Name.IsEmpty();
+		}
+
+		FCHOPInputBufferPool& Pool = CHOPInputBufferPools.FindOrAdd(Identifier);
+		if (Pool.NumChannels == NumChannels && Pool.Capacity == Capacity && Pool.ChannelNamesHash == ChannelNamesHash)
+		{
+			return Pool;
+		}
+
+		// The layout changed, so the buffers we created cannot be reused.
+		Pool.NumChannels = NumChannels;
+		Pool.Capacity = Capacity;
+		Pool.ChannelNamesHash = ChannelNamesHash;
+		Pool.Buffers.Reset();
+		Pool.NextBufferIndex = 0;
+		Pool.ChannelNamesANSI.Reset();
+		Pool.ChannelNames.Reset();
+		if (!bAreAllChannelNamesEmpty)
+		{
+			Pool.ChannelNamesANSI.Reserve(Channels.Num()); // Reserved up front so the pointers stored in ChannelNames stay valid
+			for (const FTouchEngineCHOPChannel& Channel : Channels)
+			{
+				const std::string& ChannelNameANSI = Pool.ChannelNamesANSI.Emplace_GetRef(StringCast<ANSICHAR>(*Channel.Name).Get());
+				Pool.ChannelNames.Add(Channel.Name.IsEmpty() ? nullptr : ChannelNameANSI.c_str());
+			}
+		}
+		return Pool;
+	}
+
+	TouchObject<TEFloatBuffer> FTouchVariableManager::AcquireCHOPInputBuffer(FCHOPInputBufferPool& Pool)
+	{
+		if (Pool.Buffers.Num() < CHOP_INPUT_BUFFERS_PER_LINK)
+		{
+			INC_DWORD_STAT(STAT_TE_CHOPInput_NbFloatBuffersCreated);
+			return Pool.Buffers.Add_GetRef(TouchObject<TEFloatBuffer>::make_take(TEFloatBufferCreate(-1.f, Pool.NumChannels, Pool.Capacity, Pool.ChannelNames.IsEmpty() ? nullptr : Pool.ChannelNames.GetData())));
+		}
+
+		const TouchObject<TEFloatBuffer>& Buffer = Pool.Buffers[Pool.NextBufferIndex];
+		Pool.NextBufferIndex = (Pool.NextBufferIndex + 1) % Pool.Buffers.Num();
+		return Buffer;
+	}
+
+	void FTouchVariableManager::RegisterLinks_GameThread(const TArray<FTouchEngineDynamicVariableStruct>& Variables)
 	{
 		check(IsInGameThread());
-		const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-		const char* IdentifierAsCStr = AnsiString.Get();
+		for (const FTouchEngineDynamicVariableStruct& Variable : Variables)
+		{
+			Variable.LinkHandle = FindOrAddLinkHandle(Variable.VarIdentifier);
+			
+			TouchObject<TELinkInfo> LinkInfo;
+			const char* IdentifierAsCStr;
+			const TEResult Result = ResolveLinkInfo(Variable.LinkHandle.Index, LinkInfo, IdentifierAsCStr);
+			if (Result == TEResultSuccess && LinkInfo->scope == TEScopeOutput)
+			{
+				// We might not receive a value change for outputs which never change, so we make sure they are all fetched after the first cook
+				RecordOutputValueChanged_AnyThread(Variable.LinkHandle, -1);
+			}
+		}
+	}
+
+	FTouchLinkHandle FTouchVariableManager::FindOrAddLinkHandle(const FString& Identifier) const
+	{
+		// The conversion happens in an inline buffer, so this only allocates for identifiers longer than the buffer
+		const auto AnsiIdentifier = StringCast<ANSICHAR>(*Identifier);
+		return FindOrAddLinkHandle_AnyThread(AnsiIdentifier.Get());
+	}
+
+	FTouchLinkHandle FTouchVariableManager::FindOrAddLinkHandle_AnyThread(const char* Identifier) const
+	{
+		const uint32 IdentifierHash = FCrc::StrCrc32(Identifier);
+		
+		FScopeLock Lock(&LinkRegistryLock);
+		int32 LinkIndex = FindLinkIndex(Identifier, IdentifierHash);
+		if (LinkIndex == INDEX_NONE)
+		{
+			TUniquePtr<FLinkRegistryEntry> Entry = MakeUnique<FLinkRegistryEntry>();
+			Entry->IdentifierANSI = Identifier;
+			Entry->Identifier = ANSI_TO_TCHAR(Identifier);
+			LinkIndex = LinkRegistry.Add(MoveTemp(Entry));
+			LinkIndicesByHash.Add(IdentifierHash, LinkIndex);
+		}
+		return FTouchLinkHandle{RegistryId, LinkIndex};
+	}
+
+	FTouchLinkHandle FTouchVariableManager::ResolveLinkHandle(const FString& Identifier, FTouchLinkHandle& CachedHandle) const
+	{
+		if (CachedHandle.RegistryId != RegistryId)
+		{
+			CachedHandle = FindOrAddLinkHandle(Identifier);
+		}
+		return CachedHandle;
+	}
+
+	const FString& FTouchVariableManager::GetLinkIdentifier(const FTouchLinkHandle& LinkHandle) const
+	{
+		check(LinkHandle.RegistryId == RegistryId);
+		FScopeLock Lock(&LinkRegistryLock);
+		return LinkRegistry[LinkHandle.Index]->Identifier; // Entries are heap allocated and never removed, so the reference stays valid after unlocking
+	}
+
+	TEResult FTouchVariableManager::GetCachedLinkInfo_AnyThread(const FTouchLinkHandle& LinkHandle, TouchObject<TELinkInfo>& LinkInfo) const
+	{
+		check(LinkHandle.RegistryId == RegistryId);
+		const char* IdentifierAsCStr;
+		return ResolveLinkInfo(LinkHandle.Index, LinkInfo, IdentifierAsCStr);
+	}
+
+	void FTouchVariableManager::InvalidateLinkInfo_AnyThread(const FTouchLinkHandle& LinkHandle)
+	{
+		check(LinkHandle.RegistryId == RegistryId);
+		FScopeLock Lock(&LinkRegistryLock);
+		LinkRegistry[LinkHandle.Index]->bNeedsRefresh = true;
+	}
+
+	int32 FTouchVariableManager::FindLinkIndex(const char* Identifier, uint32 IdentifierHash) const
+	{
+		for (TMultiMap<uint32, int32>::TConstKeyIterator It(LinkIndicesByHash, IdentifierHash); It; ++It)
+		{
+			if (FCStringAnsi::Strcmp(LinkRegistry[It.Value()]->IdentifierANSI.c_str(), Identifier) == 0)
+			{
+				return It.Value();
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	TEResult FTouchVariableManager::ResolveLinkInfo(int32 LinkIndex, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr) const
+	{
+		FScopeLock Lock(&LinkRegistryLock);
+		FLinkRegistryEntry& Entry = *LinkRegistry[LinkIndex]; // Entries are heap allocated and never removed, so the reference stays valid after unlocking
+		IdentifierAsCStr = Entry.IdentifierANSI.c_str();
+		if (!Entry.bNeedsRefresh)
+		{
+			LinkInfo = Entry.LinkInfo;
+			return Entry.LinkInfoResult;
+		}
+		
+		// We do not call TouchEngine while holding the lock as TouchEngine might be calling InvalidateLinkInfo_AnyThread from its own thread at the same time.
+		// If the link is invalidated while we are querying it, bNeedsRefresh will be set back to true and the info will be queried again next time.
+		Entry.bNeedsRefresh = false;
+		Lock.Unlock();
+		
 		const TEResult Result = TEInstanceLinkGetInfo(TouchEngineInstance, IdentifierAsCStr, LinkInfo.take());
+		UE_LOG(LogTouchEngineTECalls, Verbose, TEXT("  TEInstanceLinkGetInfo[%s]  for '%hs' => %s"), *GetCurrentThreadStr(), IdentifierAsCStr, *TEResultToString(Result));
+		
+		FScopeLock StoreLock(&LinkRegistryLock);
+		Entry.LinkInfoResult = Result;
+		Entry.LinkInfo = LinkInfo;
+		return Result;
+	}
+
+	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, FTouchLinkHandle* LinkHandle, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const
+	{
+		check(IsInGameThread());
+		const FTouchLinkHandle Handle = LinkHandle ? ResolveLinkHandle(Identifier, *LinkHandle) : FindOrAddLinkHandle(Identifier);
+		const TEResult Result = ResolveLinkInfo(Handle.Index, LinkInfo, IdentifierAsCStr);
 		if (Result == TEResultSuccess && LinkInfo->scope == ExpectedScope && LinkInfo->type == ExpectedType)
 		{
 			return true;
@@ -668,12 +874,11 @@ namespace UE::TouchEngine
 		return false;
 	}
 
-	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const
+	bool FTouchVariableManager::GetLinkInfo(const FString& Identifier, FTouchLinkHandle* LinkHandle, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr, TEScope ExpectedScope, const FName& FunctionName) const
 	{
 		check(IsInGameThread());
-		const auto AnsiString = StringCast<ANSICHAR>(*Identifier);
-		const char* IdentifierAsCStr = AnsiString.Get();
-		const TEResult Result = TEInstanceLinkGetInfo(TouchEngineInstance, IdentifierAsCStr, LinkInfo.take());
+		const FTouchLinkHandle Handle = LinkHandle ? ResolveLinkHandle(Identifier, *LinkHandle) : FindOrAddLinkHandle(Identifier);
+		const TEResult Result = ResolveLinkInfo(Handle.Index, LinkInfo, IdentifierAsCStr);
 		if (Result == TEResultSuccess && LinkInfo->scope == ExpectedScope)
 		{
 			return true;
@@ -53,8 +53,15 @@ namespace UE::TouchEngine
 
 	TFuture<FExportedTouchTexture::FOnTouchReleaseTexture> FExportedTouchTexture::Release()
 	{
+		const bool bWasSharedWithTouchEngine = TouchRepresentation.get() != nullptr;
 		TouchRepresentation.reset();
 		RHIOfTextureToCopy.SafeRelease();
+
+		if (!bWasSharedWithTouchEngine)
+		{
+			// Without a TouchEngine texture (like with the NullRHI), there is no release event to wait for
+			OnTouchTextureUseUpdate(TEObjectEventRelease);
+		}
 		
 		if (!bIsInUseByTouchEngine && bReceivedReleaseEvent)
 		{
@@ -17,12 +17,14 @@
 #include "Logging.h"
 #include "Rendering/Importing/ITouchImportTexture.h"
 #include "Rendering/TouchResourceProvider.h"
+#include "RenderUtils.h"
 
 #include "Engine/Util/TouchFrameCooker.h"
 #include "Tasks/Task.h"
 #include "UObject/UObjectGlobals.h"
 #include "UObject/Package.h"
 #include "Util/TouchEngineStatsGroup.h"
+#include "Util/TouchEngineTrace.h"
 #include "Util/TouchHelpers.h"
 
 namespace UE::TouchEngine
@@ -47,9 +49,12 @@ namespace UE::TouchEngine
 		}
 		{
 			FScopeLock PoolLock(&TexturePoolMutex);
-			for (FImportedTexturePoolData& Data : TexturePool)
+			for (TPair<FTexturePoolKey, FTexturePoolBucket>& Bucket : TexturePool)
 			{
-				TexturesToCleanUp.Add(Data.UETexture);
+				while (!Bucket.Value.Textures.IsEmpty())
+				{
+					TexturesToCleanUp.Add(Bucket.Value.Textures.PopFront().UETexture);
+				}
 			}
 		}
 
@@ -155,24 +160,66 @@ namespace UE::TouchEngine
 	void FTouchTextureImporter::TexturePoolMaintenance(const FTouchEngineInputFrameData& FrameData)
 	{
 		FScopeLock PoolLock(&TexturePoolMutex);
-		while (TexturePool.Num() > PoolSize)
+		while (PooledTexturesSizeInBytes > PoolBudgetInBytes)
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[0]; // we would remove from the front as they have been here the longest
-			if (IsValid(TextureData.UETexture))
+			// We evict from the least recently used bucket, skipping the ones which only hold textures added this frame as they might still be in use
+			FTexturePoolBucket* LeastRecentlyUsedBucket = nullptr;
+			for (TPair<FTexturePoolKey, FTexturePoolBucket>& Bucket : TexturePool)
 			{
-				if (TextureData.PooledFrameID == FrameData.FrameID)
+				if (!Bucket.Value.Textures.IsEmpty() && Bucket.Value.Textures.Front().PooledFrameID != FrameData.FrameID
+					&& (!LeastRecentlyUsedBucket || Bucket.Value.LastUsed < LeastRecentlyUsedBucket->LastUsed))
 				{
-					break; //if we reach a texture added this frame, we know the next textures will also have been added this frame so we stop removing from the pool
+					LeastRecentlyUsedBucket = &Bucket.Value;
 				}
-				// as we might create a lot of textures and the GC might take some time to kick in, we expedite some of the cleaning
-				TextureData.UETexture->RemoveFromRoot();
-				TextureData.UETexture->TextureReference.TextureReferenceRHI.SafeRelease();
-				TextureData.UETexture->ReleaseResource(); 
-				TextureData.UETexture->ConditionalBeginDestroy();
 			}
-			TexturePool.RemoveAt(0);
+			if (!LeastRecentlyUsedBucket)
+			{
+				break; // all the remaining textures have been added this frame
+			}
+			EvictOldestTexture(*LeastRecentlyUsedBucket);
+		}
+		UpdateTexturePoolStats();
+	}
+
+	void FTouchTextureImporter::AddTextureToPool(UTexture2D* Texture, int64 FrameID)
+	{
+		// The description is cached when the texture is pooled, from the platform data we created the texture with, so finding a match later on does not need to query the RHI
+		const FTexturePoolKey Key{static_cast<uint32>(Texture->GetSizeX()), static_cast<uint32>(Texture->GetSizeY()), Texture->GetPixelFormat(), static_cast<bool>(Texture->SRGB)};
+		FTexturePoolBucket& Bucket = TexturePool.FindOrAdd(Key);
+		if (Bucket.TextureSizeInBytes == 0)
+		{
+			Bucket.TextureSizeInBytes = CalcTextureSize(Key.SizeX, Key.SizeY, Key.PixelFormat, 1);
+		}
+		if (Bucket.Textures.IsFull())
+		{
+			Bucket.Textures.Reserve(Bucket.Textures.Capacity() * 2);
+		}
+		Bucket.Textures.PushBack({FrameID, Texture});
+		Bucket.LastUsed = ++TexturePoolUseCounter;
+		++NumPooledTextures;
+		PooledTexturesSizeInBytes += Bucket.TextureSizeInBytes;
+	}
+
+	void FTouchTextureImporter::EvictOldestTexture(FTexturePoolBucket& Bucket)
+	{
+		const FImportedTexturePoolData TextureData = Bucket.Textures.PopFront(); // we remove from the front as they have been here the longest
+		--NumPooledTextures;
+		PooledTexturesSizeInBytes -= Bucket.TextureSizeInBytes;
+		if (IsValid(TextureData.UETexture))
+		{
+			// as we might create a lot of textures and the GC might take some time to kick in, we expedite some of the cleaning
+			TextureData.UETexture->RemoveFromRoot();
+			TextureData.UETexture->TextureReference.TextureReferenceRHI.SafeRelease();
+			TextureData.UETexture->ReleaseResource(); 
+			TextureData.UETexture->ConditionalBeginDestroy();
 		}
-		SET_DWORD_STAT(STAT_TE_ImportedTexturePool_NbTexturesPool, TexturePool.Num())
+		INC_DWORD_STAT(STAT_TE_ImportedTexturePool_NbEvictions);
+	}
+
+	void FTouchTextureImporter::UpdateTexturePoolStats() const
+	{
+		SET_DWORD_STAT(STAT_TE_ImportedTexturePool_NbTexturesPool, NumPooledTextures)
+		SET_MEMORY_STAT(STAT_TE_ImportedTexturePool_Memory, PooledTexturesSizeInBytes)
 	}
 
 	bool FTouchTextureImporter::RemoveUTextureFromPool(UTexture2D* Texture)
@@ -211,6 +258,8 @@ namespace UE::TouchEngine
 		}
 		
 		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.1 [AT] Link Texture Import"), STAT_TE_III_A_1, STATGROUP_TouchEngine);
+		CSV_SCOPED_TIMING_STAT(TouchEngine, LinkTextureImport);
+		TRACE_TOUCHENGINE_COOK_STAGE(TextureImport, LinkParams.FrameData);
 		// At this point, we are neither on the GameThread nor on the RenderThread, we are on a parallel thread.
 		// A UTexture2D can be created on any thread but the call to UTexture2D::UpdateResource need to be on GameThread.
 		// As we are creating the texture here, we use an FTaskTagScope to allow us to call UTexture2D::UpdateResource from this thread.
@@ -254,6 +303,8 @@ namespace UE::TouchEngine
 			if (PlatformTexture && UEDestinationTextureRHI)
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.A.3 [RT] Link Texture Import - CopyRHI"), STAT_TE_III_A_3, STATGROUP_TouchEngine);
+				CSV_SCOPED_TIMING_STAT(TouchEngine, LinkTextureImportCopyRHI);
+				TRACE_TOUCHENGINE_COOK_STAGE(RenderCopy, LinkParams.FrameData);
 				// 2. We create a destination UTexture RHI if we don't have one already
 				const FTouchCopyTextureArgs CopyArgs { LinkParams, RHICmdList, UEDestinationTextureRHI};
 				ThisPin->CopyNativeToUnreal_RenderThread(PlatformTexture, CopyArgs);
@@ -283,7 +334,7 @@ namespace UE::TouchEngine
 				if (PreviousTextureToBePooled->IsRooted()) // if the texture is not rooted, we have been asked to remove it from the set, see RemoveUTextureFromPool
 				{
 					FScopeLock PoolLock(&ThisPin->TexturePoolMutex);
-					ThisPin->TexturePool.Add({LinkParams.FrameData.FrameID, PreviousTextureToBePooled});
+					ThisPin->AddTextureToPool(PreviousTextureToBePooled, LinkParams.FrameData.FrameID);
 				}
 			}
 			else
@@ -346,22 +397,52 @@ namespace UE::TouchEngine
 		UTexture2D* PooledTexture = nullptr;
 		
 		FScopeLock PoolLock(&TexturePoolMutex);
-		for (int i = 0; i < TexturePool.Num(); ++i)
+		if (FTexturePoolBucket* Bucket = TexturePool.Find({TETextureMetadata.SizeX, TETextureMetadata.SizeY, TETextureMetadata.PixelFormat, TETextureMetadata.IsSRGB}))
 		{
-			FImportedTexturePoolData& TextureData = TexturePool[i];
-			if (TextureData.PooledFrameID >= FrameData.FrameID || !IsValid(TextureData.UETexture))
-			{
-				// if the texture was pooled this frame, we do not return it as it could still be in use
-				continue;
-			}
-			if (CanCopyIntoUTexture(TETextureMetadata, TextureData.UETexture))
+			// Only the front of the bucket is ever taken, so every step is O(1). Each texture is looked at once at most
+			int32 NumTexturesToVisit = Bucket->Textures.Num();
+			while (!PooledTexture && NumTexturesToVisit-- > 0 && !Bucket->Textures.IsEmpty())
 			{
+				const FImportedTexturePoolData& TextureData = Bucket->Textures.Front();
+				if (TextureData.PooledFrameID >= FrameData.FrameID)
+				{
+					// textures are mostly pooled in order, so the next ones were most likely pooled this frame too, and we do not return them as they could still be in use
+					break;
+				}
+				if (!IsValid(TextureData.UETexture))
+				{
+					// the texture was destroyed while in the pool, this entry is of no use anymore
+					Bucket->Textures.PopFront();
+					--NumPooledTextures;
+					PooledTexturesSizeInBytes -= Bucket->TextureSizeInBytes;
+					continue;
+				}
+				if (!TextureData.UETexture->TextureReference.TextureReferenceRHI.IsValid())
+				{
+					// this can fail often when UE is in the background. The texture is moved to the back for a later import and we look at the next one
+					Bucket->Textures.PushBack(Bucket->Textures.PopFront());
+					continue;
+				}
+				
 				PooledTexture = TextureData.UETexture;
-				TexturePool.RemoveAt(i);
-				break;
+				Bucket->Textures.PopFront();
+				--NumPooledTextures;
+				PooledTexturesSizeInBytes -= Bucket->TextureSizeInBytes;
+				Bucket->LastUsed = ++TexturePoolUseCounter;
 			}
 		}
 
+		if (PooledTexture)
+		{
+			INC_DWORD_STAT(STAT_TE_ImportedTexturePool_NbHits);
+			CSV_CUSTOM_STAT(TouchEngine, NbImportPoolHits, 1, ECsvCustomStatOp::Accumulate);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_TE_ImportedTexturePool_NbMisses);
+			CSV_CUSTOM_STAT(TouchEngine, NbImportPoolMisses, 1, ECsvCustomStatOp::Accumulate);
+		}
+		UpdateTexturePoolStats();
 		return PooledTexture;
 	}
 
@@ -0,0 +1,115 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Null/NullTouchUtils.h"
+
+#include "HAL/IConsoleManager.h"
+
+#if PLATFORM_WINDOWS
+#include "ThirdParty/Windows/DirectX/include/dxgiformat.h"
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "TouchEngine/TED3D.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+namespace UE::TouchEngine::Null
+{
+	namespace Private
+	{
+		static TAutoConsoleVariable<float> CVarCopyLatencyMs(
+			TEXT("TouchEngine.NullRHI.CopyLatencyMs"),
+			0.f,
+			TEXT("The time, in milliseconds, a texture copy takes to complete when running with the NullRHI. 0 signals the copies instantly."));
+
+#if PLATFORM_WINDOWS
+		/** Same mapping as the D3D12 resource provider, limited to the formats TouchEngine uses for uncompressed textures */
+		static EPixelFormat ConvertDXGIFormatToPixelFormat(DXGI_FORMAT Format, bool& bIsSRGB)
+		{
+			bIsSRGB = false;
+			switch (Format)
+			{
+			case DXGI_FORMAT_R8_UNORM: return PF_G8;
+			case DXGI_FORMAT_R16_UNORM: return PF_G16;
+			case DXGI_FORMAT_R16_FLOAT: return PF_R16F;
+			case DXGI_FORMAT_R32_FLOAT: return PF_R32_FLOAT;
+			case DXGI_FORMAT_R8G8_UNORM: return PF_R8G8;
+			case DXGI_FORMAT_R16G16_UNORM: return PF_G16R16;
+			case DXGI_FORMAT_R16G16_FLOAT: return PF_G16R16F;
+			case DXGI_FORMAT_R32G32_FLOAT: return PF_G32R32F;
+			case DXGI_FORMAT_R11G11B10_FLOAT: return PF_FloatR11G11B10;
+			case DXGI_FORMAT_R10G10B10A2_UNORM: return PF_A2B10G10R10;
+			case DXGI_FORMAT_R8G8B8A8_UNORM: return PF_R8G8B8A8;
+			case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB: bIsSRGB = true; return PF_R8G8B8A8;
+			case DXGI_FORMAT_B8G8R8A8_UNORM: return PF_B8G8R8A8;
+			case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB: bIsSRGB = true; return PF_B8G8R8A8;
+			case DXGI_FORMAT_R16G16B16A16_UNORM: return PF_R16G16B16A16_UNORM;
+			case DXGI_FORMAT_R16G16B16A16_FLOAT: return PF_FloatRGBA;
+			case DXGI_FORMAT_R32G32B32A32_FLOAT: return PF_A32B32G32R32F;
+			default: return PF_Unknown;
+			}
+		}
+#endif
+	}
+
+	double GetCopyLatencySeconds()
+	{
+		return FMath::Max(0.f, Private::CVarCopyLatencyMs.GetValueOnAnyThread()) / 1000.0;
+	}
+
+	bool GetSharedTextureDescription(const TouchObject<TETexture>& Texture, uint32& OutSizeX, uint32& OutSizeY, EPixelFormat& OutPixelFormat, bool& bOutIsSRGB)
+	{
+#if PLATFORM_WINDOWS
+		if (Texture && TETextureGetType(Texture) == TETextureTypeD3DShared)
+		{
+			const TED3DSharedTexture* SharedTexture = static_cast<TED3DSharedTexture*>(Texture.get());
+			OutSizeX = static_cast<uint32>(TED3DSharedTextureGetWidth(SharedTexture));
+			OutSizeY = TED3DSharedTextureGetHeight(SharedTexture);
+			OutPixelFormat = Private::ConvertDXGIFormatToPixelFormat(TED3DSharedTextureGetFormat(SharedTexture), bOutIsSRGB);
+			return OutSizeX > 0 && OutSizeY > 0 && OutPixelFormat != PF_Unknown;
+		}
+#endif
+		return false;
+	}
+
+	TSet<EPixelFormat> GetTouchEngineSupportedPixelFormats(TEInstance& Instance)
+	{
+		TSet<EPixelFormat> Formats;
+#if PLATFORM_WINDOWS
+		int32 Count = 0;
+		if (TEInstanceGetSupportedD3DFormats(&Instance, nullptr, &Count) != TEResultInsufficientMemory)
+		{
+			return Formats;
+		}
+
+		TArray<DXGI_FORMAT> SupportedTypes;
+		SupportedTypes.SetNumZeroed(Count);
+		if (TEInstanceGetSupportedD3DFormats(&Instance, SupportedTypes.GetData(), &Count) != TEResultSuccess)
+		{
+			return Formats;
+		}
+
+		Formats.Reserve(SupportedTypes.Num());
+		for (const DXGI_FORMAT Format : SupportedTypes)
+		{
+			bool bIsSRGB;
+			const EPixelFormat PixelFormat = Private::ConvertDXGIFormatToPixelFormat(Format, bIsSRGB);
+			if (PixelFormat != PF_Unknown)
+			{
+				Formats.Add(PixelFormat);
+			}
+		}
+#endif
+		return Formats;
+	}
+}
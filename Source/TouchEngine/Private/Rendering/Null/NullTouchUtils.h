@@ -0,0 +1,34 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "TouchEngine/TouchObject.h"
+
+namespace UE::TouchEngine::Null
+{
+	/** The time, in seconds, a texture copy takes to complete when running with the NullRHI, set by TouchEngine.NullRHI.CopyLatencyMs */
+	double GetCopyLatencySeconds();
+
+	/**
+	 * Reads the size and format of a texture shared by TouchEngine from its description, without a GPU.
+	 * Returns false if the texture type does not describe itself or if the description is unknown, like with older TouchDesigner installations.
+	 */
+	bool GetSharedTextureDescription(const TouchObject<TETexture>& Texture, uint32& OutSizeX, uint32& OutSizeY, EPixelFormat& OutPixelFormat, bool& bOutIsSRGB);
+
+	/** Returns the pixel formats of the textures TouchEngine accepts as inputs, or an empty set if they cannot be queried */
+	TSet<EPixelFormat> GetTouchEngineSupportedPixelFormats(TEInstance& Instance);
+}
@@ -0,0 +1,116 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Null/TouchEngineNullResourceProvider.h"
+
+#include "ITouchEngineModule.h"
+#include "Engine/TEDebug.h"
+#include "Logging.h"
+#include "Rendering/Null/NullTouchUtils.h"
+#include "Rendering/Null/TouchTextureExporterNull.h"
+#include "Rendering/Null/TouchTextureImporterNull.h"
+#include "Util/FutureSyncPoint.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "TouchEngine/TED3D11.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+namespace UE::TouchEngine::Null
+{
+#if PLATFORM_WINDOWS
+	/** A Direct3D 11 context without a device: TouchEngine shares its textures with their description, which is all we read from them */
+	using FNullGraphicsContext = TED3D11Context;
+#else
+	using FNullGraphicsContext = TEGraphicsContext;
+#endif
+	
+	class FTouchEngineNullResourceProvider : public FTouchResourceProvider
+	{
+	public:
+
+		explicit FTouchEngineNullResourceProvider(TouchObject<FNullGraphicsContext> InTEContext)
+			: TEContext(MoveTemp(InTEContext))
+			, TextureExporter(MakeShared<FTouchTextureExporterNull>())
+			, TextureImporter(MakeShared<FTouchTextureImporterNull>())
+		{}
+
+		virtual void ConfigureInstance(const TouchObject<TEInstance>& Instance) override {}
+		virtual TEGraphicsContext* GetContext() const override { return TEContext; }
+		virtual FTouchLoadInstanceResult ValidateLoadedTouchEngine(TEInstance& Instance) override { return FTouchLoadInstanceResult::MakeSuccess(); }
+		virtual TSet<EPixelFormat> GetExportablePixelTypes(TEInstance& Instance) override
+		{
+			TSet<EPixelFormat> Formats = GetTouchEngineSupportedPixelFormats(Instance);
+			if (Formats.IsEmpty())
+			{
+				// The exported textures never reach TouchEngine, so we accept the formats TouchEngine supports on every platform
+				Formats = { PF_G8, PF_R8G8, PF_B8G8R8A8, PF_R8G8B8A8, PF_R16F, PF_G16R16F, PF_FloatRGBA, PF_R32_FLOAT, PF_G32R32F, PF_A32B32G32R32F };
+			}
+			return Formats;
+		}
+		virtual TouchObject<TETexture> ExportTextureToTouchEngineInternal_AnyThread(const FTouchExportParameters& Params) override
+		{
+			return TextureExporter->ExportTextureToTouchEngine_AnyThread(Params, GetContext());
+		}
+		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override
+		{
+			TextureExporter->FinalizeExportsToTouchEngine_GameThread(FrameData);
+		}
+		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override
+		{
+			TPromise<FTouchSuspendResult> Promise;
+			TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
+			
+			TArray<TFuture<FTouchSuspendResult>> Futures;
+			Futures.Emplace(TextureExporter->SuspendAsyncTasks());
+			Futures.Emplace(TextureImporter->SuspendAsyncTasks());
+			FFutureSyncPoint::SyncFutureCompletion<FTouchSuspendResult>(Futures, [Promise = MoveTemp(Promise)]() mutable
+			{
+				Promise.SetValue(FTouchSuspendResult{});
+			});
+			return Future;
+		}
+		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override
+		{
+			TextureExporter->PoolSize = FMath::Max(ExportedTexturePoolSize, 0);
+			return true;
+		}
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes) override
+		{
+			TextureImporter->PoolBudgetInBytes = FMath::Max<int64>(ImportedTexturePoolBudgetInBytes, 0);
+			return true;
+		}
+
+	protected:
+		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
+
+	private:
+		/** Can be null, in which case TouchEngine picks the type of the textures it shares and their description might not be readable */
+		TouchObject<FNullGraphicsContext> TEContext;
+		TSharedRef<FTouchTextureExporterNull> TextureExporter;
+		TSharedRef<FTouchTextureImporterNull> TextureImporter;
+	};
+
+	TSharedPtr<FTouchResourceProvider> MakeNullResourceProvider(const FResourceProviderInitArgs& InitArgs)
+	{
+		TouchObject<FNullGraphicsContext> TEContext = nullptr;
+#if PLATFORM_WINDOWS
+		const TEResult Result = TED3D11ContextCreate(nullptr, TEContext.take());
+		UE_CLOG(Result != TEResultSuccess, LogTouchEngine, Warning, TEXT("[MakeNullResourceProvider] Unable to create a TouchEngine context without a device (%s), the size of the imported textures might not be known"),
+			*TEResultToString(Result));
+#endif
+		return MakeShared<FTouchEngineNullResourceProvider>(MoveTemp(TEContext));
+	}
+}
@@ -0,0 +1,33 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/TouchResourceProvider.h"
+
+namespace UE::TouchEngine
+{
+	struct FResourceProviderInitArgs;
+}
+
+namespace UE::TouchEngine::Null
+{
+	/**
+	 * Creates the resource provider used when Unreal runs with the NullRHI, like in commandlets or when profiling headlessly.
+	 * Textures imported from and exported to TouchEngine are faked in CPU memory, going through the same texture pools as with a GPU.
+	 * TouchEngine never receives the exported textures, so its TOP inputs are left empty.
+	 */
+	TSharedPtr<FTouchResourceProvider> MakeNullResourceProvider(const FResourceProviderInitArgs& InitArgs);
+}
@@ -0,0 +1,121 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Null/TouchTextureExporterNull.h"
+
+#include "Logging.h"
+#include "RenderUtils.h"
+#include "Rendering/Exporting/TouchExportParams.h"
+#include "Rendering/Null/NullTouchUtils.h"
+#include "Util/TouchHelpers.h"
+
+namespace UE::TouchEngine::Null
+{
+	FExportedTextureNull::FExportedTextureNull(const FRHITexture& SourceRHI)
+		: FExportedTouchTexture(nullptr, [](const TouchObject<TETexture>&) {}) // there is no TouchEngine texture to receive callbacks from
+		, SizeX(SourceRHI.GetSizeX())
+		, SizeY(SourceRHI.GetSizeY())
+		, PixelFormat(SourceRHI.GetFormat())
+		, bIsSRGB(EnumHasAnyFlags(SourceRHI.GetFlags(), ETextureCreateFlags::SRGB))
+	{
+		Data.SetNumUninitialized(CalcTextureSize(SizeX, SizeY, PixelFormat, 1));
+	}
+
+	bool FExportedTextureNull::CanFitTexture(const FRHITexture* TextureToFit) const
+	{
+		return ensure(TextureToFit)
+			&& TextureToFit->GetSizeX() == SizeX
+			&& TextureToFit->GetSizeY() == SizeY
+			&& TextureToFit->GetFormat() == PixelFormat
+			&& EnumHasAnyFlags(TextureToFit->GetFlags(), ETextureCreateFlags::SRGB) == bIsSRGB;
+	}
+
+	void FExportedTextureNull::BeginFakeUse(double InSemaphoreSignalTime)
+	{
+		SemaphoreSignalTime = InSemaphoreSignalTime;
+		OnTouchTextureUseUpdate(TEObjectEventBeginUse);
+	}
+
+	bool FExportedTextureNull::TryEndFakeUse(bool bForce)
+	{
+		if (!bForce && FPlatformTime::Seconds() < SemaphoreSignalTime)
+		{
+			return false;
+		}
+		OnTouchTextureUseUpdate(TEObjectEventEndUse);
+		return true;
+	}
+
+	TFuture<FTouchSuspendResult> FTouchTextureExporterNull::SuspendAsyncTasks()
+	{
+		// Nobody is going to wait on the fake semaphores, so we signal them all now
+		for (const TSharedPtr<FExportedTextureNull>& Texture : TexturesInUse)
+		{
+			Texture->TryEndFakeUse(true);
+		}
+		TexturesInUse.Empty();
+		TextureExports.Empty();
+
+		TPromise<FTouchSuspendResult> Promise;
+		TFuture<FTouchSuspendResult> Future = Promise.GetFuture();
+		FTouchTextureExporter::SuspendAsyncTasks().Next([this, Promise = MoveTemp(Promise)](auto) mutable
+		{
+			ReleaseTextures().Next([Promise = MoveTemp(Promise)](auto) mutable
+			{
+				Promise.SetValue({});
+			});
+		});
+		return Future;
+	}
+
+	void FTouchTextureExporterNull::FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData)
+	{
+		// The textures exported for the previous cook are released once their fake semaphore is signaled, like TouchEngine would once done with them
+		TexturesInUse.RemoveAll([](const TSharedPtr<FExportedTextureNull>& Texture) { return Texture->TryEndFakeUse(); });
+		
+		TexturePoolMaintenance();
+
+		const double SemaphoreSignalTime = FPlatformTime::Seconds() + GetCopyLatencySeconds();
+		for (TSharedPtr<FExportedTextureNull>& Texture : TextureExports)
+		{
+			Texture->BeginFakeUse(SemaphoreSignalTime);
+			TexturesInUse.AddUnique(MoveTemp(Texture));
+		}
+		TextureExports.Reset();
+	}
+
+	void FTouchTextureExporterNull::FinaliseExportAndEnqueueCopy_AnyThread(FTouchExportParameters& Params, TSharedPtr<FExportedTextureNull>& Texture)
+	{
+		// There is nothing to copy, the stable RHI is only kept until the fake use starts
+		Texture->ClearStableRHI();
+		TextureExports.AddUnique(Texture);
+	}
+
+	TouchObject<TETexture> FTouchTextureExporterNull::ExportTexture_AnyThread(const FTouchExportParameters& Params, TEGraphicsContext* GraphicsContext)
+	{
+		bool bIsNewTexture, bTextureNeedsCopy;
+		TSharedPtr<FExportedTextureNull> ExportedTexture = GetOrCreateTexture(Params, bIsNewTexture, bTextureNeedsCopy);
+		if (!ExportedTexture)
+		{
+			UE_LOG(LogTouchEngine, Error, TEXT("[FTouchTextureExporterNull::ExportTexture_AnyThread[%s]] Unable to Get or Create a Texture to export onto. %s"), *GetCurrentThreadStr(), *Params.GetDebugDescription());
+			return nullptr;
+		}
+		if (bTextureNeedsCopy)
+		{
+			FTouchExportParameters ExportParams{Params};
+			FinaliseExportAndEnqueueCopy_AnyThread(ExportParams, ExportedTexture);
+		}
+		return nullptr; // TouchEngine cannot open a texture in CPU memory, so the input is left empty
+	}
+}
@@ -0,0 +1,102 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/Exporting/ExportedTouchTexture.h"
+#include "Rendering/Exporting/TouchTextureExporter.h"
+#include "Rendering/Exporting/ExportedTouchTextureCache.h"
+
+namespace UE::TouchEngine::Null
+{
+	/**
+	 * Stand-in for a texture shared with TouchEngine, backed by CPU memory, used when Unreal runs with the NullRHI.
+	 * TouchEngine cannot open CPU memory, so it never receives this texture: its use by TouchEngine is faked by a semaphore
+	 * which is signaled instantly or after the latency set by TouchEngine.NullRHI.CopyLatencyMs, like the copies of imported textures.
+	 */
+	class FExportedTextureNull : public FExportedTouchTexture
+	{
+	public:
+
+		explicit FExportedTextureNull(const FRHITexture& SourceRHI);
+
+		//~ Begin FExportedTouchTexture Interface
+		virtual bool CanFitTexture(const FRHITexture* TextureToFit) const override;
+		//~ End FExportedTouchTexture Interface
+
+		/** Flags the texture as used by TouchEngine until its fake semaphore is signaled */
+		void BeginFakeUse(double InSemaphoreSignalTime);
+		/** Flags the texture as no longer used by TouchEngine if its fake semaphore was signaled. Returns true if it was, or if Force is true */
+		bool TryEndFakeUse(bool bForce = false);
+
+	protected:
+
+		//~ Begin FExportedTouchTexture Interface
+		virtual void RemoveTextureCallback() override {}
+		//~ End FExportedTouchTexture Interface
+
+	private:
+
+		uint32 SizeX;
+		uint32 SizeY;
+		EPixelFormat PixelFormat;
+		bool bIsSRGB;
+		/** The memory the texture would use on the GPU, so the memory usage of the exporter can be profiled */
+		TArray<uint8> Data;
+		/** The time, in seconds, at which the fake semaphore of the last use is signaled */
+		double SemaphoreSignalTime = 0.0;
+	};
+
+	/** Exports textures without a GPU, so the texture cache, its pool and the lifetime logic of the exported textures can run with the NullRHI */
+	class FTouchTextureExporterNull
+		: public FTouchTextureExporter
+		, public TExportedTouchTextureCache<FExportedTextureNull, FTouchTextureExporterNull>
+	{
+	public:
+
+		//~ Begin FTouchTextureExporter Interface
+		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks() override;
+		//~ End FTouchTextureExporter Interface
+
+		//~ Begin TExportedTouchTextureCache Interface
+		TSharedPtr<FExportedTextureNull> CreateTexture(const FTouchExportParameters& Params, const FRHITexture* ParamTextureRHI) const
+		{
+			return ParamTextureRHI ? MakeShared<FExportedTextureNull>(*ParamTextureRHI) : nullptr;
+		}
+		//~ End TExportedTouchTextureCache Interface
+
+		/** Ends the fake use of the textures whose semaphore was signaled, then returns the unused textures to the pool */
+		void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData);
+
+	protected:
+
+		//~ Begin TExportedTouchTextureCache Interface
+		virtual TEResult AddTETextureTransfer(FTouchExportParameters& Params, const TSharedPtr<FExportedTextureNull>& Texture) override { return TEResultSuccess; }
+		virtual void FinaliseExportAndEnqueueCopy_AnyThread(FTouchExportParameters& Params, TSharedPtr<FExportedTextureNull>& Texture) override;
+		//~ End TExportedTouchTextureCache Interface
+
+		//~ Begin FTouchTextureExporter Interface
+		/** Goes through the texture cache like the other exporters, but skips the texture transfers as TouchEngine never receives the texture */
+		virtual TouchObject<TETexture> ExportTexture_AnyThread(const FTouchExportParameters& Params, TEGraphicsContext* GraphicsContext) override;
+		//~ End FTouchTextureExporter Interface
+
+	private:
+
+		/** The textures exported since the last call to FinalizeExportsToTouchEngine_GameThread */
+		TArray<TSharedPtr<FExportedTextureNull>> TextureExports;
+		/** The textures whose fake semaphore has not been signaled yet */
+		TArray<TSharedPtr<FExportedTextureNull>> TexturesInUse;
+	};
+}
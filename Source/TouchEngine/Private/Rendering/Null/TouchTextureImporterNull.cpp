@@ -0,0 +1,74 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Rendering/Null/TouchTextureImporterNull.h"
+
+#include "Logging.h"
+#include "RenderUtils.h"
+#include "Rendering/Null/NullTouchUtils.h"
+
+namespace UE::TouchEngine::Null
+{
+	namespace Private
+	{
+		/** The size of the imported textures whose description is unknown, as it cannot be read from the texture itself without a GPU */
+		static constexpr uint32 FallbackImportTextureSize = 256;
+	}
+	
+	FTouchImportTextureNull::FTouchImportTextureNull(const FTextureMetaData& InMetaData)
+		: MetaData(InMetaData)
+	{
+		Data.SetNumUninitialized(CalcTextureSize(MetaData.SizeX, MetaData.SizeY, MetaData.PixelFormat, 1));
+	}
+
+	ECopyTouchToUnrealResult FTouchImportTextureNull::CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer)
+	{
+		if (!CopyArgs.RequestParams.TETexture || !CopyArgs.TargetRHI)
+		{
+			return ECopyTouchToUnrealResult::Failure;
+		}
+		CopyDoneTime = FPlatformTime::Seconds() + GetCopyLatencySeconds();
+		return ECopyTouchToUnrealResult::Success;
+	}
+
+	bool FTouchImportTextureNull::IsCurrentCopyDone()
+	{
+		return FPlatformTime::Seconds() >= CopyDoneTime;
+	}
+
+	TSharedPtr<ITouchImportTexture> FTouchTextureImporterNull::CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture)
+	{
+		return MakeShared<FTouchImportTextureNull>(GetTextureMetaData(SharedTexture));
+	}
+
+	FTextureMetaData FTouchTextureImporterNull::GetTextureMetaData(const TouchObject<TETexture>& Texture) const
+	{
+		FTextureMetaData MetaData;
+		if (!GetSharedTextureDescription(Texture, MetaData.SizeX, MetaData.SizeY, MetaData.PixelFormat, MetaData.IsSRGB))
+		{
+			UE_LOG(LogTouchEngine, Verbose, TEXT("[FTouchTextureImporterNull::GetTextureMetaData] The description of the texture is unknown, falling back to %ux%u BGRA8"),
+				Private::FallbackImportTextureSize, Private::FallbackImportTextureSize);
+			MetaData = FTextureMetaData{Private::FallbackImportTextureSize, Private::FallbackImportTextureSize, PF_B8G8R8A8, true};
+		}
+		return MetaData;
+	}
+
+	FTouchTextureTransfer FTouchTextureImporterNull::GetTextureTransfer(const FTouchImportParameters& ImportParams)
+	{
+		// There is no GPU work to wait on, so we behave as if we already had the ownership of the texture
+		FTouchTextureTransfer Transfer;
+		Transfer.Result = TEResultNoMatchingEntity;
+		return Transfer;
+	}
+}
@@ -0,0 +1,59 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/Importing/ITouchImportTexture.h"
+#include "Rendering/Importing/TouchTextureImporter.h"
+
+namespace UE::TouchEngine::Null
+{
+	/**
+	 * Stand-in for a texture shared by TouchEngine, backed by CPU memory, used when Unreal runs with the NullRHI. Its size and format are read from the description of the shared texture.
+	 * Nothing is actually copied, but the copy completes like a GPU copy would: its fake semaphore is signaled instantly or after the latency set by TouchEngine.NullRHI.CopyLatencyMs.
+	 */
+	class FTouchImportTextureNull : public ITouchImportTexture
+	{
+	public:
+
+		explicit FTouchImportTextureNull(const FTextureMetaData& InMetaData);
+
+		//~ Begin ITouchImportTexture Interface
+		virtual FTextureMetaData GetTextureMetaData() const override { return MetaData; }
+		virtual ECopyTouchToUnrealResult CopyNativeToUnrealRHI_RenderThread(const FTouchCopyTextureArgs& CopyArgs, TSharedRef<FTouchTextureImporter> Importer) override;
+		virtual bool IsCurrentCopyDone() override;
+		//~ End ITouchImportTexture Interface
+
+	private:
+
+		FTextureMetaData MetaData;
+		/** The memory the texture would use on the GPU, so the memory usage of the importer can be profiled */
+		TArray<uint8> Data;
+		/** The time, in seconds, at which the fake semaphore of the last copy is signaled */
+		double CopyDoneTime = 0.0;
+	};
+
+	/** Imports textures without a GPU, so the texture pool, the transfer and lifetime logic of FTouchTextureImporter can run with the NullRHI */
+	class FTouchTextureImporterNull : public FTouchTextureImporter
+	{
+	protected:
+
+		//~ Begin FTouchTextureImporter Interface
+		virtual TSharedPtr<ITouchImportTexture> CreatePlatformTexture_RenderThread(const TouchObject<TEInstance>& Instance, const TouchObject<TETexture>& SharedTexture) override;
+		virtual FTextureMetaData GetTextureMetaData(const TouchObject<TETexture>& Texture) const override;
+		virtual FTouchTextureTransfer GetTextureTransfer(const FTouchImportParameters& ImportParams) override;
+		//~ End FTouchTextureImporter Interface
+	};
+}
@@ -0,0 +1,112 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchCHOPSampleRing.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TouchEngine::Private
+{
+	static constexpr int32 NumTestChannels = 2;
+
+	/** The value of a channel at a given time, so a popped sample tells which time and channel it came from */
+	static float GetTestSampleValue(int64 Time, int32 ChannelIndex)
+	{
+		return static_cast<float>(Time * 10 + ChannelIndex);
+	}
+
+	/** Pushes NumSamples samples starting at StartTime, each holding GetTestSampleValue */
+	static int32 PushTestSamples(FTouchCHOPSampleRing& Ring, int64 StartTime, int32 NumSamples)
+	{
+		TArray<float> Channels[NumTestChannels];
+		const float* ChannelPointers[NumTestChannels];
+		for (int32 ChannelIndex = 0; ChannelIndex < NumTestChannels; ++ChannelIndex)
+		{
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				Channels[ChannelIndex].Add(GetTestSampleValue(StartTime + SampleIndex, ChannelIndex));
+			}
+			ChannelPointers[ChannelIndex] = Channels[ChannelIndex].GetData();
+		}
+		return Ring.Push(MakeArrayView(ChannelPointers), NumSamples, StartTime);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchCHOPSampleRingTest, "TouchEngine.CHOPStream.SampleRing", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchCHOPSampleRingTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	constexpr int32 Capacity = 8;
+	TArray<float> Popped;
+	Popped.SetNumZeroed(Capacity * NumTestChannels);
+
+	// Underrun: popping an empty ring returns nothing and leaves the output untouched
+	{
+		FTouchCHOPSampleRing Ring(NumTestChannels, Capacity, 48000.0);
+		Popped[0] = -1.f;
+		TestEqual(TEXT("Popping an empty ring returns no sample"), Ring.Pop(Popped), 0);
+		TestEqual(TEXT("Popping an empty ring does not write"), Popped[0], -1.f);
+
+		PushTestSamples(Ring, 0, 3);
+		TestEqual(TEXT("Popping more than available only returns the available samples"), Ring.Pop(Popped), 3);
+		TestEqual(TEXT("The last available sample is popped"), Popped[2 * NumTestChannels + 1], GetTestSampleValue(2, 1));
+		TestEqual(TEXT("The ring is empty after being drained"), Ring.NumAvailable(), 0);
+		TestEqual(TEXT("Popping a drained ring returns no sample"), Ring.Pop(Popped), 0);
+	}
+
+	// Wrap-around: samples crossing the end of the ring come out in order
+	{
+		FTouchCHOPSampleRing Ring(NumTestChannels, Capacity, 48000.0);
+		TestEqual(TEXT("The first buffer is pushed"), PushTestSamples(Ring, 0, 6), 6);
+		TestEqual(TEXT("Part of the first buffer is popped"), Ring.Pop(MakeArrayView(Popped.GetData(), 4 * NumTestChannels)), 4);
+		TestEqual(TEXT("The second buffer wraps around the end of the ring"), PushTestSamples(Ring, 6, 6), 6);
+		TestEqual(TEXT("The ring is full"), Ring.NumAvailable(), Capacity);
+
+		TestEqual(TEXT("All the samples are popped"), Ring.Pop(Popped), Capacity);
+		bool bInOrder = true;
+		for (int32 SampleIndex = 0; SampleIndex < Capacity; ++SampleIndex)
+		{
+			for (int32 ChannelIndex = 0; ChannelIndex < NumTestChannels; ++ChannelIndex)
+			{
+				bInOrder &= Popped[SampleIndex * NumTestChannels + ChannelIndex] == GetTestSampleValue(4 + SampleIndex, ChannelIndex);
+			}
+		}
+		TestTrue(TEXT("The wrapped samples are popped in order"), bInOrder);
+	}
+
+	// Overflow, overlap and gaps
+	{
+		FTouchCHOPSampleRing Ring(NumTestChannels, Capacity, 48000.0);
+		TestEqual(TEXT("Only the samples fitting in the ring are pushed"), PushTestSamples(Ring, 0, Capacity + 2), Capacity);
+		TestEqual(TEXT("The samples not fitting are counted"), Ring.GetNumOverflowedSamples(), static_cast<uint64>(2));
+		Ring.Pop(Popped);
+
+		TestEqual(TEXT("Samples already pushed are skipped"), PushTestSamples(Ring, Capacity, 3), 1);
+		Ring.Pop(Popped);
+		// The samples dropped by the overflow were still pushed, so the ring now expects the sample at Capacity + 3
+		TestEqual(TEXT("Missing samples are held"), PushTestSamples(Ring, Capacity + 5, 1), 3);
+		TestEqual(TEXT("The missing samples are counted"), Ring.GetNumHeldSamples(), static_cast<uint64>(2));
+		TestEqual(TEXT("All the samples are popped after a gap"), Ring.Pop(Popped), 3);
+		TestEqual(TEXT("A missing sample holds the last pushed value"), Popped[0], GetTestSampleValue(Capacity + 2, 0));
+		TestEqual(TEXT("The sample after the gap is at its time"), Popped[2 * NumTestChannels], GetTestSampleValue(Capacity + 5, 0));
+	}
+	return true;
+}
+
+#endif
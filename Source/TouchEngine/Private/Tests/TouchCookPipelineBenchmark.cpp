@@ -0,0 +1,477 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineInfo.h"
+#include "Engine/TouchLoadResults.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchVariableManager.h"
+#include "ITouchEngineModule.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Util/TouchRollingSampleWindow.h"
+
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+#include "UObject/GCObject.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TouchEngine::Private
+{
+	/** The stages of a cook measured by the benchmark, in the order the component goes through them */
+	enum class ECookPipelineStage : uint8
+	{
+		/** Copying the changed inputs for the cook, like StartNewCook does */
+		SetInputs,
+		/** Enqueuing the cook in the frame cooker, which starts it right away as no other cook is in progress */
+		CookFrame,
+		/** The time TouchEngine took to cook, from TEInstanceStartFrameAtTime to the cook being done */
+		TouchEngineCook,
+		/** The time the GameThread was blocked waiting for the cook, like in Synchronized mode */
+		SynchronizedWait,
+		/** Fetching the outputs changed by the cook, like OnCookFinished does */
+		GetOutputs,
+		/** From copying the inputs to having fetched the outputs */
+		Total,
+		Count
+	};
+
+	static const TCHAR* CookPipelineStageNames[] = { TEXT("SetInputs"), TEXT("CookFrame"), TEXT("TouchEngineCook"), TEXT("SynchronizedWait"), TEXT("GetOutputs"), TEXT("Total") };
+	static_assert(UE_ARRAY_COUNT(CookPipelineStageNames) == static_cast<int32>(ECookPipelineStage::Count), "Update CookPipelineStageNames");
+
+	/** The percentiles are computed over the last BenchmarkWindowSize cooks of all the components */
+	static constexpr int32 BenchmarkWindowSize = 4096;
+	static const TCHAR* BenchmarkSection = TEXT("CookPipeline");
+
+	/**
+	 * The settings of the benchmark are read from Config/TouchEngineBenchmark.ini in the plugin directory, which also holds the regression thresholds.
+	 * Each setting can be overridden from the command line, and another baseline file can be given with -TouchEngineBenchmarkBaseline=.
+	 */
+	struct FCookPipelineBenchmarkSettings
+	{
+		FString ToxPath;
+		int32 NumComponents = 4;
+		int32 NumWarmupFrames = 60;
+		int32 NumFrames = 600;
+		int64 FrameRate = 60;
+		double LoadTimeoutSeconds = 60.0;
+		double CookTimeoutSeconds = 1.0;
+		FString ReportPath;
+		FConfigFile Baseline;
+
+		void Load()
+		{
+			const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TouchEngine"));
+			const FString PluginDir = Plugin ? Plugin->GetBaseDir() : FString();
+			FString BaselinePath = FPaths::Combine(PluginDir, TEXT("Config/TouchEngineBenchmark.ini"));
+			FParse::Value(FCommandLine::Get(), TEXT("TouchEngineBenchmarkBaseline="), BaselinePath);
+			Baseline.Read(BaselinePath);
+
+			Baseline.GetString(BenchmarkSection, TEXT("ToxPath"), ToxPath);
+			Baseline.GetInt(BenchmarkSection, TEXT("NumComponents"), NumComponents);
+			Baseline.GetInt(BenchmarkSection, TEXT("NumWarmupFrames"), NumWarmupFrames);
+			Baseline.GetInt(BenchmarkSection, TEXT("NumFrames"), NumFrames);
+			Baseline.GetInt64(BenchmarkSection, TEXT("FrameRate"), FrameRate);
+			Baseline.GetDouble(BenchmarkSection, TEXT("LoadTimeoutSeconds"), LoadTimeoutSeconds);
+			Baseline.GetDouble(BenchmarkSection, TEXT("CookTimeoutSeconds"), CookTimeoutSeconds);
+
+			const TCHAR* CommandLine = FCommandLine::Get();
+			FParse::Value(CommandLine, TEXT("TouchEngineBenchmarkTox="), ToxPath);
+			FParse::Value(CommandLine, TEXT("TouchEngineBenchmarkComponents="), NumComponents);
+			FParse::Value(CommandLine, TEXT("TouchEngineBenchmarkFrames="), NumFrames);
+			ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Automation/TouchEngine/CookPipelineBenchmark.csv"));
+			FParse::Value(CommandLine, TEXT("TouchEngineBenchmarkReport="), ReportPath);
+
+			if (!ToxPath.IsEmpty() && FPaths::IsRelative(ToxPath))
+			{
+				ToxPath = FPaths::ConvertRelativePathToFull(PluginDir, ToxPath);
+			}
+			NumComponents = FMath::Max(1, NumComponents);
+			NumWarmupFrames = FMath::Max(0, NumWarmupFrames);
+			NumFrames = FMath::Max(1, NumFrames);
+			FrameRate = FMath::Max<int64>(1, FrameRate);
+		}
+
+		/** Returns the threshold in milliseconds stored for the given stage and percentile, like TotalP95Ms, or an unset optional if it is not checked */
+		TOptional<double> GetThreshold(ECookPipelineStage Stage, const TCHAR* Percentile) const
+		{
+			double Threshold;
+			const FString Key = FString::Printf(TEXT("%s%sMs"), CookPipelineStageNames[static_cast<int32>(Stage)], Percentile);
+			return Baseline.GetDouble(BenchmarkSection, *Key, Threshold) ? Threshold : TOptional<double>();
+		}
+
+		/** Returns true if the baseline holds at least one threshold, in which case the benchmark is expected to run and fails when it cannot */
+		bool HasThresholds() const
+		{
+			const FConfigSection* Section = Baseline.FindSection(BenchmarkSection);
+			if (!Section)
+			{
+				return false;
+			}
+			for (const TPair<FName, FConfigValue>& Pair : *Section)
+			{
+				const FString Key = Pair.Key.ToString();
+				if (Key.EndsWith(TEXT("Ms")) || Key == TEXT("MinCooksPerSecond"))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	/**
+	 * Drives N TouchEngine instances through the same steps as a Synchronized component: the inputs are set and copied for the cook, the cook is enqueued,
+	 * the GameThread waits for it, and the changed outputs are fetched. Every frame, all the instances start their cook before any is waited for, so they cook concurrently.
+	 * The number of parameters and textures of each cook is the number of inputs and outputs of the .tox file; all the numeric inputs are changed every frame.
+	 */
+	class FCookPipelineBenchmark : public FGCObject
+	{
+	public:
+		FCookPipelineBenchmark(FAutomationTestBase& InTest, FCookPipelineBenchmarkSettings InSettings)
+			: Test(InTest)
+			, Settings(MoveTemp(InSettings))
+		{
+			for (TUniquePtr<TTouchRollingSampleWindow<BenchmarkWindowSize>>& StageSamples : Samples)
+			{
+				StageSamples = MakeUnique<TTouchRollingSampleWindow<BenchmarkWindowSize>>();
+			}
+		}
+
+		virtual ~FCookPipelineBenchmark() override
+		{
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				if (Instance.EngineInfo)
+				{
+					Instance.EngineInfo->Destroy();
+				}
+			}
+		}
+
+		void Start()
+		{
+			LoadStartTime = FPlatformTime::Seconds();
+			Instances.SetNum(Settings.NumComponents);
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				Instance.EngineInfo = NewObject<UTouchEngineInfo>();
+				Instance.EngineInfo->Engine->SetCookMode(false);
+				Instance.EngineInfo->Engine->SetFrameRate(Settings.FrameRate);
+				Instance.LoadFuture = Instance.EngineInfo->LoadTox(Settings.ToxPath, nullptr, Settings.LoadTimeoutSeconds);
+			}
+		}
+
+		/** Called every engine frame by the latent command. Returns true once the benchmark is done */
+		bool Update()
+		{
+			if (!bIsLoaded)
+			{
+				return UpdateLoad();
+			}
+
+			const bool bIsWarmup = FrameIndex < Settings.NumWarmupFrames;
+			if (!CookFrame(!bIsWarmup))
+			{
+				return true;
+			}
+			
+			++FrameIndex;
+			if (FrameIndex < Settings.NumWarmupFrames + Settings.NumFrames)
+			{
+				return false;
+			}
+			Report();
+			return true;
+		}
+
+		//~ Begin FGCObject Interface
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				Collector.AddReferencedObject(Instance.EngineInfo);
+				// The output textures are only referenced by the variables, like they are by the component
+				Collector.AddPropertyReferences(FTouchEngineDynamicVariableContainer::StaticStruct(), &Instance.DynamicVariables);
+			}
+		}
+		virtual FString GetReferencerName() const override { return TEXT("FCookPipelineBenchmark"); }
+		//~ End FGCObject Interface
+
+	private:
+		struct FBenchmarkInstance
+		{
+			TObjectPtr<UTouchEngineInfo> EngineInfo;
+			FTouchEngineDynamicVariableContainer DynamicVariables;
+			TFuture<FTouchLoadResult> LoadFuture;
+			TFuture<FCookFrameResult> CookFuture;
+			uint64 CookStartCycles = 0;
+		};
+
+		FAutomationTestBase& Test;
+		FCookPipelineBenchmarkSettings Settings;
+		TArray<FBenchmarkInstance> Instances;
+		TUniquePtr<TTouchRollingSampleWindow<BenchmarkWindowSize>> Samples[static_cast<int32>(ECookPipelineStage::Count)];
+
+		bool bIsLoaded = false;
+		double LoadStartTime = 0.0;
+		int32 FrameIndex = 0;
+		/** The wall-clock time of the measured frames, in seconds */
+		double MeasuredSeconds = 0.0;
+		int64 NumMeasuredCooks = 0;
+		int64 NumDroppedFrames = 0;
+
+		void AddSample(ECookPipelineStage Stage, uint64 StartCycles, uint64 EndCycles)
+		{
+			Samples[static_cast<int32>(Stage)]->AddSample(FPlatformTime::ToMilliseconds64(EndCycles - StartCycles));
+		}
+
+		bool UpdateLoad()
+		{
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				if (!Instance.LoadFuture.IsReady())
+				{
+					// The load is executed on the GameThread, so the future can only be ready after a few engine frames
+					if (FPlatformTime::Seconds() - LoadStartTime > Settings.LoadTimeoutSeconds + 5.0)
+					{
+						Test.AddError(FString::Printf(TEXT("Timed out loading %s"), *Settings.ToxPath));
+						return true;
+					}
+					return false;
+				}
+			}
+
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				const FTouchLoadResult& LoadResult = Instance.LoadFuture.Get();
+				if (LoadResult.IsFailure())
+				{
+					Test.AddError(FString::Printf(TEXT("Failed to load %s: %s"), *Settings.ToxPath, *LoadResult.FailureResult->ErrorMessage));
+					return true;
+				}
+				Instance.DynamicVariables.ToxParametersLoaded(LoadResult.SuccessResult->Inputs, LoadResult.SuccessResult->Outputs);
+				Instance.DynamicVariables.SetupForFirstCook();
+			}
+			
+			const FTouchEngineDynamicVariableContainer& DynamicVariables = Instances[0].DynamicVariables;
+			Test.AddInfo(FString::Printf(TEXT("Loaded %s in %d instances in %.2fs. %d inputs, %d outputs"),
+				*Settings.ToxPath, Instances.Num(), FPlatformTime::Seconds() - LoadStartTime, DynamicVariables.DynVars_Input.Num(), DynamicVariables.DynVars_Output.Num()));
+			bIsLoaded = true;
+			return false;
+		}
+
+		/** Cooks one frame on all the instances. Returns false if the benchmark cannot continue */
+		bool CookFrame(bool bRecordSamples)
+		{
+			const uint64 FrameStartCycles = FPlatformTime::Cycles64();
+			for (int32 InstanceIndex = 0; InstanceIndex < Instances.Num(); ++InstanceIndex)
+			{
+				FBenchmarkInstance& Instance = Instances[InstanceIndex];
+				const TSharedPtr<FTouchVariableManager> VariableManager = Instance.EngineInfo->Engine->GetVariableManager();
+				if (!VariableManager || !Instance.EngineInfo->Engine->IsReadyToCookFrame())
+				{
+					Test.AddError(TEXT("The TouchEngine instance is not ready to cook"));
+					return false;
+				}
+
+				FTouchEngineInputFrameData InputFrameData{ Instance.EngineInfo->Engine->GetNextFrameID() };
+				InputFrameData.ComponentId = InstanceIndex;
+				
+				Instance.CookStartCycles = FPlatformTime::Cycles64();
+				for (FTouchEngineDynamicVariableStruct& Input : Instance.DynamicVariables.DynVars_Input)
+				{
+					if (Input.bIsArray)
+					{
+						continue;
+					}
+					if (Input.VarType == EVarType::Double)
+					{
+						Input.SetValue(static_cast<double>(FrameIndex));
+						Input.SetFrameLastUpdatedFromNextCookFrame(Instance.EngineInfo);
+					}
+					else if (Input.VarType == EVarType::Float)
+					{
+						Input.SetValue(static_cast<float>(FrameIndex));
+						Input.SetFrameLastUpdatedFromNextCookFrame(Instance.EngineInfo);
+					}
+					else if (Input.VarType == EVarType::Int)
+					{
+						Input.SetValue(FrameIndex);
+						Input.SetFrameLastUpdatedFromNextCookFrame(Instance.EngineInfo);
+					}
+				}
+				InputFrameData.StartTime = FPlatformTime::Seconds() - GStartTime;
+				FCookFrameRequest CookFrameRequest{
+					1.0 / Settings.FrameRate, Settings.FrameRate * 1000, InputFrameData,
+					Instance.DynamicVariables.CopyInputsForCook(InputFrameData.FrameID, *VariableManager),
+					Settings.CookTimeoutSeconds
+				};
+				const uint64 InputsSetCycles = FPlatformTime::Cycles64();
+				
+				Instance.CookFuture = Instance.EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), -1, 1);
+				if (bRecordSamples)
+				{
+					AddSample(ECookPipelineStage::SetInputs, Instance.CookStartCycles, InputsSetCycles);
+					AddSample(ECookPipelineStage::CookFrame, InputsSetCycles, FPlatformTime::Cycles64());
+				}
+			}
+
+			FlushRenderingCommands(); // Like in Synchronized mode, the RHI Thread needs to start the copies of the inputs before we wait
+			bool bCanContinue = true;
+			for (FBenchmarkInstance& Instance : Instances)
+			{
+				const uint64 WaitStartCycles = FPlatformTime::Cycles64();
+				// The cook watchdog cancels the cook once CookTimeoutSeconds is reached, so the future should always be ready by then
+				if (!Instance.CookFuture.WaitFor(FTimespan::FromSeconds(Settings.CookTimeoutSeconds + 5.0)))
+				{
+					Test.AddError(TEXT("The cook was not cancelled once its timeout was reached"));
+					return false;
+				}
+				const uint64 WaitEndCycles = FPlatformTime::Cycles64();
+				
+				const FCookFrameResult CookFrameResult = Instance.CookFuture.Get();
+				Instance.CookFuture = TFuture<FCookFrameResult>();
+				const bool bIsSuccess = CookFrameResult.Result == ECookFrameResult::Success;
+				if (bIsSuccess && !CookFrameResult.bWasFrameDropped)
+				{
+					Instance.DynamicVariables.GetOutputs(Instance.EngineInfo);
+				}
+				const uint64 CookEndCycles = FPlatformTime::Cycles64();
+				if (CookFrameResult.OnReadyToStartNextCook)
+				{
+					CookFrameResult.OnReadyToStartNextCook->SetValue();
+				}
+
+				if (!bIsSuccess)
+				{
+					Test.AddError(FString::Printf(TEXT("Cook of frame %lld failed with %s"), CookFrameResult.FrameData.FrameID, *UEnum::GetValueAsString(CookFrameResult.Result)));
+					bCanContinue = false;
+				}
+				else if (bRecordSamples)
+				{
+					AddSample(ECookPipelineStage::SynchronizedWait, WaitStartCycles, WaitEndCycles);
+					Samples[static_cast<int32>(ECookPipelineStage::TouchEngineCook)]->AddSample(CookFrameResult.CookDurationInSeconds * 1000.0);
+					AddSample(ECookPipelineStage::GetOutputs, WaitEndCycles, CookEndCycles);
+					AddSample(ECookPipelineStage::Total, Instance.CookStartCycles, CookEndCycles);
+					++NumMeasuredCooks;
+					NumDroppedFrames += CookFrameResult.bWasFrameDropped ? 1 : 0;
+				}
+			}
+
+			if (bRecordSamples)
+			{
+				MeasuredSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - FrameStartCycles);
+			}
+			return bCanContinue;
+		}
+
+		/** Writes the results to the report file and fails the test if a percentile is over its threshold */
+		void Report()
+		{
+			const double CooksPerSecond = MeasuredSeconds > 0.0 ? NumMeasuredCooks / MeasuredSeconds : 0.0;
+			Test.AddInfo(FString::Printf(TEXT("%lld cooks of %d instances over %d frames in %.2fs: %.1f cooks/s, %lld dropped frames"),
+				NumMeasuredCooks, Instances.Num(), Settings.NumFrames, MeasuredSeconds, CooksPerSecond, NumDroppedFrames));
+
+			TArray<FString> ReportLines;
+			ReportLines.Add(TEXT("Stage,Num,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs"));
+			for (int32 StageIndex = 0; StageIndex < static_cast<int32>(ECookPipelineStage::Count); ++StageIndex)
+			{
+				const ECookPipelineStage Stage = static_cast<ECookPipelineStage>(StageIndex);
+				const FTouchRollingSampleSummary Summary = Samples[StageIndex]->GetSummary();
+				ReportLines.Add(FString::Printf(TEXT("%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f"), CookPipelineStageNames[StageIndex], Summary.Num, Summary.Mean, Summary.P50, Summary.P95, Summary.P99, Summary.Max));
+				Test.AddInfo(FString::Printf(TEXT("%s: p50 %.3fms, p95 %.3fms, p99 %.3fms, max %.3fms"), CookPipelineStageNames[StageIndex], Summary.P50, Summary.P95, Summary.P99, Summary.Max));
+
+				const TPair<const TCHAR*, double> Percentiles[] = { { TEXT("P50"), Summary.P50 }, { TEXT("P95"), Summary.P95 }, { TEXT("P99"), Summary.P99 } };
+				for (const TPair<const TCHAR*, double>& Percentile : Percentiles)
+				{
+					const TOptional<double> Threshold = Settings.GetThreshold(Stage, Percentile.Key);
+					if (Threshold && Percentile.Value > *Threshold)
+					{
+						Test.AddError(FString::Printf(TEXT("%s %s is %.3fms, over its threshold of %.3fms"), CookPipelineStageNames[StageIndex], Percentile.Key, Percentile.Value, *Threshold));
+					}
+				}
+			}
+			ReportLines.Add(FString::Printf(TEXT("CooksPerSecond,%lld,%.4f,,,,"), NumMeasuredCooks, CooksPerSecond));
+
+			double MinCooksPerSecond;
+			if (Settings.Baseline.GetDouble(BenchmarkSection, TEXT("MinCooksPerSecond"), MinCooksPerSecond) && CooksPerSecond < MinCooksPerSecond)
+			{
+				Test.AddError(FString::Printf(TEXT("The throughput is %.1f cooks/s, under its threshold of %.1f cooks/s"), CooksPerSecond, MinCooksPerSecond));
+			}
+
+			if (FFileHelper::SaveStringArrayToFile(ReportLines, *Settings.ReportPath))
+			{
+				Test.AddInfo(FString::Printf(TEXT("Report written to %s"), *FPaths::ConvertRelativePathToFull(Settings.ReportPath)));
+			}
+			else
+			{
+				Test.AddWarning(FString::Printf(TEXT("Failed to write the report to %s"), *Settings.ReportPath));
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchCookPipelineBenchmark, "TouchEngine.Benchmark.CookPipeline", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchCookPipelineBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	FCookPipelineBenchmarkSettings Settings;
+	Settings.Load();
+	// A benchmark with thresholds which silently does not run would let regressions through, so it only skips when nothing is checked
+	const bool bHasThresholds = Settings.HasThresholds();
+	// Without TouchDesigner installed, the benchmark runs against the stub library of Source/ThirdParty/TouchEngineStub given with -TouchEngineLibDir=
+	if (!ITouchEngineModule::Get().IsTouchEngineLibInitialized())
+	{
+		const FString Message = TEXT("The TouchEngine library is not loaded. Run with -TouchEngineLibDir=<directory of TouchEngine.dll or of the stub TouchEngine.dll>");
+		if (bHasThresholds)
+		{
+			AddError(Message);
+			return false;
+		}
+		AddWarning(Message + TEXT(", skipping the benchmark"));
+		return true;
+	}
+	if (Settings.ToxPath.IsEmpty() || !FPaths::FileExists(Settings.ToxPath))
+	{
+		const FString Message = FString::Printf(TEXT("No .tox file to benchmark at '%s'. Set ToxPath in Config/TouchEngineBenchmark.ini or pass -TouchEngineBenchmarkTox="), *Settings.ToxPath);
+		if (bHasThresholds)
+		{
+			AddError(Message);
+			return false;
+		}
+		AddWarning(Message);
+		return true;
+	}
+
+	const TSharedRef<FCookPipelineBenchmark> Benchmark = MakeShared<FCookPipelineBenchmark>(*this, MoveTemp(Settings));
+	Benchmark->Start();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Benchmark]()
+	{
+		return Benchmark->Update();
+	}));
+	return true;
+}
+
+#endif
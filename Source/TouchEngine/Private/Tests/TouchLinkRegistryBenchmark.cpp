@@ -0,0 +1,314 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineInfo.h"
+#include "Engine/TouchLoadResults.h"
+#include "Engine/Util/TouchVariableManager.h"
+#include "ITouchEngineModule.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TouchEngine::Private
+{
+	/** The number of links of the benchmarked components, from a small tox file to a very large one */
+	static const int32 BenchmarkLinkCounts[] = { 50, 500, 5000 };
+	/** The number of lookups measured for each link count, spread over all the links */
+	static constexpr int32 NumBenchmarkLookups = 200000;
+	/** The stub loads instantly, so a load still pending after this long is stuck */
+	static constexpr double LinkRegistryBenchmarkTimeoutSeconds = 10.0;
+
+	/** Runs Lookup for every link until NumBenchmarkLookups lookups were done, and returns the average time of one lookup in nanoseconds */
+	template<typename TLookup>
+	static double MeasureLookupNanoseconds(int32 NumLinks, TLookup&& Lookup)
+	{
+		const int32 NumIterations = FMath::Max(1, NumBenchmarkLookups / NumLinks);
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+			{
+				Lookup(LinkIndex);
+			}
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+		return Seconds * 1e9 / (static_cast<double>(NumIterations) * NumLinks);
+	}
+
+	/** Looks the links up in a registry without a TouchEngine instance, comparing the ways to find a link with what the link callbacks used to do */
+	static void BenchmarkRegistryLookups(FAutomationTestBase& Test, int32 NumLinks)
+	{
+		// The registry never calls TouchEngine when looking links up, so it can be benchmarked without an instance
+		const TSharedRef<FTouchVariableManager> VariableManager = MakeShared<FTouchVariableManager>(TouchObject<TEInstance>(), nullptr, nullptr);
+		TArray<FString> Identifiers;
+		TArray<std::string> IdentifiersANSI;
+		TArray<FTouchLinkHandle> CachedHandles;
+		for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+		{
+			const FString& Identifier = Identifiers.Add_GetRef(FString::Printf(TEXT("/project1/parameter_%d"), LinkIndex));
+			IdentifiersANSI.Add(StringCast<ANSICHAR>(*Identifier).Get());
+			CachedHandles.Add(VariableManager->FindOrAddLinkHandle(Identifier));
+		}
+
+		// The three ways to find a link must agree
+		for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+		{
+			const FTouchLinkHandle FromANSI = VariableManager->FindOrAddLinkHandle_AnyThread(IdentifiersANSI[LinkIndex].c_str());
+			FTouchLinkHandle CachedHandle = CachedHandles[LinkIndex];
+			const FTouchLinkHandle FromCache = VariableManager->ResolveLinkHandle(Identifiers[LinkIndex], CachedHandle);
+			Test.TestEqual(FString::Printf(TEXT("%d links: handle found from the ANSI identifier"), NumLinks), FromANSI.Index, CachedHandles[LinkIndex].Index);
+			Test.TestEqual(FString::Printf(TEXT("%d links: handle resolved from the cache"), NumLinks), FromCache.Index, CachedHandles[LinkIndex].Index);
+		}
+
+		// A handle created by another variable manager, like before a reload, must be resolved again
+		{
+			const TSharedRef<FTouchVariableManager> OtherVariableManager = MakeShared<FTouchVariableManager>(TouchObject<TEInstance>(), nullptr, nullptr);
+			FTouchLinkHandle StaleHandle = OtherVariableManager->FindOrAddLinkHandle(TEXT("/project1/other"));
+			const FTouchLinkHandle Resolved = VariableManager->ResolveLinkHandle(Identifiers[3], StaleHandle);
+			Test.TestEqual(FString::Printf(TEXT("%d links: stale handle resolved to the link of this registry"), NumLinks), Resolved.Index, CachedHandles[3].Index);
+			Test.TestEqual(FString::Printf(TEXT("%d links: stale handle updated in place"), NumLinks), StaleHandle.RegistryId, CachedHandles[3].RegistryId);
+		}
+
+		// What the link callbacks used to do: convert the identifier to a FString and hash it into a map
+		TMap<FString, int32> LinkIndicesByIdentifier;
+		for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+		{
+			LinkIndicesByIdentifier.Add(Identifiers[LinkIndex], LinkIndex);
+		}
+		int32 Checksum = 0;
+		const double FStringNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+		{
+			Checksum += LinkIndicesByIdentifier.FindChecked(FString(IdentifiersANSI[LinkIndex].c_str()));
+		});
+		const double IdentifierNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+		{
+			Checksum += VariableManager->FindOrAddLinkHandle(Identifiers[LinkIndex]).Index;
+		});
+		const double ANSINs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+		{
+			Checksum += VariableManager->FindOrAddLinkHandle_AnyThread(IdentifiersANSI[LinkIndex].c_str()).Index;
+		});
+		const double CachedNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+		{
+			Checksum += VariableManager->ResolveLinkHandle(Identifiers[LinkIndex], CachedHandles[LinkIndex]).Index;
+		});
+
+		// The timings depend on the machine and its load, so they are reported but not checked
+		Test.AddInfo(FString::Printf(TEXT("Link lookup over %d links (checksum %d): FString map %.1f ns, FString identifier %.1f ns, ANSI identifier %.1f ns, cached handle %.1f ns"),
+			NumLinks, Checksum, FStringNs, IdentifierNs, ANSINs, CachedNs));
+	}
+
+	/**
+	 * Loads a description of the stub TouchEngine library with as many double inputs and outputs as each benchmarked link count,
+	 * and measures the getters and setters of the variable manager, which go through the link registry and its cached TELinkInfo, with and without a link handle.
+	 */
+	class FLinkRegistryInstanceBenchmark
+	{
+	public:
+		FLinkRegistryInstanceBenchmark(FAutomationTestBase& InTest)
+			: Test(InTest)
+		{}
+
+		~FLinkRegistryInstanceBenchmark()
+		{
+			ReleaseEngine();
+		}
+
+		/** Called every engine frame by the latent command. Returns true once the test is done */
+		bool Update()
+		{
+			if (!LoadFuture.IsValid())
+			{
+				return !LoadNextDescription();
+			}
+			if (!LoadFuture.IsReady())
+			{
+				if (FPlatformTime::Seconds() - LoadStartTime > LinkRegistryBenchmarkTimeoutSeconds)
+				{
+					Test.AddError(FString::Printf(TEXT("%d links: timed out loading the stub description"), GetNumLinks()));
+					return true;
+				}
+				return false;
+			}
+			
+			const FTouchLoadResult LoadResult = LoadFuture.Get();
+			LoadFuture = TFuture<FTouchLoadResult>();
+			if (LoadResult.IsFailure())
+			{
+				Test.AddError(FString::Printf(TEXT("%d links: failed to load the stub description: %s"), GetNumLinks(), *LoadResult.FailureResult->ErrorMessage));
+				return true;
+			}
+			BenchmarkLoadedInstance();
+			ReleaseEngine();
+			++LinkCountIndex;
+			return LinkCountIndex >= UE_ARRAY_COUNT(BenchmarkLinkCounts);
+		}
+
+	private:
+		FAutomationTestBase& Test;
+		TStrongObjectPtr<UTouchEngineInfo> EngineInfo;
+		TFuture<FTouchLoadResult> LoadFuture;
+		int32 LinkCountIndex = 0;
+		double LoadStartTime = 0.0;
+
+		int32 GetNumLinks() const { return BenchmarkLinkCounts[LinkCountIndex]; }
+		static FString GetInputIdentifier(int32 LinkIndex) { return FString::Printf(TEXT("in/parameter_%d"), LinkIndex); }
+		static FString GetOutputIdentifier(int32 LinkIndex) { return FString::Printf(TEXT("out/result_%d"), LinkIndex); }
+
+		/** Writes the description of the current link count and starts loading it. Returns false if it cannot be loaded */
+		bool LoadNextDescription()
+		{
+			const int32 NumLinks = GetNumLinks();
+			TStringBuilder<1024> Description;
+			Description << TEXT("touchengine_stub 1\ncook_ms 0\ndrop_every 0\n");
+			for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+			{
+				Description.Appendf(TEXT("in double parameter_%d\nout double result_%d\n"), LinkIndex, LinkIndex);
+			}
+			
+			// The plugin only loads files with the .tox extension
+			const FString DescriptionPath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / FString::Printf(TEXT("LinkRegistryBenchmark_%d.stub.tox"), NumLinks));
+			if (!FFileHelper::SaveStringToFile(Description.ToView(), *DescriptionPath))
+			{
+				Test.AddError(FString::Printf(TEXT("%d links: failed to write the stub description to %s"), NumLinks, *DescriptionPath));
+				return false;
+			}
+			
+			EngineInfo.Reset(NewObject<UTouchEngineInfo>());
+			LoadStartTime = FPlatformTime::Seconds();
+			LoadFuture = EngineInfo->LoadTox(DescriptionPath, nullptr, LinkRegistryBenchmarkTimeoutSeconds);
+			return true;
+		}
+
+		void BenchmarkLoadedInstance()
+		{
+			const int32 NumLinks = GetNumLinks();
+			const TSharedPtr<FTouchVariableManager> VariableManager = EngineInfo->Engine ? EngineInfo->Engine->GetVariableManager() : nullptr;
+			if (!VariableManager)
+			{
+				Test.AddError(FString::Printf(TEXT("%d links: the loaded instance has no variable manager"), NumLinks));
+				return;
+			}
+
+			TArray<FString> InputIdentifiers;
+			TArray<FString> OutputIdentifiers;
+			TArray<FTouchLinkHandle> InputHandles;
+			TArray<FTouchLinkHandle> OutputHandles;
+			for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+			{
+				InputIdentifiers.Add(GetInputIdentifier(LinkIndex));
+				OutputIdentifiers.Add(GetOutputIdentifier(LinkIndex));
+				InputHandles.AddDefaulted();
+				OutputHandles.AddDefaulted();
+			}
+
+			// The handles are resolved by the first call, and the link info retrieved from TouchEngine once
+			int32 NumValidLinkInfos = 0;
+			for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+			{
+				const double Value = LinkIndex;
+				VariableManager->SetDoubleInput(InputIdentifiers[LinkIndex], MakeArrayView(&Value, 1), &InputHandles[LinkIndex]);
+				VariableManager->GetDoubleOutput(OutputIdentifiers[LinkIndex], &OutputHandles[LinkIndex]);
+				
+				TouchObject<TELinkInfo> LinkInfo;
+				if (VariableManager->GetCachedLinkInfo_AnyThread(InputHandles[LinkIndex], LinkInfo) == TEResultSuccess && LinkInfo && LinkInfo->scope == TEScopeInput && LinkInfo->type == TELinkTypeDouble)
+				{
+					++NumValidLinkInfos;
+				}
+			}
+			Test.TestEqual(FString::Printf(TEXT("%d links: inputs with a cached double input link info"), NumLinks), NumValidLinkInfos, NumLinks);
+
+			double Checksum = 0.0;
+			const double SetByIdentifierNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+			{
+				const double Value = LinkIndex;
+				VariableManager->SetDoubleInput(InputIdentifiers[LinkIndex], MakeArrayView(&Value, 1));
+			});
+			const double SetByHandleNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+			{
+				const double Value = LinkIndex;
+				VariableManager->SetDoubleInput(InputIdentifiers[LinkIndex], MakeArrayView(&Value, 1), &InputHandles[LinkIndex]);
+			});
+			const double GetByIdentifierNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+			{
+				Checksum += VariableManager->GetDoubleOutput(OutputIdentifiers[LinkIndex]);
+			});
+			const double GetByHandleNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+			{
+				Checksum += VariableManager->GetDoubleOutput(OutputIdentifiers[LinkIndex], &OutputHandles[LinkIndex]);
+			});
+			const double LinkInfoNs = MeasureLookupNanoseconds(NumLinks, [&](int32 LinkIndex)
+			{
+				TouchObject<TELinkInfo> LinkInfo;
+				VariableManager->GetCachedLinkInfo_AnyThread(InputHandles[LinkIndex], LinkInfo);
+			});
+
+			// The handles must still point to the links they were resolved to
+			for (int32 LinkIndex = 0; LinkIndex < NumLinks; ++LinkIndex)
+			{
+				if (VariableManager->GetLinkIdentifier(InputHandles[LinkIndex]) != InputIdentifiers[LinkIndex])
+				{
+					Test.AddError(FString::Printf(TEXT("%d links: the handle of %s points to %s"), NumLinks, *InputIdentifiers[LinkIndex], *VariableManager->GetLinkIdentifier(InputHandles[LinkIndex])));
+					break;
+				}
+			}
+
+			Test.AddInfo(FString::Printf(TEXT("Variable manager over %d links of the stub (checksum %.0f): SetDoubleInput by identifier %.1f ns, by handle %.1f ns, GetDoubleOutput by identifier %.1f ns, by handle %.1f ns, cached link info %.1f ns"),
+				NumLinks, Checksum, SetByIdentifierNs, SetByHandleNs, GetByIdentifierNs, GetByHandleNs, LinkInfoNs));
+		}
+
+		void ReleaseEngine()
+		{
+			if (EngineInfo)
+			{
+				EngineInfo->Destroy();
+				EngineInfo.Reset();
+			}
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchLinkRegistryBenchmark, "TouchEngine.VariableManager.LinkRegistryBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchLinkRegistryBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	for (const int32 NumLinks : BenchmarkLinkCounts)
+	{
+		BenchmarkRegistryLookups(*this, NumLinks);
+	}
+
+	// The getters and setters need an instance, which the stub library provides when started with -TouchEngineLibDir=<directory of the stub TouchEngine.dll>
+	if (!ITouchEngineModule::Get().IsTouchEngineLibInitialized())
+	{
+		AddWarning(TEXT("The TouchEngine library is not loaded, skipping the benchmark of the getters and setters"));
+		return true;
+	}
+
+	const TSharedRef<FLinkRegistryInstanceBenchmark> InstanceBenchmark = MakeShared<FLinkRegistryInstanceBenchmark>(*this);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([InstanceBenchmark]()
+	{
+		return InstanceBenchmark->Update();
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,265 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/Util/TouchLockstepClock.h"
+#include "Engine/TouchEngine.h"
+#include "Engine/TouchEngineInfo.h"
+#include "Engine/TouchLoadResults.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchVariableManager.h"
+#include "ITouchEngineModule.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TouchEngine::Private
+{
+	struct FLockstepClockTestCase
+	{
+		FFrameRate FrameRate;
+		int32 TemporalSampleCount;
+	};
+
+	static const FLockstepClockTestCase LockstepClockTestCases[] =
+	{
+		{ FFrameRate(24, 1), 1 },
+		{ FFrameRate(30000, 1001), 1 },
+		{ FFrameRate(60, 1), 8 },
+		{ FFrameRate(24000, 1001), 4 },
+	};
+
+	/** The number of consecutive samples consumed to check the clock does not drift, a bit more than an hour of render at 24000/1001 with 4 samples per frame */
+	static constexpr int64 NumLongRunSamples = 400000;
+
+	/** The stub cooks instantly, so a cook or a load still pending after this long is stuck */
+	static constexpr double LockstepCookTestTimeoutSeconds = 10.0;
+
+	/**
+	 * Cooks the clock description of the stub TouchEngine library at the times given by a lockstep clock, one cook at a time like the lockstep offline render does.
+	 * The stub reports the time and discontinuity flag given to TEInstanceStartFrameAtTime in its outputs, which are checked after every cook.
+	 */
+	class FLockstepCookTest
+	{
+	public:
+		FLockstepCookTest(FAutomationTestBase& InTest)
+			: Test(InTest)
+		{
+			// Two samples per frame, with a jump to the second sample of frame 10 in the middle of the render
+			FTouchLockstepClock Clock;
+			Clock.Configure(FFrameRate(24000, 1001), 2);
+			for (int32 CookIndex = 0; CookIndex < 6; ++CookIndex)
+			{
+				if (CookIndex == 4)
+				{
+					Clock.SetNextSample(FFrameNumber(10), 1);
+				}
+				FExpectedCook& ExpectedCook = ExpectedCooks.AddDefaulted_GetRef();
+				ExpectedCook.Time = Clock.ConsumeNextTime(ExpectedCook.bIsDiscontinuity);
+			}
+		}
+
+		~FLockstepCookTest()
+		{
+			if (EngineInfo)
+			{
+				EngineInfo->Destroy();
+			}
+		}
+
+		void Start()
+		{
+			const FString PluginDir = IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir();
+			EngineInfo.Reset(NewObject<UTouchEngineInfo>());
+			EngineInfo->Engine->SetCookMode(false); // The exact times are only given to TouchEngine in TETimeExternal mode
+			EngineInfo->Engine->SetFrameRate(24);
+			StepStartTime = FPlatformTime::Seconds();
+			LoadFuture = EngineInfo->LoadTox(FPaths::ConvertRelativePathToFull(PluginDir, TEXT("Source/ThirdParty/TouchEngineStub/LockstepCook.stub.tox")), nullptr, LockstepCookTestTimeoutSeconds);
+		}
+
+		/** Called every engine frame by the latent command. Returns true once the test is done */
+		bool Update()
+		{
+			if (FPlatformTime::Seconds() - StepStartTime > LockstepCookTestTimeoutSeconds)
+			{
+				Test.AddError(LoadFuture.IsValid() ? FString(TEXT("Timed out loading the stub clock description")) : FString::Printf(TEXT("Timed out waiting for cook %d"), CookIndex));
+				return true;
+			}
+			
+			if (LoadFuture.IsValid())
+			{
+				if (!LoadFuture.IsReady())
+				{
+					return false;
+				}
+				const FTouchLoadResult LoadResult = LoadFuture.Get();
+				LoadFuture = TFuture<FTouchLoadResult>();
+				if (LoadResult.IsFailure())
+				{
+					Test.AddError(FString::Printf(TEXT("Failed to load the stub clock description: %s"), *LoadResult.FailureResult->ErrorMessage));
+					return true;
+				}
+				return !StartCook();
+			}
+
+			if (!CookFuture.IsReady())
+			{
+				return false;
+			}
+			const FCookFrameResult CookResult = CookFuture.Get();
+			CookFuture = TFuture<FCookFrameResult>();
+			CheckCook(CookResult);
+			if (CookResult.OnReadyToStartNextCook)
+			{
+				CookResult.OnReadyToStartNextCook->SetValue();
+			}
+			
+			++CookIndex;
+			return CookIndex >= ExpectedCooks.Num() || !StartCook();
+		}
+
+	private:
+		struct FExpectedCook
+		{
+			FTouchRationalTime Time;
+			bool bIsDiscontinuity = false;
+		};
+
+		FAutomationTestBase& Test;
+		TArray<FExpectedCook> ExpectedCooks;
+		TStrongObjectPtr<UTouchEngineInfo> EngineInfo;
+		TFuture<FTouchLoadResult> LoadFuture;
+		TFuture<FCookFrameResult> CookFuture;
+		int32 CookIndex = 0;
+		double StepStartTime = 0.0;
+
+		/** Starts the cook of CookIndex. Returns false if it cannot be started */
+		bool StartCook()
+		{
+			if (!EngineInfo->Engine->IsReadyToCookFrame())
+			{
+				Test.AddError(TEXT("The TouchEngine instance is not ready to cook"));
+				return false;
+			}
+			
+			const FExpectedCook& ExpectedCook = ExpectedCooks[CookIndex];
+			FCookFrameRequest CookFrameRequest{ 1001.0 / 48000.0, 48000, FTouchEngineInputFrameData{ EngineInfo->Engine->GetNextFrameID() } };
+			CookFrameRequest.ExactTime = ExpectedCook.Time;
+			CookFrameRequest.bIsTimeDiscontinuity = ExpectedCook.bIsDiscontinuity;
+			StepStartTime = FPlatformTime::Seconds();
+			CookFuture = EngineInfo->CookFrame_GameThread(MoveTemp(CookFrameRequest), 1, 1);
+			return true;
+		}
+
+		void CheckCook(const FCookFrameResult& CookResult)
+		{
+			const FExpectedCook& ExpectedCook = ExpectedCooks[CookIndex];
+			const FString Context = FString::Printf(TEXT("Cook %d at %lld/%d%s"), CookIndex, ExpectedCook.Time.Value, ExpectedCook.Time.Scale, ExpectedCook.bIsDiscontinuity ? TEXT(" [Discontinuity]") : TEXT(""));
+			if (!Test.TestEqual(FString::Printf(TEXT("%s: result"), *Context), CookResult.Result, ECookFrameResult::Success))
+			{
+				return;
+			}
+			
+			// The start time of the TEEventFrameDidFinish event, and the time the stub read from TEInstanceStartFrameAtTime
+			Test.TestEqual(FString::Printf(TEXT("%s: start time of the cook"), *Context), CookResult.TECookStartTime, ExpectedCook.Time.ToSeconds(), 1e-12);
+			const TSharedPtr<FTouchVariableManager> VariableManager = EngineInfo->Engine->GetVariableManager();
+			Test.TestEqual(FString::Printf(TEXT("%s: time value"), *Context), VariableManager->GetDoubleOutput(TEXT("out/time_value")), static_cast<double>(ExpectedCook.Time.Value));
+			Test.TestEqual(FString::Printf(TEXT("%s: time scale"), *Context), VariableManager->GetDoubleOutput(TEXT("out/time_scale")), static_cast<double>(ExpectedCook.Time.Scale));
+			Test.TestEqual(FString::Printf(TEXT("%s: discontinuity"), *Context), VariableManager->GetDoubleOutput(TEXT("out/time_discontinuity")) != 0.0, ExpectedCook.bIsDiscontinuity);
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchLockstepClockTest, "TouchEngine.OfflineRender.LockstepClock", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchLockstepClockTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	for (const FLockstepClockTestCase& TestCase : LockstepClockTestCases)
+	{
+		const int32 Numerator = TestCase.FrameRate.Numerator;
+		const int32 Denominator = TestCase.FrameRate.Denominator;
+		const int32 SampleCount = TestCase.TemporalSampleCount;
+		const FString Context = FString::Printf(TEXT("%d/%d fps, %d temporal samples"), Numerator, Denominator, SampleCount);
+		
+		FTouchLockstepClock Clock;
+		Clock.Configure(TestCase.FrameRate, SampleCount);
+		bool bIsDiscontinuity = false;
+
+		// The first samples, checked against their exact time
+		for (int64 SampleIndex = 0; SampleIndex < 3 * SampleCount; ++SampleIndex)
+		{
+			const FTouchRationalTime Time = Clock.ConsumeNextTime(bIsDiscontinuity);
+			TestEqual(FString::Printf(TEXT("%s: time value of sample %lld"), *Context, SampleIndex), Time.Value, SampleIndex * Denominator);
+			TestEqual(FString::Printf(TEXT("%s: time scale of sample %lld"), *Context, SampleIndex), Time.Scale, Numerator * SampleCount);
+			TestTrue(FString::Printf(TEXT("%s: only the first sample is a discontinuity (sample %lld)"), *Context, SampleIndex), bIsDiscontinuity == (SampleIndex == 0));
+		}
+
+		// Jumping to a temporal sample of another frame
+		const int32 TemporalSampleIndex = SampleCount - 1;
+		Clock.SetNextSample(FFrameNumber(10), TemporalSampleIndex);
+		const FTouchRationalTime JumpTime = Clock.ConsumeNextTime(bIsDiscontinuity);
+		TestEqual(FString::Printf(TEXT("%s: time value after a jump"), *Context), JumpTime.Value, (10ll * SampleCount + TemporalSampleIndex) * Denominator);
+		TestTrue(FString::Printf(TEXT("%s: a jump is a discontinuity"), *Context), bIsDiscontinuity);
+		Clock.SetNextSample(FFrameNumber(11), 0);
+		Clock.ConsumeNextTime(bIsDiscontinuity);
+		TestFalse(FString::Printf(TEXT("%s: setting the sample which comes next is not a discontinuity"), *Context), bIsDiscontinuity);
+
+		// A long run: every sample is exactly one sample duration after the previous one, and whole frames land exactly on the frame times
+		Clock.SetNextSample(FFrameNumber(0), 0);
+		bool bHasDrifted = false;
+		for (int64 SampleIndex = 0; SampleIndex < NumLongRunSamples && !bHasDrifted; ++SampleIndex)
+		{
+			const FTouchRationalTime Time = Clock.ConsumeNextTime(bIsDiscontinuity);
+			bHasDrifted = Time.Value != SampleIndex * Denominator || Time.Scale != Numerator * SampleCount;
+		}
+		TestFalse(FString::Printf(TEXT("%s: no drift over %lld samples"), *Context, NumLongRunSamples), bHasDrifted);
+
+		const int64 LastFrame = (NumLongRunSamples - 1) / SampleCount;
+		const FTouchRationalTime LastFrameTime = Clock.GetTimeOfSample(LastFrame * SampleCount);
+		TestEqual(FString::Printf(TEXT("%s: the time of the last frame matches the frame rate"), *Context),
+			LastFrameTime.ToSeconds(), TestCase.FrameRate.AsSeconds(FFrameTime(FFrameNumber(static_cast<int32>(LastFrame)))), 1e-9);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchLockstepCookTest, "TouchEngine.OfflineRender.LockstepCook", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchLockstepCookTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	// The test cooks a description of the stub library, started with -TouchEngineLibDir=<directory of the stub TouchEngine.dll>
+	if (!ITouchEngineModule::Get().IsTouchEngineLibInitialized())
+	{
+		AddWarning(TEXT("The TouchEngine library is not loaded, skipping the test"));
+		return true;
+	}
+
+	const TSharedRef<FLockstepCookTest> CookTest = MakeShared<FLockstepCookTest>(*this);
+	CookTest->Start();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([CookTest]()
+	{
+		return CookTest->Update();
+	}));
+	return true;
+}
+
+#endif
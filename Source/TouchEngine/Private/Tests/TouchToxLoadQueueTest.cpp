@@ -0,0 +1,91 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Engine/TouchEngineSubsystem.h"
+#include "Engine/TouchLoadResults.h"
+#include "ITouchEngineModule.h"
+#include "ToxAsset.h"
+
+#include "Engine/Engine.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "UObject/StrongObjectPtr.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TouchEngine::Private
+{
+	/** The loads of the stub library complete in a few milliseconds, so a load still pending after this long is stuck in the queue */
+	static constexpr double ToxLoadQueueTestTimeoutSeconds = 10.0;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTouchToxLoadForceReloadTest, "TouchEngine.Subsystem.ForceReloadWhileLoading", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTouchToxLoadForceReloadTest::RunTest(const FString& Parameters)
+{
+	using namespace UE::TouchEngine;
+	using namespace UE::TouchEngine::Private;
+
+	// The test loads the description of the stub library, started with -TouchEngineLibDir=<directory of the stub TouchEngine.dll>
+	if (!ITouchEngineModule::Get().IsTouchEngineLibInitialized())
+	{
+		AddWarning(TEXT("The TouchEngine library is not loaded, skipping the test"));
+		return true;
+	}
+	UTouchEngineSubsystem* Subsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("TouchEngine subsystem"), Subsystem))
+	{
+		return false;
+	}
+
+	const FString PluginDir = IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir();
+	const TStrongObjectPtr<UToxAsset> ToxAsset(NewObject<UToxAsset>());
+	ToxAsset->SetFilePath(FPaths::ConvertRelativePathToFull(PluginDir, TEXT("Source/ThirdParty/TouchEngineStub/CookPipelineBenchmark.stub.tox")));
+
+	// The first request starts a load on a loader, the second one cancels it while it is in flight and merges with the restarted task
+	const TSharedFuture<FCachedToxFileInfo> FirstLoad = Subsystem->GetOrLoadParamsFromTox(ToxAsset.Get(), ToxLoadQueueTestTimeoutSeconds, true).Share();
+	if (FirstLoad.IsReady())
+	{
+		AddError(TEXT("The load completed before it could be reloaded"));
+		return false;
+	}
+	const TSharedFuture<FCachedToxFileInfo> Reload = Subsystem->GetOrLoadParamsFromTox(ToxAsset.Get(), ToxLoadQueueTestTimeoutSeconds, true).Share();
+
+	const double StartTime = FPlatformTime::Seconds();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, ToxAsset, StartTime, FirstLoad, Reload]()
+	{
+		if (!FirstLoad.IsReady() || !Reload.IsReady())
+		{
+			// The loads complete on the GameThread, so they can only be ready after a few engine frames
+			if (FPlatformTime::Seconds() - StartTime > ToxLoadQueueTestTimeoutSeconds + 5.0)
+			{
+				AddError(FString::Printf(TEXT("The reloaded tox file was never loaded. First request ready: %d, reload ready: %d"), FirstLoad.IsReady(), Reload.IsReady()));
+				return true;
+			}
+			return false;
+		}
+
+		// The cancelled load was queued again, so both requests are given the result of the reload
+		for (const FCachedToxFileInfo& Result : { FirstLoad.Get(), Reload.Get() })
+		{
+			TestTrue(TEXT("Reload succeeded"), Result.LoadResult.IsSuccess());
+			TestFalse(TEXT("Reload result is not the cached one"), Result.bWasCached);
+		}
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -29,6 +29,25 @@
 // ------------------------- FTouchEngineDynamicVariableContainer
 // ---------------------------------------------------------------------------------------------------------------------
 
+FTouchEngineDynamicVariableContainer::FTouchEngineDynamicVariableContainer(const FTouchEngineDynamicVariableContainer& Other)
+{
+	*this = Other;
+}
+
+FTouchEngineDynamicVariableContainer& FTouchEngineDynamicVariableContainer::operator=(const FTouchEngineDynamicVariableContainer& Other)
+{
+	// CookInputsPool is left out on purpose, so the copy never recycles its cook inputs into the pool of another container
+	DynVars_Input = Other.DynVars_Input;
+	DynVars_Output = Other.DynVars_Output;
+	IdentifierIndex = Other.IdentifierIndex;
+	NameIndex = Other.NameIndex;
+	bIsIndexValid = Other.bIsIndexValid;
+	ChangedOutputLinks = Other.ChangedOutputLinks;
+	NumIndexedInputs = Other.NumIndexedInputs;
+	NumIndexedOutputs = Other.NumIndexedOutputs;
+	return *this;
+}
+
 void FTouchEngineDynamicVariableContainer::ToxParametersLoaded(const TArray<FTouchEngineDynamicVariableStruct>& VariablesIn, const TArray<FTouchEngineDynamicVariableStruct>& VariablesOut)
 {
 	// if we have no data loaded
@@ -36,6 +55,7 @@ void FTouchEngineDynamicVariableContainer::ToxParametersLoaded(const TArray<FTou
 	{
 		DynVars_Input = VariablesIn;
 		DynVars_Output = VariablesOut;
+		RebuildIndex();
 		return;
 	}
 
@@ -74,6 +94,7 @@ void FTouchEngineDynamicVariableContainer::ToxParametersLoaded(const TArray<FTou
 
 	DynVars_Input = MoveTemp(InVarsCopy);
 	DynVars_Output = MoveTemp(OutVarsCopy);
+	RebuildIndex();
 }
 
 void FTouchEngineDynamicVariableContainer::EnsureMetadataIsSet(const TArray<FTouchEngineDynamicVariableStruct>& VariablesIn)
@@ -100,12 +121,14 @@ void FTouchEngineDynamicVariableContainer::Reset()
 {
 	DynVars_Input = {};
 	DynVars_Output = {};
+	RebuildIndex();
 }
 
 void FTouchEngineDynamicVariableContainer::SendInputs(const UTouchEngineInfo* EngineInfo, const FTouchEngineInputFrameData& FrameData)
 {
 	for (int32 i = 0; i < DynVars_Input.Num(); i++)
 	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.Bb [GT] Cook Frame - Send Input"), STAT_TE_I_Bb, STATGROUP_TouchEngine);
 		DynVars_Input[i].SendInput(EngineInfo, FrameData);
 	}
 }
@@ -114,16 +137,35 @@ void FTouchEngineDynamicVariableContainer::SendInputs(UE::TouchEngine::FTouchVar
 {
 	for (int32 i = 0; i < DynVars_Input.Num(); i++)
 	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.Bb [GT] Cook Frame - Send Input"), STAT_TE_I_Bb, STATGROUP_TouchEngine);
 		DynVars_Input[i].SendInput(VariableManager, FrameData);
 	}
 }
 
 void FTouchEngineDynamicVariableContainer::GetOutputs(const UTouchEngineInfo* EngineInfo)
 {
-	for (int32 i = 0; i < DynVars_Output.Num(); i++)
+	const TSharedPtr<UE::TouchEngine::FTouchVariableManager> VariableManager = EngineInfo && EngineInfo->Engine ? EngineInfo->Engine->GetVariableManager() : nullptr;
+	if (!VariableManager)
 	{
-		DynVars_Output[i].GetOutput(EngineInfo);
+		return;
 	}
+
+	// Only the outputs TouchEngine notified us about during the cook have a new value, the other ones keep the value they were last fetched with
+	VariableManager->TakeChangedOutputs_GameThread(ChangedOutputLinks);
+	const int32 NbChangedOutputs = ChangedOutputLinks.CountSetBits();
+	int32 NbOutputsFetched = 0;
+	for (int32 i = 0; i < DynVars_Output.Num() && NbOutputsFetched < NbChangedOutputs; i++)
+	{
+		FTouchEngineDynamicVariableStruct& Output = DynVars_Output[i];
+		const int32 LinkIndex = VariableManager->ResolveLinkHandle(Output.VarIdentifier, Output.LinkHandle).Index;
+		if (ChangedOutputLinks.IsValidIndex(LinkIndex) && ChangedOutputLinks[LinkIndex])
+		{
+			Output.GetOutput(*VariableManager);
+			++NbOutputsFetched;
+		}
+	}
+	SET_DWORD_STAT(STAT_TE_Cook_NbOutputsFetched, NbOutputsFetched);
+	CSV_CUSTOM_STAT(TouchEngine, NbOutputsFetched, NbOutputsFetched, ECsvCustomStatOp::Accumulate);
 }
 
 void FTouchEngineDynamicVariableContainer::SetupForFirstCook()
@@ -135,12 +177,15 @@ void FTouchEngineDynamicVariableContainer::SetupForFirstCook()
 	}
 }
 
-TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableContainer::CopyInputsForCook(int64 CurrentFrameID)
+FTouchEngineCookInputs FTouchEngineDynamicVariableContainer::CopyInputsForCook(int64 CurrentFrameID, const UE::TouchEngine::FTouchVariableManager& VariableManager)
 {
-	TMap<FString, FTouchEngineDynamicVariableStruct> VariablesForCook;
+	check(IsInGameThread());
+	FTouchEngineCookInputs VariablesForCook = CookInputsPool->IsEmpty() ? FTouchEngineCookInputs() : CookInputsPool->Pop();
+	VariablesForCook.OwningPool = CookInputsPool;
 	
-	for (FTouchEngineDynamicVariableStruct& Input : DynVars_Input)
+	for (int32 Index = 0; Index < DynVars_Input.Num(); ++Index)
 	{
+		FTouchEngineDynamicVariableStruct& Input = DynVars_Input[Index];
 		if (Input.FrameLastUpdated == -1)
 		{
 			// Force sending Inputs that have not been set or that have been reset
@@ -148,7 +193,7 @@ TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableCont
 		}
 		if (Input.FrameLastUpdated == CurrentFrameID) 
 		{
-			VariablesForCook.Add(Input.VarIdentifier, Input);
+			VariablesForCook.Add(Index, Input, VariableManager.ResolveLinkHandle(Input.VarIdentifier, Input.LinkHandle));
 			if (Input.bNeedBoolReset) // we reset the pulse values
 			{
 				Input.SetValue(false);
@@ -162,60 +207,334 @@ TMap<FString, FTouchEngineDynamicVariableStruct> FTouchEngineDynamicVariableCont
 
 FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByName(const FString& VarName)
 {
-	FTouchEngineDynamicVariableStruct* Var = nullptr;
+	const FTouchEngineDynamicVariableHandle* Handle = FindHandleByName(VarName);
+	return Handle ? GetVariableAt(Handle->bIsInput, Handle->Index) : nullptr;
+}
 
-	for (int i = 0; i < DynVars_Input.Num(); i++)
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByIdentifier(const FString& VarIdentifier)
+{
+	const FTouchEngineDynamicVariableHandle* Handle = FindHandleByIdentifier(VarIdentifier);
+	return Handle ? GetVariableAt(Handle->bIsInput, Handle->Index) : nullptr;
+}
+
+bool FTouchEngineDynamicVariableContainer::ResolveHandle(const FString& VarNameWithPrefix, FTouchEngineDynamicVariableHandle& OutHandle)
+{
+	const FTouchEngineDynamicVariableHandle* Handle = FindHandleByIdentifier(VarNameWithPrefix);
+	if (!Handle)
+	{
+		Handle = FindHandleByName(VarNameWithPrefix);
+	}
+	OutHandle = Handle ? *Handle : FTouchEngineDynamicVariableHandle();
+	return OutHandle.IsValid();
+}
+
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByHandle(const FTouchEngineDynamicVariableHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return nullptr;
+	}
+
+	FTouchEngineDynamicVariableStruct* Var = GetVariableAt(Handle.bIsInput, Handle.Index);
+	if (Var && Var->VarIdentifier.Equals(Handle.Identifier))
+	{
+		return Var;
+	}
+	// the variables changed since the handle was resolved, most likely because the tox was reloaded
+	return GetDynamicVariableByIdentifier(Handle.Identifier);
+}
+
+const FTouchEngineDynamicVariableHandle* FTouchEngineDynamicVariableContainer::FindHandleByIdentifier(const FString& VarIdentifier)
+{
+	EnsureIndexIsValid();
+	const FTouchEngineDynamicVariableHandle* Handle = IdentifierIndex.Find(VarIdentifier);
+	const FTouchEngineDynamicVariableStruct* Var = Handle ? GetVariableAt(Handle->bIsInput, Handle->Index) : nullptr;
+	if (Handle && (!Var || !(Var->VarIdentifier.Equals(VarIdentifier) || Var->VarLabel.Equals(VarIdentifier) || Var->VarName.Equals(VarIdentifier))))
 	{
-		if (DynVars_Input[i].VarName == VarName)
+		// the arrays were modified in place since the index was built
+		RebuildIndex();
+		Handle = IdentifierIndex.Find(VarIdentifier);
+	}
+	return Handle;
+}
+
+const FTouchEngineDynamicVariableHandle* FTouchEngineDynamicVariableContainer::FindHandleByName(const FString& VarName)
+{
+	EnsureIndexIsValid();
+	const FTouchEngineDynamicVariableHandle* Handle = NameIndex.Find(VarName);
+	const FTouchEngineDynamicVariableStruct* Var = Handle ? GetVariableAt(Handle->bIsInput, Handle->Index) : nullptr;
+	if (Handle && Handle->IsValid() && (!Var || Var->VarName != VarName))
+	{
+		// the arrays were modified in place since the index was built
+		RebuildIndex();
+		Handle = NameIndex.Find(VarName);
+	}
+	// names shared by multiple variables are indexed with an invalid handle
+	return Handle && Handle->IsValid() ? Handle : nullptr;
+}
+
+void FTouchEngineDynamicVariableContainer::EnsureIndexIsValid()
+{
+	if (!bIsIndexValid || NumIndexedInputs != DynVars_Input.Num() || NumIndexedOutputs != DynVars_Output.Num())
+	{
+		RebuildIndex();
+	}
+}
+
+void FTouchEngineDynamicVariableContainer::RebuildIndex()
+{
+	IdentifierIndex.Reset();
+	NameIndex.Reset();
+
+	const auto AddToIndex = [this](const TArray<FTouchEngineDynamicVariableStruct>& Variables, bool bIsInput)
+	{
+		for (int32 Index = 0; Index < Variables.Num(); ++Index)
 		{
-			if (!Var)
+			const FTouchEngineDynamicVariableStruct& Var = Variables[Index];
+			FTouchEngineDynamicVariableHandle Handle;
+			Handle.Identifier = Var.VarIdentifier;
+			Handle.bIsInput = bIsInput;
+			Handle.Index = Index;
+			// The first variable matching an identifier wins, which keeps the behaviour of the previous linear search
+			for (const FString* Key : {&Var.VarIdentifier, &Var.VarLabel, &Var.VarName})
+			{
+				if (!IdentifierIndex.Contains(*Key))
+				{
+					IdentifierIndex.Add(*Key, Handle);
+				}
+			}
+
+			if (FTouchEngineDynamicVariableHandle* Existing = NameIndex.Find(Var.VarName))
 			{
-				Var = &DynVars_Input[i];
+				// variable with duplicate names, don't try to distinguish between them
+				*Existing = FTouchEngineDynamicVariableHandle();
 			}
 			else
 			{
-				// variable with duplicate names, don't try to distinguish between them
-				return nullptr;
+				NameIndex.Add(Var.VarName, Handle);
 			}
 		}
+	};
+	AddToIndex(DynVars_Input, true);
+	AddToIndex(DynVars_Output, false);
+
+	bIsIndexValid = true;
+	NumIndexedInputs = DynVars_Input.Num();
+	NumIndexedOutputs = DynVars_Output.Num();
+}
+
+FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetVariableAt(bool bIsInput, int32 Index)
+{
+	TArray<FTouchEngineDynamicVariableStruct>& Variables = bIsInput ? DynVars_Input : DynVars_Output;
+	return Variables.IsValidIndex(Index) ? &Variables[Index] : nullptr;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// ------------------------- FTouchEngineCookInputs
+// ---------------------------------------------------------------------------------------------------------------------
+
+void FTouchEngineCookInputs::Add(int32 InputIndex, const FTouchEngineDynamicVariableStruct& Input, const UE::TouchEngine::FTouchLinkHandle& LinkHandle)
+{
+	if (InputIndex < 0 || Contains(InputIndex))
+	{
+		return;
 	}
 
-	for (int i = 0; i < DynVars_Output.Num(); i++)
+	FEntry Entry{InputIndex, Input.VarType, INDEX_NONE, 1, LinkHandle};
+	switch (Input.VarType)
 	{
-		if (DynVars_Output[i].VarName == VarName)
+	case EVarType::Bool:
 		{
-			if (!Var)
+			Entry.ValueIndex = ScalarValues.Add(Input.GetValueAsBool() ? 1.0 : 0.0);
+			break;
+		}
+	case EVarType::Int:
+		{
+			Entry.ValueIndex = ScalarValues.Num();
+			if (Input.Count <= 1)
 			{
-				Var = &DynVars_Output[i];
+				ScalarValues.Add(Input.GetValueAsInt());
+			}
+			else if (const int* Buffer = Input.GetValueAsIntArray())
+			{
+				Entry.Count = Input.Count;
+				for (int32 i = 0; i < Input.Count; ++i)
+				{
+					ScalarValues.Add(Buffer[i]);
+				}
 			}
 			else
 			{
-				// variable with duplicate names, don't try to distinguish between them
-				return nullptr;
+				return;
 			}
+			break;
+		}
+	case EVarType::Double:
+		{
+			Entry.ValueIndex = ScalarValues.Num();
+			if (Input.Count <= 1)
+			{
+				ScalarValues.Add(Input.GetValueAsDouble());
+			}
+			else if (const double* Buffer = Input.GetValueAsDoubleArray())
+			{
+				Entry.Count = Input.Count;
+				ScalarValues.Append(Buffer, Input.Count);
+			}
+			else
+			{
+				return;
+			}
+			break;
+		}
+	case EVarType::Float:
+		{
+			Entry.ValueIndex = ScalarValues.Add(Input.GetValueAsFloat());
+			break;
+		}
+	case EVarType::CHOP:
+		{
+			Entry.ValueIndex = CHOPValues.Add(MakeShared<FTouchEngineCHOP>(Input.GetValueAsCHOP()));
+			break;
+		}
+	case EVarType::String:
+	case EVarType::Texture:
+		{
+			Entry.ValueIndex = OtherValues.Add(Input);
+			break;
+		}
+	default:
+		{
+			// unimplemented type
+			return;
 		}
 	}
-	return Var;
+	AddEntry(MoveTemp(Entry));
 }
 
-FTouchEngineDynamicVariableStruct* FTouchEngineDynamicVariableContainer::GetDynamicVariableByIdentifier(const FString& VarIdentifier)
+void FTouchEngineCookInputs::MergeOlderInputs(FTouchEngineCookInputs&& OlderInputs)
 {
-	for (int32 i = 0; i < DynVars_Input.Num(); i++)
+	for (FEntry& Entry : OlderInputs.Entries)
 	{
-		if (DynVars_Input[i].VarIdentifier.Equals(VarIdentifier) || DynVars_Input[i].VarLabel.Equals(VarIdentifier) || DynVars_Input[i].VarName.Equals(VarIdentifier))
+		if (Contains(Entry.InputIndex))
 		{
-			return &DynVars_Input[i];
+			continue; // the newer value takes precedence
 		}
+
+		switch (Entry.VarType)
+		{
+		case EVarType::Bool:
+		case EVarType::Int:
+		case EVarType::Double:
+		case EVarType::Float:
+			{
+				const int32 ValueIndex = ScalarValues.Num();
+				ScalarValues.Append(&OlderInputs.ScalarValues[Entry.ValueIndex], Entry.Count);
+				Entry.ValueIndex = ValueIndex;
+				break;
+			}
+		case EVarType::CHOP:
+			{
+				Entry.ValueIndex = CHOPValues.Add(OlderInputs.CHOPValues[Entry.ValueIndex]);
+				break;
+			}
+		default:
+			{
+				Entry.ValueIndex = OtherValues.Add(MoveTemp(OlderInputs.OtherValues[Entry.ValueIndex]));
+				break;
+			}
+		}
+		AddEntry(MoveTemp(Entry));
 	}
+	OlderInputs.Reset();
+}
 
-	for (int32 i = 0; i < DynVars_Output.Num(); i++)
+void FTouchEngineCookInputs::SendInputs(UE::TouchEngine::FTouchVariableManager& VariableManager, const FTouchEngineInputFrameData& FrameData)
+{
+	for (const FEntry& Entry : Entries)
 	{
-		if (DynVars_Output[i].VarIdentifier.Equals(VarIdentifier) || DynVars_Output[i].VarLabel.Equals(VarIdentifier) || DynVars_Output[i].VarName.Equals(VarIdentifier))
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.Bb [GT] Cook Frame - Send Input"), STAT_TE_I_Bb, STATGROUP_TouchEngine);
+		// The identifier is only used for logging, the link is found from its handle
+		UE::TouchEngine::FTouchLinkHandle LinkHandle = Entry.LinkHandle;
+		const FString& Identifier = VariableManager.GetLinkIdentifier(LinkHandle);
+		
+		switch (Entry.VarType)
 		{
-			return &DynVars_Output[i];
+		case EVarType::Bool:
+			{
+				const bool Op = ScalarValues[Entry.ValueIndex] != 0.0;
+				VariableManager.SetBooleanInput(Identifier, Op, &LinkHandle);
+				break;
+			}
+		case EVarType::Int:
+			{
+				IntValuesToSend.Reset(Entry.Count);
+				for (int32 i = 0; i < Entry.Count; ++i)
+				{
+					IntValuesToSend.Add(static_cast<int32_t>(ScalarValues[Entry.ValueIndex + i]));
+				}
+				VariableManager.SetIntegerInput(Identifier, IntValuesToSend, &LinkHandle);
+				break;
+			}
+		case EVarType::Double:
+			{
+				VariableManager.SetDoubleInput(Identifier, MakeArrayView(&ScalarValues[Entry.ValueIndex], Entry.Count), &LinkHandle);
+				break;
+			}
+		case EVarType::Float:
+			{
+				FloatChannelToSend.Values.Reset(1);
+				FloatChannelToSend.Values.Add(static_cast<float>(ScalarValues[Entry.ValueIndex]));
+				VariableManager.SetCHOPInputSingleSample(Identifier, FloatChannelToSend, &LinkHandle);
+				break;
+			}
+		case EVarType::CHOP:
+			{
+				VariableManager.SetCHOPInput(Identifier, *CHOPValues[Entry.ValueIndex], &LinkHandle); //no need to check if valid as this is checked down the track
+				break;
+			}
+		default:
+			{
+				OtherValues[Entry.ValueIndex].SendInput(VariableManager, FrameData);
+				break;
+			}
 		}
 	}
-	return nullptr;
+}
+
+void FTouchEngineCookInputs::Reset()
+{
+	AddedInputs.Reset();
+	Entries.Reset();
+	ScalarValues.Reset();
+	CHOPValues.Reset();
+	OtherValues.Reset();
+}
+
+void FTouchEngineCookInputs::Recycle()
+{
+	check(IsInGameThread());
+	Reset();
+	if (const TSharedPtr<TArray<FTouchEngineCookInputs>> Pool = OwningPool.Pin())
+	{
+		// A few sets of inputs are enough to cover the cooks in flight and the ones waiting in the queue
+		constexpr int32 MaxPooledCookInputs = 4;
+		if (Pool->Num() < MaxPooledCookInputs)
+		{
+			OwningPool.Reset();
+			Pool->Add(MoveTemp(*this));
+		}
+	}
+}
+
+void FTouchEngineCookInputs::AddEntry(FEntry&& Entry)
+{
+	if (AddedInputs.Num() <= Entry.InputIndex)
+	{
+		AddedInputs.Add(false, Entry.InputIndex + 1 - AddedInputs.Num());
+	}
+	AddedInputs[Entry.InputIndex] = true;
+	Entries.Add(MoveTemp(Entry));
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -246,6 +565,7 @@ void FTouchEngineDynamicVariableStruct::Copy(const FTouchEngineDynamicVariableSt
 
 	SetValue(Other);
 	FrameLastUpdated = Other->FrameLastUpdated;
+	LinkHandle = Other->LinkHandle;
 	DropDownData = Other->DropDownData;
 }
 
@@ -256,6 +576,7 @@ void FTouchEngineDynamicVariableStruct::Clear()
 	// We are not clearing the ClampMin, the ClampMax and the DefaultValue as this is called from SetValue which would reset them.
 	// It should be fine as a DynamicVar is not supposed to change type
 	
+	CHOPView.Reset();
 	if (Value == nullptr)
 	{
 		return;
@@ -526,6 +847,10 @@ UDEPRECATED_TouchEngineCHOPMinimal* FTouchEngineDynamicVariableStruct::GetValueA
 
 FTouchEngineCHOP FTouchEngineDynamicVariableStruct::GetValueAsCHOP() const
 {
+	if (CHOPView.IsValid())
+	{
+		return CHOPView.ToCHOP();
+	}
 	if (!Value)
 	{
 		return FTouchEngineCHOP();
@@ -944,6 +1269,28 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineCHOP& InValue
 #endif
 }
 
+void FTouchEngineDynamicVariableStruct::SetValue(const UE::TouchEngine::FTouchCHOPView& InValue)
+{
+	if (VarType != EVarType::CHOP)
+	{
+		return;
+	}
+
+	Clear();
+	CHOPView = InValue;
+	Count = InValue.GetNumChannels();
+	Size = Count * InValue.GetNumSamples() * sizeof(float);
+	bIsArray = true;
+
+#if WITH_EDITORONLY_DATA
+	// The details panel needs the samples in TArrays. This copy only happens in editor builds
+	CHOPProperty = InValue.ToCHOP();
+	FloatBufferProperty.Empty();
+	CHOPProperty.GetCombinedValues(FloatBufferProperty);
+	ChannelNames = CHOPProperty.GetChannelNames();
+#endif
+}
+
 void FTouchEngineDynamicVariableStruct::SetValueAsCHOP(const TArray<float>& InValue, const int NumChannels, const int NumSamples)
 {
 	if (VarType != EVarType::CHOP)
@@ -1180,7 +1527,14 @@ void FTouchEngineDynamicVariableStruct::SetValue(const FTouchEngineDynamicVariab
 		}
 	case EVarType::CHOP:
 		{
-			SetValue(Other->GetValueAsCHOP());
+			if (Other->CHOPView.IsValid())
+			{
+				SetValue(Other->CHOPView);
+			}
+			else
+			{
+				SetValue(Other->GetValueAsCHOP());
+			}
 			break;
 		}
 	case EVarType::String:
@@ -1636,25 +1990,7 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 	if (Ar.IsTransacting()) // we only care for the undo/redo buffer
 	{
 		//todo: this should be saved not just when transacting, so the values would have bounds before the tox file is loaded
-		Ar << DefaultValue;
-		Ar << ClampMin;
-		Ar << ClampMax;
-		Ar << UIMin;
-		Ar << UIMax;
-		
-		int DropDownCount = DropDownData.Num();
-		Ar << DropDownCount;
-		for (int i = 0; i < DropDownCount; ++i)
-		{
-			if (DropDownData.Num() <= i)
-			{
-				DropDownData.Add({});
-			}
-			Ar << DropDownData[i].Index;
-			Ar << DropDownData[i].Value;
-			Ar << DropDownData[i].Label;
-		}
-		
+		SerializeMetadata(Ar);
 		Ar << FrameLastUpdated;
 	}
 	
@@ -1943,6 +2279,28 @@ bool FTouchEngineDynamicVariableStruct::Serialize(FArchive& Ar)
 	return true;
 }
 
+void FTouchEngineDynamicVariableStruct::SerializeMetadata(FArchive& Ar)
+{
+	Ar << DefaultValue;
+	Ar << ClampMin;
+	Ar << ClampMax;
+	Ar << UIMin;
+	Ar << UIMax;
+	
+	int DropDownCount = DropDownData.Num();
+	Ar << DropDownCount;
+	for (int i = 0; i < DropDownCount; ++i)
+	{
+		if (DropDownData.Num() <= i)
+		{
+			DropDownData.Add({});
+		}
+		Ar << DropDownData[i].Index;
+		Ar << DropDownData[i].Value;
+		Ar << DropDownData[i].Label;
+	}
+}
+
 FString FTouchEngineDynamicVariableStruct::ExportValue(const EPropertyPortFlags PortFlags) const
 {
 	FString ValueStr;
@@ -2261,58 +2619,40 @@ void FTouchEngineDynamicVariableStruct::SendInput(const UTouchEngineInfo* Engine
 
 void FTouchEngineDynamicVariableStruct::SendInput(UE::TouchEngine::FTouchVariableManager& VariableManager, const FTouchEngineInputFrameData& FrameData)
 {
-	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("  I.Bb [GT] Cook Frame - Send Input"), STAT_TE_I_Bb, STATGROUP_TouchEngine);
-	
 	switch (VarType)
 	{
 	case EVarType::Bool:
 		{
 			const bool Op = GetValueAsBool();
-			VariableManager.SetBooleanInput(VarIdentifier, Op);
+			VariableManager.SetBooleanInput(VarIdentifier, Op, &LinkHandle);
 			break;
 		}
 	case EVarType::Int:
 		{
-			TArray<int32_t> Op;
-			if (Count <= 1)
-			{
-				Op.Add(GetValueAsInt());
-			}
-			else
-			{
-				const int* Buffer = GetValueAsIntArray();
-				Op.Append(Buffer, Count);
-			}
-			VariableManager.SetIntegerInput(VarIdentifier, Op);
+			// The values are sent straight from the variable, without copying them in a temporary array
+			const int32_t SingleValue = Count <= 1 ? GetValueAsInt() : 0;
+			const TArrayView<const int32_t> Op = Count <= 1 ? TArrayView<const int32_t>(&SingleValue, 1) : TArrayView<const int32_t>(GetValueAsIntArray(), Count);
+			VariableManager.SetIntegerInput(VarIdentifier, Op, &LinkHandle);
 			break;
 		}
 	case EVarType::Double:
 		{
-			TArray<double> Op;
-			if (Count > 1)
-			{
-				const double* Buffer = GetValueAsDoubleArray();
-				Op.Append(Buffer, Count);
-			}
-			else
-			{
-				Op.Add(GetValueAsDouble());
-			}
-
-			VariableManager.SetDoubleInput(VarIdentifier, Op);
+			const double SingleValue = Count > 1 ? 0.0 : GetValueAsDouble();
+			const TArrayView<const double> Op = Count > 1 ? TArrayView<const double>(GetValueAsDoubleArray(), Count) : TArrayView<const double>(&SingleValue, 1);
+			VariableManager.SetDoubleInput(VarIdentifier, Op, &LinkHandle);
 			break;
 		}
 	case EVarType::Float:
 		{
 			FTouchEngineCHOPChannel CHOPChannel;
 			CHOPChannel.Values.Add(GetValueAsFloat());
-			VariableManager.SetCHOPInputSingleSample(VarIdentifier, CHOPChannel);
+			VariableManager.SetCHOPInputSingleSample(VarIdentifier, CHOPChannel, &LinkHandle);
 			break;
 		}
 	case EVarType::CHOP:
 		{
 			const FTouchEngineCHOP CHOP = GetValueAsCHOP(); //no need to check if valid as this is checked down the track
-			VariableManager.SetCHOPInput(VarIdentifier, CHOP);
+			VariableManager.SetCHOPInput(VarIdentifier, CHOP, &LinkHandle);
 			break;
 		}
 	case EVarType::String:
@@ -2322,7 +2662,7 @@ void FTouchEngineDynamicVariableStruct::SendInput(UE::TouchEngine::FTouchVariabl
 				const auto AnsiString = StringCast<ANSICHAR>(*GetValueAsString());
 				const char* TempValue = AnsiString.Get();
 				const char* Op{TempValue};
-				VariableManager.SetStringInput(VarIdentifier, Op);
+				VariableManager.SetStringInput(VarIdentifier, Op, &LinkHandle);
 			}
 			else
 			{
@@ -2338,13 +2678,13 @@ void FTouchEngineDynamicVariableStruct::SendInput(UE::TouchEngine::FTouchVariabl
 					TETableSetStringValue(Op.TableData, i, 0, TCHAR_TO_UTF8(*channel[i]));
 				}
 
-				VariableManager.SetTableInput(VarIdentifier, Op);
+				VariableManager.SetTableInput(VarIdentifier, Op, &LinkHandle);
 			}
 			break;
 		}
 	case EVarType::Texture:
 		{
-			VariableManager.SetTOPInput(VarIdentifier, GetValueAsTexture(), FrameData);
+			VariableManager.SetTOPInput(VarIdentifier, GetValueAsTexture(), FrameData, &LinkHandle);
 			break;
 		}
 	default:
@@ -2358,30 +2698,36 @@ void FTouchEngineDynamicVariableStruct::SendInput(UE::TouchEngine::FTouchVariabl
 
 void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* EngineInfo)
 {
-	if (!EngineInfo)
+	if (EngineInfo && EngineInfo->Engine)
 	{
-		return;
+		if (const TSharedPtr<UE::TouchEngine::FTouchVariableManager> VariableManager = EngineInfo->Engine->GetVariableManager())
+		{
+			GetOutput(*VariableManager);
+		}
 	}
+}
 
-	FrameLastUpdated = EngineInfo->GetFrameLastUpdatedForParameter(VarIdentifier);
+void FTouchEngineDynamicVariableStruct::GetOutput(UE::TouchEngine::FTouchVariableManager& VariableManager)
+{
+	FrameLastUpdated = VariableManager.GetFrameLastUpdatedForParameter(VarIdentifier, &LinkHandle);
 	
 	switch (VarType)
 	{
 	case EVarType::Bool:
 		{
-			const bool Op = EngineInfo->GetBooleanOutput(VarIdentifier);
+			const bool Op = VariableManager.GetBooleanOutput(VarIdentifier, &LinkHandle);
 			SetValue(Op);
 			break;
 		}
 	case EVarType::Int:
 		{
-			const int32 Op = EngineInfo->GetIntegerOutput(VarIdentifier);
+			const int32 Op = VariableManager.GetIntegerOutput(VarIdentifier, &LinkHandle);
 			SetValue(Op);
 			break;
 		}
 	case EVarType::Double:
 		{
-			const double Op = EngineInfo->GetDoubleOutput(VarIdentifier);
+			const double Op = VariableManager.GetDoubleOutput(VarIdentifier, &LinkHandle);
 			SetValue(Op);
 			break;
 		}
@@ -2391,10 +2737,10 @@ void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* Engine
 		}
 	case EVarType::CHOP:
 		{
-			FTouchEngineCHOP Chop;
+			UE::TouchEngine::FTouchCHOPView Chop;
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.B.1a [GT] Post Cook - DynVar - Get Output CHOP"), STAT_TE_III_B_1_CHOPa, STATGROUP_TouchEngine);
-				Chop = EngineInfo->GetCHOPOutput(VarIdentifier); //no need to check if valid as this is checked down the track
+				Chop = VariableManager.GetCHOPOutputView(VarIdentifier, &LinkHandle);
 			}
 			{
 				DECLARE_SCOPE_CYCLE_COUNTER(TEXT("      III.B.1b [GT] Post Cook - DynVar - Get Output CHOP - SetValue"), STAT_TE_III_B_1_CHOPb, STATGROUP_TouchEngine);
@@ -2407,12 +2753,12 @@ void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* Engine
 		{
 			if (!bIsArray)
 			{
-				const TouchObject<TEString> Op = EngineInfo->GetStringOutput(VarIdentifier);
+				const TouchObject<TEString> Op = VariableManager.GetStringOutput(VarIdentifier, &LinkHandle);
 				SetValue(FString(UTF8_TO_TCHAR(Op->string)));
 			}
 			else
 			{
-				const FTouchDATFull Op = EngineInfo->GetTableOutput(VarIdentifier);
+				const FTouchDATFull Op = VariableManager.GetTableOutput(VarIdentifier, &LinkHandle);
 
 				TArray<FString> Buffer;
 
@@ -2434,7 +2780,7 @@ void FTouchEngineDynamicVariableStruct::GetOutput(const UTouchEngineInfo* Engine
 	case EVarType::Texture:
 		{
 			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("    III.B.1 [GT] Post Cook - DynVar - Get Output TOP"), STAT_TE_III_B_1_TOP, STATGROUP_TouchEngine);
-			UTexture2D* TOP = EngineInfo->GetTOPOutput(VarIdentifier);
+			UTexture2D* TOP = VariableManager.GetTOPOutput(VarIdentifier, &LinkHandle);
 			SetValue(TOP);
 			break;
 		}
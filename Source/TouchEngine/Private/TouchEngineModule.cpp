@@ -18,19 +18,45 @@
 #if WITH_EDITOR
 #include "MessageLogModule.h"
 #endif
+#include "Engine/Util/TouchCookWatchdog.h"
+#include "Engine/Util/TouchEngineComponentStats.h"
 #include "Interfaces/IPluginManager.h"
 #include "Rendering/TouchResourceProvider.h"
+#include "Rendering/Null/TouchEngineNullResourceProvider.h"
 #include "TouchEngine/TEResult.h"
+#include "Util/TouchEngineStatsGroup.h"
 
+#include "Engine/Engine.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
 
 #define LOCTEXT_NAMESPACE "TouchEngineModule"
 
+CSV_DEFINE_CATEGORY_MODULE(TOUCHENGINE_API, TouchEngine, false);
+
 namespace UE::TouchEngine
 {
 	void FTouchEngineModule::StartupModule()
 	{
 		LoadTouchEngineLib();
+		
+		// The NullRHI does not need a dedicated module like the other RHIs, as it does not depend on any RHI specific code
+		BindResourceProvider(TEXT("Null"), FResourceProviderFactory::CreateLambda([](const FResourceProviderInitArgs& Args)
+		{
+			return Null::MakeNullResourceProvider(Args);
+		}));
+
+		// The stat overlay can only be registered once the engine exists
+		if (GEngine)
+		{
+			RegisterComponentStatsOverlay();
+		}
+		else
+		{
+			PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&RegisterComponentStatsOverlay);
+		}
 
 #if WITH_EDITOR
 		// Register the Message Log Category
@@ -45,6 +71,9 @@ namespace UE::TouchEngine
 
 	void FTouchEngineModule::ShutdownModule()
 	{
+		FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+		UnregisterComponentStatsOverlay();
+		FTouchCookWatchdog::Shutdown();
 		ResourceFactories.Reset();
 		UnloadTouchEngineLib();
 
@@ -104,10 +133,17 @@ namespace UE::TouchEngine
 	void FTouchEngineModule::LoadTouchEngineLib()
 	{
 #if WITH_EDITOR
-		const FString BasePath = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir(), TEXT("/Binaries/ThirdParty/Win64"));
+		FString BasePath = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("TouchEngine"))->GetBaseDir(), TEXT("/Binaries/ThirdParty/Win64"));
 #else
-		const FString BasePath = FPaths::Combine(FPaths::ProjectDir(), TEXT("/Binaries/Win64"));
+		FString BasePath = FPaths::Combine(FPaths::ProjectDir(), TEXT("/Binaries/Win64"));
 #endif
+		// Allows loading another build of the library implementing the same C API, like the stub in Source/ThirdParty/TouchEngineStub to profile the cook pipeline without a TouchDesigner install
+		FString OverridePath;
+		if (FParse::Value(FCommandLine::Get(), TEXT("TouchEngineLibDir="), OverridePath) && !OverridePath.IsEmpty())
+		{
+			UE_LOG(LogTouchEngine, Log, TEXT("Loading TouchEngine library from the directory given on the command line: %s"), *OverridePath);
+			BasePath = MoveTemp(OverridePath);
+		}
 		const FString FullPathToDLL = FPaths::Combine(BasePath, TEXT("TouchEngine.dll"));
 		if (!FPaths::FileExists(FullPathToDLL))
 		{
@@ -120,6 +156,7 @@ namespace UE::TouchEngine
 		FPlatformProcess::PopDllDirectory(*BasePath);
 		
 		UE_CLOG(!IsTouchEngineLibInitialized(), LogTouchEngine, Error, TEXT("Failed to load TouchEngine library: %s"), *FullPathToDLL);
+		TouchEngineLibPath = IsTouchEngineLibInitialized() ? FullPathToDLL : FString();
 	}
 
 	void FTouchEngineModule::UnloadTouchEngineLib()
@@ -128,6 +165,7 @@ namespace UE::TouchEngine
 		{
 			FPlatformProcess::FreeDllHandle(TouchEngineLibHandle);
 			TouchEngineLibHandle = nullptr;
+			TouchEngineLibPath.Empty();
 		}
 	}
 }
@@ -31,6 +31,7 @@ namespace UE::TouchEngine
 
 		//~ Begin ITouchEngineModule Interface
 		virtual bool IsTouchEngineLibInitialized() const override;
+		virtual const FString& GetTouchEngineLibPath() const override { return TouchEngineLibPath; }
 		virtual void BindResourceProvider(const FString& NameOfRHI, FResourceProviderFactory FactoryDelegate) override;
 		virtual void UnbindResourceProvider(const FString& NameOfRHI) override;
 		virtual TSharedPtr<FTouchResourceProvider> CreateResourceProvider(const FString& NameOfRHI) override;
@@ -39,9 +40,11 @@ namespace UE::TouchEngine
 	private:
 
 		TMap<FString, FResourceProviderFactory> ResourceFactories;
+		FDelegateHandle PostEngineInitHandle;
 		
 		/** Result of loading lib */
 		void* TouchEngineLibHandle = nullptr;
+		FString TouchEngineLibPath;
 		
 		void LoadTouchEngineLib();
 		void UnloadTouchEngineLib();
@@ -14,10 +14,18 @@
 
 #include "ToxAsset.h"
 
+#include "Logging.h"
+#include "ToxAssetVersion.h"
 #include "EditorFramework/AssetImportData.h"
+#include "Engine/Util/TouchToxMetadataCache.h"
 #include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "HAL/PlatformFileManager.h"
+#include "UObject/ObjectSaveContext.h"
+#if WITH_EDITOR
+#include "Engine/Engine.h"
+#endif
 
 bool UToxAsset::IsRelativePath() const
 {
@@ -69,6 +77,15 @@ void UToxAsset::SetFilePath(FString InPath)
 	// AssetImportData->Update(GetAbsoluteFilePath());
 }
 
+TOptional<UE::TouchEngine::FTouchLoadResult> UToxAsset::GetBakedLoadResult() const
+{
+	if (!bHasBakedToxMetadata)
+	{
+		return {};
+	}
+	return UE::TouchEngine::FTouchLoadResult::MakeSuccess(BakedInputs, BakedOutputs);
+}
+
 void UToxAsset::PostInitProperties()
 {
 // #if WITH_EDITORONLY_DATA
@@ -103,8 +120,14 @@ void UToxAsset::Serialize(FArchive& Ar)
 	// 	AssetImportData->Update(GetAbsoluteFilePath());
 	// }
 	
+	Ar.UsingCustomVersion(FToxAssetVersion::GUID);
 	Super::Serialize(Ar);
 
+	if ((Ar.IsLoading() || Ar.IsSaving()) && Ar.CustomVer(FToxAssetVersion::GUID) >= FToxAssetVersion::AddedBakedToxMetadata)
+	{
+		SerializeBakedToxMetadata(Ar);
+	}
+
 	// if (Ar.IsLoading() && !AssetImportData && !HasAnyFlags(RF_ClassDefaultObject))
 	// {
 	// 	// AssetImportData should always be valid
@@ -114,7 +137,83 @@ void UToxAsset::Serialize(FArchive& Ar)
 	// }
 }
 
+void UToxAsset::SerializeBakedToxMetadata(FArchive& Ar)
+{
+	Ar << bHasBakedToxMetadata;
+	if (!bHasBakedToxMetadata)
+	{
+		return;
+	}
+	
+	Ar << BakedToxFileHash;
+	UE::TouchEngine::FTouchToxMetadataCache::SerializeVariables(Ar, BakedInputs);
+	UE::TouchEngine::FTouchToxMetadataCache::SerializeVariables(Ar, BakedOutputs);
+	if (Ar.IsLoading() && Ar.IsError())
+	{
+		UE_LOG(LogTouchEngine, Warning, TEXT("The baked tox metadata of '%s' could not be read. Components will wait for TouchEngine to load the tox file."), *GetPathName());
+		bHasBakedToxMetadata = false;
+		BakedInputs.Reset();
+		BakedOutputs.Reset();
+	}
+}
+
 #if WITH_EDITOR
+void UToxAsset::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+	
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		BakeToxMetadata(ObjectSaveContext.IsCooking());
+	}
+}
+
+void UToxAsset::BakeToxMetadata(bool bIsCooking)
+{
+	using namespace UE::TouchEngine;
+	
+	const FString AbsolutePath = GetAbsoluteFilePath();
+	const FMD5Hash FileHash = FMD5Hash::HashFile(*AbsolutePath);
+	if (!FileHash.IsValid())
+	{
+		UE_CLOG(bIsCooking, LogTouchEngine, Warning, TEXT("Unable to bake the tox metadata of '%s': the tox file '%s' could not be read."), *GetPathName(), *AbsolutePath);
+		return;
+	}
+	
+	// The subsystem has the most recent data if the file was loaded during this session, otherwise the metadata cache might know the file
+	TOptional<FTouchLoadResult> LoadResult;
+	const UTouchEngineSubsystem* TESubsystem = GEngine ? GEngine->GetEngineSubsystem<UTouchEngineSubsystem>() : nullptr;
+	if (const FTouchLoadResult* LoadedResult = TESubsystem ? TESubsystem->FindLoadedResult(this) : nullptr)
+	{
+		LoadResult = *LoadedResult;
+	}
+	else
+	{
+		LoadResult = FTouchToxMetadataCache::FindSynchronous_GameThread(AbsolutePath);
+	}
+
+	const FString FileHashString = LexToString(FileHash);
+	if (LoadResult && LoadResult->IsSuccess())
+	{
+		bHasBakedToxMetadata = true;
+		BakedInputs = LoadResult->SuccessResult->Inputs;
+		BakedOutputs = LoadResult->SuccessResult->Outputs;
+		BakedToxFileHash = FileHashString;
+	}
+	else if (bHasBakedToxMetadata && BakedToxFileHash != FileHashString)
+	{
+		UE_LOG(LogTouchEngine, Warning, TEXT("The baked tox metadata of '%s' is stale as the tox file '%s' has changed, and it was discarded. Load the tox file in the Editor and save the asset again to bake it."), *GetPathName(), *AbsolutePath);
+		bHasBakedToxMetadata = false;
+		BakedInputs.Reset();
+		BakedOutputs.Reset();
+		BakedToxFileHash.Reset();
+	}
+	else if (!bHasBakedToxMetadata && bIsCooking)
+	{
+		UE_LOG(LogTouchEngine, Display, TEXT("No tox metadata to bake in '%s'. Components using it will wait for TouchEngine to load the tox file '%s'."), *GetPathName(), *AbsolutePath);
+	}
+}
+
 void UToxAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
@@ -0,0 +1,88 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#include "Util/TouchEngineTrace.h"
+
+#if TOUCHENGINE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(TouchEngineChannel)
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, Component, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(uint32, ComponentId)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, CookStageBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int64, FrameID)
+	UE_TRACE_EVENT_FIELD(uint32, ComponentId)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, CookStageEnd)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int64, FrameID)
+	UE_TRACE_EVENT_FIELD(uint32, ComponentId)
+	UE_TRACE_EVENT_FIELD(uint8, Stage)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(TouchEngine, CookTimes)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int64, FrameID)
+	UE_TRACE_EVENT_FIELD(uint32, ComponentId)
+	UE_TRACE_EVENT_FIELD(double, CookStartTime)
+	UE_TRACE_EVENT_FIELD(double, CookEndTime)
+	UE_TRACE_EVENT_FIELD(bool, bWasFrameDropped)
+UE_TRACE_EVENT_END()
+
+namespace UE::TouchEngine::Trace
+{
+	void OutputComponent(uint32 ComponentId, const FString& ComponentName)
+	{
+		UE_TRACE_LOG(TouchEngine, Component, TouchEngineChannel)
+			<< Component.ComponentId(ComponentId)
+			<< Component.Name(*ComponentName, ComponentName.Len());
+	}
+
+	void OutputCookStageBegin(ECookStage Stage, const FTouchEngineInputFrameData& FrameData)
+	{
+		UE_TRACE_LOG(TouchEngine, CookStageBegin, TouchEngineChannel)
+			<< CookStageBegin.Cycle(FPlatformTime::Cycles64())
+			<< CookStageBegin.FrameID(FrameData.FrameID)
+			<< CookStageBegin.ComponentId(FrameData.ComponentId)
+			<< CookStageBegin.Stage(static_cast<uint8>(Stage));
+	}
+
+	void OutputCookStageEnd(ECookStage Stage, const FTouchEngineInputFrameData& FrameData)
+	{
+		UE_TRACE_LOG(TouchEngine, CookStageEnd, TouchEngineChannel)
+			<< CookStageEnd.Cycle(FPlatformTime::Cycles64())
+			<< CookStageEnd.FrameID(FrameData.FrameID)
+			<< CookStageEnd.ComponentId(FrameData.ComponentId)
+			<< CookStageEnd.Stage(static_cast<uint8>(Stage));
+	}
+
+	void OutputTouchEngineCookTimes(const FTouchEngineInputFrameData& FrameData, double CookStartTime, double CookEndTime, bool bWasFrameDropped)
+	{
+		UE_TRACE_LOG(TouchEngine, CookTimes, TouchEngineChannel)
+			<< CookTimes.Cycle(FPlatformTime::Cycles64())
+			<< CookTimes.FrameID(FrameData.FrameID)
+			<< CookTimes.ComponentId(FrameData.ComponentId)
+			<< CookTimes.CookStartTime(CookStartTime)
+			<< CookTimes.CookEndTime(CookEndTime)
+			<< CookTimes.bWasFrameDropped(bWasFrameDropped);
+	}
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include "Engine/TouchVariables.h"
 #include "Engine/Util/TouchErrorLog.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "TouchEngineDynamicVariableStruct.h"
 #include "TouchBlueprintFunctionLibrary.generated.h"
 
 struct FTouchEngineDynamicVariableStruct;
@@ -171,6 +172,35 @@ public:
 	UFUNCTION(meta = (BlueprintInternalUseOnly = "true"), BlueprintCallable, Category = "TouchEngine")
 	static bool GetEnumInputLatestByName(UTouchEngineComponentBase* Target, FString VarName, uint8& Value, int64& FrameLastUpdated, FString Prefix);
 
+	// Resolved Handles
+
+	/**
+	 * Looks up a variable of the TouchEngine Component once, so it can then be set every frame through the "Set ... By Handle" functions without being looked up again.
+	 * The Variable Name is the identifier of the variable including its prefix, like "p/MyParameter" or "i/MyInput", or its label.
+	 * The handle stays valid when the tox is reloaded as long as the variable still exists.
+	 * @return Returns True if the variable was found, otherwise false
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables", meta = (Keywords = "Find Variable Parameter Input"))
+	static bool ResolveVariableHandle(UTouchEngineComponentBase* Target, const FString& VarName, FTouchEngineDynamicVariableHandle& Handle);
+
+	// The setters below set the value of the variable a handle was resolved to. They return false if the variable does not exist anymore or has a different type
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetFloatByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, float Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetFloatArrayByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const TArray<float>& Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetIntByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, int32 Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetBoolByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, bool Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetStringByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FString& Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetLinearColorByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FLinearColor& Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetVectorByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FVector& Value);
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Variables")
+	static bool SetChopByHandle(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle, const FTouchEngineCHOP& Value);
+
 	/**
 	 * Force the recreation of the internal Texture Samplers based on the current value of the Texture Filter, AddressX, AddressY, AddressZ, and MipBias.
 	 * This can be called on any type of textures (even the ones not created by TouchEngine), but it might not work on all types if they have specific implementations.
@@ -240,6 +270,20 @@ public:
 private:
 	/** Returns the dynamic variable with the identifier in the TouchEngineComponent if possible. If the Variable is found, this also means that the given Target was not null. */
 	static FTouchEngineDynamicVariableStruct* TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix);
+	/** Same as TryGetDynamicVariable, but first waits for the outputs of the current Synchronized cook if they are late-latched. To be used by the output getters. */
+	static FTouchEngineDynamicVariableStruct* TryGetOutputDynamicVariable(UTouchEngineComponentBase* Target, const FString& VarName, const FString& Prefix);
+	/** Returns the dynamic variable the handle was resolved to in the TouchEngineComponent if possible. */
+	static FTouchEngineDynamicVariableStruct* TryGetDynamicVariable(UTouchEngineComponentBase* Target, const FTouchEngineDynamicVariableHandle& Handle);
+
+	/** Sets the value of the given variable if it has the right type, and logs an error otherwise. Shared by the "By Name" and "By Handle" setters */
+	static bool SetFloatValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, float Value, const FString& VarName);
+	static bool SetFloatArrayValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const TArray<float>& Value, const FString& VarName);
+	static bool SetIntValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, int32 Value, const FString& VarName);
+	static bool SetBoolValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, bool Value, const FString& VarName);
+	static bool SetStringValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FString& Value, const FString& VarName);
+	static bool SetLinearColorValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FLinearColor& Value, const FString& VarName);
+	static bool SetVectorValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FVector& Value, const FString& VarName);
+	static bool SetChopValue(UTouchEngineComponentBase* Target, FTouchEngineDynamicVariableStruct* DynVar, const FTouchEngineCHOP& Value, const FString& VarName);
 	/** Logs an error in the given UTouchEngineComponentBase struct */
 	static void LogTouchEngineError(const UTouchEngineComponentBase* Target, UE::TouchEngine::FTouchErrorLog::EErrorType ErrorType, const FString& VarName, const FName& FunctionName, const FString& AdditionalDescription = FString());
 };
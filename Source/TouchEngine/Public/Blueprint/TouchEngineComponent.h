@@ -19,6 +19,10 @@
 #include "TouchEngineDynamicVariableStruct.h"
 #include "Engine/TouchEngine.h"
 #include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchAdaptiveCookController.h"
+#include "Engine/Util/TouchCHOPSampleRing.h"
+#include "Engine/Util/TouchEngineComponentStats.h"
+#include "Engine/Util/TouchLockstepClock.h"
 #include "TouchEngineComponent.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogTouchEngineComponent, Display, All)
@@ -48,6 +52,25 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnToxFailedLoad, const FString&, Er
 DECLARE_MULTICAST_DELEGATE(FOnToxUnloaded_Native)
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnToxUnloaded);
 
+/*
+* The reasons for which the TouchEngine component restarts its TouchEngine instance
+*/
+UENUM(BlueprintType)
+enum class ETouchEngineRestartReason : uint8
+{
+	/** The TouchEngine process crashed */
+	Crashed = 0			UMETA(DisplayName = "Crashed"),
+	/** TouchEngine did not answer the cancellation of a cook which timed out */
+	Unresponsive = 1	UMETA(DisplayName = "Unresponsive"),
+	Max					UMETA(Hidden)
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTouchEngineLost_Native, ETouchEngineRestartReason /*Reason*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTouchEngineLost, ETouchEngineRestartReason, Reason);
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnTouchEngineRecovered_Native, ETouchEngineRestartReason /*Reason*/, double /*GapInSeconds*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTouchEngineRecovered, ETouchEngineRestartReason, Reason, double, GapInSeconds);
+
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStartFrame, const FTouchEngineInputFrameData&, FrameData);
 // The comment after FrameData was the only way found to give comments to event parameters
@@ -105,6 +128,36 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File")
 	ETouchEngineCookMode CookMode = ETouchEngineCookMode::Independent;
 
+	/**
+	 * Only used in Synchronized mode. When set to true, the GameThread does not wait for the cook right after starting it, but only when the outputs of this frame are first needed:
+	 * the first time an output is read through Get TouchEngine Output (or LatchSynchronizedCookOutputs is called), or at the end of the world tick if nothing read them before.
+	 * The outputs are still consumed in the frame they were cooked, and OnEndFrame is still called before the frame is rendered, but the actors ticking between the start of the cook
+	 * and the first read of the outputs run while TouchEngine cooks. OnEndFrame is called from within the first read of the outputs if it happens before the end of the world tick.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="CookMode==ETouchEngineCookMode::Synchronized"))
+	bool bLateLatchSynchronizedOutputs = false;
+
+	/**
+	 * Only used in Synchronized mode. When set to true, the component runs in lockstep with the rendered samples of an offline render like Movie Render Queue:
+	 * every tick cooks exactly once, at the exact time of the sample computed from LockstepFrameRate and LockstepTemporalSampleCount instead of the tick delta time,
+	 * and waits for the cook whatever its duration, up to LockstepCookTimeout. No frame is dropped and no input is discarded, and the render runs as fast as TouchEngine can cook.
+	 * The cook scheduler is bypassed in this mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="CookMode==ETouchEngineCookMode::Synchronized"))
+	bool bLockstepOfflineRender = false;
+
+	/** The frame rate of the offline render, which should match the output frame rate of the Movie Render Queue job */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bLockstepOfflineRender"))
+	FFrameRate LockstepFrameRate = FFrameRate(24, 1);
+
+	/** The number of temporal samples rendered per frame, which should match the Temporal Sample Count of the Movie Render Queue anti-aliasing settings. Each sample is one tick and one cook */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bLockstepOfflineRender", ClampMin=1, UIMin=1, UIMax=64))
+	int32 LockstepTemporalSampleCount = 1;
+
+	/** The number of seconds to wait for a cook in lockstep offline render mode before cancelling it. Replaces CookTimeout, as offline cooks are allowed to be slower than realtime */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bLockstepOfflineRender", ClampMin=0.01, UIMin=1, UIMax=300, ForceUnits="s"))
+	double LockstepCookTimeout = 60.0;
+
 	/** Mode for the component to set and get variables. Deprecated as a there shouldn't be a send mode and we should just  */
 	UPROPERTY(meta=(DeprecatedProperty, DeprecationMessage="There shouldn't be the need for a SendMode available to the user, the backend of the component will deal with this."))
 	ETouchEngineSendMode SendMode_DEPRECATED = ETouchEngineSendMode::EveryFrame;
@@ -128,6 +181,42 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", meta=(ClampMin=1, UIMin=1, UIMax=30))
 	int32 InputBufferLimit = 10;
 
+	/**
+	 * Sets the number of cooks in flight at the same time. This happens in DelayedSynchronized and Independent modes.
+	 * When set to 2, the inputs of the next cook are sent to TouchEngine as soon as it is done cooking the current frame, while the outputs of the current frame are being read,
+	 * so the next cook can start as soon as they are. When set to 1, the inputs are only sent once the outputs of the previous cook have been read.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, ClampMax=2, UIMin=1, UIMax=2))
+	int32 CookPipelineDepth = 1;
+
+	/**
+	 * When set to true, InputBufferLimit and CookPipelineDepth are only used as starting values and are adjusted while running, based on the time TouchEngine takes to cook,
+	 * the game frame time and the number of discarded inputs, to keep the latency as low as possible without discarding inputs.
+	 * When TouchEngine cooks slower than the game ticks, cooks are also submitted less often, with their delta time accumulated.
+	 * This happens in DelayedSynchronized and Independent modes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	bool bAdaptiveCookQueue = false;
+
+	/**
+	 * When set to true, the cooks of this component are started by the TouchEngine subsystem at the end of the frame instead of in the component tick,
+	 * together with the other scheduled components, ordered by priority and within the frame budget set by TouchEngine.Scheduler.FrameBudgetMs.
+	 * Useful to get predictable frame times with many TouchEngine components in the same level.
+	 * As the cooks only start once every actor of the world has ticked, the outputs are always at least one frame late for the other actors and components reading them from their tick,
+	 * and ordering their tick after this component does not change it. Only OnEndFrame is called with the outputs of the cook as soon as they are available.
+	 * Not used in Synchronized mode, which always cooks in the component tick so the outputs can be read in the same frame.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="CookMode!=ETouchEngineCookMode::Synchronized"))
+	bool bUseCookScheduler = false;
+
+	/** The cooks of the scheduled components with a higher priority are started first, and are the last to be postponed when the frame is over budget */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bUseCookScheduler"))
+	int32 CookPriority = 0;
+
+	/** The scheduler starts a cook of this component at most every N frames. Components with the same value are spread over different frames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bUseCookScheduler", ClampMin=1, UIMin=1, UIMax=10))
+	int32 CookEveryNFrames = 1;
+
 	/** Container for all dynamic variables */
 	UPROPERTY(EditAnywhere, meta = (NoResetToDefault), Category = "Tox File")
 	FTouchEngineDynamicVariableContainer DynamicVariables;
@@ -156,11 +245,14 @@ public:
 	/**
 	 * To import textures from TouchEngine, we need to create Frame UTextures into which we will copy the textures returned by TouchEngine.
 	 * For better performances, these Frame UTextures are returned to a texture pool once done to be reused.
-	 * This parameters sets how many Frame UTextures can be kept in the pool.
+	 * This parameters sets how much memory the Frame UTextures kept in the pool can use. When over budget, the textures of the sizes and formats used the least recently are released first.
 	 * This will only have an effect if changed before loading a tox file.
 	 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=1, UIMin=1, UIMax=30))
-	int32 ImportedTexturePoolSize = 20;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=0, UIMin=16, UIMax=2048, DisplayName="Imported Texture Pool Budget (MB)"))
+	int32 ImportedTexturePoolBudgetMB = 256;
+	/** Number of Frame UTextures kept in the imported texture pool. Deprecated as the pool is now limited by memory, it is converted to ImportedTexturePoolBudgetMB when set. */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter=SetImportedTexturePoolSize, Category = "Tox File", meta=(DeprecatedProperty, DeprecationMessage="The imported texture pool is now limited by memory, use ImportedTexturePoolBudgetMB instead."))
+	int32 ImportedTexturePoolSize_DEPRECATED = INDEX_NONE;
 	
 	/**
 	 * The number of second to wait for the tox file to load before cancelling.
@@ -171,10 +263,24 @@ public:
 	/**
 	 * The number of second to wait for a cook before cancelling it.
 	 * If the cook is not done by that time, the component will raise a TouchEngineCookTimeout error and will continue running.
+	 * The timeout is checked by a dedicated watchdog thread, so it is detected on time even if the GameThread hitches. If TouchEngine does not answer the cancellation of the cook either,
+	 * the instance is restarted (see TouchEngine.CookWatchdog.UnresponsiveTimeout).
 	 * Be careful of not using too high values in Synchronized mode as we are stalling the GameThread, the application could become unusable
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(ClampMin=0.01, UIMin=0.01, UIMax=0.5, ForceUnits="s"))
 	double CookTimeout = 0.3;
+
+	/**
+	 * When set to true, the component restarts its TouchEngine instance if the TouchEngine process crashes or stops responding, reloads the tox file
+	 * and sends the last value of every input with the first cook, so cooking resumes by itself. OnTouchEngineLost and OnTouchEngineRecovered are called around the restart.
+	 * When set to false, the component stops cooking until the tox file is loaded again.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay)
+	bool bRestartOnFailure = true;
+
+	/** The number of restarts attempted in a row without a successful cook in between before the component gives up and reports the tox file as failing to load */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tox File", AdvancedDisplay, meta=(EditCondition="bRestartOnFailure", ClampMin=1, UIMin=1, UIMax=10))
+	int32 MaxConsecutiveRestarts = 3;
 	
 	UTouchEngineComponentBase();
 
@@ -222,6 +328,29 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "TouchEngine|TOP")
 	bool KeepFrameTexture(UTexture2D* FrameTexture, UTexture2D*& Texture);
+
+	/**
+	 * Setter of the deprecated ImportedTexturePoolSize. Converts the number of textures to ImportedTexturePoolBudgetMB,
+	 * and applies the new budget to the imported texture pool right away if a tox file is loaded.
+	 */
+	UFUNCTION(BlueprintSetter, meta=(DeprecatedFunction, DeprecationMessage="The imported texture pool is now limited by memory, set ImportedTexturePoolBudgetMB instead."))
+	void SetImportedTexturePoolSize(int32 InImportedTexturePoolSize);
+
+	/**
+	 * Sets the frame and temporal sample cooked by the next tick in lockstep offline render mode. The following ticks carry on from there, one sample per tick.
+	 * To be called at the start of each shot of the render, or whenever the render jumps to another frame. The render starts from frame 0 otherwise.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TouchEngine|Offline Render")
+	void SetLockstepRenderFrame(FFrameNumber Frame, int32 TemporalSampleIndex = 0);
+
+	/**
+	 * Waits for the Synchronized cook started this frame with bLateLatchSynchronizedOutputs and reads its outputs, if it was not done already.
+	 * Called by the output getters, to be called before reading DynamicVariables directly from C++. Does nothing in the other cases.
+	 */
+	void LatchSynchronizedCookOutputs();
+
+	/** Returns true if the component cooks in lockstep with the rendered samples. See bLockstepOfflineRender */
+	bool IsUsingLockstepOfflineRender() const { return bLockstepOfflineRender && CookMode == ETouchEngineCookMode::Synchronized; }
 	
 	//~ Begin UObject Interface
 	virtual void BeginDestroy() override;
@@ -264,6 +393,28 @@ public:
 	FOnToxReset_Native& GetOnToxReset() { return OnToxReset_Native; }
 	FOnToxFailedLoad_Native& GetOnToxFailedLoad() { return OnToxFailedLoad_Native; }
 	FOnToxUnloaded_Native& GetOnToxUnloaded() { return OnToxUnloaded_Native; }
+	FOnTouchEngineLost_Native& GetOnTouchEngineLost() { return OnTouchEngineLost_Native; }
+	FOnTouchEngineRecovered_Native& GetOnTouchEngineRecovered() { return OnTouchEngineRecovered_Native; }
+
+	/** Returns the rolling stats of the cooks of this component, as displayed by the `TouchEngine.Stats` console command */
+	const UE::TouchEngine::FTouchEngineComponentStats& GetCookStats() const { return CookStats; }
+	void ResetCookStats() { CookStats.Reset(); }
+	/** Returns the current queue depth and pool sizes of the TouchEngine instance */
+	UE::TouchEngine::FTouchEngineInstanceStatsSnapshot GetInstanceStatsSnapshot() const;
+
+	/** Starts the cook requested to the cook scheduler. Only meant to be called by the FTouchCookScheduler */
+	void StartScheduledCook(float DeltaTime);
+
+	/**
+	 * Streams the samples of a time-dependent CHOP output into a ring buffer, which can be drained from any thread at its own rate, like audio or physics.
+	 * The ring is owned by the component and keeps being filled after the tox file is reloaded or TouchEngine is restarted. Returns the existing ring if the output is already streamed.
+	 */
+	TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing> GetOrCreateCHOPOutputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate);
+	/**
+	 * Streams samples into a CHOP input. Samples can be pushed into the returned ring buffer from any thread, and the ones available are sent to TouchEngine before every cook.
+	 * The ring is owned by the component and keeps being sent after the tox file is reloaded or TouchEngine is restarted. Returns the existing ring if the input is already streamed.
+	 */
+	TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing> GetOrCreateCHOPInputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate);
 
 protected:
 	/** Called when the TouchEngine instance starts to load the tox file */
@@ -291,6 +442,16 @@ protected:
 	FOnToxUnloaded OnToxUnloaded;
 	FOnToxUnloaded_Native OnToxUnloaded_Native;
 
+	/** Called when the TouchEngine instance crashed or stopped responding and is about to be restarted. Only called if bRestartOnFailure is set */
+	UPROPERTY(BlueprintAssignable, Category = "Components|Activation")
+	FOnTouchEngineLost OnTouchEngineLost;
+	FOnTouchEngineLost_Native OnTouchEngineLost_Native;
+
+	/** Called when the first cook of a restarted TouchEngine instance succeeded. GapInSeconds is the time during which no cook succeeded */
+	UPROPERTY(BlueprintAssignable, Category = "Components|Activation")
+	FOnTouchEngineRecovered OnTouchEngineRecovered;
+	FOnTouchEngineRecovered_Native OnTouchEngineRecovered_Native;
+
 	/** Called before sending the inputs to the TouchEngine */
 	UPROPERTY(BlueprintAssignable, Category = "Components|Parameters")
 	FOnStartFrame OnStartFrame;
@@ -311,6 +472,8 @@ protected:
 	void BroadcastOnToxReset(bool bInSkipBlueprintEvent = false);
 	void BroadcastOnToxFailedLoad(const FString& Error, bool bInSkipBlueprintEvent = false);
 	void BroadcastOnToxUnloaded(bool bInSkipBlueprintEvent = false);
+	void BroadcastOnTouchEngineLost(ETouchEngineRestartReason Reason);
+	void BroadcastOnTouchEngineRecovered(ETouchEngineRestartReason Reason, double GapInSeconds);
 	void BroadcastOnStartFrame(const FTouchEngineInputFrameData& FrameData) const;
 	void BroadcastOnEndFrame(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData) const;
 
@@ -326,10 +489,64 @@ private:
 
 	FDelegateHandle ParamsLoadedDelegateHandle;
 	FDelegateHandle LoadFailedDelegateHandle;
+
+	UE::TouchEngine::FTouchEngineComponentStats CookStats;
+	UE::TouchEngine::FTouchAdaptiveCookController AdaptiveCookController;
+	/** The delta time of the ticks for which the adaptive controller decided not to submit a cook, to be added to the next cook */
+	float AdaptiveSkippedDeltaTime = 0.f;
+
+	/** Returns true if the InputBufferLimit and CookPipelineDepth are driven by the AdaptiveCookController */
+	bool IsUsingAdaptiveCookQueue() const { return bAdaptiveCookQueue && CookMode != ETouchEngineCookMode::Synchronized; }
+	/** Returns true if the cooks are started by the cook scheduler of the subsystem instead of the component tick. The scheduler is not used in Synchronized mode */
+	bool IsUsingCookScheduler() const { return bUseCookScheduler && CookMode != ETouchEngineCookMode::Synchronized; }
+
+	/** Gives the exact time of each cook in lockstep offline render mode */
+	UE::TouchEngine::FTouchLockstepClock LockstepClock;
+
+	/** The CHOP streams requested by the user. They are kept here as the variable manager streaming them is recreated every time the tox file is loaded */
+	TMap<FString, TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing>> CHOPOutputStreams;
+	TMap<FString, TSharedRef<UE::TouchEngine::FTouchCHOPSampleRing>> CHOPInputStreams;
+	/** Binds the CHOP streams to the variable manager of the current TouchEngine instance, if it is loaded */
+	void BindCHOPStreams_GameThread();
+	/** Returns the number of seconds TouchEngine has to cook a frame, which is longer in lockstep offline render mode */
+	double GetEffectiveCookTimeout() const { return IsUsingLockstepOfflineRender() ? LockstepCookTimeout : CookTimeout; }
+	/** Returns the budget of the imported texture pool, converting ImportedTexturePoolSize_DEPRECATED if it was set */
+	int64 GetImportedTexturePoolBudgetInBytes();
 	
 	void StartNewCook(float DeltaTime);
+	/** Calls OnCookFinished on the GameThread once the cook is done */
+	TFuture<void> HandleCookResultWhenDone(TFuture<UE::TouchEngine::FCookFrameResult>&& CookFuture);
 	void OnCookFinished(const UE::TouchEngine::FCookFrameResult& CookFrameResult);
 
+	/** The cook started in Synchronized mode with bLateLatchSynchronizedOutputs, which is waited for by the first read of its outputs or at the end of the world tick */
+	struct FDeferredSynchronizedCook
+	{
+		TFuture<UE::TouchEngine::FCookFrameResult> CookFuture;
+		int64 FrameID;
+		uint64 StartCycles;
+	};
+	TOptional<FDeferredSynchronizedCook> DeferredSynchronizedCook;
+	FDelegateHandle OnWorldPostActorTickHandle;
+	
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	/** Waits for the deferred synchronized cook until its CookTimeout and calls OnCookFinished. If the cook is not done by then, its result is handled whenever it is done, like in the other modes */
+	void FinishDeferredSynchronizedCook();
+	/** Destroys the TouchEngine instance after it crashed or the cook watchdog found it unresponsive, and loads the tox file in a new instance. Gives up after MaxConsecutiveRestarts */
+	void RestartTouchEngine(ETouchEngineRestartReason Reason);
+	/** Called for the first successful cook after a restart, to report the gap during which the component could not cook */
+	void OnTouchEngineRecovered();
+
+	/** Set while the TouchEngine instance is being restarted, until the first successful cook of the new instance */
+	struct FPendingRestart
+	{
+		ETouchEngineRestartReason Reason;
+		/** When the failure was detected, to measure the time the component could not cook */
+		uint64 FailureCycles;
+	};
+	TOptional<FPendingRestart> PendingRestart;
+	/** The number of restarts since the last successful cook */
+	int32 NumConsecutiveRestarts = 0;
+
 	/**
 	 * Internal function to load the current ToxAsset
 	 * @param bForceReloadTox If set to true, we will force the asset to be reloaded, either through the Subsystem if in Editor, or through the component
@@ -341,12 +558,17 @@ private:
 	void HandleToxLoaded(const UE::TouchEngine::FTouchLoadResult& LoadResult, bool bLoadedLocalTouchEngine, bool bInSkipBlueprintEvents);
 	/* Copies the Default, Min, Max and Dropdown values of all input DynamicVariables from the given load result */
 	void EnsureToxMetadataIsSet(const UE::TouchEngine::FTouchLoadResult& LoadResult);
+	/** Binds the variables baked in the ToxAsset, so inputs can be set while TouchEngine is still loading the tox file. Returns false if the asset has no baked variables */
+	bool ApplyBakedToxMetadata();
+	/** Checks that the variables baked in the ToxAsset match the ones of the live instance. The live ones are used either way by HandleToxLoaded */
+	void ValidateBakedToxMetadata(const UE::TouchEngine::FTouchLoadResult& LoadResult) const;
 	/** Attempts to create an engine instance for this object. Should only be used for in world objects. */
 	TFuture<UE::TouchEngine::FTouchLoadResult> LoadToxThroughComponentInstance();
 	/** Loads or gets the cached data from the loading subsystem */
 	TFuture<UE::TouchEngine::FCachedToxFileInfo> LoadToxThroughCache(bool bForceReloadTox);
 	
-	void CreateEngineInfo();
+	/** @param bTakeInstanceFromPool Whether an idle instance of the subsystem instance pool should be used if this component does not have an instance yet. Only set when the .tox file will be loaded by this component */
+	void CreateEngineInfo(bool bTakeInstanceFromPool = false);
 
 	FString GetAbsoluteToxPath() const;
 	
@@ -354,7 +576,7 @@ private:
 
 	enum class EReleaseTouchResources
 	{
-		/** Completely destroys the TE process - TERelease will be called on the instance */
+		/** Completely destroys the TE process - TERelease will be called on the instance, unless it can be given back to the subsystem instance pool */
 		KillProcess,
 		/** Just calls TEInstanceUnload so the engine can be reused later. */
 		Unload
@@ -27,6 +27,9 @@ struct FTouchEngineInputFrameData
 
 	/** The time at which the frame started. Only used to compute the tick latency of the matching FTouchEngineOutputFrameData */
 	double StartTime = 0.0;
+
+	/** The unique ID of the component which started the frame. Only used to tag the trace events of the frame, see TouchEngineTrace.h */
+	uint32 ComponentId = 0;
 };
 
 USTRUCT(BlueprintType)
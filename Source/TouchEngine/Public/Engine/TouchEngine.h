@@ -82,12 +82,27 @@ namespace UE::TouchEngine
 		/** Will end up calling TERelease on the instance. Kills the process. */
 		void DestroyTouchEngine_GameThread();
 
+		/**
+		 * Starts a TE instance without any .tox file so it can be kept idle in the warm instance pool. The graphics context is associated and the instance configured with a null path.
+		 * The instance is loaded later by configuring it again with the .tox path, which keeps the running process.
+		 * The future is executed on the game thread with true once the instance is ready to load a .tox file.
+		 */
+		TFuture<bool> Prewarm_GameThread();
+		/** Sets up an idle instance taken from the warm instance pool to be used by the given component. The cook mode and frame rate are applied to the running instance. */
+		bool AdoptPooledInstance_GameThread(bool bIsIndependent, int64 FrameRate, UTouchEngineComponentBase* Component);
+		/** Unloads the .tox file and releases the data of the previous component, keeping the process alive so the instance can be returned to the warm instance pool. */
+		void ReleaseToPool_GameThread();
+
 		/** Returns the FrameID to be used for the next cook. */
 		int64 GetNextFrameID() const;
 
-		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+		TFuture<FCookFrameResult> CookFrame_GameThread(FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 PipelineDepth = 1);
 		/** Execute the next queued CookFrameRequest if no cook is on going */
 		bool ExecuteNextPendingCookFrame_GameThread() const;
+		/** Returns the number of cooks waiting for the current cook to be done */
+		int32 GetNumPendingCooks() const;
+		/** Gets the number of textures available in the import texture pool and the memory they use */
+		void GetImportedTexturePoolUsage(int32& OutNumPooledTextures, int64& OutPooledTexturesSizeInBytes) const;
 		
 		void SetCookMode(bool bIsIndependent);
 		bool SetFrameRate(int64 FrameRate);
@@ -96,11 +111,12 @@ namespace UE::TouchEngine
 			return TargetFrameRate;
 		}
 		bool SetExportedTexturePoolSize(int ExportedTexturePoolSize);
-		bool SetImportedTexturePoolSize(int ImportedTexturePoolSize);
+		bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes);
 
 		/* Code to be reviewed */
 		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier) const	{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutputSingleSample(Identifier) : FTouchEngineCHOP{}; }
 		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier) const				{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutput(Identifier) : FTouchEngineCHOP{}; }
+		FTouchCHOPView GetCHOPOutputView(const FString& Identifier) const			{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetCHOPOutputView(Identifier) : FTouchCHOPView{}; }
 		UTexture2D* GetTOPOutput(const FString& Identifier) const					{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetTOPOutput(Identifier) : nullptr; }
 		bool GetBooleanOutput(const FString& Identifier) const			{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetBooleanOutput(Identifier) : bool{}; }
 		double GetDoubleOutput(const FString& Identifier) const			{ return LoadState_GameThread == ELoadState::Ready && ensure(TouchResources.VariableManager) ? TouchResources.VariableManager->GetDoubleOutput(Identifier) : double{}; }
@@ -143,7 +159,12 @@ namespace UE::TouchEngine
 
 		void CancelCurrentAndNextCooks_GameThread(ECookFrameResult CookFrameResult);
 		bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
-		bool CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds);
+		/** Returns true if the cook watchdog found that TouchEngine stopped answering the cancellation of a timed-out cook. The instance needs to be restarted */
+		bool IsUnresponsive() const;
+		/** Returns true if TouchEngine reported that its process crashed. The instance needs to be restarted */
+		bool HasCrashed() const;
+		/** Returns true if the instance cannot cook anymore, either because it crashed or stopped responding, and needs to be restarted */
+		bool NeedsRestart() const { return IsUnresponsive() || HasCrashed(); }
 
 	private:
 		
@@ -204,6 +225,8 @@ namespace UE::TouchEngine
 		FCriticalSection LoadPromiseMutex;
 		/** Has a valid value while a load is active. */
 		TOptional<TPromise<FTouchLoadResult>> LoadPromise;
+		/** Has a valid value while Prewarm_GameThread is waiting for TEEventInstanceReady. Only accessed on the game thread. */
+		TOptional<TPromise<bool>> PrewarmPromise;
 
 		/** The value of StartTimeValue the last time we received a TouchEventCallback of value TEEventFrameDidFinish.
 		 * If this is the first one we receive, LastFrameStartTimeValue would not be set. */
@@ -218,6 +241,8 @@ namespace UE::TouchEngine
 		TFuture<FTouchLoadResult> LoadTouchEngine(const FString& InToxPath, double TimeoutInSeconds);
 		/** Create a TouchEngine instance, if none exists, and set up the engine with the tox path. This won't call TEInstanceLoad. */
 		bool InstantiateEngineWithToxFile(const FString& InToxPath);
+		/** Creates the resource provider and the TE instance, and associates the graphics context. Does not configure the instance with a tox file. */
+		bool CreateTouchEngineInstance();
 
 		// Handlers for loading tox
 		void TouchEventCallback_AnyThread(TEInstance* Instance, TEEvent Event, TEResult Result, int64_t StartTimeValue, int32_t StartTimeScale, int64_t EndTimeValue, int32_t EndTimeScale);
@@ -228,6 +253,7 @@ namespace UE::TouchEngine
 		TPair<TEResult, TArray<FTouchEngineDynamicVariableStruct>> ProcessTouchVariables(TEInstance* Instance, TEScope Scope);
 
 		void OnInstancedUnloaded_AnyThread();
+		void OnInstanceReady_AnyThread(TEResult Result);
 		void ResumeLoadAfterUnload_GameThread();
 
 		void LinkValue_AnyThread(TEInstance* Instance, TELinkEvent Event, const char* Identifier);
@@ -30,6 +30,7 @@ namespace UE::TouchEngine
 {
 	struct FTouchLoadResult;
 	class FTouchEngine;
+	class FTouchCHOPView;
     struct FCookFrameRequest;
     struct FCookFrameResult;
 }
@@ -62,6 +63,8 @@ public:
 	void Destroy();
 	
 	FTouchEngineCHOP GetCHOPOutput(const FString& Identifier) const;
+	/** Returns the CHOP output without copying its samples. Prefer this over GetCHOPOutput when the samples do not need to be in TArrays */
+	UE::TouchEngine::FTouchCHOPView GetCHOPOutputView(const FString& Identifier) const;
 	UTexture2D* GetTOPOutput(const FString& Identifier) const;
 	FTouchDATFull GetTableOutput(const FString& Identifier) const;
 	bool GetBooleanOutput(const FString& Identifier) const;
@@ -85,9 +88,10 @@ public:
 	 * @param CookFrameRequest The CookFrameRequest
 	 * @param InputBufferLimit  Sets the maximum number of cooks we will enqueue while another cook is processing by TouchEngine. If the limit is reached, older cooks will be discarded.
 	 * If set to less than 0, there will be no limit to the amount of cooks enqueued.
+	 * @param PipelineDepth The number of cooks in flight. When set to 2, the inputs of the next cook are sent as soon as TouchEngine is done with the current one, while its outputs are consumed.
 	 * @return 
 	 */
-	TFuture<UE::TouchEngine::FCookFrameResult> CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit);
+	TFuture<UE::TouchEngine::FCookFrameResult> CookFrame_GameThread(UE::TouchEngine::FCookFrameRequest&& CookFrameRequest, int32 InputBufferLimit, int32 PipelineDepth = 1);
 	/** Execute the next queued CookFrameRequest if no cook is on going */
 	bool ExecuteNextPendingCookFrame_GameThread() const;
 	
@@ -107,7 +111,6 @@ public:
 	 * @return Returns true if the frame with the GivenID was cancelled
 	 */
 	bool CancelCurrentFrame_GameThread(int64 FrameID, ECookFrameResult CookFrameResult = ECookFrameResult::Cancelled);
-	bool CheckIfCookTimedOut_GameThread(double CookTimeoutInSeconds);
 
 	TSharedPtr<UE::TouchEngine::FTouchEngine> Engine = nullptr;
 };
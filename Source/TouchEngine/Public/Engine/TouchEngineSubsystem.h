@@ -21,6 +21,7 @@
 #include "TouchEngineDynamicVariableStruct.h"
 #include "TouchLoadResults.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "Util/TouchRollingSampleWindow.h"
 #include "TouchEngineSubsystem.generated.h"
 
 class UToxAsset;
@@ -28,6 +29,9 @@ class UTouchEngineInfo;
 
 namespace UE::TouchEngine
 {
+	class FTouchCookScheduler;
+	class FTouchEngineInstancePool;
+	
 	struct TOUCHENGINE_API FCachedToxFileInfo
 	{
 		const FTouchLoadResult LoadResult;
@@ -42,7 +46,10 @@ namespace UE::TouchEngine
 	
 }
 
-/** Keeps a global list of loaded tox files. */
+/**
+ * Keeps a global list of loaded tox files.
+ * Up to TouchEngine.Subsystem.MaxConcurrentLoads files are loaded at the same time, each by its own TouchEngine instance. Identical requests are merged with the load already queued or running.
+ */
 UCLASS()
 class TOUCHENGINE_API UTouchEngineSubsystem : public UEngineSubsystem
 {
@@ -69,6 +76,8 @@ public:
 	bool IsSupportedPixelFormat(TEnumAsByte<ETextureRenderTargetFormat> PixelFormat) const;
 	
 	bool IsLoaded(const UToxAsset* ToxAsset) const;
+	/** Returns the cached result of the last successful load of the given asset, or nullptr if it is not loaded */
+	const UE::TouchEngine::FTouchLoadResult* FindLoadedResult(const UToxAsset* ToxAsset) const;
 	bool IsLoading(const UToxAsset* ToxAsset) const;
 	/** Check if the given asset has failed loading. Make sure to check that the file is not loading before calling this function */
 	bool HasFailedLoad(const UToxAsset* ToxAsset) const;
@@ -89,32 +98,78 @@ public:
 	 */
 	void LoadPixelFormats(const UTouchEngineInfo* ComponentEngineInfo);
 
-	TObjectPtr<UTouchEngineInfo> GetTempEngineInfo() const { return EngineForLoading; }
+	TObjectPtr<UTouchEngineInfo> GetTempEngineInfo() const { return LoaderEngines.IsEmpty() ? nullptr : LoaderEngines[0]; }
+
+	/** Describes the number of loads and the percentiles of their queue wait and load time, as output by TouchEngine.Subsystem.LoadStats */
+	TArray<FString> GetToxLoadStats() const;
+
+	/** The scheduler starting the cooks of the components which have bUseCookScheduler set. Only valid while the subsystem is initialized */
+	UE::TouchEngine::FTouchCookScheduler* GetCookScheduler() const { return CookScheduler.Get(); }
+	/** The pool of idle TouchEngine instances the components take their instance from. Only valid while the subsystem is initialized */
+	UE::TouchEngine::FTouchEngineInstancePool* GetInstancePool() const { return InstancePool.Get(); }
 	
 private:
 	struct FLoadTask
 	{
-		UToxAsset* ToxAsset;
-		TPromise<UE::TouchEngine::FCachedToxFileInfo> Promise;
+		TWeakObjectPtr<UToxAsset> ToxAsset;
+		FString AbsolutePath;
+		/** The promises of all the requests for this file, as identical requests are merged into a single task */
+		TArray<TPromise<UE::TouchEngine::FCachedToxFileInfo>> Promises;
 		double LoadTimeoutInSeconds;
+		/** True when the file is reloaded to refresh data found in the tox metadata cache. Nobody waits for these, so they are executed after the other tasks */
+		bool bIsRevalidation = false;
+		/** FPlatformTime::Seconds() when the task was queued and when its load started */
+		double EnqueueTime = 0.0;
+		double StartTime = 0.0;
+	};
+
+	/** The task being executed by the engine of LoaderEngines with the same index */
+	struct FLoader
+	{
+		TOptional<FLoadTask> ActiveTask;
+		/** Incremented for each load, so the result of a cancelled load is ignored */
+		uint64 LoadId = 0;
 	};
 	
-	TOptional<FLoadTask> ActiveTask;
+	TArray<FLoader> Loaders;
 	TArray<FLoadTask> TaskQueue;
 
+	UE::TouchEngine::TTouchRollingSampleWindow<256> LoadQueueWaitTimesMs;
+	UE::TouchEngine::TTouchRollingSampleWindow<256> LoadTimesMs;
+	uint64 NumLoadsCompleted = 0;
+	uint64 NumLoadRequestsMerged = 0;
+	uint64 NumLoadsCancelled = 0;
+
 	TMap<FString, UE::TouchEngine::FTouchLoadResult> CachedFileData;
 
 	// Temporary pointer needed to have IsLoading return true for this asset when it is starting to be processed in GetOrLoadParamsFromTox.
 	TWeakObjectPtr<UToxAsset> ToxAssetToStartLoading;
+	/** The assets being looked up in the tox metadata cache, for which IsLoading returns true */
+	TArray<TWeakObjectPtr<UToxAsset>> ToxAssetsReadingFromCache;
 
 	/** List of Supported EPixelFormat */
 	UPROPERTY(Transient)
 	TSet<TEnumAsByte<EPixelFormat>> CachedSupportedPixelFormats;
 
-	/** TouchEngine instance used to load items into the details panel */
+	/** TouchEngine instances used to load items into the details panel, one per entry of Loaders */
 	UPROPERTY(Transient)
-	TObjectPtr<UTouchEngineInfo> EngineForLoading;
-
-	TFuture<UE::TouchEngine::FCachedToxFileInfo> EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds);
-	void ExecuteLoadTask(FLoadTask&& LoadTask);
+	TArray<TObjectPtr<UTouchEngineInfo>> LoaderEngines;
+
+	TSharedPtr<UE::TouchEngine::FTouchCookScheduler> CookScheduler;
+	TSharedPtr<UE::TouchEngine::FTouchEngineInstancePool> InstancePool;
+
+	/** Looks for the parameters in the tox metadata cache saved on disk, and only loads the tox file if they are not found */
+	TFuture<UE::TouchEngine::FCachedToxFileInfo> LoadFromToxMetadataCache(UToxAsset* ToxAsset, double LoadTimeoutInSeconds);
+	TFuture<UE::TouchEngine::FCachedToxFileInfo> EnqueueOrExecuteLoadTask(UToxAsset* ToxAsset, double LoadTimeoutInSeconds, bool bIsRevalidation = false);
+	/** Starts the queued tasks on the idle loaders, up to TouchEngine.Subsystem.MaxConcurrentLoads at the same time */
+	void DispatchLoadTasks();
+	void ExecuteLoadTask(int32 LoaderIndex, FLoadTask&& LoadTask);
+	void OnLoadTaskFinished(int32 LoaderIndex, uint64 LoadId, const UE::TouchEngine::FTouchLoadResult& LoadResult);
+	/** Cancels the load of the given file if it is running, and queues it again with its promises. Used when the file is force reloaded, as the running load might have read an older version of the file */
+	void RestartActiveLoad(const FString& AbsolutePath);
+	/** Returns the task queued or running for the given file */
+	FLoadTask* FindLoadTask(const FString& AbsolutePath);
+	/** Inserts the task in the queue, before the revalidations if it is not one */
+	void InsertInQueue(FLoadTask&& LoadTask);
+	void UpdateLoadStats() const;
 };
\ No newline at end of file
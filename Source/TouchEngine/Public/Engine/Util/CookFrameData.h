@@ -51,6 +51,17 @@ enum class ECookFrameResult : uint8
 
 namespace UE::TouchEngine
 {
+	/** A time expressed as a number of ticks of a time scale, so it can be given to TouchEngine exactly instead of going through floating point seconds */
+	struct FTouchRationalTime
+	{
+		int64 Value = 0;
+		int32 Scale = 1;
+
+		double ToSeconds() const { return static_cast<double>(Value) / Scale; }
+		bool operator==(const FTouchRationalTime& Other) const { return Value == Other.Value && Scale == Other.Scale; }
+		bool operator!=(const FTouchRationalTime& Other) const { return !(*this == Other); }
+	};
+	
 	struct TOUCHENGINE_API FCookFrameRequest
 	{
 		/** The frame time in Seconds, with TimeScale not yet multiplied. */
@@ -60,8 +71,16 @@ namespace UE::TouchEngine
 		/** The FrameData information about the frame request. Contains a unique FrameID for this Cook */
 		FTouchEngineInputFrameData FrameData;
 
-		/** A copy of the variables and their values needed for that cook */
-		TMap<FString, FTouchEngineDynamicVariableStruct> VariablesToSend;
+		/** A copy of the values of the variables that changed for that cook */
+		FTouchEngineCookInputs VariablesToSend;
+
+		/** The number of seconds TouchEngine has to cook the frame once it is started before the cook watchdog cancels it. The cook is not watched if 0 */
+		double CookTimeoutInSeconds = 0.0;
+
+		/** When set, TouchEngine cooks the frame at exactly this time in TETimeExternal mode, instead of adding FrameTimeInSeconds to the time of the previous cook. Set by the lockstep offline render */
+		TOptional<FTouchRationalTime> ExactTime;
+		/** Set if ExactTime does not follow the time of the previous cook, like after a seek or a restart of TouchEngine */
+		bool bIsTimeDiscontinuity = false;
 	};
 
 	
@@ -84,7 +103,8 @@ namespace UE::TouchEngine
 		double TECookStartTime = 0.0;
 		/** The end_time returned by the TEInstanceEventCallback for this TE Cook. */
 		double TECookEndTime = 0.0;
-
+		/** The wall-clock time between the call to TEInstanceStartFrameAtTime and TouchEngine telling us the cook was done, in seconds. 0 if the cook was not started */
+		double CookDurationInSeconds = 0.0;
 
 		static FCookFrameResult FromCookFrameRequest(const FCookFrameRequest& CookRequest, ECookFrameResult ErrorCode, int64 FrameLastUpdated, TEResult TouchEngineInternalResult)
 		{
@@ -0,0 +1,75 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Adjusts the InputBufferLimit, the pipeline depth and the rate at which cooks are submitted based on the measured TouchEngine cook duration,
+	 * the game frame time and the number of discarded inputs, so the queue is deep enough to never discard inputs but no deeper, keeping the latency low.
+	 * Increases are applied as soon as they are needed while decreases need to be confirmed over several evaluations, so the values do not oscillate.
+	 * Only meant to be used from the GameThread.
+	 */
+	class TOUCHENGINE_API FTouchAdaptiveCookController
+	{
+	public:
+		/** The maximum InputBufferLimit the controller can choose, matching the maximum value exposed on the component */
+		static constexpr int32 MaxInputBufferLimit = 30;
+		/** The maximum number of ticks between two cooks the controller can choose */
+		static constexpr int32 MaxSubmissionInterval = 8;
+
+		/** Starts over from the given values, forgetting all measurements */
+		void Reset(int32 InInputBufferLimit, int32 InPipelineDepth);
+		bool IsInitialized() const { return bIsInitialized; }
+
+		/**
+		 * To be called every tick, before deciding to start a new cook.
+		 * @return True if a cook should be submitted this tick, false if it should be skipped as TouchEngine would not be able to process it before the next one anyway.
+		 */
+		bool ShouldSubmitCook_GameThread(float DeltaTime);
+		/** To be called when a cook submitted by the component is done */
+		void OnCookFinished_GameThread(const FCookFrameResult& CookFrameResult);
+
+		int32 GetInputBufferLimit() const { return InputBufferLimit; }
+		int32 GetPipelineDepth() const { return PipelineDepth; }
+		/** The number of ticks between two submitted cooks */
+		int32 GetSubmissionInterval() const { return SubmissionInterval; }
+
+	private:
+		bool bIsInitialized = false;
+		int32 InputBufferLimit = 1;
+		int32 PipelineDepth = 1;
+		int32 SubmissionInterval = 1;
+		int32 TicksSinceLastSubmission = 0;
+
+		/** Exponential moving average of the game frame time, in seconds */
+		double SmoothedFrameTime = 0.0;
+		/** Exponential moving average of the wall-clock time TouchEngine takes to cook a frame, in seconds */
+		double SmoothedCookDuration = 0.0;
+
+		/** The number of cooks finished and discarded since the last evaluation */
+		int32 NumCooksSinceEvaluation = 0;
+		int32 NumDiscardsSinceEvaluation = 0;
+		/** The number of consecutive evaluations which found the queue deeper than needed. The InputBufferLimit is only decreased after a few of them */
+		int32 NumEvaluationsAllowingShallowerQueue = 0;
+		int32 NumEvaluationsAllowingShorterInterval = 0;
+
+		void Evaluate();
+		void UpdateStats() const;
+	};
+}
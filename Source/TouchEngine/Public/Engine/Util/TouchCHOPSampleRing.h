@@ -0,0 +1,90 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+namespace UE::TouchEngine
+{
+	class FTouchCHOPView;
+
+	/**
+	 * Single producer, single consumer ring buffer of CHOP samples, used to stream time-dependent CHOPs between TouchEngine and code running at its own rate, like audio or physics.
+	 * The producer and the consumer can be on different threads without any lock. Samples are stored interleaved, one frame of NumChannels values per sample.
+	 * Each sample has a time expressed in samples, which is used to skip the samples which were already pushed and to detect the ones which never arrived,
+	 * so buffers overlapping each other or arriving at a different rate than the consumer drains them do not lose or duplicate samples.
+	 */
+	class TOUCHENGINE_API FTouchCHOPSampleRing
+	{
+	public:
+		FTouchCHOPSampleRing(int32 InNumChannels, int32 InCapacity, double InSampleRate);
+
+		int32 GetNumChannels() const { return NumChannels; }
+		int32 GetCapacity() const { return Capacity; }
+		double GetSampleRate() const { return SampleRate; }
+
+		/**
+		 * Producer only. Appends NumSamples samples of each channel, the first of which is at StartTime.
+		 * The samples before the time of the last pushed sample are skipped, and a gap since the last pushed sample is filled by holding the last pushed values.
+		 * Samples not fitting in the ring are dropped and counted in GetNumOverflowedSamples.
+		 * Returns the number of samples added to the ring.
+		 */
+		int32 Push(TArrayView<const float* const> Channels, int32 NumSamples, int64 StartTime);
+		/**
+		 * Producer only. Appends the samples of a CHOP received from TouchEngine. The samples of a CHOP which is not time-dependent are appended after the last pushed sample.
+		 * A CHOP whose number of channels or sample rate (if time-dependent) does not match the ring is rejected, logged once, and counted in GetNumRejectedBuffers.
+		 */
+		int32 Push(const FTouchCHOPView& CHOP);
+
+		/** Consumer only. Pops as many samples as available and fitting in OutSamples, written interleaved. Returns the number of samples popped */
+		int32 Pop(TArrayView<float> OutSamples);
+		/** Consumer only. Returns the number of samples which can be popped */
+		int32 NumAvailable() const;
+
+		/** Producer only. The time of the next sample expected by Push */
+		int64 GetNextPushTime() const { return NextPushTime.Get(0); }
+		/** The number of samples which were dropped because the consumer did not drain the ring fast enough */
+		uint64 GetNumOverflowedSamples() const { return NumOverflowedSamples.load(std::memory_order_relaxed); }
+		/** The number of samples which were filled in by holding the last values because they were missing from the pushed buffers */
+		uint64 GetNumHeldSamples() const { return NumHeldSamples.load(std::memory_order_relaxed); }
+		/** The number of CHOPs which were not pushed because their number of channels or sample rate did not match the ring */
+		uint64 GetNumRejectedBuffers() const { return NumRejectedBuffers.load(std::memory_order_relaxed); }
+
+	private:
+		const int32 NumChannels;
+		const int32 Capacity;
+		const double SampleRate;
+		TArray<float> Samples;
+
+		/** The total number of samples pushed and popped since the ring was created. Their difference is the number of samples currently in the ring */
+		std::atomic<uint64> NumPushed = 0;
+		std::atomic<uint64> NumPopped = 0;
+		std::atomic<uint64> NumOverflowedSamples = 0;
+		std::atomic<uint64> NumHeldSamples = 0;
+		std::atomic<uint64> NumRejectedBuffers = 0;
+
+		/** Producer only. The time of the sample following the last pushed one, unset until the first push */
+		TOptional<int64> NextPushTime;
+		/** Producer only. The last pushed value of each channel, used to fill gaps */
+		TArray<float> LastValues;
+		/** Producer only. True once a mismatching CHOP was logged, so a stream of them does not flood the log */
+		bool bHasLoggedMismatch = false;
+
+		/** Producer only. Writes NumSamples samples in the ring, calling GetValue(ChannelIndex, SampleIndex) for each value. Returns the number of samples written */
+		template<typename FGetValue>
+		int32 WriteSamples(int32 NumSamples, FGetValue&& GetValue);
+	};
+}
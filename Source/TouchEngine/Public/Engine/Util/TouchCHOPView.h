@@ -0,0 +1,67 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/TouchVariables.h"
+#include "TouchEngine/TEFloatBuffer.h"
+#include "TouchEngine/TouchObject.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Read-only view of a CHOP received from TouchEngine, pointing directly to the memory of its TEFloatBuffer.
+	 * The view holds a reference to the buffer so the channels stay valid as long as the view (or any copy of it) is alive.
+	 * Copying a view is cheap as it does not copy the samples. Use ToCHOP to get a FTouchEngineCHOP when Blueprint needs one.
+	 */
+	class TOUCHENGINE_API FTouchCHOPView
+	{
+	public:
+		FTouchCHOPView() = default;
+		explicit FTouchCHOPView(TouchObject<TEFloatBuffer> InBuffer);
+
+		bool IsValid() const { return Buffer.get() != nullptr; }
+		void Reset() { *this = FTouchCHOPView(); }
+
+		int32 GetNumChannels() const { return NumChannels; }
+		int32 GetNumSamples() const { return NumSamples; }
+		bool IsTimeDependent() const { return bIsTimeDependent; }
+		/** For time-dependent CHOPs, the time of the first sample, expressed in samples at the rate of the CHOP */
+		int64 GetStartTime() const { return StartTime; }
+		/** The number of samples per second, or -1 if no rate applies to the data */
+		double GetRate() const { return Rate; }
+		/** Returns the samples of the given channel, directly from the TEFloatBuffer memory */
+		TArrayView<const float> GetChannel(int32 ChannelIndex) const;
+		/** Returns the name of the given channel as stored in the TEFloatBuffer, or nullptr if the channel has no name */
+		const char* GetChannelNameANSI(int32 ChannelIndex) const;
+		FString GetChannelName(int32 ChannelIndex) const;
+		TArray<FString> GetChannelNames() const;
+
+		const TouchObject<TEFloatBuffer>& GetBuffer() const { return Buffer; }
+
+		/** Copies the samples into a FTouchEngineCHOP. Should only be called when the data is needed as TArrays, like in Blueprint */
+		FTouchEngineCHOP ToCHOP() const;
+
+	private:
+		TouchObject<TEFloatBuffer> Buffer;
+		int32 NumChannels = 0;
+		int32 NumSamples = 0;
+		bool bIsTimeDependent = false;
+		int64 StartTime = 0;
+		double Rate = -1.0;
+		const float* const* Channels = nullptr;
+		const char* const* ChannelNames = nullptr;
+	};
+}
@@ -0,0 +1,86 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "UObject/ObjectKey.h"
+
+class UTouchEngineComponentBase;
+
+namespace UE::TouchEngine
+{
+	/** How the cook scheduler treated a component, as displayed in the component stats */
+	struct FTouchCookSchedulerComponentStats
+	{
+		int32 Priority = 0;
+		int32 CookEveryNFrames = 1;
+		/** The number of cooks started by the scheduler */
+		uint64 NumScheduledCooks = 0;
+		/** The number of times a cook request was postponed to a later frame because of the budget or the policies */
+		uint64 NumDeferrals = 0;
+		/** Moving average of the GameThread time spent starting a cook of this component, in milliseconds */
+		double AverageGameThreadMs = 0.0;
+		/** Moving average of the share of the frame time spent starting the cooks of this component, in percent */
+		double UtilizationPercent = 0.0;
+	};
+	
+	/**
+	 * Starts the cooks of the components which opted in, once per frame after all actors have ticked, instead of each component starting its cook in its own tick.
+	 * Requests are processed by priority, then by the number of frames they have been waiting, while the GameThread time spent this frame is below the frame budget.
+	 * Components can be limited to cook at most every N frames, in which case their cooks are staggered so they do not all cook on the same frame.
+	 * A request is never postponed for more than TouchEngine.Scheduler.MaxDeferredFrames frames, and its delta time is accumulated while it waits.
+	 * Because the cooks start after the actor tick, their outputs can only be read by the other actors from their tick of the next frame, so components in Synchronized mode never use it.
+	 */
+	class TOUCHENGINE_API FTouchCookScheduler
+	{
+	public:
+		FTouchCookScheduler();
+		~FTouchCookScheduler();
+
+		/** Called by a component instead of starting a cook. The request is processed at the end of the frame */
+		void RequestCook(UTouchEngineComponentBase* Component, float DeltaTime);
+		/** Forgets the given component and its pending request */
+		void UnregisterComponent(const UTouchEngineComponentBase* Component);
+
+		/** Returns the stats of the given component, or an unset optional if it never requested a cook */
+		TOptional<FTouchCookSchedulerComponentStats> GetComponentStats(const UTouchEngineComponentBase* Component) const;
+
+	private:
+		struct FScheduledComponent
+		{
+			TWeakObjectPtr<UTouchEngineComponentBase> Component;
+			bool bHasPendingRequest = false;
+			/** The delta time accumulated since the last cook of this component */
+			float PendingDeltaTime = 0.f;
+			/** The GFrameCounter value when this component last cooked */
+			uint64 LastCookFrame = 0;
+			/** The number of consecutive frames a pending request has been postponed */
+			int32 NumFramesDeferred = 0;
+			/** The GameThread time spent starting this component's cook this frame, in seconds */
+			double GameThreadTimeThisFrame = 0.0;
+			FTouchCookSchedulerComponentStats Stats;
+		};
+
+		TMap<TObjectKey<UTouchEngineComponentBase>, FScheduledComponent> ScheduledComponents;
+		/** Incremented for each registered component, used to spread the components cooking every N frames over different frames */
+		uint32 NumComponentsRegistered = 0;
+		FDelegateHandle OnWorldPostActorTickHandle;
+
+		void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+		/** Returns true if the "cook every N frames" policy of the component allows it to cook this frame */
+		static bool IsEligibleThisFrame(const FScheduledComponent& Scheduled);
+	};
+}
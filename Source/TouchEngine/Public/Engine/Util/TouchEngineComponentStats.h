@@ -0,0 +1,108 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Engine/Util/TouchCookScheduler.h"
+#include "Util/TouchRollingSampleWindow.h"
+#include <atomic>
+
+class UTouchEngineComponentBase;
+
+namespace UE::TouchEngine
+{
+	/** The state of the TouchEngine instance of a component when its stats are displayed */
+	struct FTouchEngineInstanceStatsSnapshot
+	{
+		/** The number of cooks waiting in the frame cooker queue, including the staged one */
+		int32 NumPendingCooks = 0;
+		int32 NumPooledImportTextures = 0;
+		int64 PooledImportTexturesSizeInBytes = 0;
+
+		/** The values used for the next cook, either the ones set on the component or the ones chosen by the adaptive controller */
+		bool bIsAdaptive = false;
+		int32 InputBufferLimit = 0;
+		int32 PipelineDepth = 0;
+		int32 SubmissionInterval = 1;
+
+		/** Set if the cooks of the component are started by the cook scheduler */
+		TOptional<FTouchCookSchedulerComponentStats> SchedulerStats;
+	};
+	
+	/**
+	 * Keeps rolling statistics about the cooks of a UTouchEngineComponentBase, so the latency and drop rate of each instance can be checked while running
+	 * with the `TouchEngine.Stats [ComponentName]` console command and the `stat TouchEngineComponents` overlay.
+	 * Recording is lock-free and can be done from any thread.
+	 */
+	class TOUCHENGINE_API FTouchEngineComponentStats
+	{
+	public:
+		/** The number of cooks the percentiles are computed from */
+		static constexpr int32 WindowSize = 512;
+		
+		/** Records the result of a cook. The latencies are only recorded for successful cooks, and TickLatency is ignored when negative */
+		void RecordCookFinished(ECookFrameResult Result, const FTouchEngineOutputFrameData& FrameData);
+		/** Records that the TouchEngine instance was restarted after it crashed or the cook watchdog found it unresponsive */
+		void RecordRestart() { NumRestarts.fetch_add(1, std::memory_order_relaxed); }
+		/** Records the first successful cook after a restart, with the time during which no cook succeeded. Only called from the GameThread */
+		void RecordRecovery(double GapMs);
+		void Reset();
+
+		FTouchRollingSampleSummary GetLatencyMsSummary() const { return LatencyMs.GetSummary(); }
+		FTouchRollingSampleSummary GetTickLatencySummary() const { return TickLatency.GetSummary(); }
+		FTouchRollingSampleSummary GetTouchEngineCookDurationMsSummary() const { return TouchEngineCookDurationMs.GetSummary(); }
+
+		uint64 GetNumCooks() const { return NumCooks.load(std::memory_order_relaxed); }
+		uint64 GetNumFramesDropped() const { return NumFramesDropped.load(std::memory_order_relaxed); }
+		uint64 GetNumInputsDiscarded() const { return NumInputsDiscarded.load(std::memory_order_relaxed); }
+		uint64 GetNumTimeouts() const { return NumTimeouts.load(std::memory_order_relaxed); }
+		uint64 GetNumCancelled() const { return NumCancelled.load(std::memory_order_relaxed); }
+		uint64 GetNumErrors() const { return NumErrors.load(std::memory_order_relaxed); }
+		uint64 GetNumRestarts() const { return NumRestarts.load(std::memory_order_relaxed); }
+		uint64 GetNumRecoveries() const { return NumRecoveries.load(std::memory_order_relaxed); }
+		double GetLastRecoveryGapMs() const { return LastRecoveryGapMs.load(std::memory_order_relaxed); }
+		double GetMaxRecoveryGapMs() const { return MaxRecoveryGapMs.load(std::memory_order_relaxed); }
+		/** The percentage of the successful cooks that were dropped by TouchEngine */
+		double GetDropRatePercent() const;
+
+		/** Returns the stats as lines of text, as displayed by the console command and the overlay */
+		TArray<FString> ToStrings(const FTouchEngineInstanceStatsSnapshot& InstanceSnapshot) const;
+
+	private:
+		/** The time between the start of the frame and the outputs being available on the GameThread, in milliseconds */
+		TTouchRollingSampleWindow<WindowSize> LatencyMs;
+		/** The number of ticks between the start of the frame and the outputs being available on the GameThread */
+		TTouchRollingSampleWindow<WindowSize> TickLatency;
+		/** The time TouchEngine reported it took to cook the frames which were not dropped, in milliseconds */
+		TTouchRollingSampleWindow<WindowSize> TouchEngineCookDurationMs;
+
+		std::atomic<uint64> NumCooks { 0 };
+		std::atomic<uint64> NumSuccessfulCooks { 0 };
+		std::atomic<uint64> NumFramesDropped { 0 };
+		std::atomic<uint64> NumInputsDiscarded { 0 };
+		std::atomic<uint64> NumTimeouts { 0 };
+		std::atomic<uint64> NumCancelled { 0 };
+		std::atomic<uint64> NumErrors { 0 };
+		std::atomic<uint64> NumRestarts { 0 };
+		std::atomic<uint64> NumRecoveries { 0 };
+		std::atomic<double> LastRecoveryGapMs { 0.0 };
+		std::atomic<double> MaxRecoveryGapMs { 0.0 };
+	};
+
+	/** Registers the `stat TouchEngineComponents` overlay. GEngine needs to be initialized */
+	void RegisterComponentStatsOverlay();
+	void UnregisterComponentStatsOverlay();
+}
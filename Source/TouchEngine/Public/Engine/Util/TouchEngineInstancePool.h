@@ -0,0 +1,107 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTouchEngineComponentBase;
+
+namespace UE::TouchEngine
+{
+	class FTouchEngine;
+
+	/** How well the warm instance pool served the components */
+	struct FTouchEngineInstancePoolStats
+	{
+		/** The number of instances ready to be taken */
+		int32 NumIdleInstances = 0;
+		/** The number of instances being started or unloaded */
+		int32 NumPendingInstances = 0;
+		/** The number of loads which got an idle instance from the pool */
+		uint64 NumHits = 0;
+		/** The number of loads which had to start a new instance because the pool was empty */
+		uint64 NumMisses = 0;
+		/** The number of instances given back by components instead of being destroyed */
+		uint64 NumReturned = 0;
+		/** The number of instances started by the pool, and how many of them failed to start */
+		uint64 NumSpawned = 0;
+		uint64 NumSpawnFailures = 0;
+		/** The time it took to start the last instance, until it was ready to load a .tox file, in milliseconds */
+		double LastSpawnTimeMs = 0.0;
+		/** The average time it took to start an instance, in milliseconds */
+		double AverageSpawnTimeMs = 0.0;
+	};
+	
+	/**
+	 * Keeps TouchEngine instances started and idle, with their graphics context already associated, so components can load their .tox file without waiting for a TE process to start.
+	 * Components take an instance when loading their .tox file and give it back when they release their resources, instead of killing the process.
+	 * The number of idle instances to keep is set by TouchEngine.InstancePool.Size; the pool is disabled when it is 0, which is the default.
+	 * Only used on the game thread.
+	 */
+	class TOUCHENGINE_API FTouchEngineInstancePool : public TSharedFromThis<FTouchEngineInstancePool>
+	{
+	public:
+		FTouchEngineInstancePool();
+		~FTouchEngineInstancePool();
+
+		/**
+		 * Takes an idle instance out of the pool and sets it up with the given cook mode and frame rate for the given component.
+		 * Returns nullptr if there is no idle instance; a replacement is started in both cases.
+		 */
+		TSharedPtr<FTouchEngine> Acquire_GameThread(bool bIsIndependent, int64 FrameRate, UTouchEngineComponentBase* Component);
+		/**
+		 * Unloads the given engine and keeps its instance idle in the pool. If the pool is full, the engine replaces an instance which is still starting.
+		 * Returns false if the pool is full of idle instances or the engine has no usable instance, in which case the caller should destroy it.
+		 */
+		bool Release_GameThread(const TSharedPtr<FTouchEngine>& Engine);
+
+		/**
+		 * Starts or destroys instances until the pool holds the number of instances set by TouchEngine.InstancePool.Size.
+		 * @param bRetryAfterFailure After an instance failed to start, the pool is not refilled until this is set, to avoid starting processes in a loop.
+		 */
+		void Refill_GameThread(bool bRetryAfterFailure = false);
+		/** Destroys all the instances of the pool */
+		void Empty_GameThread();
+
+		const FTouchEngineInstancePoolStats& GetStats() const { return Stats; }
+		TArray<FString> ToStrings() const;
+
+	private:
+		struct FPooledInstance
+		{
+			TSharedPtr<FTouchEngine> Engine;
+			/** True until the TE process has started */
+			bool bIsStarting = false;
+			/** FPlatformTime::Seconds() when the instance was spawned or returned, used to time out the instances which never become idle */
+			double PendingStartTime = 0.0;
+		};
+		
+		TArray<FPooledInstance> Instances;
+		FTouchEngineInstancePoolStats Stats;
+		bool bHasSpawnFailed = false;
+		/** The number of successful spawns used for AverageSpawnTimeMs */
+		uint64 NumSpawnTimesAveraged = 0;
+		FDelegateHandle PostEngineInitHandle;
+
+		static int32 GetTargetSize();
+
+		void SpawnInstance_GameThread();
+		void OnInstanceSpawned_GameThread(const TSharedPtr<FTouchEngine>& Engine, bool bSuccess, double SpawnTimeInSeconds);
+		/** Destroys the instances which took too long to start or unload */
+		void RemoveTimedOutInstances_GameThread();
+		bool IsIdle(const FPooledInstance& Instance) const;
+		void UpdateStats();
+	};
+}
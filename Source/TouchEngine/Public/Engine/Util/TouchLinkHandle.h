@@ -0,0 +1,36 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Identifies a link in the link registry of a FTouchVariableManager, so the link can be found every frame without hashing its identifier.
+	 * A handle only means something to the variable manager which created it, which is checked with RegistryId. A handle coming from a previous
+	 * variable manager (after the tox file is reloaded or TouchEngine is restarted) is resolved again the next time it is used.
+	 */
+	struct FTouchLinkHandle
+	{
+		/** The id of the variable manager which created this handle, or 0 if the handle was never resolved */
+		uint32 RegistryId = 0;
+		/** The index of the link in the registry */
+		int32 Index = INDEX_NONE;
+
+		bool IsSet() const { return RegistryId != 0 && Index != INDEX_NONE; }
+		void Reset() { *this = FTouchLinkHandle(); }
+	};
+}
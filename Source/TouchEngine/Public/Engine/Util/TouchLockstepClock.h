@@ -0,0 +1,54 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Util/CookFrameData.h"
+#include "Misc/FrameNumber.h"
+#include "Misc/FrameRate.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Gives the exact time of each cook of a lockstep offline render, so every rendered sample is cooked by TouchEngine at exactly its time in the sequence.
+	 * The time of the sample N is N / (FrameRate * TemporalSampleCount). It is kept as a rational number so it never drifts, however long the render is.
+	 * Only meant to be used from the GameThread.
+	 */
+	class TOUCHENGINE_API FTouchLockstepClock
+	{
+	public:
+		/** Sets the frame rate and the number of temporal samples rendered per frame. Starts over from the first sample if they changed */
+		void Configure(const FFrameRate& InFrameRate, int32 InTemporalSampleCount);
+		/** Sets the frame and temporal sample of the next cook, like at the start of a shot or when the render jumps to another frame */
+		void SetNextSample(FFrameNumber Frame, int32 TemporalSampleIndex);
+		/** The next cook will be flagged as a discontinuity, like after TouchEngine was restarted */
+		void MarkDiscontinuity() { bNextIsDiscontinuity = true; }
+
+		/** Returns the time of the next cook and moves on to the following sample. bOutIsDiscontinuity is set if the time does not follow the previous one */
+		FTouchRationalTime ConsumeNextTime(bool& bOutIsDiscontinuity);
+		FTouchRationalTime GetTimeOfSample(int64 SampleIndex) const;
+		double GetSampleDurationInSeconds() const { return FrameRate.AsInterval() / TemporalSampleCount; }
+
+		const FFrameRate& GetFrameRate() const { return FrameRate; }
+		int32 GetTemporalSampleCount() const { return TemporalSampleCount; }
+		int64 GetNextSampleIndex() const { return NextSampleIndex; }
+
+	private:
+		FFrameRate FrameRate { 24, 1 };
+		int32 TemporalSampleCount = 1;
+		int64 NextSampleIndex = 0;
+		bool bNextIsDiscontinuity = true;
+	};
+}
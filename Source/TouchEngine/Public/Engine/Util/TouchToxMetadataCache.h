@@ -0,0 +1,52 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+struct FTouchEngineDynamicVariableStruct;
+
+namespace UE::TouchEngine
+{
+	struct FTouchLoadResult;
+	
+	/**
+	 * Persistent cache of the input and output variables parsed from .tox files, saved in Saved/TouchEngine/ToxMetadataCache so the details panel can be populated without starting TouchEngine.
+	 * Entries are keyed by the hash of the .tox file content and by the version of the TouchEngine library, so a modified file or a TouchEngine update never returns stale data.
+	 * Only successful loads are cached. Files are hashed, read and written on the thread pool, while the variables are serialized on the game thread.
+	 */
+	class TOUCHENGINE_API FTouchToxMetadataCache
+	{
+	public:
+		/** Looks for the cached variables of the given .tox file. The future is executed on the game thread, with an unset optional if there is no valid entry. */
+		static TFuture<TOptional<FTouchLoadResult>> Find_GameThread(const FString& AbsoluteToxPath);
+		/** Same as Find_GameThread but hashes and reads the entry on the calling thread. Meant for when the result is needed right away, like when a UToxAsset is saved or cooked */
+		static TOptional<FTouchLoadResult> FindSynchronous_GameThread(const FString& AbsoluteToxPath);
+		/** Saves the variables of a successful load of the given .tox file. Failed loads are ignored. */
+		static void Store_GameThread(const FString& AbsoluteToxPath, const FTouchLoadResult& LoadResult);
+		/** Returns true if the variables of the given load results are the same, comparing their serialized data */
+		static bool AreEqual_GameThread(const FTouchLoadResult& Lhs, const FTouchLoadResult& Rhs);
+		/** Serializes the variables with their metadata (default value, ranges and dropdown data). Used for the cache entries and for the metadata baked in UToxAsset */
+		static void SerializeVariables(FArchive& Ar, TArray<FTouchEngineDynamicVariableStruct>& Variables);
+		/** Deletes all the cached entries */
+		static void Clear();
+
+		/** Whether the cache is used, set by TouchEngine.ToxMetadataCache.Enabled */
+		static bool IsEnabled();
+		/** Whether cached entries are reloaded in the background to refresh them, set by TouchEngine.ToxMetadataCache.Revalidate */
+		static bool ShouldRevalidate();
+	};
+}
@@ -15,11 +15,17 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <string>
+
 #include "Async/Future.h"
 #include "TouchEngineDynamicVariableStruct.h"
 #include "Blueprint/TouchEngineInputFrameData.h"
 #include "Engine/TouchVariables.h"
+#include "Engine/Util/TouchCHOPSampleRing.h"
+#include "Engine/Util/TouchCHOPView.h"
+#include "Engine/Util/TouchLinkHandle.h"
 #include "TouchEngine/TouchObject.h"
+#include "TouchEngine/TEFloatBuffer.h"
 #include "TouchEngine/TEInstance.h"
 
 namespace UE::TouchEngine
@@ -58,28 +64,81 @@ namespace UE::TouchEngine
 		 */
 		UTexture2D* UpdateLinkedTOP(FName ParamName, UTexture2D* Texture);
 		
-		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier);
-		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier);
-		UTexture2D* GetTOPOutput(const FString& Identifier);
-		bool GetBooleanOutput(const FString& Identifier);
-		double GetDoubleOutput(const FString& Identifier);
-		int32_t GetIntegerOutput(const FString& Identifier);
-		TouchObject<TEString> GetStringOutput(const FString& Identifier);
-		FTouchDATFull GetTableOutput(const FString& Identifier) const;
+		/*
+		 * The getters and setters below find the link in the link registry from its identifier. Callers accessing the same link every frame
+		 * should pass a LinkHandle which is kept from call to call: it is resolved on the first call and then used instead of the identifier.
+		 */
+		
+		FTouchEngineCHOP GetCHOPOutputSingleSample(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		FTouchEngineCHOP GetCHOPOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		/** Returns a view of the CHOP output pointing directly to the TEFloatBuffer received from TouchEngine, without copying the samples */
+		FTouchCHOPView GetCHOPOutputView(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		UTexture2D* GetTOPOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		bool GetBooleanOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		double GetDoubleOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		int32_t GetIntegerOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		TouchObject<TEString> GetStringOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr);
+		FTouchDATFull GetTableOutput(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr) const;
 		TArray<FString> GetCHOPChannelNames(const FString& Identifier) const;
 
-		void SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel);
-		void SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP);
-		void SetTOPInput(const FString& Identifier, UTexture* Texture, const FTouchEngineInputFrameData& FrameData);
-		void SetBooleanInput(const FString& Identifier, const bool& Op);
-		void SetDoubleInput(const FString& Identifier, const TArray<double>& Op);
-		void SetIntegerInput(const FString& Identifier, const TArray<int32_t>& Op);
-		void SetStringInput(const FString& Identifier, const char*& Op);
-		void SetTableInput(const FString& Identifier, const FTouchDATFull& Op);
+		void SetCHOPInputSingleSample(const FString& Identifier, const FTouchEngineCHOPChannel& CHOPChannel, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetCHOPInput(const FString& Identifier, const FTouchEngineCHOP& CHOP, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetTOPInput(const FString& Identifier, UTexture* Texture, const FTouchEngineInputFrameData& FrameData, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetBooleanInput(const FString& Identifier, const bool& Op, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetDoubleInput(const FString& Identifier, TArrayView<const double> Op, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetIntegerInput(const FString& Identifier, TArrayView<const int32_t> Op, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetStringInput(const FString& Identifier, const char*& Op, FTouchLinkHandle* LinkHandle = nullptr);
+		void SetTableInput(const FString& Identifier, const FTouchDATFull& Op, FTouchLinkHandle* LinkHandle = nullptr);
+
+		/**
+		 * Starts streaming the samples of a time-dependent CHOP output into a ring buffer, which can then be drained from any thread at its own rate.
+		 * The ring is filled every time the output is retrieved after a cook. Returns the existing ring if the output is already streamed.
+		 */
+		TSharedRef<FTouchCHOPSampleRing> GetOrCreateCHOPOutputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate);
+		/**
+		 * Starts streaming samples into a CHOP input. Samples can be pushed into the returned ring buffer from any thread, and the ones available
+		 * are sent to TouchEngine as a time-dependent buffer before every cook. Returns the existing ring if the input is already streamed.
+		 */
+		TSharedRef<FTouchCHOPSampleRing> GetOrCreateCHOPInputStream_GameThread(const FString& Identifier, int32 NumChannels, int32 CapacityInSamples, double SampleRate);
+		/**
+		 * Streams a CHOP output into a ring created by the caller, replacing the ring previously streaming this output if any.
+		 * Used to keep streaming into the same ring when the variable manager is recreated, like when the tox file is reloaded.
+		 */
+		void BindCHOPOutputStream_GameThread(const FString& Identifier, const TSharedRef<FTouchCHOPSampleRing>& Ring);
+		/** Streams the samples of a ring created by the caller into a CHOP input, replacing the ring previously streamed into this input if any */
+		void BindCHOPInputStream_GameThread(const FString& Identifier, const TSharedRef<FTouchCHOPSampleRing>& Ring);
+		/** Sends the samples pushed into the CHOP input streams since the last call. Called when the inputs of a cook are sent */
+		void SendCHOPInputStreams_GameThread();
 
-		/** Sets in which frame a TouchEngine Parameter was last updated. This should come from a LinkValue Callback */
-		void SetFrameLastUpdatedForParameter(const FString& Identifier, int64 FrameID);
-		int64 GetFrameLastUpdatedForParameter(const FString& Identifier);
+		/**
+		 * Records that a TouchEngine output received a new value, so it is fetched by the next call to TakeChangedOutputs_GameThread. This should come from a LinkValue Callback.
+		 * If the value changed during a cook, FrameID is the frame of that cook and is recorded as the frame the output was last updated, otherwise it should be -1.
+		 */
+		void RecordOutputValueChanged_AnyThread(const FTouchLinkHandle& LinkHandle, int64 FrameID);
+		int64 GetFrameLastUpdatedForParameter(const FString& Identifier, FTouchLinkHandle* LinkHandle = nullptr) const;
+		/**
+		 * Fills OutChangedLinks with the outputs which received a new value since the last call, indexed by the Index of their link handle,
+		 * and starts recording again from no changed outputs.
+		 */
+		void TakeChangedOutputs_GameThread(TBitArray<>& OutChangedLinks);
+
+		/**
+		 * Registers the given variables in the link registry, so their ANSI identifier and their TELinkInfo are computed once instead of every frame,
+		 * and stores their link handle on them. Should be called once the tox file has been loaded. Links not registered here are added to the registry the first time they are accessed.
+		 */
+		void RegisterLinks_GameThread(const TArray<FTouchEngineDynamicVariableStruct>& Variables);
+		/** Returns the handle of the given link in the link registry, adding it to the registry if needed. The handle stays valid for the lifetime of this variable manager. */
+		FTouchLinkHandle FindOrAddLinkHandle(const FString& Identifier) const;
+		/** Same as above, for the identifiers received from TouchEngine. Does not allocate unless the link is not registered yet, so it can be called from the link callbacks */
+		FTouchLinkHandle FindOrAddLinkHandle_AnyThread(const char* Identifier) const;
+		/** Returns CachedHandle if it was created by this variable manager, otherwise finds the handle of the link and stores it in CachedHandle */
+		FTouchLinkHandle ResolveLinkHandle(const FString& Identifier, FTouchLinkHandle& CachedHandle) const;
+		/** Returns the identifier of the given link. The reference stays valid for the lifetime of this variable manager */
+		const FString& GetLinkIdentifier(const FTouchLinkHandle& LinkHandle) const;
+		/** Returns the cached TELinkInfo of the given link, calling TEInstanceLinkGetInfo only if the link info was never retrieved or has been invalidated. */
+		TEResult GetCachedLinkInfo_AnyThread(const FTouchLinkHandle& LinkHandle, TouchObject<TELinkInfo>& LinkInfo) const;
+		/** Marks the cached TELinkInfo of the given link as outdated. Should be called when TouchEngine notifies us that a link was added, removed or modified */
+		void InvalidateLinkInfo_AnyThread(const FTouchLinkHandle& LinkHandle);
 
 		/** Empty the saved data. Should be called before trying to close TE to be sure we do not keep hold on any pointer */
 		void ClearSavedData();
@@ -92,30 +151,104 @@ namespace UE::TouchEngine
 			bool bIsAwaitingFinalisation = false;
 		};
 
+		/** Everything we need to know about a link to get or set its value, computed once and reused every frame */
+		struct FLinkRegistryEntry
+		{
+			/** The identifier converted to ANSI. Never modified once the entry is created, so pointers to it stay valid */
+			std::string IdentifierANSI;
+			/** The identifier, used for logging. Never modified once the entry is created */
+			FString Identifier;
+			/** The result of the last call to TEInstanceLinkGetInfo for this link */
+			TEResult LinkInfoResult = TEResultSuccess;
+			/** The cached scope, type and count of the link. Only valid if LinkInfoResult is TEResultSuccess */
+			TouchObject<TELinkInfo> LinkInfo;
+			/** True when LinkInfo has not been retrieved yet, or when TouchEngine told us the link has changed since it was retrieved */
+			bool bNeedsRefresh = true;
+			/** The FrameID the output was last updated, or -1 if it was never updated during a cook */
+			int64 FrameLastUpdated = -1;
+		};
+
+		/** The float buffers used to send the values of a CHOP input, reused from frame to frame as long as the CHOP keeps the same layout */
+		struct FCHOPInputBufferPool
+		{
+			int32 NumChannels = -1;
+			int32 Capacity = -1;
+			uint32 ChannelNamesHash = 0;
+			/** The channel names converted once to ANSI, which only needs to happen again when the names change */
+			TArray<std::string> ChannelNamesANSI;
+			/** Pointers to ChannelNamesANSI, or nullptr for the channels without a name. Empty if none of the channels have a name */
+			TArray<const char*> ChannelNames;
+			TArray<TouchObject<TEFloatBuffer>> Buffers;
+			int32 NextBufferIndex = 0;
+			/** Pointers to the values of each channel, kept to avoid allocating a new array every frame */
+			TArray<const float*> DataPointers;
+		};
+		/**
+		 * The number of buffers each CHOP input rotates through. TouchEngine might still be reading the buffer sent for the cook in progress when
+		 * the inputs of the next cook are sent, so a buffer is only written to again once the cooks it was sent for are done.
+		 */
+		static constexpr int32 CHOP_INPUT_BUFFERS_PER_LINK = 3;
+
+		/** Unique to each variable manager, so link handles created by a previous variable manager are not mistaken for ours */
+		const uint32 RegistryId;
 		TouchObject<TEInstance> TouchEngineInstance;
 		TSharedPtr<FTouchResourceProvider> ResourceProvider;
 		TSharedPtr<FTouchErrorLog> ErrorLog;
 
-		TMap<FString, FTouchEngineCHOPChannel> CHOPChannelOutputs;
-		TMap<FString, FTouchEngineCHOP> CHOPOutputs;
+		TMap<FString, TSharedRef<FTouchCHOPSampleRing>> CHOPOutputStreams;
+		struct FCHOPInputStream
+		{
+			TSharedRef<FTouchCHOPSampleRing> Ring;
+			FTouchLinkHandle LinkHandle;
+			/** The time of the next sample to send, expressed in samples at the rate of the ring */
+			int64 NextSampleTime = 0;
+			/** The samples popped from the ring, kept to avoid allocating a new array every frame */
+			TArray<float> InterleavedSamples;
+			TArray<float> ChannelSamples;
+			TArray<const float*> DataPointers;
+		};
+		TMap<FString, FCHOPInputStream> CHOPInputStreams;
+		TMap<FString, FTouchCHOPView> CHOPOutputs;
+		TMap<FString, FCHOPInputBufferPool> CHOPInputBufferPools;
 		TMap<FName, TouchObject<TETexture>> TOPInputs;
 		FCriticalSection TOPInputsLock;
 		TMap<FName, UTexture2D*> TOPOutputs;
 		FCriticalSection TOPOutputsLock;
 
-		/** The FrameID the parameters were last updated */
-		TMap<FString, int64> LastFrameParameterUpdated; //todo: could this be a FName? we would need more guarantees on what names can be given to TouchEngine parameters to ensure no clashes
+		/** The link registry. Entries are never removed, so their index can be used as a handle. Entries are heap allocated so their ANSI identifier never moves */
+		mutable TArray<TUniquePtr<FLinkRegistryEntry>> LinkRegistry;
+		/**
+		 * Maps the CRC of the ANSI identifier of a link to its index in LinkRegistry. Keyed by CRC so the identifiers received in the TouchEngine
+		 * callbacks can be looked up without converting them to FString. Collisions are resolved by comparing with the identifier of the entry.
+		 */
+		mutable TMultiMap<uint32, int32> LinkIndicesByHash;
+		/** The outputs which received a TELinkEventValueChange since the outputs were last fetched, indexed by link. Only these need to be fetched after a cook */
+		TBitArray<> ChangedOutputs;
+		/** The registry and ChangedOutputs are read on the GameThread and written from the TouchEngine link callbacks */
+		mutable FCriticalSection LinkRegistryLock;
+
+		/** Returns the pool of the given CHOP input, reset if the number of channels, the capacity or the channel names changed since the last call */
+		FCHOPInputBufferPool& FindOrResetCHOPInputBufferPool(const FString& Identifier, TArrayView<const FTouchEngineCHOPChannel> Channels, int32 NumChannels, int32 Capacity);
+		/** Returns the next buffer of the pool to be filled with new values, creating it if needed */
+		TouchObject<TEFloatBuffer> AcquireCHOPInputBuffer(FCHOPInputBufferPool& Pool);
+
+		/** Returns the index of the link in LinkRegistry, or INDEX_NONE if it is not registered. LinkRegistryLock must be held */
+		int32 FindLinkIndex(const char* Identifier, uint32 IdentifierHash) const;
+		/** Returns the cached info of the link, calling TEInstanceLinkGetInfo first if it is outdated. */
+		TEResult ResolveLinkInfo(int32 LinkIndex, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr) const;
 
 		/**
-		 * Helper Function to call TEInstanceLinkGetInfo and take care of common error logging.
+		 * Helper Function to get the cached link info from the link registry and take care of common error logging.
 		 * Returns true if TEInstanceLinkGetInfo was successful, as well as the expected scope and type matches.
+		 * IdentifierAsCStr is set to the ANSI identifier stored in the registry, which can be passed to the TouchEngine API.
+		 * If LinkHandle is given, it is used to find the link instead of the identifier, and is resolved first if needed.
 		 */
-		bool GetLinkInfo(const FString& Identifier,TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const;
+		bool GetLinkInfo(const FString& Identifier, FTouchLinkHandle* LinkHandle, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr, TEScope ExpectedScope, TELinkType ExpectedType, const FName& FunctionName) const;
 		/**
-		 * Helper Function to call TEInstanceLinkGetInfo and take care of common error logging.
+		 * Helper Function to get the cached link info from the link registry and take care of common error logging.
 		 * Returns true if TEInstanceLinkGetInfo was successful, as well as the expected scope and type matches.
 		 * This overload does not check for the type, if multiple types can be specified for example
 		 */
-		bool GetLinkInfo(const FString& Identifier,TouchObject<TELinkInfo>& LinkInfo, TEScope ExpectedScope, const FName& FunctionName) const;
+		bool GetLinkInfo(const FString& Identifier, FTouchLinkHandle* LinkHandle, TouchObject<TELinkInfo>& LinkInfo, const char*& IdentifierAsCStr, TEScope ExpectedScope, const FName& FunctionName) const;
 	};
 }
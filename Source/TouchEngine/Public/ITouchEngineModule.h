@@ -52,6 +52,8 @@ namespace UE::TouchEngine
 
 		/** Whether the TouchEngine library was initialized successfully. You can use this to avoid certain calls in error state. */
 		virtual bool IsTouchEngineLibInitialized() const = 0;
+		/** The path of the loaded TouchEngine library. Empty if the library failed to load. */
+		virtual const FString& GetTouchEngineLibPath() const = 0;
 		
 		/** Registers a resource provider for the given RHI */
 		virtual void BindResourceProvider(const FString& NameOfRHI, FResourceProviderFactory FactoryDelegate) = 0;
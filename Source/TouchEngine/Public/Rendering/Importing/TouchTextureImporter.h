@@ -19,6 +19,7 @@
 
 #include "Rendering/TouchResourceProvider.h"
 #include "Util/TaskSuspender.h"
+#include "Util/TouchRingBuffer.h"
 
 #include "Async/TaskGraphInterfaces.h"
 
@@ -73,11 +74,19 @@ namespace UE::TouchEngine
 			return false;
 		}
 
-		/** The maximum size of the Importing texture pool */
-		int32 PoolSize = 10;
+		/** Returns the number of textures available in the pool and the memory they use */
+		void GetTexturePoolUsage(int32& OutNumPooledTextures, int64& OutPooledTexturesSizeInBytes)
+		{
+			FScopeLock Lock(&TexturePoolMutex);
+			OutNumPooledTextures = NumPooledTextures;
+			OutPooledTexturesSizeInBytes = PooledTexturesSizeInBytes;
+		}
+
+		/** The maximum amount of memory, in bytes, the textures of the Importing texture pool can use */
+		int64 PoolBudgetInBytes = 256 * 1024 * 1024;
 		/**
-		 * Ensure the number of available textures in the pool is less than the PoolSize.
-		 * We could have more textures in the pool than the PoolSize as we are not removing textures recently added to the pool.
+		 * Ensure the memory used by the available textures in the pool is less than the PoolBudgetInBytes, evicting the least recently used sizes first.
+		 * We could go over the PoolBudgetInBytes as we are not removing textures recently added to the pool.
 		 */
 		void TexturePoolMaintenance(const FTouchEngineInputFrameData& FrameData);
 
@@ -122,9 +131,36 @@ namespace UE::TouchEngine
 			int64 PooledFrameID;
 			TObjectPtr<UTexture2D> UETexture;
 		};
+		/** The description of the textures a pool bucket holds. A TE texture can be copied into any texture of the bucket with the same description */
+		struct FTexturePoolKey
+		{
+			uint32 SizeX;
+			uint32 SizeY;
+			EPixelFormat PixelFormat;
+			bool bIsSRGB;
+
+			bool operator==(const FTexturePoolKey& Other) const { return SizeX == Other.SizeX && SizeY == Other.SizeY && PixelFormat == Other.PixelFormat && bIsSRGB == Other.bIsSRGB; }
+			friend uint32 GetTypeHash(const FTexturePoolKey& Key) { return HashCombine(HashCombine(GetTypeHash(Key.SizeX), GetTypeHash(Key.SizeY)), GetTypeHash(static_cast<uint32>(Key.PixelFormat) << 1 | Key.bIsSRGB)); }
+		};
+		struct FTexturePoolBucket
+		{
+			/** The pooled textures, oldest first. Textures are always added at the back, so the ones pooled this frame are all at the back */
+			TTouchRingBuffer<FImportedTexturePoolData> Textures;
+			/** The memory used by one texture of this bucket */
+			int64 TextureSizeInBytes = 0;
+			/** The value of TexturePoolUseCounter when a texture was last added or taken from this bucket, used to evict the least recently used buckets first */
+			uint64 LastUsed = 0;
+		};
 		FCriticalSection TexturePoolMutex;
-		/** The texture pool itself, keeping hold of the temporary UTexture created to reuse them when an import is needed, saving the need to go back to GameThread to create a new one */
-		TArray<FImportedTexturePoolData> TexturePool;
+		/**
+		 * The texture pool itself, keeping hold of the temporary UTexture created to reuse them when an import is needed, saving the need to go back to GameThread to create a new one.
+		 * Textures are grouped by description so finding a matching texture does not require to go through all of them, nor to query their RHI.
+		 */
+		TMap<FTexturePoolKey, FTexturePoolBucket> TexturePool;
+		/** Incremented every time the pool is used, to know which buckets were used last */
+		uint64 TexturePoolUseCounter = 0;
+		int32 NumPooledTextures = 0;
+		int64 PooledTexturesSizeInBytes = 0;
 
 		FCriticalSection KeepTexturesAliveMutex;
 		/** Array of textures to keep alive while we are copying them */
@@ -140,6 +176,11 @@ namespace UE::TouchEngine
 		
 		UTexture2D* GetOrCreateUTextureMatchingMetaData(const FTextureMetaData& TETextureMetadata, const FTouchImportParameters& LinkParams, bool& bOutAccessRHIViaReferenceTexture);
 		UTexture2D* FindPoolTextureMatchingMetadata(const FTextureMetaData& TETextureMetadata, const FTouchEngineInputFrameData& FrameData);
+		/** Adds a texture back to the pool so it can be reused for a later import. TexturePoolMutex must be locked */
+		void AddTextureToPool(UTexture2D* Texture, int64 FrameID);
+		/** Removes and releases the oldest texture of the bucket. TexturePoolMutex must be locked */
+		void EvictOldestTexture(FTexturePoolBucket& Bucket);
+		void UpdateTexturePoolStats() const;
 	};
 }
 
@@ -98,7 +98,7 @@ namespace UE::TouchEngine
 		virtual FTouchTextureImporter& GetImporter() = 0;
 
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) = 0;
-		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) = 0;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes) = 0;
 		
 		/**
 		 * Returns a stable RHI for the given texture. The texture needs to not be null.
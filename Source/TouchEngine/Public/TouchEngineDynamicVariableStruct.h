@@ -17,6 +17,8 @@
 #include "CoreMinimal.h"
 #include "TouchEngineIntVector4.h"
 #include "Engine/TouchVariables.h"
+#include "Engine/Util/TouchCHOPView.h"
+#include "Engine/Util/TouchLinkHandle.h"
 #include "Misc/Variant.h"
 #include "Util/TouchHelpers.h"
 #include "TouchEngineDynamicVariableStruct.generated.h"
@@ -270,6 +272,8 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	// Pointer to variable value
 	void* Value = nullptr;
 	size_t Size = 0; // todo: Is the size necessary? Almost never used
+	/** For CHOP outputs, the CHOP received from TouchEngine. When valid, Value is not used and the samples are only copied when GetValueAsCHOP is called */
+	UE::TouchEngine::FTouchCHOPView CHOPView;
 
 	/* The minimum value this variable should be able to have. Retrieved from TELinkValueMinimum and is equivalent to the clamp min in TouchDesigner */
 	FVariant ClampMin;
@@ -293,6 +297,9 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	UPROPERTY(Transient)
 	int64 FrameLastUpdated = -1;
 
+	/** The handle of this variable in the link registry of the variable manager, resolved the first time the value is sent or retrieved so the identifier is not looked up every frame */
+	mutable UE::TouchEngine::FTouchLinkHandle LinkHandle;
+
 	bool IsInputVariable() const { return UE::TouchEngine::IsInputVariable(VarName); }
 	bool IsOutputVariable() const { return UE::TouchEngine::IsOutputVariable(VarName); }
 	bool IsParameterVariable() const { return  UE::TouchEngine::IsParameterVariable(VarName); }
@@ -396,6 +403,8 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	void SetValue(const FLinearColor& InValue) { SetValue(TArray<float>{InValue.R, InValue.G, InValue.B, InValue.A});}
 	void SetValue(const FVector& InValue) { SetValue(TArray<double>{InValue.X, InValue.Y, InValue.Z});}
 	void SetValue(const FTouchEngineCHOP& InValue);
+	/** Sets the value of a CHOP without copying its samples. The given view is kept until the value changes */
+	void SetValue(const UE::TouchEngine::FTouchCHOPView& InValue);
 	void SetValueAsCHOP(const TArray<float>& InValue, int NumChannels, int NumSamples);
 	void SetValueAsCHOP(const TArray<float>& InValue, const TArray<FString>& InChannelNames);
 	void SetValue(const UTouchEngineDAT* InValue);
@@ -429,6 +438,8 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableStruct
 	
 	/** Function called when serializing this struct to a FArchive */
 	bool Serialize(FArchive& Ar);
+	/** Serializes the default value, the clamp and UI ranges and the dropdown data, which are only known once the tox file has been loaded. Only serialized by Serialize when transacting */
+	void SerializeMetadata(FArchive& Ar);
 	/** Function called when copying the object, exporting the Value as string */
 	FString ExportValue(const EPropertyPortFlags PortFlags = PPF_Delimited) const;
 	/**
@@ -583,6 +594,8 @@ public:
 
 	/** Updates the output value from the engine info */
 	void GetOutput(const UTouchEngineInfo* EngineInfo);
+	/** Updates the output value from the VariableManager directly */
+	void GetOutput(UE::TouchEngine::FTouchVariableManager& VariableManager);
 
 	/** Tooltip text for this parameter / input / output when shown in the display panel */
 	FText GetTooltip() const;
@@ -758,6 +771,98 @@ DECLARE_MULTICAST_DELEGATE(FTouchOnReset);
 // Callback for when the TouchEngine instance fails to load a tox file
 DECLARE_MULTICAST_DELEGATE_OneParam(FTouchOnLoadFailed, const FString&);
 
+/**
+ * Copy of the input values that changed for a given cook, created by FTouchEngineDynamicVariableContainer::CopyInputsForCook.
+ * Inputs are identified by their index in FTouchEngineDynamicVariableContainer::DynVars_Input, so merging two sets of inputs does not hash any string,
+ * and are sent to TouchEngine through their link handle.
+ * Bool, Int, Double and Float values are stored in a flat array, and CHOP values are converted once and shared, so moving this between cooks stays cheap.
+ * Once sent, the arrays are given back to the container which created them through Recycle, so the next cooks reuse them instead of allocating new ones.
+ */
+struct TOUCHENGINE_API FTouchEngineCookInputs
+{
+	/** Adds the current value of the given input. Does nothing if a value was already added for this InputIndex. LinkHandle must be resolved */
+	void Add(int32 InputIndex, const FTouchEngineDynamicVariableStruct& Input, const UE::TouchEngine::FTouchLinkHandle& LinkHandle);
+	/** Adds the values of an older set of inputs that are not set in this one. Used when a cook is discarded, so its inputs are sent with the next cook instead */
+	void MergeOlderInputs(FTouchEngineCookInputs&& OlderInputs);
+	/** Sends all the values to TouchEngine */
+	void SendInputs(UE::TouchEngine::FTouchVariableManager& VariableManager, const FTouchEngineInputFrameData& FrameData);
+
+	bool Contains(int32 InputIndex) const { return AddedInputs.IsValidIndex(InputIndex) && AddedInputs[InputIndex]; }
+	int32 Num() const { return Entries.Num(); }
+	bool IsEmpty() const { return Entries.IsEmpty(); }
+	/** Removes all the values, keeping the memory of the arrays */
+	void Reset();
+	/** Resets the inputs and gives their arrays back to the pool of the container which created them. Must be called on the GameThread */
+	void Recycle();
+
+private:
+	friend struct FTouchEngineDynamicVariableContainer;
+	
+	struct FEntry
+	{
+		/** The index of the input in DynVars_Input */
+		int32 InputIndex;
+		EVarType VarType;
+		/** The index of the first value in ScalarValues, CHOPValues or OtherValues, depending on the VarType */
+		int32 ValueIndex;
+		/** The number of consecutive values in ScalarValues */
+		int32 Count;
+		/** The link of the input in the variable manager the inputs are sent to */
+		UE::TouchEngine::FTouchLinkHandle LinkHandle;
+	};
+
+	/** One bit per entry of DynVars_Input, set when a value was added for this input */
+	TBitArray<> AddedInputs;
+	TArray<FEntry> Entries;
+	/** The values of the Bool, Int, Double and Float inputs. All of them can be represented exactly as doubles */
+	TArray<double> ScalarValues;
+	/** The values of the CHOP inputs, immutable once converted */
+	TArray<TSharedRef<const FTouchEngineCHOP>> CHOPValues;
+	/** The String, DAT and Texture inputs, kept as a copy of the dynamic variable */
+	TArray<FTouchEngineDynamicVariableStruct> OtherValues;
+	/** The Int values converted back from ScalarValues when they are sent, kept to avoid allocating a new array every cook */
+	TArray<int32_t> IntValuesToSend;
+	/** The channel used to send the Float values, kept to avoid allocating a new array every cook */
+	FTouchEngineCHOPChannel FloatChannelToSend;
+	/** The pool of the container which created these inputs, which Recycle gives the arrays back to */
+	TWeakPtr<TArray<FTouchEngineCookInputs>> OwningPool;
+
+	void AddEntry(FEntry&& Entry);
+};
+
+/**
+ * A dynamic variable resolved once by name, so it can be set or retrieved repeatedly without looking it up again.
+ * The handle stays usable if the tox is reloaded: if the variable moved, it is looked up again by its identifier.
+ */
+USTRUCT(BlueprintType)
+struct TOUCHENGINE_API FTouchEngineDynamicVariableHandle
+{
+	GENERATED_BODY()
+
+	/** The identifier of the resolved variable, like "p/Param" */
+	UPROPERTY(BlueprintReadOnly, Category = "TouchEngine")
+	FString Identifier;
+
+	UPROPERTY()
+	bool bIsInput = true;
+	/** The index of the variable in DynVars_Input or DynVars_Output */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+};
+
+namespace UE::TouchEngine
+{
+	/** Key functions for the identifier index of FTouchEngineDynamicVariableContainer. Identifiers are compared case sensitively, unlike the default FString keys */
+	template<typename ValueType>
+	struct TCaseSensitiveStringMapKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+}
+
 /**
  * Holds all input and output variables for an instance of the "UTouchEngineComponentBase" component class.
  * Also holds callbacks from the TouchEngine to get info about when parameters are loaded
@@ -773,6 +878,11 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableContainer
 	UPROPERTY(EditAnywhere, meta = (NoResetToDefault, DisplayName = "Output"), Category = "Properties")
 	TArray<FTouchEngineDynamicVariableStruct> DynVars_Output;
 
+	FTouchEngineDynamicVariableContainer() = default;
+	/** Copies the variables, but not the pool of cook inputs: the copy gets its own, as the pool is only meant to be used from the GameThread by a single container */
+	FTouchEngineDynamicVariableContainer(const FTouchEngineDynamicVariableContainer& Other);
+	FTouchEngineDynamicVariableContainer& operator=(const FTouchEngineDynamicVariableContainer& Other);
+
 	// Callback function attached to parent component's TouchEngine parameters loaded delegate
 	void ToxParametersLoaded(const TArray<FTouchEngineDynamicVariableStruct>& VariablesIn, const TArray<FTouchEngineDynamicVariableStruct>& VariablesOut);
 	/* Copies the Default, Min, Max and Dropdown values from the passed in variables */
@@ -786,13 +896,44 @@ struct TOUCHENGINE_API FTouchEngineDynamicVariableContainer
 	void SetupForFirstCook();
 
 	/**
-	 * This function will return a new FTouchEngineDynamicVariableContainer with a copy of the inputs that have changed this frame, and no outputs.
+	 * This function will return a copy of the values of the inputs that have changed this frame, resolving their link in the given VariableManager.
 	 * This will also reset any Pulse variable to their default values
 	 */
-	TMap<FString, FTouchEngineDynamicVariableStruct> CopyInputsForCook(int64 CurrentFrameID);
+	FTouchEngineCookInputs CopyInputsForCook(int64 CurrentFrameID, const UE::TouchEngine::FTouchVariableManager& VariableManager);
 	
+	/** Returns the variable with the given name, or nullptr if there is none or if more than one variable have this name. */
 	FTouchEngineDynamicVariableStruct* GetDynamicVariableByName(const FString& VarName);
+	/** Returns the first variable whose identifier, label or name is VarIdentifier, inputs first. */
 	FTouchEngineDynamicVariableStruct* GetDynamicVariableByIdentifier(const FString& VarIdentifier);
+
+	/** Finds a variable by identifier, label or name, like GetDynamicVariableByIdentifier followed by GetDynamicVariableByName, and returns a handle to it */
+	bool ResolveHandle(const FString& VarNameWithPrefix, FTouchEngineDynamicVariableHandle& OutHandle);
+	/** Returns the variable the handle was resolved to, looking it up by identifier if the variables changed since */
+	FTouchEngineDynamicVariableStruct* GetDynamicVariableByHandle(const FTouchEngineDynamicVariableHandle& Handle);
+
+	/** Marks the lookup index as out of date. Must be called when variables are added, removed or renamed without going through ToxParametersLoaded or Reset, like editor changes */
+	void InvalidateIndex() { bIsIndexValid = false; }
+
+private:
+	using FIdentifierIndex = TMap<FString, FTouchEngineDynamicVariableHandle, FDefaultSetAllocator, UE::TouchEngine::TCaseSensitiveStringMapKeyFuncs<FTouchEngineDynamicVariableHandle>>;
+	/** Maps the identifier, label and name of all variables to the first variable which has it, like the linear search of GetDynamicVariableByIdentifier would */
+	FIdentifierIndex IdentifierIndex;
+	/** Maps the names of all variables, case insensitively. Names shared by multiple variables map to an invalid handle */
+	TMap<FString, FTouchEngineDynamicVariableHandle> NameIndex;
+	bool bIsIndexValid = false;
+	/** The outputs which changed during the last cook, indexed by link. Kept from frame to frame so GetOutputs does not allocate */
+	TBitArray<> ChangedOutputLinks;
+	/** The cook inputs which have been sent to TouchEngine, whose arrays are reused by CopyInputsForCook. Only accessed on the GameThread, and never shared with a copy of this container */
+	TSharedRef<TArray<FTouchEngineCookInputs>> CookInputsPool = MakeShared<TArray<FTouchEngineCookInputs>>();
+	/** The number of variables when the index was built, to catch changes made directly to the arrays */
+	int32 NumIndexedInputs = 0;
+	int32 NumIndexedOutputs = 0;
+
+	const FTouchEngineDynamicVariableHandle* FindHandleByIdentifier(const FString& VarIdentifier);
+	const FTouchEngineDynamicVariableHandle* FindHandleByName(const FString& VarName);
+	void EnsureIndexIsValid();
+	void RebuildIndex();
+	FTouchEngineDynamicVariableStruct* GetVariableAt(bool bIsInput, int32 Index);
 };
 
 // Templated function definitions
@@ -15,6 +15,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "TouchEngineDynamicVariableStruct.h"
+#include "Engine/TouchLoadResults.h"
 #if WITH_EDITOR
 #include "Engine/TouchEngineSubsystem.h"
 #endif
@@ -44,6 +46,14 @@ public:
 	UFUNCTION(BlueprintSetter, Category = ImportSettings)
 	void SetFilePath(FString InPath);
 
+	/** Whether the variables parsed from the tox file were baked in the asset when it was last saved or cooked */
+	bool HasBakedToxMetadata() const { return bHasBakedToxMetadata; }
+	/**
+	 * Returns the variables parsed from the tox file when the asset was last saved or cooked, if any.
+	 * This allows components to bind their variables before TouchEngine has loaded the tox file. The variables still need to be validated against the ones of the live instance.
+	 */
+	TOptional<UE::TouchEngine::FTouchLoadResult> GetBakedLoadResult() const;
+
 private:
 	/*
 	 * File path to the tox file.
@@ -52,6 +62,19 @@ private:
 	*/
 	UPROPERTY(EditAnywhere, BlueprintGetter=GetRelativeFilePath, BlueprintSetter=SetFilePath, Category = ImportSettings)
 	FString FilePath;
+
+	/** Whether BakedInputs and BakedOutputs are set. They are serialized manually in Serialize, as FTouchEngineDynamicVariableStruct does not save its metadata */
+	bool bHasBakedToxMetadata = false;
+	TArray<FTouchEngineDynamicVariableStruct> BakedInputs;
+	TArray<FTouchEngineDynamicVariableStruct> BakedOutputs;
+	/** MD5 hash of the tox file the variables were baked from, used to detect when the baked variables are stale */
+	FString BakedToxFileHash;
+
+	void SerializeBakedToxMetadata(FArchive& Ar);
+#if WITH_EDITOR
+	/** Bakes the variables from the subsystem or from the tox metadata cache, or discards the baked variables if they are stale and cannot be refreshed */
+	void BakeToxMetadata(bool bIsCooking);
+#endif
 	
 public:
 // #if WITH_EDITORONLY_DATA
@@ -65,6 +88,7 @@ public:
 	// virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
 	virtual void Serialize(FArchive& Ar) override;
 #if WITH_EDITOR
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 	// End of UObject interface
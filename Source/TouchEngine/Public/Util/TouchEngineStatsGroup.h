@@ -15,11 +15,54 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 DECLARE_STATS_GROUP(TEXT("TouchEngine"), STATGROUP_TouchEngine, STATCAT_Advanced)
 
+/**
+ * CSV profiler category recording the timings of the cook stages and the cook counters every frame, so runs can be compared against each other.
+ * Disabled by default, enable it with -csvCategories=TouchEngine or the `csvcategory TouchEngine` console command.
+ */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TOUCHENGINE_API, TouchEngine);
+
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Nb Total Textures"), STAT_TE_ExportedTexturePool_NbTexturesTotal, STATGROUP_TouchEngine)
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Export - Texture Pool - Nb Textures in Pool"), STAT_TE_ExportedTexturePool_NbTexturesPool, STATGROUP_TouchEngine)
 
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Textures in Pool"), STAT_TE_ImportedTexturePool_NbTexturesPool, STATGROUP_TouchEngine)
+DECLARE_MEMORY_STAT(TEXT("Import - Texture Pool - Memory"), STAT_TE_ImportedTexturePool_Memory, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Hits"), STAT_TE_ImportedTexturePool_NbHits, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Misses"), STAT_TE_ImportedTexturePool_NbMisses, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - Texture Pool - Nb Evictions"), STAT_TE_ImportedTexturePool_NbEvictions, STATGROUP_TouchEngine)
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Import - No Texture2d Created for Import"), STAT_TE_Import_NbTexture2dCreated, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Input - CHOP - Nb Float Buffers Created"), STAT_TE_CHOPInput_NbFloatBuffersCreated, STATGROUP_TouchEngine)
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Cook - Idle Gap Between Cooks (ms)"), STAT_TE_Cook_IdleGapMs, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cook - Nb Outputs Fetched"), STAT_TE_Cook_NbOutputsFetched, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Adaptive - Input Buffer Limit"), STAT_TE_Adaptive_InputBufferLimit, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Adaptive - Pipeline Depth"), STAT_TE_Adaptive_PipelineDepth, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Adaptive - Submission Interval (ticks)"), STAT_TE_Adaptive_SubmissionInterval, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Adaptive - Cook Duration / Frame Time"), STAT_TE_Adaptive_CookToFrameRatio, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler - Nb Cooks Started"), STAT_TE_Scheduler_NbCooksStarted, STATGROUP_TouchEngine)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler - Nb Cooks Deferred"), STAT_TE_Scheduler_NbCooksDeferred, STATGROUP_TouchEngine)
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduler - GameThread Time (ms)"), STAT_TE_Scheduler_GameThreadMs, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance Pool - Nb Idle Instances"), STAT_TE_InstancePool_NbIdle, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance Pool - Nb Pending Instances"), STAT_TE_InstancePool_NbPending, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance Pool - Nb Hits"), STAT_TE_InstancePool_NbHits, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Instance Pool - Nb Misses"), STAT_TE_InstancePool_NbMisses, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Instance Pool - Last Spawn Time (ms)"), STAT_TE_InstancePool_SpawnTimeMs, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook Watchdog - Nb Watched Cooks"), STAT_TE_CookWatchdog_NbWatched, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook Watchdog - Nb Timeouts"), STAT_TE_CookWatchdog_NbTimeouts, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cook Watchdog - Nb Unresponsive Instances"), STAT_TE_CookWatchdog_NbUnresponsive, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Cook Watchdog - Max Detection Delay (ms)"), STAT_TE_CookWatchdog_MaxDetectionDelayMs, STATGROUP_TouchEngine)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tox Load - Nb Queued"), STAT_TE_ToxLoad_NbQueued, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tox Load - Nb Running"), STAT_TE_ToxLoad_NbActive, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tox Load - Nb Merged Requests"), STAT_TE_ToxLoad_NbMerged, STATGROUP_TouchEngine)
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tox Load - Nb Cancelled"), STAT_TE_ToxLoad_NbCancelled, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Tox Load - Last Queue Wait (ms)"), STAT_TE_ToxLoad_QueueWaitMs, STATGROUP_TouchEngine)
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Tox Load - Last Load Time (ms)"), STAT_TE_ToxLoad_LoadTimeMs, STATGROUP_TouchEngine)
@@ -0,0 +1,122 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/TouchEngineInputFrameData.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+#define TOUCHENGINE_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if TOUCHENGINE_TRACE_ENABLED
+
+/**
+ * Trace channel used to follow a cook across the GameThread, RenderThread and TouchEngine callback threads in Unreal Insights.
+ * Enable it with -trace=cpu,TouchEngine or `Trace.Enable TouchEngine` in the console. When the channel is off, the events cost a branch.
+ */
+UE_TRACE_CHANNEL_EXTERN(TouchEngineChannel, TOUCHENGINE_API)
+
+namespace UE::TouchEngine::Trace
+{
+	/** The stages of a cook, from the moment the component enqueues its inputs to the moment the outputs are broadcast */
+	enum class ECookStage : uint8
+	{
+		/** The whole cook, from the call to TEInstanceStartFrameAtTime until TouchEngine tells us the frame is done */
+		Cook,
+		/** The component enqueues a cook request in the frame cooker */
+		Enqueue,
+		/** The component gathers the input values by calling OnStartFrame */
+		GatherInputs,
+		/** The inputs are sent to TouchEngine (input staging) */
+		SendInputs,
+		/** The call to TEInstanceStartFrameAtTime */
+		StartFrame,
+		/** An output texture is being imported from TouchEngine */
+		TextureImport,
+		/** The copy of an output texture into its Unreal texture on the RenderThread */
+		RenderCopy,
+		/** The output values are read back into the dynamic variables */
+		GetOutputs,
+		/** The call to OnEndFrame */
+		BroadcastOnEndFrame,
+	};
+
+	/** Outputs the name of a component so the events carrying its ComponentId can be attributed to it. */
+	TOUCHENGINE_API void OutputComponent(uint32 ComponentId, const FString& ComponentName);
+	TOUCHENGINE_API void OutputCookStageBegin(ECookStage Stage, const FTouchEngineInputFrameData& FrameData);
+	TOUCHENGINE_API void OutputCookStageEnd(ECookStage Stage, const FTouchEngineInputFrameData& FrameData);
+	/** Outputs the start and end times returned by TouchEngine in the TEEventFrameDidFinish event */
+	TOUCHENGINE_API void OutputTouchEngineCookTimes(const FTouchEngineInputFrameData& FrameData, double CookStartTime, double CookEndTime, bool bWasFrameDropped);
+
+	/** Outputs the begin and end events of a cook stage for the lifetime of the scope */
+	class FCookStageScope
+	{
+	public:
+		FCookStageScope(ECookStage InStage, const FTouchEngineInputFrameData& InFrameData)
+			: Stage(InStage)
+			, FrameData(InFrameData)
+			, bIsEnabled(UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel))
+		{
+			if (bIsEnabled)
+			{
+				OutputCookStageBegin(Stage, FrameData);
+			}
+		}
+
+		~FCookStageScope()
+		{
+			if (bIsEnabled)
+			{
+				OutputCookStageEnd(Stage, FrameData);
+			}
+		}
+
+	private:
+		ECookStage Stage;
+		FTouchEngineInputFrameData FrameData;
+		bool bIsEnabled;
+	};
+}
+
+/**
+ * Traces the current scope as the given cook stage of the given frame. The stage appears as a timer named "TouchEngine <Stage>" in the Insights timing view,
+ * and a pair of TouchEngine.CookStageBegin/End events tagged with the FrameID and the ComponentId of the frame is output.
+ */
+#define TRACE_TOUCHENGINE_COOK_STAGE(Stage, FrameData) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("TouchEngine " #Stage, TouchEngineChannel); \
+	const UE::TouchEngine::Trace::FCookStageScope PREPROCESSOR_JOIN(TouchEngineCookStageScope, __LINE__)(UE::TouchEngine::Trace::ECookStage::Stage, FrameData);
+
+#define TRACE_TOUCHENGINE_COOK_STAGE_BEGIN(Stage, FrameData) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel)) { UE::TouchEngine::Trace::OutputCookStageBegin(UE::TouchEngine::Trace::ECookStage::Stage, FrameData); } } while (0)
+
+#define TRACE_TOUCHENGINE_COOK_STAGE_END(Stage, FrameData) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel)) { UE::TouchEngine::Trace::OutputCookStageEnd(UE::TouchEngine::Trace::ECookStage::Stage, FrameData); } } while (0)
+
+#define TRACE_TOUCHENGINE_COOK_TIMES(FrameData, CookStartTime, CookEndTime, bWasFrameDropped) \
+	do { if (UE_TRACE_CHANNELEXPR_IS_ENABLED(TouchEngineChannel)) { UE::TouchEngine::Trace::OutputTouchEngineCookTimes(FrameData, CookStartTime, CookEndTime, bWasFrameDropped); } } while (0)
+
+#define TRACE_TOUCHENGINE_COMPONENT(ComponentId, ComponentName) \
+	do { UE::TouchEngine::Trace::OutputComponent(ComponentId, ComponentName); } while (0)
+
+#else
+
+#define TRACE_TOUCHENGINE_COOK_STAGE(Stage, FrameData)
+#define TRACE_TOUCHENGINE_COOK_STAGE_BEGIN(Stage, FrameData)
+#define TRACE_TOUCHENGINE_COOK_STAGE_END(Stage, FrameData)
+#define TRACE_TOUCHENGINE_COOK_TIMES(FrameData, CookStartTime, CookEndTime, bWasFrameDropped)
+#define TRACE_TOUCHENGINE_COMPONENT(ComponentId, ComponentName)
+
+#endif
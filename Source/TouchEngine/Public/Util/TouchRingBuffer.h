@@ -0,0 +1,102 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Optional.h"
+
+namespace UE::TouchEngine
+{
+	/**
+	 * Bounded FIFO queue stored in a circular array. Pushing and popping are O(1) and never move the other elements,
+	 * which allows move-only types (like a struct holding a TPromise) to be queued without being shuffled around.
+	 * Not thread safe: the owner is responsible for locking.
+	 */
+	template<typename ElementType>
+	class TTouchRingBuffer
+	{
+	public:
+		explicit TTouchRingBuffer(int32 InCapacity = 1)
+		{
+			Reserve(InCapacity);
+		}
+
+		int32 Num() const { return Count; }
+		int32 Capacity() const { return Slots.Num(); }
+		bool IsEmpty() const { return Count == 0; }
+		bool IsFull() const { return Count == Slots.Num(); }
+
+		/** Grows the buffer so it can hold at least InCapacity elements. The buffer never shrinks, so no queued elements can be lost. */
+		void Reserve(int32 InCapacity)
+		{
+			InCapacity = FMath::Max(1, InCapacity);
+			if (InCapacity <= Slots.Num())
+			{
+				return;
+			}
+
+			TArray<TOptional<ElementType>> NewSlots;
+			NewSlots.SetNum(InCapacity);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				NewSlots[Index] = MoveTemp(Slots[GetSlotIndex(Index)]);
+			}
+			Slots = MoveTemp(NewSlots);
+			Head = 0;
+		}
+
+		/** Adds the element at the back of the queue. The buffer must not be full. */
+		void PushBack(ElementType&& Element)
+		{
+			check(!IsFull());
+			Slots[GetSlotIndex(Count)].Emplace(MoveTemp(Element));
+			++Count;
+		}
+
+		/** Removes and returns the oldest element of the queue. The buffer must not be empty. */
+		ElementType PopFront()
+		{
+			check(!IsEmpty());
+			TOptional<ElementType>& Slot = Slots[Head];
+			ElementType Element = MoveTemp(Slot.GetValue());
+			Slot.Reset();
+			Head = (Head + 1) % Slots.Num();
+			--Count;
+			return Element;
+		}
+
+		/** Returns the oldest element of the queue, which would be returned by the next call to PopFront. */
+		ElementType& Front()
+		{
+			check(!IsEmpty());
+			return Slots[Head].GetValue();
+		}
+
+		/** Returns the newest element of the queue. */
+		ElementType& Back()
+		{
+			check(!IsEmpty());
+			return Slots[GetSlotIndex(Count - 1)].GetValue();
+		}
+
+	private:
+		TArray<TOptional<ElementType>> Slots;
+		/** Index in Slots of the oldest element */
+		int32 Head = 0;
+		int32 Count = 0;
+
+		int32 GetSlotIndex(int32 OffsetFromHead) const { return (Head + OffsetFromHead) % Slots.Num(); }
+	};
+}
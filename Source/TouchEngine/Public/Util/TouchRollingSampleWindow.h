@@ -0,0 +1,103 @@
+/* Shared Use License: This file is owned by Derivative Inc. (Derivative)
+* and can only be used, and/or modified for use, in conjunction with
+* Derivative's TouchDesigner software, and only if you are a licensee who has
+* accepted Derivative's TouchDesigner license or assignment agreement
+* (which also govern the use of this file). You may share or redistribute
+* a modified version of this file provided the following conditions are met:
+*
+* 1. The shared file or redistribution must retain the information set out
+* above and this list of conditions.
+* 2. Derivative's name (Derivative Inc.) or its trademarks may not be used
+* to endorse or promote products derived from this file without specific
+* prior written permission from Derivative.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+namespace UE::TouchEngine
+{
+	/** The distribution of the samples held by a TTouchRollingSampleWindow at the time it was queried */
+	struct FTouchRollingSampleSummary
+	{
+		int32 Num = 0;
+		double Mean = 0.0;
+		double P50 = 0.0;
+		double P95 = 0.0;
+		double P99 = 0.0;
+		double Max = 0.0;
+	};
+	
+	/**
+	 * Keeps the last WindowSize samples of a value to compute its percentiles over a rolling window.
+	 * Adding a sample is lock-free and wait-free so it can be done from any thread; the percentiles are computed on demand by sorting a copy of the window,
+	 * which is meant to be done at a low frequency, like when displaying stats. A summary taken while samples are being added might mix samples of two consecutive updates.
+	 */
+	template<int32 WindowSize>
+	class TTouchRollingSampleWindow
+	{
+		static_assert(WindowSize > 0, "The window needs to hold at least one sample");
+	public:
+		TTouchRollingSampleWindow()
+		{
+			Reset();
+		}
+
+		void AddSample(double Value)
+		{
+			const uint64 SampleIndex = NumSamplesAdded.fetch_add(1, std::memory_order_relaxed);
+			Samples[SampleIndex % WindowSize].store(Value, std::memory_order_relaxed);
+		}
+
+		void Reset()
+		{
+			for (std::atomic<double>& Sample : Samples)
+			{
+				Sample.store(0.0, std::memory_order_relaxed);
+			}
+			NumSamplesAdded.store(0, std::memory_order_relaxed);
+		}
+
+		/** The number of samples added since the last reset, including the ones which are not part of the window anymore */
+		uint64 GetNumSamplesAdded() const { return NumSamplesAdded.load(std::memory_order_relaxed); }
+
+		FTouchRollingSampleSummary GetSummary() const
+		{
+			FTouchRollingSampleSummary Summary;
+			Summary.Num = static_cast<int32>(FMath::Min<uint64>(GetNumSamplesAdded(), WindowSize));
+			if (Summary.Num == 0)
+			{
+				return Summary;
+			}
+
+			TArray<double, TInlineAllocator<WindowSize>> SortedSamples;
+			SortedSamples.Reserve(Summary.Num);
+			double Total = 0.0;
+			for (int32 Index = 0; Index < Summary.Num; ++Index)
+			{
+				const double Sample = Samples[Index].load(std::memory_order_relaxed);
+				SortedSamples.Add(Sample);
+				Total += Sample;
+			}
+			SortedSamples.Sort();
+
+			const auto GetPercentile = [&SortedSamples](double Percentile)
+			{
+				const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedSamples.Num()) - 1, 0, SortedSamples.Num() - 1);
+				return SortedSamples[Index];
+			};
+			Summary.Mean = Total / Summary.Num;
+			Summary.P50 = GetPercentile(0.5);
+			Summary.P95 = GetPercentile(0.95);
+			Summary.P99 = GetPercentile(0.99);
+			Summary.Max = SortedSamples.Last();
+			return Summary;
+		}
+
+	private:
+		std::atomic<double> Samples[WindowSize];
+		std::atomic<uint64> NumSamplesAdded;
+	};
+}
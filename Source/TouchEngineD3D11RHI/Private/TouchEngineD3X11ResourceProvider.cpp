@@ -78,7 +78,7 @@ namespace UE::TouchEngine::D3DX11
 		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override;
 		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override {};
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override { return false; }
-		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override { return false; }
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes) override { return false; }
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
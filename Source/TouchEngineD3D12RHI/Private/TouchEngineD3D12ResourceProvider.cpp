@@ -71,7 +71,7 @@ namespace UE::TouchEngine::D3DX12
 		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override;
 		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override;
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override;
-		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes) override;
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
@@ -234,9 +234,9 @@ namespace UE::TouchEngine::D3DX12
 		return true;
 	}
 
-	bool FTouchEngineD3X12ResourceProvider::SetImportedTexturePoolSize(int ImportedTexturePoolSize)
+	bool FTouchEngineD3X12ResourceProvider::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes)
 	{
-		TextureImporter->PoolSize = FMath::Max(ImportedTexturePoolSize, 0);
+		TextureImporter->PoolBudgetInBytes = FMath::Max<int64>(ImportedTexturePoolBudgetInBytes, 0);
 		return true;
 	}
 }
@@ -66,7 +66,7 @@ namespace UE::TouchEngine::Vulkan
 		virtual TFuture<FTouchSuspendResult> SuspendAsyncTasks_GameThread() override;
 		virtual void FinalizeExportsToTouchEngine_GameThread(const FTouchEngineInputFrameData& FrameData) override;
 		virtual bool SetExportedTexturePoolSize(int ExportedTexturePoolSize) override;
-		virtual bool SetImportedTexturePoolSize(int ImportedTexturePoolSize) override;
+		virtual bool SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes) override;
 
 	protected:
 		virtual FTouchTextureImporter& GetImporter() override { return TextureImporter.Get(); }
@@ -206,9 +206,9 @@ namespace UE::TouchEngine::Vulkan
 		return true;
 	}
 
-	bool FTouchEngineVulkanResourceProvider::SetImportedTexturePoolSize(int ImportedTexturePoolSize)
+	bool FTouchEngineVulkanResourceProvider::SetImportedTexturePoolBudget(int64 ImportedTexturePoolBudgetInBytes)
 	{
-		TextureImporter->PoolSize = FMath::Max(ImportedTexturePoolSize, 0);
+		TextureImporter->PoolBudgetInBytes = FMath::Max<int64>(ImportedTexturePoolBudgetInBytes, 0);
 		return true;
 	}
 